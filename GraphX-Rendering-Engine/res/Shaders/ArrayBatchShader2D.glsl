@@ -0,0 +1,52 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec3 vPosition;
+layout(location = 1) in vec4 vColor;
+layout(location = 2) in vec2 vTexCoords;
+layout(location = 3) in uint vTexIndex;
+layout(location = 4) in uint vTexLayer;
+
+uniform mat4 u_ProjectionView = mat4(1.0f);
+
+out vec2 v_TexCoords;
+out vec4 v_Color;
+flat out uint v_TexIndex;
+flat out uint v_TexLayer;
+
+void main()
+{
+	gl_Position = u_ProjectionView * vec4(vPosition, 1.0f);
+	v_TexCoords = vTexCoords;
+	v_Color = vColor;
+	v_TexIndex = vTexIndex;
+	v_TexLayer = vTexLayer;
+}
+
+#shader fragment
+
+#version 330 core
+in vec2 v_TexCoords;
+in vec4 v_Color;
+flat in uint v_TexIndex;
+flat in uint v_TexLayer;
+
+uniform float u_Tiling = 1.0f;
+
+// Each slot holds a texture array, the textures of the same size and format are layers of the same array
+uniform sampler2DArray u_TextureArrays[32];
+
+// Layer used by the quads that only use colors
+const uint NoTextureLayer = 65535u;
+
+out vec4 color;
+
+void main()
+{
+	int index = int(v_TexIndex);
+
+	if (v_TexLayer == NoTextureLayer)
+		color = v_Color;
+	else
+		color = texture(u_TextureArrays[index], vec3(v_TexCoords * u_Tiling, float(v_TexLayer))) * v_Color;
+}
\ No newline at end of file
@@ -10,24 +10,23 @@ uniform mat4 u_Model = mat4(1.0f);
 uniform mat4 u_ProjectionView = mat4(1.0f);
 uniform mat3 u_Normal = mat3(1.0f);
 
-uniform mat4 u_LightSpaceMatrix = mat4(1.0f);
-
 // Varying variables
 out struct Data
 {
 	vec3 Normal;
 	vec3 WorldPosition;
 	vec4 Color;
-	vec4 LightSpacePos;
 } v_Data;
 
+/* Has to match the depth written by the depth pre pass */
+invariant gl_Position;
+
 void main()
 {
 	v_Data.WorldPosition = vec3(u_Model * vec4(vPosition, 1.0));
 	gl_Position = u_ProjectionView * vec4(v_Data.WorldPosition, 1.0);
 	v_Data.Normal = u_Normal * vNormal;
 	v_Data.Color = vColor;
-	v_Data.LightSpacePos = u_LightSpaceMatrix * vec4(v_Data.WorldPosition, 1.0f);
 }
 
 #shader fragment
@@ -38,12 +37,9 @@ in struct Data
 	vec3 Normal;
 	vec3 WorldPosition;
 	vec4 Color;
-	vec4 LightSpacePos;
 } v_Data;
 
 // Uniforms
-uniform vec4 u_LightColor;
-uniform vec3 u_LightPos;
 uniform vec3 u_CameraPos;
 uniform vec4 u_TintColor = vec4(0.0f);
 
@@ -62,27 +58,24 @@ uniform float u_AmbientStrength;
 uniform float u_Shininess;
 uniform float u_Reflectivity;
 
-uniform vec3 u_AttenuationFactors = vec3(1.0, 0.0, 0.0);
+uniform vec3 u_CameraForward;
 
-uniform sampler2D u_ShadowMap;
+#ifdef GX_TEXTURED
 uniform sampler2D u_Texture0;
+#endif
 
 out vec4 fColor;
 
-float ShadowCalculation(vec4 fragLightSpacePos)
-{
-	vec3 ProjectionCoords = fragLightSpacePos.xyz / fragLightSpacePos.w;	/* Normalised coordinates [-1, 1] */
-	ProjectionCoords = (ProjectionCoords + 1.0f) / 2.0f;					/* Range 0 - 1 */
-	float ClosestDepth = texture(u_ShadowMap, ProjectionCoords.xy).r;		/* ProjectionCoords.z is the current depth of the fragment */
+#ifdef GX_SHADOWS
+#include "Include/Shadows.glsl"
+#endif
 
-	// Check whether the fragment is in the shade or light
-	return ClosestDepth > ProjectionCoords.z ? 0.0f : 1.0f;
-}
+#ifdef GX_POINT_LIGHTS
+#include "Include/PointLights.glsl"
+#endif
 
 void main()
 {
-	bool bCalculateShadow = true;
-
 	// Normalize the light vector and the normal vector
 	vec3 UnitNormal = normalize(v_Data.Normal);
 
@@ -103,28 +96,26 @@ void main()
 
 
 	/**** Color due to the Point Lights ****/
-	// Diffuse Light Color
-	vec3 UnitLightVec = normalize(u_LightPos - v_Data.WorldPosition);
-	brightness = max(0.0f, dot(UnitNormal, UnitLightVec));
-	vec4 diffuseColor = u_LightColor * brightness;
-
-	// Specular Light Color
-	ViewDir = normalize(u_CameraPos - v_Data.WorldPosition);
-	vec3 ReflectedLightDir = reflect(-UnitLightVec, UnitNormal);
-	float shine = pow(max(dot(ReflectedLightDir, ViewDir), 0.0), u_Shininess);
-	vec4 specularColor = shine * u_Reflectivity * u_LightColor;
-
-	// Calculate the distance of the fragment from the light source
-	float distance = length(u_LightPos - v_Data.WorldPosition);
-
-	// Calculate the attenuation factor based on the distance of the fragment from the light source
-	float AttenuationFactor = (u_AttenuationFactors.x + (u_AttenuationFactors.y * distance) + (u_AttenuationFactors.z * distance * distance));
+#ifdef GX_POINT_LIGHTS
+	vec4 PointLightColor = PointLightsColor(v_Data.WorldPosition, UnitNormal, ViewDir);
+#else
+	vec4 PointLightColor = vec4(0.0f);
+#endif
 
 	// Calculate the shadow
+#ifdef GX_SHADOWS
+	float Shadow = ShadowCalculation(v_Data.WorldPosition, UnitNormal, LightDir);
+#else
 	float Shadow = 0.0f;
-	if(bCalculateShadow)
-		Shadow = ShadowCalculation(v_Data.LightSpacePos);
+#endif
+
+	// Untextured materials are coloured by the tint alone
+#ifdef GX_TEXTURED
+	vec4 BaseColor = mix(texture(u_Texture0, vec2(v_Data.Color.xy)), u_TintColor, 0.5f);
+#else
+	vec4 BaseColor = u_TintColor;
+#endif
 
 	// Divide the diffuse and specular components of the light color (ambient is the property of the environment, probably due to the directional light source - most probably sun)
-	fColor = (AmbientColor + (1.0f - Shadow) * (DiffuseColor_Global + SpecularColor_Global + (diffuseColor / AttenuationFactor) + (specularColor / AttenuationFactor))) * (mix(texture(u_Texture0, vec2(v_Data.Color.xy)), u_TintColor, 0.5f));
+	fColor = (AmbientColor + (1.0f - Shadow) * (DiffuseColor_Global + SpecularColor_Global) + PointLightColor) * BaseColor;
 }
\ No newline at end of file
@@ -4,13 +4,13 @@
 layout(location = 0) in vec3 vPosition;
 layout(location = 1) in vec4 vColor;
 layout(location = 2) in vec2 vTexCoords;
-layout(location = 3) in float vTexIndex;
+layout(location = 3) in uint vTexIndex;
 
 uniform mat4 u_ProjectionView = mat4(1.0f);
 
 out vec2 v_TexCoords;
 out vec4 v_Color;
-out float v_TexIndex;
+flat out uint v_TexIndex;
 
 void main()
 {
@@ -25,7 +25,7 @@ void main()
 #version 330 core
 in vec2 v_TexCoords;
 in vec4 v_Color;
-in float v_TexIndex;
+flat in uint v_TexIndex;
 
 uniform float u_Tiling = 1.0f;
 uniform sampler2D u_Textures[32];
@@ -34,6 +34,6 @@ out vec4 color;
 
 void main()
 {
-	int index = int(ceil(v_TexIndex));
+	int index = int(v_TexIndex);
 	color = texture(u_Textures[index], v_TexCoords * u_Tiling) * v_Color;
 }
\ No newline at end of file
@@ -6,9 +6,13 @@ layout(location = 0) in vec3 vPosition;
 uniform mat4 u_LightSpaceMatrix;
 uniform mat4 u_Model;
 
+/* Depth pre pass requires the exact same depth as the lighting shaders (computed the same way) */
+invariant gl_Position;
+
 void main()
 {
-	gl_Position = u_LightSpaceMatrix * u_Model * vec4(vPosition, 1.0f);
+	vec3 WorldPosition = vec3(u_Model * vec4(vPosition, 1.0f));
+	gl_Position = u_LightSpaceMatrix * vec4(WorldPosition, 1.0f);
 }
 
 #shader fragment
@@ -0,0 +1,38 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec3 vPosition;
+layout(location = 1) in vec3 vNormal;
+
+uniform mat4 u_Model = mat4(1.0f);
+uniform mat4 u_ProjectionView = mat4(1.0f);
+uniform mat3 u_Normal = mat3(1.0f);
+
+out vec3 v_Normal;
+
+/* Has to match the depth written by the depth pre pass */
+invariant gl_Position;
+
+void main()
+{
+	vec3 WorldPosition = vec3(u_Model * vec4(vPosition, 1.0));
+	gl_Position = u_ProjectionView * vec4(WorldPosition, 1.0);
+	v_Normal = u_Normal * vNormal;
+}
+
+#shader fragment
+#version 330 core
+
+in vec3 v_Normal;
+
+/* Used for the meshes while their own shader is being compiled, so kept as cheap as possible */
+uniform vec4 u_TintColor = vec4(0.5f, 0.5f, 0.5f, 1.0f);
+
+out vec4 fColor;
+
+void main()
+{
+	// Shade by the facing towards the up (z) axis, so that the shape of the mesh is visible
+	float Shade = 0.4f + 0.6f * max(normalize(v_Normal).z, 0.0f);
+	fColor = vec4(u_TintColor.rgb * Shade, 1.0f);
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+/* Lighting from the point lights assigned to the view clusters
+*  Requires u_CameraPos, u_CameraForward, u_Shininess and u_Reflectivity to be declared by the including shader
+*/
+
+/* Point lights (3 texels per light: position & range, color, attenuation factors) and the light lists of the view clusters */
+uniform samplerBuffer u_LightData;
+uniform usamplerBuffer u_ClusterData;	/* Offset (in to the light indices) and number of lights for each cluster */
+uniform usamplerBuffer u_LightIndices;
+uniform ivec3 u_ClusterGridSize;		/* Tiles along the width & height of the screen and the slices along the depth */
+uniform vec2 u_ClusterDepthParams;		/* Slice = log(ViewDepth) * x + y */
+uniform vec2 u_ViewportSize;
+
+/* Diffuse and specular color due to the point lights affecting the cluster of the fragment */
+vec4 PointLightsColor(vec3 WorldPosition, vec3 UnitNormal, vec3 ViewDir)
+{
+	// Find the cluster containing the fragment
+	float ViewDepth = max(dot(WorldPosition - u_CameraPos, u_CameraForward), 1e-4f);
+	ivec2 Tile = clamp(ivec2(gl_FragCoord.xy / u_ViewportSize * vec2(u_ClusterGridSize.xy)), ivec2(0), u_ClusterGridSize.xy - 1);
+	int Slice = clamp(int(log(ViewDepth) * u_ClusterDepthParams.x + u_ClusterDepthParams.y), 0, u_ClusterGridSize.z - 1);
+	uvec2 LightList = texelFetch(u_ClusterData, Tile.x + u_ClusterGridSize.x * (Tile.y + u_ClusterGridSize.y * Slice)).rg;
+
+	vec4 Color = vec4(0.0f);
+	for(uint i = 0u; i < LightList.y; i++)
+	{
+		int Light = 3 * int(texelFetch(u_LightIndices, int(LightList.x + i)).r);
+		vec4 PositionRange = texelFetch(u_LightData, Light);
+		vec4 LightColor = texelFetch(u_LightData, Light + 1);
+		vec3 AttenuationFactors = texelFetch(u_LightData, Light + 2).xyz;
+
+		vec3 LightVec = PositionRange.xyz - WorldPosition;
+		float Distance = length(LightVec);
+		vec3 UnitLightVec = LightVec / max(Distance, 1e-4f);
+
+		float Brightness = max(0.0f, dot(UnitNormal, UnitLightVec));
+		float Shine = pow(max(dot(reflect(-UnitLightVec, UnitNormal), ViewDir), 0.0f), u_Shininess);
+
+		// Attenuate with the distance and fade out to zero at the range of the light (lights are culled at the range)
+		float Attenuation = AttenuationFactors.x + AttenuationFactors.y * Distance + AttenuationFactors.z * Distance * Distance;
+		float Fade = clamp(1.0f - pow(Distance / PositionRange.w, 4.0f), 0.0f, 1.0f);
+		Color += LightColor * (Brightness + Shine * u_Reflectivity) * Fade * Fade / Attenuation;
+	}
+
+	return Color;
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+/* Shadows of the sun from the cascaded shadow map
+*  Requires u_CameraPos and u_CameraForward to be declared by the including shader
+*/
+
+/* Depth maps of the shadow cascades (one layer per cascade) */
+#define MAX_CASCADES 4
+uniform sampler2DArray u_ShadowMap;
+uniform mat4 u_LightSpaceMatrices[MAX_CASCADES];
+uniform float u_CascadeSplits[MAX_CASCADES];	/* Distance along the view direction at which each cascade ends */
+uniform int u_CascadeCount = 0;
+
+float ShadowCalculation(vec3 WorldPosition, vec3 UnitNormal, vec3 LightDir)
+{
+	// Select the cascade using the distance of the fragment along the view direction
+	float ViewDepth = dot(WorldPosition - u_CameraPos, u_CameraForward);
+	int Cascade = 0;
+	while(Cascade < u_CascadeCount && ViewDepth > u_CascadeSplits[Cascade])
+		Cascade++;
+
+	// Fragment is beyond the shadow distance
+	if(Cascade == u_CascadeCount)
+		return 0.0f;
+
+	vec4 fragLightSpacePos = u_LightSpaceMatrices[Cascade] * vec4(WorldPosition, 1.0f);
+	vec3 ProjectionCoords = fragLightSpacePos.xyz / fragLightSpacePos.w;	/* Normalised coordinates [-1, 1] */
+	ProjectionCoords = (ProjectionCoords + 1.0f) / 2.0f;					/* Range 0 - 1 */
+	if(ProjectionCoords.z > 1.0f)
+		return 0.0f;
+
+	float ClosestDepth = texture(u_ShadowMap, vec3(ProjectionCoords.xy, Cascade)).r;	/* ProjectionCoords.z is the current depth of the fragment */
+	float Bias = max(0.0025f * (1.0f - dot(UnitNormal, LightDir)), 0.0005f);		/* Slope scaled bias to avoid shadow acne */
+
+	// Check whether the fragment is in the shade or light
+	return ClosestDepth + Bias > ProjectionCoords.z ? 0.0f : 1.0f;
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#shader vertex
+#version 330 core
+
+// Per instance attributes
+layout(location = 0) in vec3 iPosition;
+layout(location = 1) in vec2 iSize;
+layout(location = 2) in vec4 iRotationAndTiling;	// xyz - Rotation (pitch, yaw, roll in degrees), w - Tiling
+layout(location = 3) in vec4 iColor;
+layout(location = 4) in vec4 iTexRect;				// xy - Lower left tex coords, zw - Upper right tex coords
+layout(location = 5) in uvec2 iTexIndexAndLayer;	// x - Texture slot, y - Texture array layer
+
+uniform mat4 u_ProjectionView = mat4(1.0f);
+
+out vec2 v_TexCoords;
+out vec4 v_Color;
+flat out uint v_TexIndex;
+flat out uint v_TexLayer;
+
+void main()
+{
+	// Corners of the quad in triangle strip order
+	vec2 Corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+
+	// Same rotation as GM::ScaleRotationTranslationMatrix (Only x and y axes are needed since the quad lies in the xy plane)
+	vec3 Angles = radians(iRotationAndTiling.xyz);
+	float CP = cos(Angles.x), SP = sin(Angles.x);
+	float CY = cos(Angles.y), SY = sin(Angles.y);
+	float CR = cos(Angles.z), SR = sin(Angles.z);
+
+	vec3 AxisX = vec3(CP * CY, CP * SY, -SP);
+	vec3 AxisY = vec3(SR * SP * CY - CR * SY, SR * SP * SY + CR * CY, SR * CP);
+
+	vec2 Local = (Corner - 0.5f) * iSize;
+	vec3 Position = iPosition + AxisX * Local.x + AxisY * Local.y;
+
+	gl_Position = u_ProjectionView * vec4(Position, 1.0f);
+	v_TexCoords = mix(iTexRect.xy, iTexRect.zw, Corner) * iRotationAndTiling.w;
+	v_Color = iColor;
+	v_TexIndex = iTexIndexAndLayer.x;
+	v_TexLayer = iTexIndexAndLayer.y;
+}
+
+#shader fragment
+
+#version 330 core
+in vec2 v_TexCoords;
+in vec4 v_Color;
+flat in uint v_TexIndex;
+flat in uint v_TexLayer;
+
+// Each slot holds a texture array, the textures of the same size and format are layers of the same array
+uniform sampler2DArray u_TextureArrays[32];
+
+// Layer used by the quads that only use colors
+const uint NoTextureLayer = 65535u;
+
+out vec4 color;
+
+void main()
+{
+	if (v_TexLayer == NoTextureLayer)
+		color = v_Color;
+	else
+		color = texture(u_TextureArrays[int(v_TexIndex)], vec3(v_TexCoords, float(v_TexLayer))) * v_Color;
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec3 vPosition;
+layout(location = 1) in vec4 vColor;
+layout(location = 2) in vec2 vTexCoords1;
+layout(location = 3) in vec2 vTexCoords2;
+layout(location = 4) in float vBlendFactor;
+layout(location = 5) in uvec2 vTexIndexAndRows;		// x - Texture Index, y - Rows in the texture atlas
+layout(location = 6) in uint vTexLayer;
+
+out vec4 v_Color;
+out vec2 v_TexCoords1;
+out vec2 v_TexCoords2;
+flat out uint v_TexAtlasRows;
+out float v_BlendFactor;
+flat out uint v_TexIndex;
+flat out uint v_TexLayer;
+
+// Uniforms
+uniform mat4 u_Projection;
+
+void main()
+{
+	v_Color = vColor;
+	v_TexCoords1 = vTexCoords1;
+	v_TexCoords2 = vTexCoords2;
+	v_TexAtlasRows = vTexIndexAndRows.y;
+	v_BlendFactor = vBlendFactor;
+	v_TexIndex = vTexIndexAndRows.x;
+	v_TexLayer = vTexLayer;
+	gl_Position = u_Projection * vec4(vPosition, 1.0f);
+}
+
+#shader fragment
+#version 330 core
+
+in vec4 v_Color;
+in vec2 v_TexCoords1;
+in vec2 v_TexCoords2;
+flat in uint v_TexAtlasRows;
+in float v_BlendFactor;
+flat in uint v_TexIndex;
+flat in uint v_TexLayer;
+
+// Each slot holds a texture array, the textures of the same size and format are layers of the same array
+uniform sampler2DArray u_TextureArrays[32];
+
+// Layer used by the particles that only use colors
+const uint NoTextureLayer = 65535u;
+
+out vec4 fColor;
+
+void main()
+{
+	int index = int(v_TexIndex);
+	float layer = float(v_TexLayer);
+
+	if (v_TexLayer == NoTextureLayer)
+	{
+		fColor = v_Color;
+	}
+	// Means texture atlas is not used
+	else if (v_TexAtlasRows <= 1u)
+	{
+		fColor = texture(u_TextureArrays[index], vec3(v_TexCoords1, layer)) * v_Color;
+	}
+	else
+	{
+		fColor = mix(texture(u_TextureArrays[index], vec3(v_TexCoords1, layer)), texture(u_TextureArrays[index], vec3(v_TexCoords2, layer)), v_BlendFactor) * v_Color;
+	}
+}
\ No newline at end of file
@@ -8,7 +8,6 @@ layout(location = 2) in vec2 vTexCoord;
 /* Uniforms */
 uniform mat4 u_Model = mat4(1.0f);
 uniform mat4 u_ProjectionView = mat4(1.0f);
-uniform mat4 u_LightSpaceMatrix = mat4(1.0f);
 
 /* Data sent to the fragment shader */
 out struct Data
@@ -16,16 +15,17 @@ out struct Data
 	vec3 Normal;
 	vec2 TexCoord;
 	vec3 WorldPosition;
-	vec4 LightSpacePos;
 } v_Data;
 
+/* Has to match the depth written by the depth pre pass */
+invariant gl_Position;
+
 void main()
 {
 	v_Data.WorldPosition = vec3(u_Model * vec4(vPosition, 1.0f));
 	gl_Position = u_ProjectionView * vec4(v_Data.WorldPosition, 1.0f);
 	v_Data.Normal = vNormal;
 	v_Data.TexCoord = vTexCoord;
-	v_Data.LightSpacePos = u_LightSpaceMatrix * vec4(v_Data.WorldPosition, 1.0f);
 }
 
 #shader fragment
@@ -37,11 +37,8 @@ in struct Data
 	vec3 Normal;
 	vec2 TexCoord;
 	vec3 WorldPosition;
-	vec4 LightSpacePos;
 } v_Data;
 
-uniform vec4 u_LightColor;
-uniform vec3 u_LightPos;
 uniform vec3 u_CameraPos;
 
 uniform ivec2 u_TerrainDimensions;	/* X & Z dimension of the terrain */
@@ -57,8 +54,6 @@ struct DirectionalLight
 /* Ambient Light (Represents Sun) */
 uniform DirectionalLight u_LightSource = DirectionalLight(vec4(1.0f, 1.0f, 1.0f, 1.0f), vec3(1.0f, 1.0f, 1.0f), 1.0f);
 
-uniform bool u_CalculateShadow = false;
-
 uniform float u_AmbientStrength;
 uniform float u_Shininess;
 uniform float u_Reflectivity;
@@ -78,20 +73,18 @@ uniform sampler2D u_Texture2;
 /* Represented by the B - channel in blendmap */
 uniform sampler2D u_Texture3;
 
-uniform sampler2D u_ShadowMap;
+uniform vec3 u_CameraForward;
 
 /* Final color */
 out vec4 fColor;
 
-float ShadowCalculation(vec4 fragLightSpacePos)
-{
-	vec3 ProjectionCoords = fragLightSpacePos.xyz / fragLightSpacePos.w;	/* Normalised coordinates [-1, 1] */
-	ProjectionCoords = (ProjectionCoords + 1.0f) / 2.0f;					/* Range 0 - 1 */
-	float ClosestDepth = texture(u_ShadowMap, ProjectionCoords.xy).r;		/* ProjectionCoords.z is the current depth of the fragment */
+#ifdef GX_SHADOWS
+#include "Include/Shadows.glsl"
+#endif
 
-	// Check whether the fragment is in the shade or light
-	return ClosestDepth > ProjectionCoords.z ? 0.0f : 1.0f;
-}
+#ifdef GX_POINT_LIGHTS
+#include "Include/PointLights.glsl"
+#endif
 
 void main()
 {
@@ -114,21 +107,18 @@ void main()
 	vec4 SpecularColor_Global = u_LightSource.Intensity * u_LightSource.Color * Shine * u_Reflectivity;
 
 	/**** Color due to the Point Lights ****/
-	// Diffuse Light Color
-	vec3 UnitLightVec = normalize(u_LightPos - v_Data.WorldPosition);
-	brightness = max(0.0f, dot(UnitNormal, UnitLightVec));
-	vec4 diffuseColor = u_LightColor * brightness;
-
-	// Specular Light Color
-	ViewDir = normalize(u_CameraPos - v_Data.WorldPosition);
-	vec3 ReflectedLightDir = reflect(-UnitLightVec, UnitNormal);
-	float shine = pow(max(dot(ReflectedLightDir, ViewDir), 0.0), u_Shininess);
-	vec4 specularColor = shine * u_Reflectivity * u_LightColor;
+#ifdef GX_POINT_LIGHTS
+	vec4 PointLightColor = PointLightsColor(v_Data.WorldPosition, UnitNormal, ViewDir);
+#else
+	vec4 PointLightColor = vec4(0.0f);
+#endif
 
 	// Calculate the shadow
+#ifdef GX_SHADOWS
+	float Shadow = ShadowCalculation(v_Data.WorldPosition, UnitNormal, LightDir);
+#else
 	float Shadow = 0.0f;
-	if(u_CalculateShadow)
-		Shadow = ShadowCalculation(v_Data.LightSpacePos);
+#endif
 
 	vec2 BlendTexCoord = vec2(v_Data.TexCoord.x / (u_TerrainDimensions.x - 1), v_Data.TexCoord.y / (u_TerrainDimensions.y - 1));
 	vec4 texColorBlend = texture(u_BlendMap, BlendTexCoord);
@@ -138,5 +128,5 @@ void main()
 	vec4 texColor2 = texture(u_Texture2, v_Data.TexCoord) * texColorBlend.g;
 	vec4 texColor3 = texture(u_Texture3, v_Data.TexCoord) * texColorBlend.b;
 
-	fColor = (AmbientColor + (1.0f - Shadow) * (DiffuseColor_Global + SpecularColor_Global + diffuseColor + specularColor)) * (texColor0 + texColor1 + texColor2 + texColor3);
+	fColor = (AmbientColor + (1.0f - Shadow) * (DiffuseColor_Global + SpecularColor_Global) + PointLightColor) * (texColor0 + texColor1 + texColor2 + texColor3);
 }
\ No newline at end of file
@@ -10,15 +10,23 @@
 #include "Engine/Core/Buffers/VertexBuffer.h"
 #include "Engine/Core/Buffers/VertexBufferLayout.h"
 #include "Engine/Core/Buffers/IndexBuffer.h"
-#include "Engine/Core/Buffers/FrameBuffer.h"
 
 #include "Engine/Core/Textures/Texture2D.h"
 #include "Engine/Core/Textures/SpriteSheet.h"
+#include "Engine/Core/Textures/TextureStreamer.h"
+#include "Engine/Core/AssetManager/AssetManager.h"
 
 /* Renderer */
 #include "Engine/Core/Renderer/Renderer.h"
 #include "Engine/Core/Renderer/Renderer2D.h"
 #include "Engine/Core/Renderer/Renderer3D.h"
+#include "Engine/Core/Renderer/CascadedShadowMap.h"
+#include "Engine/Core/Renderer/ClusteredLighting.h"
+#include "Engine/Core/Device/RenderDevice.h"
+#include "Engine/Core/Batches/BatchBenchmark.h"
+
+#include "Engine/Profiler/GPUProfiler.h"
+#include "Engine/Profiler/Benchmark.h"
 
 /* Controllers */
 #include "Engine/Controllers/CameraController.h"
@@ -35,6 +43,7 @@
 
 #include "Window.h"
 #include "Timer/Clock.h"
+#include "Timer/FixedTimestep.h"
 #include "Gui/GraphXGui.h"
 
 /* Events */
@@ -51,7 +60,7 @@
 #include "Engine/Model/ModelTypes.h"
 #include "Engine/Model/Mesh/Mesh2D.h"
 #include "Engine/Model/Mesh/Mesh3D.h"
-#include "Engine/model/Cube.h"
+#include "Engine/Model/Cube.h"
 
 /* Utils */
 #include "Engine/Utilities/EngineUtil.h"
@@ -67,7 +76,7 @@ namespace GraphX
 	Application* Application::s_Instance = nullptr;
 
 	Application::Application(const char* title, int width, int height)
-		: m_Window(nullptr), m_Title(title), m_IsRunning(true), m_EngineDayTime(0.1f), m_SelectedObject2D(nullptr), m_SelectedObject3D(nullptr), m_SunLight(nullptr), m_ShadowBuffer(nullptr), m_DepthShader(nullptr), m_CameraController(nullptr), m_DaySkybox(nullptr), m_NightSkybox(nullptr), m_CurrentSkybox(nullptr), m_Shader(nullptr), m_DefaultMaterial(nullptr), m_Light(nullptr), m_DefaultTexture(nullptr)
+		: m_Window(nullptr), m_Title(title), m_IsRunning(true), m_EngineDayTime(0.1f), m_SelectedObject2D(nullptr), m_SelectedObject3D(nullptr), m_SunLight(nullptr), m_ShadowMap(nullptr), m_ClusteredLighting(nullptr), m_DepthShader(nullptr), m_CameraController(nullptr), m_SimulationTimestep(nullptr), m_DaySkybox(nullptr), m_NightSkybox(nullptr), m_CurrentSkybox(nullptr), m_Shader(nullptr), m_DefaultMaterial(nullptr), m_Light(nullptr), m_DefaultTexture(nullptr)
 	{
 		GX_PROFILE_FUNCTION()
 
@@ -85,13 +94,26 @@ namespace GraphX
 		Mouse::Init();
 		Keyboard::Init();
 
-		m_Window = new Window(WindowProps(m_Title, width, height));
+		// Assets loaded from the files are shared from here on
+		AssetManager::Init();
+
+		// Benchmark scene is generated from the same random values every run and can be rendered offscreen
+		const bool IsBenchmark = Benchmark::IsEnabled();
+		if (IsBenchmark)
+			EngineUtil::ResetSeed();
+
+		// Benchmark can run on the null device to measure the CPU cost of the renderer without a GPU (or a window)
+		RenderDevice::Init(IsBenchmark && Benchmark::GetSettings().UseNullDevice ? RenderDeviceType::Null : RenderDeviceType::OpenGL);
+
+		m_Window = new Window(WindowProps(m_Title, width, height, !(IsBenchmark && Benchmark::GetSettings().IsHeadless)));
 		
 		// Set the event callback with the window
 		m_Window->SetEventCallback(BIND_EVENT_FUNC(Application::OnEvent));
 
 		// Intialise the ImGui
-		GraphXGui::Init(BIND_EVENT_FUNC(Application::OnEvent));
+		m_IsGuiEnabled = RenderDevice::GetType() != RenderDeviceType::Null;
+		if (m_IsGuiEnabled)
+			GraphXGui::Init(BIND_EVENT_FUNC(Application::OnEvent));
 
 		// Initialise the renderer
 		Renderer::Init();
@@ -105,6 +127,8 @@ namespace GraphX
 
 		m_CameraController = CreateRef<CameraController>(GM::Vector3(-3.0f, 0.0f, 0.0f), GM::Vector3::ZeroVector, EngineConstants::UpAxis, (float)m_Window->GetWidth() / (float)m_Window->GetHeight(), EngineConstants::NearPlane, EngineConstants::FarPlane);
 
+		m_SimulationTimestep = CreateScope<FixedTimestep>(EngineConstants::SimulationTickRate, EngineConstants::MaxSimulationTicksPerFrame);
+
 		std::vector<std::string> SkyboxNames = { "right.png", "left.png" , "top.png" , "bottom.png" , "front.png" , "back.png" };
 		m_DaySkybox  = CreateRef<Skybox>("res/Textures/Skybox/Day/", SkyboxNames, Vector4(0.0f, 0.0f, 0.0f, 1.0f));
 		m_NightSkybox = CreateRef<Skybox>("res/Textures/Skybox/Night/", SkyboxNames, Vector4(0.5f, 0.5f, 0.5f, 1.0f), 0.0f, 0.f);
@@ -115,7 +139,7 @@ namespace GraphX
 		m_Lights.emplace_back(m_SunLight);
 
 		// Basic Lighting Shader 
-		m_Shader = CreateRef<Shader>("res/Shaders/BasicLightingShader.glsl");
+		m_Shader = AssetManager::LoadShader("res/Shaders/BasicLightingShader.glsl");
 		m_Shader->Bind();
 		m_Shaders.push_back(m_Shader);
 
@@ -123,13 +147,16 @@ namespace GraphX
 
 		m_Light = CreateRef<PointLight>(Vector3(0.0f, 50.0f, 50.0f), Vector4(1, 1, 1, 1));
 		m_Lights.emplace_back(m_Light);
+		m_PointLights.emplace_back(m_Light);
+
+		m_ClusteredLighting = CreateRef<ClusteredLighting>();
 
-		m_ShadowBuffer = CreateRef<FrameBuffer>(m_Window->GetWidth(), m_Window->GetHeight(), FramebufferType::GX_FRAME_DEPTH);
-		m_DepthShader = CreateRef<Shader>("res/Shaders/DepthShader.glsl");
+		m_ShadowMap = CreateRef<CascadedShadowMap>(EngineConstants::ShadowMapResolution, EngineConstants::ShadowCascadeCount);
+		m_DepthShader = AssetManager::LoadShader("res/Shaders/DepthShader.glsl");
 
 		ParticleManager::Init(m_CameraController->GetCamera());
 
-		m_DefaultTexture  = CreateRef<Texture2D>("res/Textures/stone.jpg");
+		m_DefaultTexture  = AssetManager::LoadTexture2D("res/Textures/stone.jpg", false, TextureLoadMode::Immediate);
 
 		// Initialise the mouse picker
 		MousePicker::Init(m_CameraController->GetCamera(), m_Window->GetWidth(), m_Window->GetHeight());
@@ -143,9 +170,6 @@ namespace GraphX
 		m_Shader->SetUniform1f("u_AmbientStrength", 0.1f);
 		m_Shader->SetUniform1f("u_Shininess", 256.0f);
 		m_Shader->SetUniform1f("u_Reflectivity", 1.0f);
-
-		m_Shader->SetUniform3f("u_LightPos", m_Light->Position);
-		m_Shader->SetUniform4f("u_LightColor", m_Light->Color);
 		
 		{
 			GX_PROFILE_SCOPE("Load Scene")
@@ -165,7 +189,7 @@ namespace GraphX
 
 			// Load Trees
 			Ref<Material> TreeMaterial = CreateRef<Material>(m_Shader);
-			TreeMaterial->AddTexture(CreateRef<const Texture2D>("res/Textures/tree.png"));
+			TreeMaterial->AddTexture(AssetManager::LoadTexture2D("res/Textures/tree.png", false, TextureLoadMode::Streamed));
 
 			std::future<Ref<Mesh3D>> ft = Async<Ref<Mesh3D>>(AsyncExecutionPolicy::ThreadPool, std::bind(&Mesh3D::Load, "res/Models/tree.obj", TreeMaterial));
 			Ref<Mesh3D> TreeMesh = ft.get();
@@ -177,12 +201,13 @@ namespace GraphX
 				Vector3 Position((2 * EngineUtil::Rand<float>() - 1) * ter->GetWidth() / 2, (2 * EngineUtil::Rand<float>() - 1) * ter->GetDepth() / 2, 0.0f);
 				TreeMesh->Position = Position;
 				TreeMesh->Rotation.Roll = -90.0f;
+				TreeMesh->bIsStatic = true;
 				m_Objects3D.emplace_back(CreateRef<Mesh3D>(TreeMesh.operator*()));
 			}
 
 			// Load Low poly Trees
 			Ref<Material> LowPolyTreeMaterial = CreateRef<Material>(m_Shader);
-			LowPolyTreeMaterial->AddTexture(CreateRef<const Texture2D>("res/Textures/lowPolyTree.png"));
+			LowPolyTreeMaterial->AddTexture(AssetManager::LoadTexture2D("res/Textures/lowPolyTree.png", false, TextureLoadMode::Streamed));
 
 			Ref<Mesh3D> LowPolyTreeMesh = Mesh3D::Load("res/Models/lowPolyTree.obj", LowPolyTreeMaterial);
 			LowPolyTreeMesh->Scale = Vector3::UnitVector;
@@ -192,22 +217,33 @@ namespace GraphX
 				Vector3 Position((2 * EngineUtil::Rand<float>() - 1) * ter->GetWidth() / 2, (2 * EngineUtil::Rand<float>() - 1) * ter->GetDepth() / 2, 0.0f);
 				LowPolyTreeMesh->Position = Position;
 				LowPolyTreeMesh->Rotation.Roll = 90.0f;
+				LowPolyTreeMesh->bIsStatic = true;
 				m_Objects3D.emplace_back(CreateRef<Mesh3D>(LowPolyTreeMesh.operator*()));
 			}
 
+			// Scatter lamps over the terrain
+			unsigned int NumLamps = 100;
+			for (unsigned int i = 0; i < NumLamps; i++)
+			{
+				Vector3 Position((2 * EngineUtil::Rand<float>() - 1) * ter->GetWidth() / 2, (2 * EngineUtil::Rand<float>() - 1) * ter->GetDepth() / 2, 15.0f);
+				Vector4 Color(0.5f + 0.5f * EngineUtil::Rand<float>(), 0.5f + 0.5f * EngineUtil::Rand<float>(), 0.5f * EngineUtil::Rand<float>(), 1.0f);
+				m_PointLights.emplace_back(CreateRef<PointLight>(Position, Color, 2.0f, Vector3(1.0f, 0.2f, 0.05f)));
+			}
+
 			// Load Stall
 			Ref<Material> StallMaterial = CreateRef<Material>(m_Shader);
-			StallMaterial->AddTexture(CreateRef<const Texture2D>("res/Textures/stallTexture.png"));
+			StallMaterial->AddTexture(AssetManager::LoadTexture2D("res/Textures/stallTexture.png", false, TextureLoadMode::Streamed));
 
 			Ref<Mesh3D> StallMesh = Mesh3D::Load("res/Models/stall.obj", StallMaterial);
 			StallMesh->Position = Vector3(100.0f, -75.0f, 0.0f);
 			StallMesh->Rotation.Roll = 90.0f;
+			StallMesh->bIsStatic = true;
 			m_Objects3D.emplace_back(StallMesh);
 
 			m_Shader->UnBind();
 		}
 		
-		Ref<SpriteSheet> particleSpriteSheet = CreateRef<SpriteSheet>("res/Textures/Particles/particleAtlas.png", 16, GM::Vector2(32.0f, 32.0f));
+		Ref<SpriteSheet> particleSpriteSheet = AssetManager::LoadSpriteSheet("res/Textures/Particles/particleAtlas.png", 16, GM::Vector2(32.0f, 32.0f));
 		ParticleProps particleProperties;
 		particleProperties.Texture = particleSpriteSheet;
 		particleProperties.Velocity = GM::Vector3(2.0f);
@@ -266,6 +302,13 @@ namespace GraphX
 			// Tick the clock every frame to get the delta time
 			Clock::GetClock()->Tick();
 
+			// Benchmark simulates every frame with the same time step, so that the runs are comparable
+			if (Benchmark::IsEnabled())
+			{
+				Benchmark::BeginFrame();
+				DeltaTime = Benchmark::GetSettings().FixedDeltaTime;
+			}
+
 			// Calculate the fps
 			times++;
 			float now = Clock::GetClock()->GetEngineTime();
@@ -277,6 +320,9 @@ namespace GraphX
 
 				Renderer2D::Statistics Stats = Renderer2D::GetStats();
 				GX_ENGINE_INFO("Renderer2D Stats: {0} Draw Calls, {1} Quad Count", Stats.DrawCalls, Stats.QuadCount);
+
+				Renderer3D::Statistics Stats3D = Renderer3D::GetStats();
+				GX_ENGINE_INFO("Renderer3D Stats: {0} Draw Calls, {1} Shadow Draw Calls, {2} Shadow Casters Culled, {3} Depth Pre Pass Draw Calls", Stats3D.DrawCalls, Stats3D.ShadowDrawCalls, Stats3D.ShadowCastersCulled, Stats3D.DepthPrePassDrawCalls);
 			}
 
 			// No need to update or render stuff if the application (window) is minimised
@@ -284,20 +330,22 @@ namespace GraphX
 			{
 				// Reset Stats at the beginning of the frame 
 				Renderer2D::ResetStats();
+				Renderer3D::ResetStats();
 
 				{
 					GX_PROFILE_SCOPE("Frame-Update")
 
-					if (GX_ENABLE_PARTICLE_EFFECTS)
+					UpdateCamera(DeltaTime);
+
+					// Update all the elements of the scene
 					{
-						ParticleManager::SpawnParticles(DeltaTime);
+						GX_BENCHMARK_SCOPE("Update")
+						Simulate(DeltaTime);
 					}
-					
-					// Update all the elements of the scene
-					Update(DeltaTime);
 
 					// Update the Gui
-					GraphXGui::Update();
+					if (m_IsGuiEnabled)
+						GraphXGui::Update();
 					
 					// Clear the window 
 					m_Window->Clear();
@@ -306,11 +354,27 @@ namespace GraphX
 				{
 					GX_PROFILE_SCOPE("Frame-Render")
 
+					// Time the passes on the GPU (results are read back a few frames later)
+					GPUProfiler::BeginFrame();
+
+					// Upload the streamed texture levels decoded since the last frame
+					{
+						GX_BENCHMARK_SCOPE("Texture Streaming")
+						TextureStreamer::Update();
+					}
+
 					// Start a scene
 					Renderer::BeginScene(m_CameraController->GetCamera());
 
+					// Meshes are shaded by the variants having only the features enabled for the scene
+					uint32_t SceneFeatures = ShaderFeature::Textured;
+					if (GX_ENABLE_SHADOWS)
+						SceneFeatures |= ShaderFeature::Shadows;
+					if (!m_PointLights.empty())
+						SceneFeatures |= ShaderFeature::PointLights;
+
 					Renderer2D::BeginScene();
-					Renderer3D::BeginScene();
+					Renderer3D::BeginScene(SceneFeatures, [this](Shader& shader) { ConfigureMeshShader(shader); });
 
 					for (unsigned int i = 0; i < m_Objects3D.size(); i++)
 						Renderer::Submit(m_Objects3D[i]);
@@ -318,35 +382,69 @@ namespace GraphX
 					// Calculate the shadow maps
 					if (GX_ENABLE_SHADOWS)
 					{
+						GX_BENCHMARK_SCOPE("Shadow Maps")
+						GX_GPU_PROFILE_SCOPE("Shadow Maps")
 						RenderShadowMap();
 					}
 
 					// Draw the debug quad to show the depth map
 					//Renderer2D::DrawQuad({ -10.0f, 10.0f, 0.0f }, 5 * GM::Vector2::UnitVector, m_DefaultTexture);
 
-					Renderer::RenderSkybox(m_CurrentSkybox);
+					{
+						GX_BENCHMARK_SCOPE("Skybox")
+						GX_GPU_PROFILE_SCOPE("Skybox")
+						Renderer::RenderSkybox(m_CurrentSkybox);
+					}
+
+					if (GX_ENABLE_DEPTH_PREPASS)
+					{
+						GX_BENCHMARK_SCOPE("Depth Pre Pass")
+						GX_GPU_PROFILE_SCOPE("Depth Pre Pass")
+						RenderDepthPrePass();
+					}
 					
-					// Bind the shader and draw the objects
-					m_Shader->Bind();
-					m_ShadowBuffer->BindDepthMap(EngineConstants::ShadowMapTextureSlot);
-					ConfigureShaderForRendering(*m_Shader);
+					// Assign the point lights to the clusters of the camera view
+					{
+						GX_BENCHMARK_SCOPE("Light Clustering")
+						m_ClusteredLighting->Update(*m_CameraController, m_PointLights, GM::Vector2((float)m_Window->GetWidth(), (float)m_Window->GetHeight()));
+					}
+
+					// Draw the objects (The mesh shaders are configured by the renderer when they are first bound)
+					m_ShadowMap->BindDepthMap(EngineConstants::ShadowMapTextureSlot);
 
-					Render2DScene();
-					RenderScene();
+					{
+						GX_BENCHMARK_SCOPE("Scene")
+						GX_GPU_PROFILE_SCOPE("Scene")
+						Render2DScene();
+						RenderScene();
+					}
 
 					if (GX_ENABLE_PARTICLE_EFFECTS)
 					{
-						ParticleManager::RenderParticles();
+						GX_BENCHMARK_SCOPE("Particles")
+						GX_GPU_PROFILE_SCOPE("Particles")
+						ParticleManager::RenderParticles(m_SimulationTimestep->GetAlpha());
 					}
 
-					Renderer2D::EndScene();
+					{
+						GX_BENCHMARK_SCOPE("2D Batches")
+						GX_GPU_PROFILE_SCOPE("2D Batches")
+						Renderer2D::EndScene();
+					}
 					Renderer3D::EndScene();
 
 					// End the scene
 					Renderer::EndScene();
 
 					// Renders ImGUI
-					RenderGui();
+					if (m_IsGuiEnabled)
+					{
+						GX_BENCHMARK_SCOPE("Gui")
+						GX_GPU_PROFILE_SCOPE("Gui")
+						RenderGui();
+					}
+
+					GPUProfiler::EndFrame();
 				}
 			}
 
@@ -355,16 +453,58 @@ namespace GraphX
 
 			//Poll events and swap buffers
 			m_Window->OnUpdate();
+
+			if (Benchmark::IsEnabled())
+			{
+				Benchmark::EndFrame();
+
+				if (Benchmark::IsFinished())
+				{
+					// Texture slot lookups of the batches are measured over (atleast) as many textures as the scene has created
+					BatchBenchmark::TextureSlotResult SlotResult = BatchBenchmark::RunTextureSlotBenchmark(100000, std::max(Texture2D::GetHandleCount(), 40u));
+					Benchmark::RecordMicroBenchmark("texture_slots", {
+						{ "quads", SlotResult.QuadCount },
+						{ "textures", SlotResult.TextureCount },
+						{ "linear_ms", SlotResult.LinearTime },
+						{ "mapped_ms", SlotResult.MappedTime },
+						{ "flushes", SlotResult.Flushes }
+					});
+
+					Benchmark::WriteResults();
+					m_IsRunning = false;
+				}
+			}
+		}
+	}
+
+	void Application::Simulate(float FrameTime)
+	{
+		GX_PROFILE_FUNCTION()
+
+		const uint32_t Ticks = m_SimulationTimestep->Advance(FrameTime);
+		const float TickDelta = m_SimulationTimestep->GetTickDelta();
+
+		for (uint32_t Tick = 0; Tick < Ticks; Tick++)
+		{
+			for (size_t i = 0; i < m_Objects3D.size(); i++)
+				m_Objects3D[i]->BeginTick();
+
+			if (GX_ENABLE_PARTICLE_EFFECTS)
+				ParticleManager::SpawnParticles(TickDelta);
+
+			Update(TickDelta);
 		}
+
+		// Render the moving meshes in between the last two ticks
+		const float Alpha = m_SimulationTimestep->GetAlpha();
+		for (size_t i = 0; i < m_Objects3D.size(); i++)
+			m_Objects3D[i]->InterpolateTransform(Alpha);
 	}
 
 	void Application::Update(float DeltaTime)
 	{
 		GX_PROFILE_FUNCTION()
 
-		// Update the camera
-		m_CameraController->Update(DeltaTime);
-		
 		// Update the lights
 		{
 			GX_PROFILE_SCOPE("Update::Lights")
@@ -402,6 +542,17 @@ namespace GraphX
 		DayNightCycleCalculations(DeltaTime);
 
 		m_CurrentSkybox->Update(DeltaTime);
+	}
+
+	void Application::UpdateCamera(float DeltaTime)
+	{
+		GX_PROFILE_FUNCTION()
+
+		// Benchmark flies the camera along a fixed path
+		if (Benchmark::IsEnabled())
+			Benchmark::UpdateCamera(*m_CameraController);
+
+		m_CameraController->Update(DeltaTime);
 
 		if (m_CameraController->GetCamera()->IsRenderStateDirty())
 		{
@@ -437,16 +588,47 @@ namespace GraphX
 	{
 		GX_PROFILE_FUNCTION()
 
-		// Render the shadow maps
+		// Fit the cascades to the current camera view
+		m_ShadowMap->Update(*m_CameraController, m_SunLight->Direction);
+
+		// Static casters need to be rendered again if any of them has changed
+		m_ShadowMap->SetStaticCastersSignature(Renderer3D::GetStaticCastersSignature());
+
+		// Render the shadow map for each cascade
 		m_DepthShader->Bind();
-		m_DepthShader->SetUniformMat4f("u_LightSpaceMatrix", m_SunLight->GetShadowInfo()->LightViewProjMat);
-		m_ShadowBuffer->Bind();
-	
-		m_Window->ClearDepthBuffer();
+		for (uint32_t i = 0; i < m_ShadowMap->GetCascadeCount(); i++)
+		{
+			const ShadowCascade& Cascade = m_ShadowMap->GetCascade(i);
+			m_DepthShader->SetUniformMat4f("u_LightSpaceMatrix", Cascade.LightViewProjMat);
 
-		RenderScene(true);
+			// Without the texture copies, the static casters are rendered again every frame
+			if (GX_ENABLE_STATIC_SHADOW_CACHE && m_ShadowMap->IsStaticCacheSupported())
+			{
+				// Static casters (and the terrain) are rendered only when the cache is out of date
+				if (!m_ShadowMap->IsStaticCacheValid(i))
+				{
+					m_ShadowMap->BindStaticCascade(i);
+					m_Window->ClearDepthBuffer();
+
+					Renderer::RenderDepth(*m_DepthShader, DepthPassType::Shadow, &Cascade, ShadowCasterType::Static);
+					RenderTerrain(true);
+				}
+
+				// Dynamic casters are rendered on top of the copy of the cache
+				m_ShadowMap->BindCascade(i, true);
+				Renderer::RenderDepth(*m_DepthShader, DepthPassType::Shadow, &Cascade, ShadowCasterType::Dynamic);
+			}
+			else
+			{
+				m_ShadowMap->BindCascade(i);
+				m_Window->ClearDepthBuffer();
+
+				Renderer::RenderDepth(*m_DepthShader, DepthPassType::Shadow, &Cascade);
+				RenderTerrain(true);
+			}
+		}
 
-		m_ShadowBuffer->UnBind();
+		m_ShadowMap->UnBind();
 	}
 
 	void Application::RenderScene(bool IsShadowPhase)
@@ -455,14 +637,36 @@ namespace GraphX
 
 		if (IsShadowPhase)
 		{
-			Renderer::RenderDepth(*m_DepthShader);
+			Renderer::RenderDepth(*m_DepthShader, DepthPassType::Shadow);
+			RenderTerrain(IsShadowPhase);
+		}
+		else if (GX_ENABLE_DEPTH_PREPASS)
+		{
+			// Only the 3D meshes and the terrain are in the pre pass
+			Renderer::BeginPrePassedColorPass();
+			Renderer3D::Render();
+			RenderTerrain(IsShadowPhase);
+			Renderer::EndPrePassedColorPass();
+
+			Renderer2D::Render();
 		}
 		else
 		{
 			Renderer::Render();
+			RenderTerrain(IsShadowPhase);
 		}
-		
-		RenderTerrain(IsShadowPhase);
+	}
+
+	void Application::RenderDepthPrePass()
+	{
+		GX_PROFILE_FUNCTION()
+
+		Renderer::BeginDepthPrePass(*m_DepthShader);
+
+		Renderer3D::Render(*m_DepthShader, DepthPassType::PrePass);
+		RenderTerrain(true);
+
+		Renderer::EndDepthPrePass();
 	}
 
 	void Application::Render2DScene()
@@ -470,12 +674,6 @@ namespace GraphX
 		Renderer2D::DrawQuad({ -4.0f, 5.0f, -10.f }, { 5.0f, 5.0f }, GM::Vector4(1.0f, 0.0f, 0.0f, 1.0f));
 		Renderer2D::DrawRotatedQuad({ -10.0f, 5.0f, -10.f }, { 5.0f, 5.0f }, {0.0f, 0.0f, 45.0f}, GM::Vector4(1.0f, 0.0f, 0.0f, 1.0f));
 		Renderer2D::DrawQuad({ 4.0f, 5.0f, -10.f }, { 5.0f, 5.0f }, m_DefaultTexture);
-
-		if (GX_ENABLE_SHADOWS)
-		{
-			// Draw the debug quad to show the depth map
-			Renderer2D::DrawDebugQuad({-10.0f, 10.0f, 0.0f}, 5 * GM::Vector2::UnitVector, m_ShadowBuffer->GetDepthMap(), EngineConstants::ShadowMapTextureSlot);
-		}
 	}
 
 	void Application::RenderTerrain(bool IsShadowPhase)
@@ -490,11 +688,21 @@ namespace GraphX
 			Ref<Terrain> terrain = m_Terrain[i];
 
 			// Configure the terrain shaders
-			terrain->Enable();
-			if (!IsShadowPhase)
+			if (IsShadowPhase)
 			{
-				shader = terrain->GetMaterial()->GetShader();
-				ConfigureShaderForRendering(*shader);
+				terrain->Enable();
+			}
+			else
+			{
+				// Terrain is shaded by the variant having the scene features, the base shader is used until the variant is compiled
+				const Ref<Material>& TerrainMaterial = terrain->GetMaterial();
+				shader = Renderer::GetShaderLibrary().GetVariant(TerrainMaterial->GetShader(), Renderer3D::GetSceneFeatures() & TerrainMaterial->GetShaderFeatures());
+				if (!shader->IsReady())
+					shader = TerrainMaterial->GetShader();
+
+				shader->Bind();
+				ConfigureMeshShader(*shader);
+				terrain->Enable(*shader);
 			}
 
 			shader->Bind();
@@ -504,7 +712,7 @@ namespace GraphX
 			shader->SetUniformMat4f("u_Model", Model);
 
 			// Render the Terrain
-			Renderer::RenderIndexed(*terrain->GetMesh()->GetIBO());
+			Renderer3D::DrawSections(*terrain->GetMesh());
 
 			terrain->Disable();
 		}
@@ -525,20 +733,37 @@ namespace GraphX
 		{
 			GraphXGui::TerrainDetails(m_Terrain[0]);
 		}
-		GraphXGui::GlobalSettings(m_CurrentSkybox, m_EngineDayTime, m_SunLight->Intensity, GX_ENABLE_PARTICLE_EFFECTS);
+		GraphXGui::GlobalSettings(m_CurrentSkybox, m_EngineDayTime, m_SunLight->Intensity, GX_ENABLE_PARTICLE_EFFECTS, GX_ENABLE_DEPTH_PREPASS);
+		GraphXGui::GPUTimings();
+		GraphXGui::SimulationSettings(*m_SimulationTimestep);
 		GraphXGui::Render();
 	}
 
+	void Application::ConfigureMeshShader(Shader& shader)
+	{
+		GX_PROFILE_FUNCTION()
+
+		// Variants compiled during the run have none of the uniforms set at the start
+		shader.SetUniform1f("u_AmbientStrength", 0.1f);
+		shader.SetUniform3f("u_CameraPos", m_CameraController->GetCameraPosition());
+		shader.SetUniformMat4f("u_ProjectionView", m_CameraController->GetCamera()->GetProjectionViewMatrix());
+
+		ConfigureShaderForRendering(shader);
+	}
+
 	void Application::ConfigureShaderForRendering(Shader& shader)
 	{
 		GX_PROFILE_FUNCTION()
 
-		shader.SetUniform1i("u_ShadowMap", EngineConstants::ShadowMapTextureSlot);
-		shader.SetUniform3f("u_LightPos", m_Light->Position);
-		shader.SetUniform4f("u_LightColor", m_Light->Color);
+		// Point lights are looked up from the cluster of each fragment
+		m_ClusteredLighting->Enable(shader);
 
+		// Cascade is selected by the distance of the fragment along the camera view direction
+		shader.SetUniform3f("u_CameraForward", m_CameraController->GetForwardAxis());
 		if(GX_ENABLE_SHADOWS)
-			shader.SetUniformMat4f("u_LightSpaceMatrix", m_SunLight->GetShadowInfo()->LightViewProjMat);
+			m_ShadowMap->SetShaderUniforms(shader, EngineConstants::ShadowMapTextureSlot);
+		else
+			shader.SetUniform1i("u_ShadowMap", EngineConstants::ShadowMapTextureSlot);
 
 		m_SunLight->Enable(shader, "u_LightSource");
 	}
@@ -637,7 +862,7 @@ namespace GraphX
 		// Raise an error if the event is not handled
 		if (!handled)
 		{
-			GX_ENGINE_ERROR("Unhandled Event: \"{0}\" ", e);
+			GX_ENGINE_ERROR("Unhandled Event: \"{0}\" ", e.ToString());
 		}
 	}
 
@@ -817,7 +1042,7 @@ namespace GraphX
 		dialog.Show();
 
 		std::string TexName = EngineUtil::ToByteString(dialog.GetAbsolutePath());
-		Ref<Texture2D> texture = CreateRef<Texture2D>(TexName);
+		Ref<Texture2D> texture = AssetManager::LoadTexture2D(TexName, false, TextureLoadMode::Immediate);
 
 		if (m_SelectedObject3D)
 		{
@@ -884,6 +1109,9 @@ namespace GraphX
 	bool Application::OnCreateTerrain(CreateTerrainEvent& e)
 	{
 		m_Terrain.push_back(e.GetTerrain());
+
+		// Terrain is a static caster
+		m_ShadowMap->InvalidateStaticCache();
 		return true;
 	}
 
@@ -914,11 +1142,16 @@ namespace GraphX
 		Renderer::Shutdown();
 
 		/* Cleanup the ImGui */
-		GraphXGui::Cleanup();
+		if (m_IsGuiEnabled)
+			GraphXGui::Cleanup();
 
 		delete m_Window;
 
+		RenderDevice::Shutdown();
+
 		/* Release resources of subsystems */
+		AssetManager::Shutdown();
+		Benchmark::Shutdown();
 		Multithreading::Shutdown();
 	}
 }
\ No newline at end of file
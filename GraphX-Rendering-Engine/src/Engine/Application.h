@@ -9,7 +9,8 @@ namespace GraphX
 	class Shader;
 	class Texture2D;
 	class Skybox;
-	class FrameBuffer;
+	class CascadedShadowMap;
+	class ClusteredLighting;
 	class Terrain;
 	class CameraController;
 
@@ -19,6 +20,8 @@ namespace GraphX
 
 	class ParticleManager;
 
+	class FixedTimestep;
+
 	class Application
 	{
 	public:
@@ -87,15 +90,27 @@ namespace GraphX
 		/* Initializes all the components of the application */
 		void InitializeApplication();
 
-		/* Updates the scene */
+		/* Runs the simulation ticks due for the frame and blends the rendered transforms between the last two ticks */
+		void Simulate(float FrameTime);
+
+		/* Updates the scene by a simulation tick */
 		void Update(float DeltaTime);
 
+		/* Moves the camera (Updated every frame, since it follows the input) */
+		void UpdateCamera(float DeltaTime);
+
 		/* Configure the shader for rendering by setting the proper uniforms */
 		void ConfigureShaderForRendering(class Shader& shader);
 
+		/* Sets the camera and the scene uniforms on a variant of the mesh shader (Called by the renderer when the variant is first bound in a frame) */
+		void ConfigureMeshShader(class Shader& shader);
+
 		/* Calculates the shadows */
 		void RenderShadowMap();
 
+		/* Renders the depth of the 3D scene from the camera, before it is shaded */
+		void RenderDepthPrePass();
+
 		/* Renders the scene */
 		void RenderScene(bool IsShadowPhase = false);
 
@@ -130,6 +145,9 @@ namespace GraphX
 		/* Whether the application is minimised or not */
 		bool m_IsMinimised = false;
 
+		/* Whether the gui is shown (there is no gui without a window to show it in) */
+		bool m_IsGuiEnabled = true;
+
 		/* How long will a day last in the engine (in hours) */
 		float m_EngineDayTime;
 
@@ -145,6 +163,9 @@ namespace GraphX
 		/* All the lights in the scene */
 		std::vector<Ref<Light>> m_Lights;
 
+		/* Point lights in the scene (shaded using the clustered lighting) */
+		std::vector<Ref<PointLight>> m_PointLights;
+
 		/* All the terrain in the scene */
 		std::vector<Ref<Terrain>> m_Terrain;
 
@@ -157,8 +178,11 @@ namespace GraphX
 		/* Main light source for the scene */
 		Ref<DirectionalLight> m_SunLight;
 
-		/* Depth Frame buffer for shadow calculation */
-		Ref<FrameBuffer> m_ShadowBuffer;
+		/* Cascaded shadow map for the sun light */
+		Ref<CascadedShadowMap> m_ShadowMap;
+
+		/* Assigns the point lights to the clusters of the camera view */
+		Ref<ClusteredLighting> m_ClusteredLighting;
 
 		/* Shader used for rendering to depth buffer */
 		Ref<Shader> m_DepthShader;
@@ -166,6 +190,9 @@ namespace GraphX
 		/* Main Camera for the application */
 		Ref<CameraController> m_CameraController;
 
+		/* Splits the frame time in to the fixed simulation ticks */
+		Scope<FixedTimestep> m_SimulationTimestep;
+
 		/* SKybox for the day time */
 		Ref<Skybox> m_DaySkybox;
 
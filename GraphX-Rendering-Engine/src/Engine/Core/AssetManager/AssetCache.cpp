@@ -0,0 +1,104 @@
+#include "pch.h"
+#include "AssetCache.h"
+
+#include <cctype>
+#include <cstring>
+
+namespace GraphX
+{
+	static const uint64_t FNVOffsetBasis = 14695981039346656037ULL;
+	static const uint64_t FNVPrime = 1099511628211ULL;
+
+	std::string AssetKey::NormalizePath(const std::string& FilePath)
+	{
+		// Paths on windows are not case sensitive
+		std::string Path(FilePath);
+		for (char& Char : Path)
+			Char = Char == '\\' ? '/' : (char)std::tolower((unsigned char)Char);
+
+		const bool IsAbsolute = !Path.empty() && Path[0] == '/';
+
+		std::vector<std::string> Segments;
+		size_t Start = 0;
+		while (Start <= Path.size())
+		{
+			size_t End = Path.find('/', Start);
+			if (End == std::string::npos)
+				End = Path.size();
+
+			const std::string Segment = Path.substr(Start, End - Start);
+			if (Segment == "..")
+			{
+				// Leading '..' of a relative path can not be resolved
+				if (!Segments.empty() && Segments.back() != "..")
+					Segments.pop_back();
+				else if (!IsAbsolute)
+					Segments.emplace_back(Segment);
+			}
+			else if (!Segment.empty() && Segment != ".")
+			{
+				Segments.emplace_back(Segment);
+			}
+
+			Start = End + 1;
+		}
+
+		std::string Result = IsAbsolute ? "/" : "";
+		for (size_t i = 0; i < Segments.size(); i++)
+		{
+			if (i > 0)
+				Result += '/';
+
+			Result += Segments[i];
+		}
+
+		return Result;
+	}
+
+	uint64_t AssetKey::HashFile(const std::string& FilePath)
+	{
+		GX_PROFILE_FUNCTION()
+
+		std::ifstream Stream(FilePath, std::ios::in | std::ios::binary);
+		if (!Stream)
+			return 0;
+
+		// Hashed 8 bytes at a time, since the file is read on every miss of a new path
+		std::vector<char> Buffer(64 * 1024);
+		uint64_t Hash = FNVOffsetBasis;
+		uint64_t Length = 0;
+		while (Stream)
+		{
+			Stream.read(Buffer.data(), Buffer.size());
+			const size_t BytesRead = (size_t)Stream.gcount();
+			Length += BytesRead;
+
+			size_t i = 0;
+			for (; i + sizeof(uint64_t) <= BytesRead; i += sizeof(uint64_t))
+			{
+				uint64_t Word;
+				std::memcpy(&Word, Buffer.data() + i, sizeof(uint64_t));
+				Hash = (Hash ^ Word) * FNVPrime;
+			}
+
+			for (; i < BytesRead; i++)
+				Hash = (Hash ^ (uint8_t)Buffer[i]) * FNVPrime;
+		}
+
+		return Combine(Hash, Length);
+	}
+
+	uint64_t AssetKey::HashString(const std::string& String)
+	{
+		uint64_t Hash = FNVOffsetBasis;
+		for (const char Char : String)
+			Hash = (Hash ^ (uint8_t)Char) * FNVPrime;
+
+		return Hash;
+	}
+
+	uint64_t AssetKey::Combine(uint64_t Hash, uint64_t Value)
+	{
+		return Hash ^ (Value + 0x9e3779b97f4a7c15ULL + (Hash << 6) + (Hash >> 2));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <atomic>
+#include <future>
+#include <mutex>
+
+namespace GraphX
+{
+	/* Keys the cached assets are found by */
+	class AssetKey
+	{
+	public:
+		/* Returns the path with forward slashes, in lower case and without the '.' and '..' segments (So the different spellings of a path refer to the same asset) */
+		static std::string NormalizePath(const std::string& FilePath);
+
+		/* Returns the hash of the contents of the file (0 if the file can not be read) */
+		static uint64_t HashFile(const std::string& FilePath);
+
+		/* 64-bit FNV-1a of the string */
+		static uint64_t HashString(const std::string& String);
+
+		/* Mixes a value in to the hash */
+		static uint64_t Combine(uint64_t Hash, uint64_t Value);
+	};
+
+	/*
+	* Cache of the assets loaded from the files, holding weak references (An asset is released as soon as nothing else refers to it)
+	* Assets are found by the normalised path of the file, and optionally by the hash of its contents, so the copies of a file share the asset too
+	* Concurrent loads of the same asset are coalesced, the later requests wait for the first load instead of loading the asset again
+	*/
+	template<typename T>
+	class AssetCache
+	{
+	public:
+		using Loader = std::function<Ref<T>()>;
+
+		/**
+		* Returns the cached asset, loading it on the first request
+		* @param FilePath File the asset is loaded from
+		* @param Variant Options the asset is loaded with, which make it a separate asset (e.g. the wrapping of a texture)
+		* @param ShareByContents Whether the copies of the file share the asset. Reads the whole file on the first request of the path,
+		*		 and only suits the assets which do not refer to other files relative to their own (e.g. not the models)
+		* @param LoadAsset Loads the asset on a miss (Called without holding the lock, so it can load the other assets)
+		*/
+		Ref<T> Load(const std::string& FilePath, const std::string& Variant, bool ShareByContents, const Loader& LoadAsset);
+
+		/* Requests returned from the cache, the ones waiting on a load in progress and the ones which loaded the asset */
+		uint32_t GetHits() const { return m_Hits; }
+		uint32_t GetCoalesced() const { return m_Coalesced; }
+		uint32_t GetMisses() const { return m_Misses; }
+
+	private:
+		struct Entry
+		{
+			std::weak_ptr<T> Asset;
+
+			/* Valid while the asset is being loaded */
+			std::shared_future<Ref<T>> PendingLoad;
+		};
+
+		/* Removes the entries of the released assets (Called with the lock held) */
+		void RemoveExpired();
+
+	private:
+		std::mutex m_Mutex;
+
+		/* Content key by the normalised path and the variant */
+		std::unordered_map<std::string, uint64_t> m_ContentKeys;
+
+		/* Assets by the content key */
+		std::unordered_map<uint64_t, Entry> m_Entries;
+
+		std::atomic<uint32_t> m_Hits{ 0 };
+		std::atomic<uint32_t> m_Coalesced{ 0 };
+		std::atomic<uint32_t> m_Misses{ 0 };
+	};
+
+	template<typename T>
+	Ref<T> AssetCache<T>::Load(const std::string& FilePath, const std::string& Variant, bool ShareByContents, const Loader& LoadAsset)
+	{
+		GX_PROFILE_FUNCTION()
+
+		const std::string PathKey = AssetKey::NormalizePath(FilePath) + '|' + Variant;
+
+		std::unique_lock<std::mutex> Lock(m_Mutex);
+
+		uint64_t ContentKey = 0;
+		auto KeyItr = m_ContentKeys.find(PathKey);
+		if (KeyItr != m_ContentKeys.end())
+		{
+			ContentKey = KeyItr->second;
+		}
+		else if (ShareByContents)
+		{
+			// Reading the file is the slow part, so it is not done under the lock (A path hashed by two threads at once gets the same key)
+			Lock.unlock();
+
+			uint64_t FileHash = AssetKey::HashFile(FilePath);
+
+			// Files which can not be read are still cached by their path, so the failure is reported once
+			if (FileHash == 0)
+				FileHash = AssetKey::HashString(PathKey);
+
+			ContentKey = AssetKey::Combine(FileHash, AssetKey::HashString(Variant));
+
+			Lock.lock();
+			m_ContentKeys[PathKey] = ContentKey;
+		}
+		else
+		{
+			ContentKey = AssetKey::HashString(PathKey);
+			m_ContentKeys[PathKey] = ContentKey;
+		}
+
+		Entry& CacheEntry = m_Entries[ContentKey];
+		if (Ref<T> Asset = CacheEntry.Asset.lock())
+		{
+			m_Hits++;
+			return Asset;
+		}
+
+		if (CacheEntry.PendingLoad.valid())
+		{
+			std::shared_future<Ref<T>> PendingLoad = CacheEntry.PendingLoad;
+			Lock.unlock();
+
+			m_Coalesced++;
+			return PendingLoad.get();
+		}
+
+		std::promise<Ref<T>> Promise;
+		CacheEntry.PendingLoad = Promise.get_future().share();
+		m_Misses++;
+
+		RemoveExpired();
+		Lock.unlock();
+
+		Ref<T> Asset;
+		try
+		{
+			Asset = LoadAsset();
+		}
+		catch (...)
+		{
+			// Next request loads the asset again, the ones waiting get the same exception
+			Lock.lock();
+			m_Entries[ContentKey].PendingLoad = std::shared_future<Ref<T>>();
+			Lock.unlock();
+
+			Promise.set_exception(std::current_exception());
+			throw;
+		}
+
+		Lock.lock();
+		Entry& LoadedEntry = m_Entries[ContentKey];
+		LoadedEntry.Asset = Asset;
+		LoadedEntry.PendingLoad = std::shared_future<Ref<T>>();
+		Lock.unlock();
+
+		Promise.set_value(Asset);
+		return Asset;
+	}
+
+	template<typename T>
+	void AssetCache<T>::RemoveExpired()
+	{
+		for (auto Itr = m_Entries.begin(); Itr != m_Entries.end();)
+		{
+			if (Itr->second.Asset.expired() && !Itr->second.PendingLoad.valid())
+				Itr = m_Entries.erase(Itr);
+			else
+				++Itr;
+		}
+
+		for (auto Itr = m_ContentKeys.begin(); Itr != m_ContentKeys.end();)
+		{
+			if (m_Entries.find(Itr->second) == m_Entries.end())
+				Itr = m_ContentKeys.erase(Itr);
+			else
+				++Itr;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "pch.h"
+#include "AssetManager.h"
+
+#include "Textures/Texture2D.h"
+#include "Textures/SpriteSheet.h"
+#include "Shaders/Shader.h"
+#include "Model/Mesh/Mesh3D.h"
+
+namespace GraphX
+{
+	struct AssetManagerData
+	{
+		AssetCache<Texture2D> Textures;
+		AssetCache<SpriteSheet> SpriteSheets;
+		AssetCache<Shader> Shaders;
+		AssetCache<const Mesh3D> Meshes;
+	};
+
+	AssetManagerData* AssetManager::s_Data = nullptr;
+
+	void AssetManager::Init()
+	{
+		GX_PROFILE_FUNCTION()
+
+		GX_ENGINE_ASSERT(!s_Data, "Asset manager is already initialised");
+		s_Data = new AssetManagerData();
+	}
+
+	void AssetManager::Shutdown()
+	{
+		GX_PROFILE_FUNCTION()
+
+		if (!s_Data)
+			return;
+
+		// Assets still referenced outlive the cache, it only holds weak references
+		GX_ENGINE_INFO("Asset Manager: {0} textures loaded, {1} requests shared ({2} waited on a load)", s_Data->Textures.GetMisses(), s_Data->Textures.GetHits() + s_Data->Textures.GetCoalesced(), s_Data->Textures.GetCoalesced());
+		GX_ENGINE_INFO("Asset Manager: {0} meshes loaded, {1} requests shared ({2} waited on a load)", s_Data->Meshes.GetMisses(), s_Data->Meshes.GetHits() + s_Data->Meshes.GetCoalesced(), s_Data->Meshes.GetCoalesced());
+		GX_ENGINE_INFO("Asset Manager: {0} shaders loaded, {1} requests shared", s_Data->Shaders.GetMisses(), s_Data->Shaders.GetHits() + s_Data->Shaders.GetCoalesced());
+
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	Ref<Texture2D> AssetManager::LoadTexture2D(const std::string& FilePath, bool TileTexture, TextureLoadMode LoadMode)
+	{
+		GX_ENGINE_ASSERT(s_Data, "Asset manager is not initialised");
+
+		// Immediate loads expect a resident texture, so they do not share the streamed ones. Streamed loads skip the hashing, which would read the whole file here
+		const bool IsStreamed = LoadMode == TextureLoadMode::Streamed;
+		const std::string Variant = std::string(TileTexture ? "Tiled" : "") + (IsStreamed ? "|Streamed" : "");
+
+		return s_Data->Textures.Load(FilePath, Variant, !IsStreamed, [&]() {
+			return CreateRef<Texture2D>(FilePath, TileTexture, LoadMode);
+		});
+	}
+
+	Ref<SpriteSheet> AssetManager::LoadSpriteSheet(const std::string& FilePath, uint32_t NumSprites, const GM::Vector2& SpriteSize)
+	{
+		GX_ENGINE_ASSERT(s_Data, "Asset manager is not initialised");
+
+		std::stringstream Variant;
+		Variant << NumSprites << ' ' << SpriteSize.x << 'x' << SpriteSize.y;
+
+		return s_Data->SpriteSheets.Load(FilePath, Variant.str(), true, [&]() {
+			return CreateRef<SpriteSheet>(FilePath, NumSprites, SpriteSize);
+		});
+	}
+
+	Ref<Shader> AssetManager::LoadShader(const std::string& FilePath)
+	{
+		GX_ENGINE_ASSERT(s_Data, "Asset manager is not initialised");
+
+		return s_Data->Shaders.Load(FilePath, "", true, [&]() {
+			return CreateRef<Shader>(FilePath);
+		});
+	}
+
+	Ref<const Mesh3D> AssetManager::LoadMesh(const std::string& FilePath, const Ref<Material>& Mat)
+	{
+		GX_ENGINE_ASSERT(s_Data, "Asset manager is not initialised");
+
+		// Imported mesh holds a reference to the material, so its address is not reused while the entry is alive
+		// Textures of a model are found relative to its file, so the copies of a model in the other directories are separate assets
+		return s_Data->Meshes.Load(FilePath, std::to_string((uintptr_t)Mat.get()), false, [&]() {
+			return Ref<const Mesh3D>(Mesh3D::Import(FilePath, Mat));
+		});
+	}
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "AssetCache.h"
+
+namespace GraphX
+{
+	class Texture2D;
+	class SpriteSheet;
+	class Shader;
+	class Mesh3D;
+	class Material;
+	enum class TextureLoadMode;
+	struct AssetManagerData;
+
+	/*
+	* Shares the assets loaded from the files, so a file referenced by several materials (or models) is decoded and uploaded only once
+	* Assets are held weakly (see AssetCache) and can be requested from any thread
+	*/
+	class AssetManager
+	{
+	public:
+		static void Init();
+		static void Shutdown();
+
+		/* Returns the texture loaded from the file (Tiled and clamped, or streamed and immediate textures of a file are separate assets) */
+		static Ref<Texture2D> LoadTexture2D(const std::string& FilePath, bool TileTexture, TextureLoadMode LoadMode);
+
+		/* Returns the sprite sheet loaded from the file (Sheets split in to different sprites are separate assets) */
+		static Ref<SpriteSheet> LoadSpriteSheet(const std::string& FilePath, uint32_t NumSprites, const GM::Vector2& SpriteSize);
+
+		/* Returns the shader compiled from the file */
+		static Ref<Shader> LoadShader(const std::string& FilePath);
+
+		/* Returns the meshes imported from the file with the material (Shared by all the instances of the mesh, see Mesh3D::Load) */
+		static Ref<const Mesh3D> LoadMesh(const std::string& FilePath, const Ref<Material>& Mat);
+
+	private:
+		static AssetManagerData* s_Data;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "pch.h"
+#include "Batch.h"
+
+#include "Engine/Core/VertexArray.h"
+#include "Engine/Core/Buffers/VertexBuffer.h"
+#include "Engine/Core/Buffers/IndexBuffer.h"
+
+#include "Engine/Core/Textures/Texture2D.h"
+#include "Engine/Core/Textures/Texture2DArray.h"
+#include "Engine/Core/Textures/Texture2DArrayPool.h"
+
+namespace GraphX
+{
+	void Batch::SetTextureArrayPool(Texture2DArrayPool* Pool)
+	{
+		GX_ENGINE_ASSERT(Pool == m_TextureArrays || m_TextureSlotIndex == 1, "Texture array pool changed in the middle of a batch");
+		m_TextureArrays = Pool;
+	}
+
+	uint32_t Batch::PrepareTextureSlot(const Texture2D& Tex, uint32_t& OutLayer)
+	{
+		if (m_TextureArrays)
+		{
+			const Texture2DArrayPool::Location& Loc = m_TextureArrays->Resolve(Tex);
+
+			// Pool only takes the fully uploaded textures, so a streamed texture is drawn untextured until then
+			if (Loc.Array == nullptr)
+			{
+				FlushIfFull();
+
+				OutLayer = NoTextureLayer;
+				return 0;
+			}
+
+			const uint32_t ArrayID = Loc.Array->GetID();
+
+			// Only a handful of arrays are used in a batch, so a linear search is enough (Slot 0 is the white texture)
+			uint32_t ArraySlot = 0;
+			for (uint32_t i = 1; i < m_TextureSlotIndex; i++)
+			{
+				if (m_TextureIDs[i] == ArrayID)
+				{
+					ArraySlot = i;
+					break;
+				}
+			}
+
+			if (IsFull() || (ArraySlot == 0 && m_TextureSlotIndex == Renderer::MaxTextureImageUnits))
+			{
+				FlushBatch();
+				ArraySlot = 0;
+			}
+
+			if (ArraySlot == 0)
+			{
+				ArraySlot = m_TextureSlotIndex++;
+				m_TextureIDs[ArraySlot] = ArrayID;
+			}
+
+			OutLayer = Loc.Layer;
+			return ArraySlot;
+		}
+
+		uint32_t TextureHandle = Tex.GetHandle();
+		uint32_t TextureSlot = FindTextureSlot(TextureHandle);
+
+		// If the batch is full or the texture is not in the batch and all texture slots are used
+		if (IsFull() || (TextureSlot == 0 && m_TextureSlotIndex == Renderer::MaxTextureImageUnits))
+		{
+			FlushBatch();
+			TextureSlot = 0;
+		}
+
+		// If texture is not in the texture slots
+		if (TextureSlot == 0)
+		{
+			TextureSlot = AddTextureSlot(TextureHandle, Tex.GetID());
+		}
+
+		OutLayer = 0;
+		return TextureSlot;
+	}
+
+	void Batch::FlushIfFull()
+	{
+		if (IsFull())
+		{
+			FlushBatch();
+		}
+	}
+
+	void Batch::FlushBatch()
+	{
+		EndBatch();
+		Flush();
+		BeginBatch();
+	}
+}
\ No newline at end of file
@@ -4,13 +4,20 @@
 
 namespace GraphX
 {
+	class Texture2D;
+	class Texture2DArrayPool;
+
 	class Batch
 	{
 	public:
-		Batch(uint32_t PrimCount)
+		/**
+		* @Param Indexed - Whether the batch stores indices for its primitives (Instanced batches do not need any)
+		*/
+		Batch(uint32_t PrimCount, bool Indexed = true)
 			: m_PrimitivesCount(PrimCount), m_MaxVerticesCount(4 * m_PrimitivesCount), m_MaxIndicesCount(6 * m_PrimitivesCount)
 		{
-			m_IndicesData = new uint32_t[m_MaxIndicesCount];
+			if (Indexed)
+				m_IndicesData = new uint32_t[m_MaxIndicesCount];
 
 			// TODO: Replace 32, get the actual count from the GPU
 			for (int i = 0; i < Renderer::MaxTextureImageUnits; i++)
@@ -31,6 +38,79 @@ namespace GraphX
 		
 		virtual bool IsFull() const = 0;
 
+		/**
+		* Sets the pool used to batch the textures as texture array layers (nullptr to use the texture slots)
+		* With a pool, each slot holds a texture array, so the textures of the same size and format share a slot
+		* NOTE: Should only be changed between batches
+		*/
+		void SetTextureArrayPool(Texture2DArrayPool* Pool);
+
+		// Texture array layer used by the primitives without a texture
+		static const uint32_t NoTextureLayer = 0xffff;
+
+	protected:
+		/**
+		* Returns the slot for the texture (and the layer of the texture array in the slot, when batching with texture arrays)
+		* Flushes the batch if the batch is full or all the texture slots are used
+		*/
+		uint32_t PrepareTextureSlot(const Texture2D& Tex, uint32_t& OutLayer);
+
+		/* Flushes the batch if it is full, used before adding the primitives without a texture */
+		void FlushIfFull();
+
+		/* Renders the primitives of the current batch and starts a new one */
+		void FlushBatch();
+
+		/* Returns whether the texture slots hold texture arrays */
+		bool IsUsingTextureArrays() const { return m_TextureArrays != nullptr; }
+
+
+		/**
+		* Returns the slot the texture is bound to in the current batch or 0 if the texture is not in the batch yet
+		* Lookup is a direct index into the slot table using the texture handle, validated by the batch generation
+		*/
+		uint32_t FindTextureSlot(uint32_t TextureHandle) const
+		{
+			if (TextureHandle < m_SlotGenerations.size() && m_SlotGenerations[TextureHandle] == m_BatchGeneration)
+				return m_TextureSlots[TextureHandle];
+
+			return 0;
+		}
+
+		/* Stores the texture in the next free slot and returns the slot index (Batch should not be full) */
+		uint32_t AddTextureSlot(uint32_t TextureHandle, uint32_t RendererID)
+		{
+			GX_ENGINE_ASSERT(m_TextureSlotIndex < Renderer::MaxTextureImageUnits, "No texture slots available in the batch");
+
+			if (TextureHandle >= m_SlotGenerations.size())
+			{
+				// Grow geometrically, so that the table is resized only a handful of times
+				size_t NewSize = GM::Utility::Max<size_t>(2 * m_SlotGenerations.size(), TextureHandle + 1);
+				m_SlotGenerations.resize(NewSize, 0);
+				m_TextureSlots.resize(NewSize, 0);
+			}
+
+			uint32_t Slot = m_TextureSlotIndex++;
+			m_TextureIDs[Slot] = RendererID;
+			m_TextureSlots[TextureHandle] = Slot;
+			m_SlotGenerations[TextureHandle] = m_BatchGeneration;
+
+			return Slot;
+		}
+
+		/* Releases all the texture slots (except the white texture) in constant time */
+		void ResetTextureSlots()
+		{
+			m_TextureSlotIndex = 1;
+
+			// Clear the stale generations when the counter wraps around
+			if (++m_BatchGeneration == 0)
+			{
+				std::fill(m_SlotGenerations.begin(), m_SlotGenerations.end(), 0);
+				m_BatchGeneration = 1;
+			}
+		}
+
 	protected:
 		// Number of primitives the batch can hold
 		const uint32_t m_PrimitivesCount;
@@ -54,5 +134,17 @@ namespace GraphX
 
 		// Index at which the next texture will be stored
 		uint32_t m_TextureSlotIndex = 1;
+
+		// Slot of each texture in the current batch (indexed by the texture handle)
+		std::vector<uint32_t> m_TextureSlots;
+
+		// Batch generation in which the slot of each texture was assigned (indexed by the texture handle)
+		std::vector<uint32_t> m_SlotGenerations;
+
+		// Generation of the current batch, entries from older generations are stale
+		uint32_t m_BatchGeneration = 1;
+
+		// Pool of texture arrays (Only when batching with texture arrays)
+		Texture2DArrayPool* m_TextureArrays = nullptr;
 	};
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "Batch2D.h"
 #include "GL/glew.h"
+#include "Engine/Core/Device/RenderDevice.h"
 
 #include "Engine/Core/Renderer/Renderer.h"
 
@@ -12,6 +13,7 @@
 
 #include "Engine/Core/Shaders/Shader.h"
 #include "Engine/Core/Textures/Texture2D.h"
+#include "Engine/Core/Textures/SubTexture2D.h"
 
 #include "Engine/Core/Renderer/Renderer2D.h"
 
@@ -29,7 +31,8 @@ namespace GraphX
 		m_VBO = CreateScope<VertexBuffer>(m_MaxVerticesCount * sizeof(VertexBatch2D));
 		m_VAO->AddVertexBuffer(*m_VBO, Layout);
 
-		m_IBO = CreateScope<IndexBuffer>(m_MaxIndicesCount);
+		// Quads of a batch fit in 16 bit indices, unless the batch is very large
+		m_IBO = CreateScope<IndexBuffer>(m_MaxIndicesCount, IndexBuffer::SelectIndexType(m_MaxVerticesCount - 1));
 		m_VAO->AddIndexBuffer(*m_IBO);
 
 		m_VertexData = new VertexBatch2D[m_MaxVerticesCount];
@@ -52,25 +55,25 @@ namespace GraphX
 		if (m_VertexDataPtr == m_VertexData)
 			return;
 
-		Ref<Shader> shader = Renderer::GetShaderLibrary().GetShader("Batch2D");
+		Ref<Shader> shader = Renderer::GetShaderLibrary().GetShader(IsUsingTextureArrays() ? "ArrayBatch2D" : "Batch2D");
 		shader->Bind();
 
-		// Bind all the textures
+		// Bind all the textures (or the texture arrays)
 		for (uint32_t i = 0; i < m_TextureSlotIndex; i++)
 		{
-			glBindTextureUnit(i, m_TextureIDs[i]);
+			RenderDevice::Get().BindTextureUnit(i, m_TextureIDs[i]);
 		}
 
 		m_VAO->Bind();
 
-		glDrawElements(GL_TRIANGLES, m_IndexCount, GL_UNSIGNED_INT, nullptr);
+		RenderDevice::Get().DrawElements(GL_TRIANGLES, m_IndexCount, m_IBO->GetDrawType(), nullptr);
 
 		// Maintain stats
 		Renderer2D::s_Data->Stats.DrawCalls++;
 
 		m_Offset = 0;
 		m_IndexCount = 0;
-		m_TextureSlotIndex = 1;
+		ResetTextureSlots();
 	}
 
 	void Batch2D::AddQuad(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Vector4& Color)
@@ -87,61 +90,48 @@ namespace GraphX
 	{
 		GX_ENGINE_ASSERT(m_VertexDataPtr != nullptr && m_IndicesDataPtr != nullptr, "Batch::Begin() not called before submitting primities");
 
-		if (IsFull())
-		{
-			EndBatch();
-			Flush();
-			BeginBatch();
-		}
+		FlushIfFull();
 
-		float textureIndex = 0.0f;		// White Texture Index
-
-		AddQuad_Internal(Position, Size, Rotation, Color, 1.0f, textureIndex);
+		// White Texture Index
+		AddQuad_Internal(Position, Size, Rotation, Color, 1.0f, 0, NoTextureLayer);
 	}
 
 	void Batch2D::AddQuad(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Vector3& Rotation, const Ref<class Texture2D>& Tex, const GM::Vector4& TintColor, float tiling)
 	{
 		GX_ENGINE_ASSERT(m_VertexDataPtr != nullptr && m_IndicesDataPtr != nullptr, "Batch::Begin() not called before submitting primities");
 
-		// If index buffer is full or all texture slots are used
-		if (IsFull() || m_TextureSlotIndex == Renderer::MaxTextureImageUnits)
-		{
-			EndBatch();
-			Flush();
-			BeginBatch();
-		}
+		uint32_t textureLayer = 0;
+		uint32_t textureIndex = PrepareTextureSlot(*Tex, textureLayer);
 
-		uint32_t TexID = Tex->GetID();
-		float textureIndex = 0.0f;
-		for (uint32_t i = 1; i < m_TextureSlotIndex; i++)
-		{
-			if (TexID == m_TextureIDs[i])
-			{
-				textureIndex = (float)i;
-				break;
-			}
-		}
+		AddQuad_Internal(Position, Size, Rotation, TintColor, tiling, textureIndex, textureLayer);
+	}
 
-		// If texture is not in the texture slots
-		if (textureIndex == 0.0f)
-		{
-			textureIndex = (float)m_TextureSlotIndex;
-			m_TextureIDs[m_TextureSlotIndex++] = Tex->GetID();
-		}
+	void Batch2D::AddQuad(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Vector3& Rotation, const Ref<SubTexture2D>& SubTexture, const GM::Vector4& TintColor)
+	{
+		GX_ENGINE_ASSERT(m_VertexDataPtr != nullptr && m_IndicesDataPtr != nullptr, "Batch::Begin() not called before submitting primities");
+
+		uint32_t textureLayer = 0;
+		uint32_t textureIndex = PrepareTextureSlot(*SubTexture->GetTexture(), textureLayer);
 
-		AddQuad_Internal(Position, Size, Rotation, TintColor, tiling, textureIndex);
+		AddQuad_Internal(Position, Size, Rotation, TintColor, 1.0f, textureIndex, textureLayer, SubTexture->GetTexCoords());
 	}
 
-	void Batch2D::AddQuad_Internal(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Vector3& Rotation, const GM::Vector4& Color, float tiling, float textureIndex)
+	void Batch2D::AddQuad_Internal(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Vector3& Rotation, const GM::Vector4& Color, float tiling, uint32_t textureIndex, uint32_t textureLayer, const GM::Vector2* TexCoords)
 	{
 		GM::Matrix4 transform = GM::ScaleRotationTranslationMatrix({ Size, 1.0f }, GM::Rotator::MakeFromEuler(Rotation), Position);
 
+		// Attributes shared by all the vertices are packed only once
+		uint32_t PackedColor = Pack::Color(Color);
+		uint8_t TexIndex = (uint8_t)textureIndex;
+		uint16_t TexLayer = (uint16_t)textureLayer;
+
 		for (int i = 0; i < 4; i++)
 		{
 			m_VertexDataPtr->Position = transform * Quad::s_QuadVertexPositions[i];
-			m_VertexDataPtr->Color = Color;
-			m_VertexDataPtr->TexCoords = Quad::s_QuadVertexTexCoords[i] * tiling;
-			m_VertexDataPtr->TexIndex = textureIndex;
+			m_VertexDataPtr->Color = PackedColor;
+			m_VertexDataPtr->TexCoords = ((TexCoords != nullptr) ? TexCoords[i] : Quad::s_QuadVertexTexCoords[i]) * tiling;
+			m_VertexDataPtr->TexIndex = TexIndex;
+			m_VertexDataPtr->TexLayer = TexLayer;
 			m_VertexDataPtr++;
 		}
 
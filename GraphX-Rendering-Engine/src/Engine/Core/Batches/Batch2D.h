@@ -27,10 +27,17 @@ namespace GraphX
 		void AddQuad(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Vector3& Rotation, const GM::Vector4& Color);
 		void AddQuad(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Vector3& Rotation, const Ref<class Texture2D>& Tex, const GM::Vector4& TintColor, float tiling);
 
+		/* Quad that samples only part of a texture (e.g. a sprite or an image in a texture atlas) */
+		void AddQuad(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Vector3& Rotation, const Ref<class SubTexture2D>& SubTexture, const GM::Vector4& TintColor);
+
 		bool IsFull() const override;
 
 	private:
-		void AddQuad_Internal(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Vector3& Rotation, const GM::Vector4& Color, float tiling, float textureIndex);
+		/**
+		* @textureLayer - Layer of the texture array in the slot (Only when batching with texture arrays)
+		* @TexCoords - Texture coords of the 4 vertices, nullptr to use the entire texture
+		*/
+		void AddQuad_Internal(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Vector3& Rotation, const GM::Vector4& Color, float tiling, uint32_t textureIndex, uint32_t textureLayer, const GM::Vector2* TexCoords = nullptr);
 
 	private:
 		// Buffer to store vertices
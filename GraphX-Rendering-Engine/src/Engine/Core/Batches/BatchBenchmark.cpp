@@ -0,0 +1,173 @@
+#include "pch.h"
+#include "BatchBenchmark.h"
+
+#include "Batch.h"
+#include "Engine/Core/VertexArray.h"
+#include "Engine/Core/Buffers/VertexBuffer.h"
+#include "Engine/Core/Buffers/IndexBuffer.h"
+#include "Utilities/EngineUtil.h"
+
+namespace GraphX
+{
+	namespace BatchBenchmark
+	{
+		/* Texture as seen by the slot lookups (The benchmark makes no GL textures) */
+		struct BenchmarkTexture
+		{
+			std::string FilePath;
+			uint32_t Width, Height;
+			uint32_t Handle;
+		};
+
+		/* Comparison used by the old slot search (Same as Texture2D::operator==, compares the file names and the sizes) */
+		static bool IsSameTexture(const BenchmarkTexture& A, const BenchmarkTexture& B)
+		{
+			return EngineUtil::ExtractFileName(A.FilePath) == EngineUtil::ExtractFileName(B.FilePath) && A.Width == B.Width && A.Height == B.Height;
+		}
+
+		/* Batch that only does the texture slot bookkeeping */
+		class TextureSlotBatch
+			: public Batch
+		{
+		public:
+			TextureSlotBatch(uint32_t QuadCount)
+				: Batch(QuadCount)
+			{}
+
+			void BeginBatch() override {}
+			void EndBatch() override {}
+
+			void Flush() override
+			{
+				m_IndexCount = 0;
+				ResetTextureSlots();
+				FlushCount++;
+			}
+
+			bool IsFull() const override { return m_IndexCount >= m_MaxIndicesCount; }
+
+			/* Old path: linear search through the used slots, comparing the textures */
+			uint32_t AddQuadLinear(const BenchmarkTexture& Texture)
+			{
+				uint32_t TextureSlot = 0;
+				for (uint32_t i = 1; i < m_TextureSlotIndex; i++)
+				{
+					if (IsSameTexture(*m_SlotTextures[i], Texture))
+					{
+						TextureSlot = i;
+						break;
+					}
+				}
+
+				if (IsFull() || (TextureSlot == 0 && m_TextureSlotIndex == Renderer::MaxTextureImageUnits))
+				{
+					Flush();
+					TextureSlot = 0;
+				}
+
+				if (TextureSlot == 0)
+				{
+					TextureSlot = m_TextureSlotIndex;
+					m_SlotTextures[m_TextureSlotIndex] = &Texture;
+					m_TextureIDs[m_TextureSlotIndex++] = Texture.Handle;
+				}
+
+				m_IndexCount += 6;
+				return TextureSlot;
+			}
+
+			/* New path: direct lookup using the texture handle */
+			uint32_t AddQuadMapped(uint32_t TextureHandle)
+			{
+				uint32_t TextureSlot = FindTextureSlot(TextureHandle);
+
+				if (IsFull() || (TextureSlot == 0 && m_TextureSlotIndex == Renderer::MaxTextureImageUnits))
+				{
+					Flush();
+					TextureSlot = 0;
+				}
+
+				if (TextureSlot == 0)
+				{
+					TextureSlot = AddTextureSlot(TextureHandle, TextureHandle);
+				}
+
+				m_IndexCount += 6;
+				return TextureSlot;
+			}
+
+		public:
+			uint32_t FlushCount = 0;
+
+		private:
+			/* Textures bound to the slots, compared by the old path */
+			std::array<const BenchmarkTexture*, Renderer::MaxTextureImageUnits> m_SlotTextures = {};
+		};
+
+		TextureSlotResult RunTextureSlotBenchmark(uint32_t QuadCount, uint32_t TextureCount)
+		{
+			GX_PROFILE_FUNCTION()
+
+			GX_ENGINE_ASSERT(TextureCount > 0, "Benchmark requires at least one texture");
+
+			// Same quad count as the Renderer2D batch
+			const uint32_t BatchSize = 1000;
+
+			// Textures with paths and sizes like the ones loaded by the engine
+			std::vector<BenchmarkTexture> Textures(TextureCount);
+			for (uint32_t i = 0; i < TextureCount; i++)
+			{
+				Textures[i].FilePath = "res/Textures/Benchmark/Texture" + std::to_string(i) + ".png";
+				Textures[i].Width = Textures[i].Height = 256;
+				Textures[i].Handle = i + 1;
+			}
+
+			// Pseudo random but repeatable texture sequence, same for both the runs
+			std::vector<uint32_t> TextureIndices(QuadCount);
+			std::mt19937 Generator(1337);
+			std::uniform_int_distribution<uint32_t> Distribution(0, TextureCount - 1);
+			for (uint32_t i = 0; i < QuadCount; i++)
+			{
+				TextureIndices[i] = Distribution(Generator);
+			}
+
+			uint64_t LinearChecksum = 0, MappedChecksum = 0;
+			uint32_t LinearFlushes = 0, MappedFlushes = 0;
+			float LinearTime = 0.0f, MappedTime = 0.0f;
+
+			{
+				TextureSlotBatch LinearBatch(BatchSize);
+				Timer timer("BatchBenchmark::LinearTextureSlots");
+				for (uint32_t Index : TextureIndices)
+				{
+					LinearChecksum += LinearBatch.AddQuadLinear(Textures[Index]);
+				}
+				LinearTime = timer.GetTime();
+				LinearFlushes = LinearBatch.FlushCount;
+			}
+
+			{
+				TextureSlotBatch MappedBatch(BatchSize);
+				Timer timer("BatchBenchmark::MappedTextureSlots");
+				for (uint32_t Index : TextureIndices)
+				{
+					MappedChecksum += MappedBatch.AddQuadMapped(Textures[Index].Handle);
+				}
+				MappedTime = timer.GetTime();
+				MappedFlushes = MappedBatch.FlushCount;
+			}
+
+			GX_ENGINE_ASSERT(LinearChecksum == MappedChecksum && LinearFlushes == MappedFlushes, "Texture slot lookups do not match");
+
+			GX_ENGINE_INFO("Texture slot benchmark ({0} quads, {1} textures): Linear {2} ms, Mapped {3} ms, Flushes {4}", QuadCount, TextureCount, LinearTime * 1000.0f, MappedTime * 1000.0f, MappedFlushes);
+
+			TextureSlotResult Result;
+			Result.QuadCount = QuadCount;
+			Result.TextureCount = TextureCount;
+			Result.LinearTime = LinearTime * 1000.0f;
+			Result.MappedTime = MappedTime * 1000.0f;
+			Result.Flushes = MappedFlushes;
+			return Result;
+		}
+	}
+}
\ No newline at end of file
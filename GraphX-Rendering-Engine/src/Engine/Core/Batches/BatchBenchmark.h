@@ -0,0 +1,28 @@
+#pragma once
+
+namespace GraphX
+{
+	namespace BatchBenchmark
+	{
+		/* Timings of the texture slot benchmark */
+		struct TextureSlotResult
+		{
+			uint32_t QuadCount = 0;
+			uint32_t TextureCount = 0;
+
+			/* Time taken (in milliseconds) by the linear slot search (comparing the file names) and by the handle based lookup */
+			float LinearTime = 0.0f;
+			float MappedTime = 0.0f;
+
+			/* Number of times the batch was flushed (same for both the lookups) */
+			uint32_t Flushes = 0;
+		};
+
+		/**
+		* Micro benchmark for the texture slot lookup used by the batches (CPU only, no draw calls are made)
+		* Submits QuadCount quads cycling through TextureCount textures and compares the old linear slot search, which compared the file names
+		* and the sizes of the textures (Texture2D::operator==), against the handle based lookup
+		*/
+		TextureSlotResult RunTextureSlotBenchmark(uint32_t QuadCount = 100000, uint32_t TextureCount = 40);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include "pch.h"
+
+#include "InstancedBatch2D.h"
+#include "GL/glew.h"
+#include "Engine/Core/Device/RenderDevice.h"
+
+#include "Engine/Core/Renderer/Renderer.h"
+
+#include "Engine/Core/Vertex.h"
+#include "Engine/Core/VertexArray.h"
+#include "Engine/Core/Buffers/VertexBuffer.h"
+#include "Engine/Core/Buffers/IndexBuffer.h"
+
+#include "Engine/Core/Shaders/Shader.h"
+#include "Engine/Core/Textures/Texture2D.h"
+#include "Engine/Core/Textures/SubTexture2D.h"
+
+#include "Engine/Core/Renderer/Renderer2D.h"
+
+#include "Engine/Model/Quad.h"
+
+namespace GraphX
+{
+	InstancedBatch2D::InstancedBatch2D(uint32_t QuadCount)
+		: Batch(QuadCount, false)
+	{
+		// NOTE: No vertex or index buffer is required, the quad corners are generated from gl_VertexID
+
+		m_VAO = CreateScope<VertexArray>();
+		m_VBO = CreateScope<VertexBuffer>(m_PrimitivesCount * sizeof(QuadInstance2D));
+		m_VAO->AddVertexBuffer(*m_VBO, QuadInstance2D::VertexLayout(), true);
+
+		m_InstanceData = new QuadInstance2D[m_PrimitivesCount];
+	}
+
+	InstancedBatch2D::~InstancedBatch2D()
+	{
+		delete[] m_InstanceData;
+	}
+
+	void InstancedBatch2D::BeginBatch()
+	{
+		m_InstanceDataPtr = m_InstanceData;
+	}
+
+	void InstancedBatch2D::EndBatch()
+	{
+		size_t size = (m_InstanceDataPtr - m_InstanceData) * sizeof(QuadInstance2D);
+		m_VBO->SetData(m_InstanceData, 0, size);
+
+		m_InstanceDataPtr = nullptr;
+	}
+
+	void InstancedBatch2D::Flush()
+	{
+		// No Need to flush if there is no new data in the buffer
+		if (m_InstanceCount == 0)
+			return;
+
+		Ref<Shader> shader = Renderer::GetShaderLibrary().GetShader(IsUsingTextureArrays() ? "InstancedArrayBatch2D" : "InstancedBatch2D");
+		shader->Bind();
+
+		// Bind all the textures (or the texture arrays)
+		for (uint32_t i = 0; i < m_TextureSlotIndex; i++)
+		{
+			RenderDevice::Get().BindTextureUnit(i, m_TextureIDs[i]);
+		}
+
+		m_VAO->Bind();
+
+		// Each instance is a 4 vertex triangle strip
+		RenderDevice::Get().DrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, m_InstanceCount);
+
+		// Maintain stats
+		Renderer2D::s_Data->Stats.DrawCalls++;
+
+		m_InstanceCount = 0;
+		ResetTextureSlots();
+	}
+
+	void InstancedBatch2D::AddQuad(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Vector4& Color)
+	{
+		AddQuad(Position, Size, GM::Vector3::ZeroVector, Color);
+	}
+
+	void InstancedBatch2D::AddQuad(const GM::Vector3& Position, const GM::Vector2& Size, const Ref<Texture2D>& Tex, const GM::Vector4& TintColor, float tiling)
+	{
+		AddQuad(Position, Size, GM::Vector3::ZeroVector, Tex, TintColor, tiling);
+	}
+
+	void InstancedBatch2D::AddQuad(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Vector3& Rotation, const GM::Vector4& Color)
+	{
+		GX_ENGINE_ASSERT(m_InstanceDataPtr != nullptr, "Batch::Begin() not called before submitting primities");
+
+		FlushIfFull();
+
+		// White Texture Index
+		AddQuad_Internal(Position, Size, Rotation, Color, 1.0f, Quad::s_QuadVertexTexCoords[0], Quad::s_QuadVertexTexCoords[2], 0, NoTextureLayer);
+	}
+
+	void InstancedBatch2D::AddQuad(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Vector3& Rotation, const Ref<Texture2D>& Tex, const GM::Vector4& TintColor, float tiling)
+	{
+		GX_ENGINE_ASSERT(m_InstanceDataPtr != nullptr, "Batch::Begin() not called before submitting primities");
+
+		uint32_t TextureLayer = 0;
+		uint32_t TextureSlot = PrepareTextureSlot(*Tex, TextureLayer);
+		AddQuad_Internal(Position, Size, Rotation, TintColor, tiling, Quad::s_QuadVertexTexCoords[0], Quad::s_QuadVertexTexCoords[2], TextureSlot, TextureLayer);
+	}
+
+	void InstancedBatch2D::AddQuad(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Vector3& Rotation, const Ref<SubTexture2D>& SubTexture, const GM::Vector4& TintColor)
+	{
+		GX_ENGINE_ASSERT(m_InstanceDataPtr != nullptr, "Batch::Begin() not called before submitting primities");
+
+		uint32_t TextureLayer = 0;
+		uint32_t TextureSlot = PrepareTextureSlot(*SubTexture->GetTexture(), TextureLayer);
+
+		const GM::Vector2* TexCoords = SubTexture->GetTexCoords();
+		AddQuad_Internal(Position, Size, Rotation, TintColor, 1.0f, TexCoords[0], TexCoords[2], TextureSlot, TextureLayer);
+	}
+
+	void InstancedBatch2D::AddQuad_Internal(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Vector3& Rotation, const GM::Vector4& Color, float tiling, const GM::Vector2& TexCoordsMin, const GM::Vector2& TexCoordsMax, uint32_t textureIndex, uint32_t textureLayer)
+	{
+		m_InstanceDataPtr->Position = Position;
+		m_InstanceDataPtr->Size = Size;
+		m_InstanceDataPtr->RotationAndTiling[0] = Pack::FloatToHalf(Rotation.x);
+		m_InstanceDataPtr->RotationAndTiling[1] = Pack::FloatToHalf(Rotation.y);
+		m_InstanceDataPtr->RotationAndTiling[2] = Pack::FloatToHalf(Rotation.z);
+		m_InstanceDataPtr->RotationAndTiling[3] = Pack::FloatToHalf(tiling);
+		m_InstanceDataPtr->Color = Pack::Color(Color);
+		m_InstanceDataPtr->TexRect[0] = Pack::Unorm16(TexCoordsMin.x);
+		m_InstanceDataPtr->TexRect[1] = Pack::Unorm16(TexCoordsMin.y);
+		m_InstanceDataPtr->TexRect[2] = Pack::Unorm16(TexCoordsMax.x);
+		m_InstanceDataPtr->TexRect[3] = Pack::Unorm16(TexCoordsMax.y);
+		m_InstanceDataPtr->TexIndex = (uint16_t)textureIndex;
+		m_InstanceDataPtr->TexLayer = (uint16_t)textureLayer;
+		m_InstanceDataPtr++;
+
+		m_InstanceCount++;
+
+		// Maintain stats
+		Renderer2D::s_Data->Stats.QuadCount++;
+	}
+
+	bool InstancedBatch2D::IsFull() const
+	{
+		return m_InstanceCount >= m_PrimitivesCount;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Batch.h"
+
+namespace GraphX
+{
+	class Texture2D;
+	class SubTexture2D;
+
+	/* Batch that stores one instance per quad and lets the vertex shader generate the corners */
+	class InstancedBatch2D
+		: public Batch
+	{
+		friend class Renderer2D;
+	public:
+		/**
+		* InstancedBatch2D
+		* @size - number of quads that the batch can hold
+		*/
+		InstancedBatch2D(uint32_t QuadCount);
+		~InstancedBatch2D();
+
+		void BeginBatch() override;
+		void EndBatch() override;
+
+		void Flush() override;
+
+		void AddQuad(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Vector4& Color);
+		void AddQuad(const GM::Vector3& Position, const GM::Vector2& Size, const Ref<Texture2D>& Tex, const GM::Vector4& TintColor, float tiling);
+
+		void AddQuad(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Vector3& Rotation, const GM::Vector4& Color);
+		void AddQuad(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Vector3& Rotation, const Ref<Texture2D>& Tex, const GM::Vector4& TintColor, float tiling);
+
+		/* Quad that samples only part of a texture */
+		void AddQuad(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Vector3& Rotation, const Ref<SubTexture2D>& SubTexture, const GM::Vector4& TintColor);
+
+		bool IsFull() const override;
+
+	private:
+		/* @textureLayer - Layer of the texture array in the slot (Only when batching with texture arrays) */
+		void AddQuad_Internal(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Vector3& Rotation, const GM::Vector4& Color, float tiling, const GM::Vector2& TexCoordsMin, const GM::Vector2& TexCoordsMax, uint32_t textureIndex, uint32_t textureLayer);
+
+	private:
+		// Buffer to store the quad instances
+		struct QuadInstance2D* m_InstanceData = nullptr;
+		struct QuadInstance2D* m_InstanceDataPtr = nullptr;
+
+		// Number of quads in the current batch
+		uint32_t m_InstanceCount = 0;
+	};
+}
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "ParticleBatch.h"
 
 #include "GL/glew.h"
+#include "Engine/Core/Device/RenderDevice.h"
 
 #include "Engine/Core/Vertex.h"
 #include "Engine/Core/VertexArray.h"
@@ -32,7 +33,8 @@ namespace GraphX
 		m_VBO = CreateScope<VertexBuffer>(m_MaxVerticesCount * sizeof(VertexParticleBatch));
 		m_VAO->AddVertexBuffer(*m_VBO, Layout);
 
-		m_IBO = CreateScope<IndexBuffer>(m_MaxIndicesCount);
+		// Quads of a batch fit in 16 bit indices, unless the batch is very large
+		m_IBO = CreateScope<IndexBuffer>(m_MaxIndicesCount, IndexBuffer::SelectIndexType(m_MaxVerticesCount - 1));
 		m_VAO->AddIndexBuffer(*m_IBO);
 
 		m_VertexData = new VertexParticleBatch[m_MaxVerticesCount];
@@ -66,108 +68,106 @@ namespace GraphX
 		if (m_VertexDataPtr == m_VertexData)
 			return;
 
-		Ref<Shader> shader = Renderer::GetShaderLibrary().GetShader("ParticleBatch");
+		Ref<Shader> shader = Renderer::GetShaderLibrary().GetShader(IsUsingTextureArrays() ? "ParticleArrayBatch" : "ParticleBatch");
 		shader->Bind();
 
 		// Pre Render stuff
-		glDepthMask(false);		// Don't render the particles to the depth buffer
+		RenderDevice::Get().DepthMask(false);		// Don't render the particles to the depth buffer
 
-		glEnable(GL_BLEND);		// To enable blending
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+		RenderDevice::Get().Enable(GL_BLEND);		// To enable blending
+		RenderDevice::Get().BlendFunc(GL_SRC_ALPHA, GL_ONE);
 
-		// Bind all the textures
+		// Bind all the textures (or the texture arrays)
 		for (uint32_t i = 0; i < m_TextureSlotIndex; i++)
 		{
-			glBindTextureUnit(i, m_TextureIDs[i]);
+			RenderDevice::Get().BindTextureUnit(i, m_TextureIDs[i]);
 		}
 
 		m_VAO->Bind();
 
-		glDrawElements(GL_TRIANGLES, m_IndexCount, GL_UNSIGNED_INT, nullptr);
+		RenderDevice::Get().DrawElements(GL_TRIANGLES, m_IndexCount, m_IBO->GetDrawType(), nullptr);
 		Renderer2D::s_Data->Stats.DrawCalls++;
 
 		// Post Render Stuff
-		glDepthMask(true);
-		glDisable(GL_BLEND);
+		RenderDevice::Get().DepthMask(true);
+		RenderDevice::Get().Disable(GL_BLEND);
 
 		m_Offset = 0;
 		m_IndexCount = 0;
-		m_TextureSlotIndex = 1;
+		ResetTextureSlots();
 	}
 
 	void ParticleBatch::AddParticle(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Rotator& Rotation, const GM::Vector4& Color)
 	{
 		GX_ENGINE_ASSERT(m_VertexDataPtr != nullptr && m_IndicesDataPtr != nullptr, "Batch::Begin() not called before submitting primities");
 
-		if (IsFull())
-		{
-			EndBatch();
-			Flush();
-			BeginBatch();
-		}
-
-		float textureIndex = 0.0f;		// White Texture Index
+		FlushIfFull();
 
-		AddParticle_Internal(Position, Size, Rotation, Color, nullptr, nullptr, 0.0f, 0, textureIndex);
+		// White Texture Index
+		AddParticle_Internal(Position, Size, Rotation, Color, nullptr, nullptr, 0.0f, 0, 0, NoTextureLayer);
 	}
 
 	void ParticleBatch::AddParticle(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Rotator& Rotation, const Ref<Texture2D>& Texture, const uint32_t SubTextureIndex1, const uint32_t SubTextureIndex2, const GM::Vector4& TintColor, float BlendFactor)
 	{
 		GX_ENGINE_ASSERT(m_VertexDataPtr != nullptr && m_IndicesDataPtr != nullptr, "Batch::Begin() not called before submitting primities");
 
-		// If index buffer is full or all texture slots are used
-		if (IsFull() || m_TextureSlotIndex == Renderer::MaxTextureImageUnits)
-		{
-			EndBatch();
-			Flush();
-			BeginBatch();
-		}
-
-		uint32_t TexID = Texture->GetID();
-		float textureIndex = 0.0f;
-		for (uint32_t i = 1; i < m_TextureSlotIndex; i++)
-		{
-			if (TexID == m_TextureIDs[i])
-			{
-				textureIndex = (float)i;
-				break;
-			}
-		}
-
-		// If texture is not in the texture slots
-		if (textureIndex == 0.0f)
-		{
-			textureIndex = (float)m_TextureSlotIndex;
-			m_TextureIDs[m_TextureSlotIndex++] = Texture->GetID();
-		}
-
 		uint32_t RowsInAtlas = Texture->GetRowsInAtlas();
 		const GM::Vector2* TextureCoords1 = nullptr;
 		const GM::Vector2* TextureCoords2 = nullptr;
+		uint32_t textureIndex = 0;
+		uint32_t textureLayer = 0;
 
 		if (RowsInAtlas > 1)
 		{
+			// Sprites of a packed sheet are in the sprite atlas, so the texture of the sprite is the one bound
 			SpriteSheet* spriteSheet = static_cast<SpriteSheet*>(Texture.get());
-			TextureCoords1 = spriteSheet->GetSprite(SubTextureIndex1)->GetTexCoords();
-			TextureCoords2 = spriteSheet->GetSprite(SubTextureIndex2)->GetTexCoords();
+			const Ref<SubTexture2D>& Sprite1 = spriteSheet->GetSprite(SubTextureIndex1);
+			const Ref<SubTexture2D>& Sprite2 = spriteSheet->GetSprite(SubTextureIndex2);
+
+			textureIndex = PrepareTextureSlot(*Sprite1->GetTexture(), textureLayer);
+			TextureCoords1 = Sprite1->GetTexCoords();
+			TextureCoords2 = Sprite2->GetTexCoords();
+		}
+		else
+		{
+			textureIndex = PrepareTextureSlot(*Texture, textureLayer);
 		}
 
-		AddParticle_Internal(Position, Size, Rotation, TintColor, TextureCoords1, TextureCoords2, BlendFactor, (float)Texture->GetRowsInAtlas(), textureIndex);
+		AddParticle_Internal(Position, Size, Rotation, TintColor, TextureCoords1, TextureCoords2, BlendFactor, (float)Texture->GetRowsInAtlas(), textureIndex, textureLayer);
 	}
 
-	void ParticleBatch::AddParticle_Internal(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Rotator& Rotation, const GM::Vector4& Color, const GM::Vector2* TextureCoords1, const GM::Vector2* TextureCoords2, float BlendFactor, float TexAtlasRows, float TextureIndex)
+	void ParticleBatch::AddParticle(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Rotator& Rotation, const Ref<SubTexture2D>& SubTexture, const GM::Vector4& TintColor)
+	{
+		GX_ENGINE_ASSERT(m_VertexDataPtr != nullptr && m_IndicesDataPtr != nullptr, "Batch::Begin() not called before submitting primities");
+
+		uint32_t textureLayer = 0;
+		uint32_t textureIndex = PrepareTextureSlot(*SubTexture->GetTexture(), textureLayer);
+
+		const GM::Vector2* TextureCoords = SubTexture->GetTexCoords();
+		AddParticle_Internal(Position, Size, Rotation, TintColor, TextureCoords, TextureCoords, 0.0f, 1.0f, textureIndex, textureLayer);
+	}
+
+	void ParticleBatch::AddParticle_Internal(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Rotator& Rotation, const GM::Vector4& Color, const GM::Vector2* TextureCoords1, const GM::Vector2* TextureCoords2, float BlendFactor, float TexAtlasRows, uint32_t TextureIndex, uint32_t TextureLayer)
 	{
 		GM::Matrix4 transform = GM::ScaleRotationTranslationMatrix({ Size, 1.0f }, Rotation, Position);
 
+		// Attributes shared by all the vertices are packed only once
+		uint32_t PackedColor = Pack::Color(Color);
+		uint16_t PackedBlendFactor = Pack::Unorm16(BlendFactor);
+		uint8_t PackedTexIndex = (uint8_t)TextureIndex;
+		uint8_t PackedTexAtlasRows = (uint8_t)GM::Utility::Min(TexAtlasRows, 255.0f);
+		uint16_t PackedTexLayer = (uint16_t)TextureLayer;
+
 		for (int i = 0; i < 4; i++)
 		{
 			m_VertexDataPtr->Position = transform * Quad::s_QuadVertexPositions[i];
-			m_VertexDataPtr->Color = Color;
+			m_VertexDataPtr->Color = PackedColor;
 			m_VertexDataPtr->TexCoords1 = (TextureCoords1 != nullptr) ? TextureCoords1[i] : Quad::s_QuadVertexTexCoords[i];
 			m_VertexDataPtr->TexCoords2 = (TextureCoords2 != nullptr) ? TextureCoords2[i] : Quad::s_QuadVertexTexCoords[i];
-			m_VertexDataPtr->TexAtlasRows = TexAtlasRows;
-			m_VertexDataPtr->BlendFactor = BlendFactor;
-			m_VertexDataPtr->TexIndex = TextureIndex;
+			m_VertexDataPtr->BlendFactor = PackedBlendFactor;
+			m_VertexDataPtr->TexIndex = PackedTexIndex;
+			m_VertexDataPtr->TexAtlasRows = PackedTexAtlasRows;
+			m_VertexDataPtr->TexLayer = PackedTexLayer;
 			m_VertexDataPtr++;
 		}
 
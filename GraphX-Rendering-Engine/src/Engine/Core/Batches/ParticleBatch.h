@@ -24,9 +24,13 @@ namespace GraphX
 		void AddParticle(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Rotator& Rotation, const GM::Vector4& Color);
 		void AddParticle(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Rotator& Rotation, const Ref<class Texture2D>& Texture, const uint32_t SubTextureIndex1, const uint32_t SubTextureIndex2, const GM::Vector4& TintColor, float BlendFactor);
 
+		/* Particle that samples only part of a texture (e.g. an image in a texture atlas) */
+		void AddParticle(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Rotator& Rotation, const Ref<class SubTexture2D>& SubTexture, const GM::Vector4& TintColor);
+
 		bool IsFull() const override;
 	private:
-		void AddParticle_Internal(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Rotator& Rotation, const GM::Vector4& Color, const GM::Vector2* TextureCoords1, const GM::Vector2* TextureCoords2, float BlendFactor, float TexAtlasRows, float TextureIndex);
+		/* @TextureLayer - Layer of the texture array in the slot (Only when batching with texture arrays) */
+		void AddParticle_Internal(const GM::Vector3& Position, const GM::Vector2& Size, const GM::Rotator& Rotation, const GM::Vector4& Color, const GM::Vector2* TextureCoords1, const GM::Vector2* TextureCoords2, float BlendFactor, float TexAtlasRows, uint32_t TextureIndex, uint32_t TextureLayer);
 
 	private:
 		// Buffer to store vertices
@@ -1,6 +1,7 @@
 #include "pch.h"
 #include "FrameBuffer.h"
 #include "GL/glew.h"
+#include "Device/RenderDevice.h"
 
 #include "Textures/Texture2D.h"
 
@@ -11,35 +12,35 @@ namespace GraphX
 	{
 		GX_PROFILE_FUNCTION()
 
-		glGenFramebuffers(1, &m_RendererID);
+		RenderDevice::Get().GenFramebuffers(1, &m_RendererID);
 		if (Type == FramebufferType::GX_FRAME_DEPTH)
 		{
-			glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
+			RenderDevice::Get().BindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
 			m_DepthMap = CreateRef<Texture2D>(m_Width, m_Height, FramebufferAttachmentType::GX_TEX_DEPTH);
 			m_DepthMap->Bind();
-			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_DepthMap->m_RendererID, 0);
-			glDrawBuffer(GL_NONE);
-			glReadBuffer(GL_NONE);
+			RenderDevice::Get().FramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_DepthMap->m_RendererID, 0);
+			RenderDevice::Get().DrawBuffer(GL_NONE);
+			RenderDevice::Get().ReadBuffer(GL_NONE);
 		}
 		else
 			m_DepthMap = nullptr;
 
-		GX_ENGINE_ASSERT(m_DepthMap != nullptr && glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Unable to Create Framebuffer");
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		GX_ENGINE_ASSERT(m_DepthMap != nullptr && RenderDevice::Get().CheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Unable to Create Framebuffer");
+		RenderDevice::Get().BindFramebuffer(GL_FRAMEBUFFER, 0);
 	}
 
 	void FrameBuffer::Bind() const
 	{
 		GX_PROFILE_FUNCTION()
 
-		glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
+		RenderDevice::Get().BindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
 	}
 
 	void FrameBuffer::UnBind() const
 	{
 		GX_PROFILE_FUNCTION()
 
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		RenderDevice::Get().BindFramebuffer(GL_FRAMEBUFFER, 0);
 	}
 
 	void FrameBuffer::BindDepthMap(unsigned int slot) const
@@ -62,6 +63,6 @@ namespace GraphX
 	{
 		GX_PROFILE_FUNCTION()
 
-		glDeleteFramebuffers(1, &m_RendererID);
+		RenderDevice::Get().DeleteFramebuffers(1, &m_RendererID);
 	}
 }
\ No newline at end of file
@@ -1,65 +1,74 @@
 #include "pch.h"
 #include "IndexBuffer.h"
 #include "GL/glew.h"
+#include "Device/RenderDevice.h"
+
+#include <algorithm>
+#include <limits>
 
 namespace GraphX
 {
 	IndexBuffer::IndexBuffer(const uint32_t* data, uint32_t count)
-		: RendererAsset(), m_Count(count)
+		: RendererAsset(), m_Count(count), m_IndexType(SelectIndexType(count ? *std::max_element(data, data + count) : 0))
 	{
 		GX_PROFILE_FUNCTION()
 
-		glGenBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_Count * sizeof(uint32_t), data, GL_STATIC_DRAW);
+		const void* Indices = PrepareData(data, m_Count);
+
+		RenderDevice::Get().GenBuffers(1, &m_RendererID);
+		RenderDevice::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+		RenderDevice::Get().BufferData(GL_ELEMENT_ARRAY_BUFFER, m_Count * GetIndexSize(), Indices, GL_STATIC_DRAW);
 
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		RenderDevice::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+		// Static indices are not uploaded again
+		m_NarrowedIndices = std::vector<uint16_t>();
 	}
 
-	IndexBuffer::IndexBuffer(const uint32_t count)
-		: RendererAsset(), m_Count(count)
+	IndexBuffer::IndexBuffer(const uint32_t count, IndexType Type)
+		: RendererAsset(), m_Count(count), m_IndexType(Type)
 	{
 		GX_PROFILE_FUNCTION()
 
-		glGenBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_Count * sizeof(uint32_t), nullptr, GL_DYNAMIC_DRAW);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		RenderDevice::Get().GenBuffers(1, &m_RendererID);
+		RenderDevice::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+		RenderDevice::Get().BufferData(GL_ELEMENT_ARRAY_BUFFER, m_Count * GetIndexSize(), nullptr, GL_DYNAMIC_DRAW);
+		RenderDevice::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 	}
 
 	IndexBuffer::IndexBuffer(const IndexBuffer& Other)
-		: RendererAsset(), m_Count(Other.m_Count)
+		: RendererAsset(), m_Count(Other.m_Count), m_IndexType(Other.m_IndexType)
 	{
 		GX_PROFILE_FUNCTION()
 
 		// Bind source buffer
-		glBindBuffer(GL_COPY_READ_BUFFER, Other.m_RendererID);
+		RenderDevice::Get().BindBuffer(GL_COPY_READ_BUFFER, Other.m_RendererID);
 
 		// Create the new buffer (data not specified)
-		glGenBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_Count * sizeof(unsigned int), nullptr, GL_STATIC_DRAW);
+		RenderDevice::Get().GenBuffers(1, &m_RendererID);
+		RenderDevice::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+		RenderDevice::Get().BufferData(GL_ELEMENT_ARRAY_BUFFER, m_Count * GetIndexSize(), nullptr, GL_STATIC_DRAW);
 
 		// Copy data from the source buffer
-		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_ELEMENT_ARRAY_BUFFER, 0, 0, m_Count * sizeof(unsigned int));
+		RenderDevice::Get().CopyBufferSubData(GL_COPY_READ_BUFFER, GL_ELEMENT_ARRAY_BUFFER, 0, 0, m_Count * GetIndexSize());
 
 		// Unbind
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		RenderDevice::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		RenderDevice::Get().BindBuffer(GL_COPY_READ_BUFFER, 0);
 	}
 
 	void IndexBuffer::Bind() const
 	{
 		GX_PROFILE_FUNCTION()
 
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+		RenderDevice::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
 	}
 
 	void IndexBuffer::UnBind() const
 	{
 		GX_PROFILE_FUNCTION()
 
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		RenderDevice::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 	}
 
 	void IndexBuffer::SetData(const uint32_t* data, uint32_t count)
@@ -73,17 +82,44 @@ namespace GraphX
 
 		GX_ENGINE_ASSERT(count - offset <= m_Count, "Data not provided properly");
 
-		glBindVertexArray(0);	// To make sure buffer doesn't get bound to other vaos'
+		const void* Indices = PrepareData(data, count);
+
+		RenderDevice::Get().BindVertexArray(0);	// To make sure buffer doesn't get bound to other vaos'
+
+		RenderDevice::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+		RenderDevice::Get().BufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset * GetIndexSize(), count * GetIndexSize(), Indices);
+		RenderDevice::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	}
+
+	uint32_t IndexBuffer::GetDrawType() const
+	{
+		return m_IndexType == IndexType::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+	}
+
+	IndexType IndexBuffer::SelectIndexType(uint32_t MaxIndex)
+	{
+		return MaxIndex <= std::numeric_limits<uint16_t>::max() ? IndexType::UInt16 : IndexType::UInt32;
+	}
+
+	const void* IndexBuffer::PrepareData(const uint32_t* data, uint32_t count)
+	{
+		if (m_IndexType == IndexType::UInt32 || data == nullptr)
+			return data;
+
+		m_NarrowedIndices.resize(count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			GX_ENGINE_ASSERT(data[i] <= std::numeric_limits<uint16_t>::max(), "Index doesn't fit in a 16 bit index buffer");
+			m_NarrowedIndices[i] = (uint16_t)data[i];
+		}
 
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
-		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset * sizeof(uint32_t), count * sizeof(uint32_t), data);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		return m_NarrowedIndices.data();
 	}
 
 	IndexBuffer::~IndexBuffer()
 	{
 		GX_PROFILE_FUNCTION()
 
-		glDeleteBuffers(1, &m_RendererID);
+		RenderDevice::Get().DeleteBuffers(1, &m_RendererID);
 	}
 }
\ No newline at end of file
@@ -4,16 +4,22 @@
 
 namespace GraphX
 {
-	// NOTE: GraphX only support 32-bit index buffers
+	/* Size of the indices stored in an index buffer (Indices are always provided as 32 bit, and narrowed when uploaded) */
+	enum class IndexType : uint8_t
+	{
+		UInt16,
+		UInt32
+	};
+
 	class IndexBuffer
 		: public RendererAsset
 	{
 	public:
-		/* data is the collection of indices and size is the size of collection in bytes */
+		/* data is the collection of indices and count is the number of indices (Stored as 16 bit indices, if all of them fit) */
 		IndexBuffer(const uint32_t* data, uint32_t count);
 
-		/* Creates an empty index buffer (data to be specified using SetData() )*/
-		IndexBuffer(const uint32_t count);
+		/* Creates an empty index buffer of the given type (data to be specified using SetData() )*/
+		IndexBuffer(const uint32_t count, IndexType Type = IndexType::UInt32);
 
 		/* Copy Construct an index buffer */
 		IndexBuffer(const IndexBuffer& Other);
@@ -38,8 +44,30 @@ namespace GraphX
 		/* Returns the count */
 		uint32_t GetCount() const { return m_Count; }
 
+		/* Returns the type of the indices stored in the buffer */
+		inline IndexType GetIndexType() const { return m_IndexType; }
+
+		/* Returns the size of an index in bytes */
+		inline uint32_t GetIndexSize() const { return m_IndexType == IndexType::UInt16 ? sizeof(uint16_t) : sizeof(uint32_t); }
+
+		/* Returns the type of the indices, for the draw calls (GL_UNSIGNED_SHORT / GL_UNSIGNED_INT) */
+		uint32_t GetDrawType() const;
+
+		/* Returns the smallest index type which can store the index */
+		static IndexType SelectIndexType(uint32_t MaxIndex);
+
+	private:
+		/* Returns the indices in the type of the buffer (16 bit indices are narrowed in to the staging storage) */
+		const void* PrepareData(const uint32_t* data, uint32_t count);
+
 	private:
 		/* # of primitives to be drawn */
 		uint32_t m_Count;
+
+		/* Type of the indices stored in the buffer */
+		IndexType m_IndexType;
+
+		/* 16 bit copy of the indices being uploaded (Kept around, since the batches upload their indices every frame) */
+		std::vector<uint16_t> m_NarrowedIndices;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "pch.h"
+#include "GL/glew.h"
+#include "Device/RenderDevice.h"
+#include "TextureBuffer.h"
+
+namespace GraphX
+{
+	TextureBuffer::TextureBuffer(uint32_t InternalFormat, uint32_t size)
+		: RendererAsset(), m_TextureID(0), m_BufferSize(size), m_InternalFormat(InternalFormat)
+	{
+		GX_PROFILE_FUNCTION()
+
+		RenderDevice::Get().GenBuffers(1, &m_RendererID);
+		RenderDevice::Get().BindBuffer(GL_TEXTURE_BUFFER, m_RendererID);
+		RenderDevice::Get().BufferData(GL_TEXTURE_BUFFER, m_BufferSize, nullptr, GL_DYNAMIC_DRAW);
+		RenderDevice::Get().BindBuffer(GL_TEXTURE_BUFFER, 0);
+
+		RenderDevice::Get().GenTextures(1, &m_TextureID);
+		RenderDevice::Get().BindTexture(GL_TEXTURE_BUFFER, m_TextureID);
+		RenderDevice::Get().TexBuffer(GL_TEXTURE_BUFFER, m_InternalFormat, m_RendererID);
+		RenderDevice::Get().BindTexture(GL_TEXTURE_BUFFER, 0);
+	}
+
+	void TextureBuffer::Bind(uint32_t slot) const
+	{
+		GX_PROFILE_FUNCTION()
+
+		RenderDevice::Get().ActiveTexture(GL_TEXTURE0 + slot);
+		RenderDevice::Get().BindTexture(GL_TEXTURE_BUFFER, m_TextureID);
+	}
+
+	void TextureBuffer::UnBind() const
+	{
+		GX_PROFILE_FUNCTION()
+
+		RenderDevice::Get().BindTexture(GL_TEXTURE_BUFFER, 0);
+	}
+
+	void TextureBuffer::SetData(const void* data, uint32_t size)
+	{
+		GX_PROFILE_FUNCTION()
+
+		RenderDevice::Get().BindBuffer(GL_TEXTURE_BUFFER, m_RendererID);
+
+		if (size > m_BufferSize)
+		{
+			// Grow the buffer (The buffer texture needs to be attached again for the new storage)
+			m_BufferSize = size;
+			RenderDevice::Get().BufferData(GL_TEXTURE_BUFFER, m_BufferSize, data, GL_DYNAMIC_DRAW);
+
+			RenderDevice::Get().BindTexture(GL_TEXTURE_BUFFER, m_TextureID);
+			RenderDevice::Get().TexBuffer(GL_TEXTURE_BUFFER, m_InternalFormat, m_RendererID);
+			RenderDevice::Get().BindTexture(GL_TEXTURE_BUFFER, 0);
+		}
+		else if (size > 0)
+			RenderDevice::Get().BufferSubData(GL_TEXTURE_BUFFER, 0, size, data);
+
+		RenderDevice::Get().BindBuffer(GL_TEXTURE_BUFFER, 0);
+	}
+
+	TextureBuffer::~TextureBuffer()
+	{
+		GX_PROFILE_FUNCTION()
+
+		RenderDevice::Get().DeleteTextures(1, &m_TextureID);
+		RenderDevice::Get().DeleteBuffers(1, &m_RendererID);
+	}
+}
\ No newline at end of file
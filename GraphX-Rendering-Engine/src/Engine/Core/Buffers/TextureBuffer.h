@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Engine/Core/RendererAsset.h"
+
+namespace GraphX
+{
+	/* Buffer accessed in the shaders as a buffer texture (samplerBuffer) */
+	class TextureBuffer
+		: public RendererAsset
+	{
+	public:
+		/**
+		* @param InternalFormat Format of the texels in the buffer (eg. GL_RGBA32F)
+		* @param size Initial size (in bytes) of the buffer
+		*/
+		TextureBuffer(uint32_t InternalFormat, uint32_t size = 0);
+
+		/* Bind the buffer texture to the texture slot */
+		void Bind(uint32_t slot = 0) const;
+
+		/* Un Bind the buffer texture */
+		void UnBind() const;
+
+		/* Sets new data for the buffer (buffer is grown if the data does not fit) */
+		void SetData(const void* data, uint32_t size);
+
+		/* Returns the size (in bytes) of the buffer */
+		inline uint32_t GetSize() const { return m_BufferSize; }
+
+		~TextureBuffer();
+
+	private:
+		/* Texture used to access the buffer in the shaders */
+		uint32_t m_TextureID;
+
+		/* Total Size (in bytes) of the buffer */
+		uint32_t m_BufferSize;
+
+		/* Format of the texels in the buffer */
+		uint32_t m_InternalFormat;
+	};
+}
\ No newline at end of file
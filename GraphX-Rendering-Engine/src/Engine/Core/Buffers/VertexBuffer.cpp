@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "GL/glew.h"
+#include "Device/RenderDevice.h"
 #include "VertexBuffer.h"
 
 namespace GraphX
@@ -9,11 +10,11 @@ namespace GraphX
 	{
 		GX_PROFILE_FUNCTION()
 
-		glGenBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ARRAY_BUFFER, m_BufferSize, data, GL_STATIC_DRAW);
+		RenderDevice::Get().GenBuffers(1, &m_RendererID);
+		RenderDevice::Get().BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+		RenderDevice::Get().BufferData(GL_ARRAY_BUFFER, m_BufferSize, data, GL_STATIC_DRAW);
 
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		RenderDevice::Get().BindBuffer(GL_ARRAY_BUFFER, 0);
 	}
 
 	VertexBuffer::VertexBuffer(uint32_t size)
@@ -21,11 +22,11 @@ namespace GraphX
 	{
 		GX_PROFILE_FUNCTION()
 
-		glGenBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ARRAY_BUFFER, m_BufferSize, nullptr, GL_DYNAMIC_DRAW);
+		RenderDevice::Get().GenBuffers(1, &m_RendererID);
+		RenderDevice::Get().BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+		RenderDevice::Get().BufferData(GL_ARRAY_BUFFER, m_BufferSize, nullptr, GL_DYNAMIC_DRAW);
 
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		RenderDevice::Get().BindBuffer(GL_ARRAY_BUFFER, 0);
 	}
 
 	VertexBuffer::VertexBuffer(const VertexBuffer& Other)
@@ -34,33 +35,33 @@ namespace GraphX
 		GX_PROFILE_FUNCTION()
 
 		// Bind source buffer
-		glBindBuffer(GL_COPY_READ_BUFFER, Other.m_RendererID);
+		RenderDevice::Get().BindBuffer(GL_COPY_READ_BUFFER, Other.m_RendererID);
 
 		// Create the new buffer (data not specified)
-		glGenBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ARRAY_BUFFER, m_BufferSize, nullptr, GL_STATIC_DRAW);
+		RenderDevice::Get().GenBuffers(1, &m_RendererID);
+		RenderDevice::Get().BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+		RenderDevice::Get().BufferData(GL_ARRAY_BUFFER, m_BufferSize, nullptr, GL_STATIC_DRAW);
 
 		// Copy data from the source buffer
-		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_ARRAY_BUFFER, 0, 0, m_BufferSize);
+		RenderDevice::Get().CopyBufferSubData(GL_COPY_READ_BUFFER, GL_ARRAY_BUFFER, 0, 0, m_BufferSize);
 
 		// Unbind
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		RenderDevice::Get().BindBuffer(GL_ARRAY_BUFFER, 0);
+		RenderDevice::Get().BindBuffer(GL_COPY_READ_BUFFER, 0);
 	}
 
 	void VertexBuffer::Bind() const
 	{
 		GX_PROFILE_FUNCTION()
 
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+		RenderDevice::Get().BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
 	}
 
 	void VertexBuffer::UnBind() const
 	{
 		GX_PROFILE_FUNCTION()
 
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		RenderDevice::Get().BindBuffer(GL_ARRAY_BUFFER, 0);
 	}
 
 	void VertexBuffer::SetData(const void* data, uint32_t size)
@@ -74,17 +75,17 @@ namespace GraphX
 
 		GX_ENGINE_ASSERT(size - offset <= m_BufferSize, "Data not provided properly")
 
-		glBindVertexArray(0);	// To make sure buffer doesn't get bound to other vaos'
+		RenderDevice::Get().BindVertexArray(0);	// To make sure buffer doesn't get bound to other vaos'
 
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		RenderDevice::Get().BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+		RenderDevice::Get().BufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+		RenderDevice::Get().BindBuffer(GL_ARRAY_BUFFER, 0);
 	}
 
 	VertexBuffer::~VertexBuffer()
 	{
 		GX_PROFILE_FUNCTION()
 
-		glDeleteBuffers(1, &m_RendererID);
+		RenderDevice::Get().DeleteBuffers(1, &m_RendererID);
 	}
 }
\ No newline at end of file
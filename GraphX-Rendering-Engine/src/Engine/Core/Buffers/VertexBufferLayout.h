@@ -5,7 +5,10 @@ namespace GraphX
 	/* Data types for the buffers (To Decouple Engine Implementation from specific API Implementations) */
 	enum class BufferDataType
 	{
-		None = 0, Float, Float2, Float3, Float4, Int, Int2, Int3, Int4, UInt, Bool, Mat3, Mat4
+		None = 0, Float, Float2, Float3, Float4, Int, Int2, Int3, Int4, UInt, Bool, Mat3, Mat4,
+		
+		/* Compact types for packed vertices */
+		Half2, Half4, UByte2, UByte4, UShort, UShort2, UShort4
 	};
 
 	/* Returns the size of the Buffer Data Type */
@@ -25,12 +28,41 @@ namespace GraphX
 			case BufferDataType::Bool:		return 1;
 			case BufferDataType::Mat3:		return 4 * 3 * 3;
 			case BufferDataType::Mat4:		return 4 * 4 * 4;
+			case BufferDataType::Half2:		return 2 * 2;
+			case BufferDataType::Half4:		return 2 * 4;
+			case BufferDataType::UByte2:	return 1 * 2;
+			case BufferDataType::UByte4:	return 1 * 4;
+			case BufferDataType::UShort:	return 2;
+			case BufferDataType::UShort2:	return 2 * 2;
+			case BufferDataType::UShort4:	return 2 * 4;
 		}
 
 		GX_ENGINE_ASSERT(false, "Unknown Buffer Data Type");
 		return 0;
 	}
 
+	/* Returns whether the Buffer Data Type stores integers */
+	static bool IsIntegerBufferDataType(BufferDataType Type)
+	{
+		switch (Type)
+		{
+			case BufferDataType::Int:
+			case BufferDataType::Int2:
+			case BufferDataType::Int3:
+			case BufferDataType::Int4:
+			case BufferDataType::UInt:
+			case BufferDataType::Bool:
+			case BufferDataType::UByte2:
+			case BufferDataType::UByte4:
+			case BufferDataType::UShort:
+			case BufferDataType::UShort2:
+			case BufferDataType::UShort4:
+				return true;
+		}
+
+		return false;
+	}
+
 	struct BufferLayoutElement
 	{
 		BufferDataType Type;
@@ -38,11 +70,15 @@ namespace GraphX
 		unsigned int Offset;
 		bool Normalised;
 
+		/* @Param normalised - Integer data is converted to [0, 1] floats in the shader, otherwise it is read as integers */
 		BufferLayoutElement(BufferDataType type, bool normalised = false)
 			: Type(type), Size(GetBufferDataTypeSize(type)), Offset(0), Normalised(normalised)
 		{
 		}
 
+		/* Whether the attribute should be read as an integer (and not converted to float) in the shader */
+		bool IsInteger() const { return IsIntegerBufferDataType(Type) && !Normalised; }
+
 		int GetComponentCount() const
 		{
 			switch (Type)
@@ -59,6 +95,13 @@ namespace GraphX
 				case BufferDataType::Bool:		return 1;
 				case BufferDataType::Mat3:		return 3 * 3;
 				case BufferDataType::Mat4:		return 4 * 4;
+				case BufferDataType::Half2:		return 2;
+				case BufferDataType::Half4:		return 4;
+				case BufferDataType::UByte2:	return 2;
+				case BufferDataType::UByte4:	return 4;
+				case BufferDataType::UShort:	return 1;
+				case BufferDataType::UShort2:	return 2;
+				case BufferDataType::UShort4:	return 4;
 			}
 
 			GX_ENGINE_ASSERT(false, "Unknown Buffer Data Type");
@@ -0,0 +1,501 @@
+#include "pch.h"
+#include "GLRenderDevice.h"
+#include "GL/glew.h"
+
+namespace GraphX
+{
+	/****** Buffers ******/
+
+	void GLRenderDevice::GenBuffers(int32_t Count, uint32_t* IDs)
+	{
+		glGenBuffers(Count, IDs);
+	}
+
+	void GLRenderDevice::DeleteBuffers(int32_t Count, const uint32_t* IDs)
+	{
+		glDeleteBuffers(Count, IDs);
+	}
+
+	void GLRenderDevice::BindBuffer(uint32_t Target, uint32_t ID)
+	{
+		glBindBuffer(Target, ID);
+	}
+
+	void GLRenderDevice::BufferData(uint32_t Target, intptr_t Size, const void* Data, uint32_t Usage)
+	{
+		glBufferData(Target, Size, Data, Usage);
+	}
+
+	void GLRenderDevice::BufferSubData(uint32_t Target, intptr_t Offset, intptr_t Size, const void* Data)
+	{
+		glBufferSubData(Target, Offset, Size, Data);
+	}
+
+	void GLRenderDevice::CopyBufferSubData(uint32_t ReadTarget, uint32_t WriteTarget, intptr_t ReadOffset, intptr_t WriteOffset, intptr_t Size)
+	{
+		glCopyBufferSubData(ReadTarget, WriteTarget, ReadOffset, WriteOffset, Size);
+	}
+
+	void* GLRenderDevice::MapBufferRange(uint32_t Target, intptr_t Offset, intptr_t Length, uint32_t Access)
+	{
+		return glMapBufferRange(Target, Offset, Length, Access);
+	}
+
+	bool GLRenderDevice::UnmapBuffer(uint32_t Target)
+	{
+		return glUnmapBuffer(Target) == GL_TRUE;
+	}
+
+	/****** Vertex Arrays ******/
+
+	void GLRenderDevice::GenVertexArrays(int32_t Count, uint32_t* IDs)
+	{
+		glGenVertexArrays(Count, IDs);
+	}
+
+	void GLRenderDevice::DeleteVertexArrays(int32_t Count, const uint32_t* IDs)
+	{
+		glDeleteVertexArrays(Count, IDs);
+	}
+
+	void GLRenderDevice::BindVertexArray(uint32_t ID)
+	{
+		glBindVertexArray(ID);
+	}
+
+	void GLRenderDevice::EnableVertexAttribArray(uint32_t Index)
+	{
+		glEnableVertexAttribArray(Index);
+	}
+
+	void GLRenderDevice::VertexAttribPointer(uint32_t Index, int32_t Size, uint32_t Type, bool Normalised, int32_t Stride, const void* Offset)
+	{
+		glVertexAttribPointer(Index, Size, Type, Normalised ? GL_TRUE : GL_FALSE, Stride, Offset);
+	}
+
+	void GLRenderDevice::VertexAttribIPointer(uint32_t Index, int32_t Size, uint32_t Type, int32_t Stride, const void* Offset)
+	{
+		glVertexAttribIPointer(Index, Size, Type, Stride, Offset);
+	}
+
+	void GLRenderDevice::VertexAttribDivisor(uint32_t Index, uint32_t Divisor)
+	{
+		glVertexAttribDivisor(Index, Divisor);
+	}
+
+	/****** Textures ******/
+
+	void GLRenderDevice::GenTextures(int32_t Count, uint32_t* IDs)
+	{
+		glGenTextures(Count, IDs);
+	}
+
+	void GLRenderDevice::DeleteTextures(int32_t Count, const uint32_t* IDs)
+	{
+		glDeleteTextures(Count, IDs);
+	}
+
+	void GLRenderDevice::BindTexture(uint32_t Target, uint32_t ID)
+	{
+		glBindTexture(Target, ID);
+	}
+
+	void GLRenderDevice::ActiveTexture(uint32_t Unit)
+	{
+		glActiveTexture(Unit);
+	}
+
+	void GLRenderDevice::BindTextureUnit(uint32_t Unit, uint32_t ID)
+	{
+		glBindTextureUnit(Unit, ID);
+	}
+
+	void GLRenderDevice::TexParameteri(uint32_t Target, uint32_t Name, int32_t Value)
+	{
+		glTexParameteri(Target, Name, Value);
+	}
+
+	void GLRenderDevice::TexParameterf(uint32_t Target, uint32_t Name, float Value)
+	{
+		glTexParameterf(Target, Name, Value);
+	}
+
+	void GLRenderDevice::TextureParameteri(uint32_t Texture, uint32_t Name, int32_t Value)
+	{
+		glTextureParameteri(Texture, Name, Value);
+	}
+
+	void GLRenderDevice::TextureParameterfv(uint32_t Texture, uint32_t Name, const float* Values)
+	{
+		glTextureParameterfv(Texture, Name, Values);
+	}
+
+	void GLRenderDevice::TexImage2D(uint32_t Target, int32_t Level, int32_t InternalFormat, int32_t Width, int32_t Height, int32_t Border, uint32_t Format, uint32_t Type, const void* Data)
+	{
+		glTexImage2D(Target, Level, InternalFormat, Width, Height, Border, Format, Type, Data);
+	}
+
+	void GLRenderDevice::CompressedTexImage2D(uint32_t Target, int32_t Level, uint32_t InternalFormat, int32_t Width, int32_t Height, int32_t Border, int32_t ImageSize, const void* Data)
+	{
+		glCompressedTexImage2D(Target, Level, InternalFormat, Width, Height, Border, ImageSize, Data);
+	}
+
+	void GLRenderDevice::TexSubImage2D(uint32_t Target, int32_t Level, int32_t XOffset, int32_t YOffset, int32_t Width, int32_t Height, uint32_t Format, uint32_t Type, const void* Data)
+	{
+		glTexSubImage2D(Target, Level, XOffset, YOffset, Width, Height, Format, Type, Data);
+	}
+
+	void GLRenderDevice::TexStorage3D(uint32_t Target, int32_t Levels, uint32_t InternalFormat, int32_t Width, int32_t Height, int32_t Depth)
+	{
+		glTexStorage3D(Target, Levels, InternalFormat, Width, Height, Depth);
+	}
+
+	void GLRenderDevice::TexSubImage3D(uint32_t Target, int32_t Level, int32_t XOffset, int32_t YOffset, int32_t ZOffset, int32_t Width, int32_t Height, int32_t Depth, uint32_t Format, uint32_t Type, const void* Data)
+	{
+		glTexSubImage3D(Target, Level, XOffset, YOffset, ZOffset, Width, Height, Depth, Format, Type, Data);
+	}
+
+	void GLRenderDevice::TexBuffer(uint32_t Target, uint32_t InternalFormat, uint32_t Buffer)
+	{
+		glTexBuffer(Target, InternalFormat, Buffer);
+	}
+
+	void GLRenderDevice::GenerateMipmap(uint32_t Target)
+	{
+		glGenerateMipmap(Target);
+	}
+
+	void GLRenderDevice::PixelStorei(uint32_t Name, int32_t Value)
+	{
+		glPixelStorei(Name, Value);
+	}
+
+	void GLRenderDevice::CopyImageSubData(uint32_t SrcName, uint32_t SrcTarget, int32_t SrcLevel, int32_t SrcX, int32_t SrcY, int32_t SrcZ, uint32_t DstName, uint32_t DstTarget, int32_t DstLevel, int32_t DstX, int32_t DstY, int32_t DstZ, int32_t Width, int32_t Height, int32_t Depth)
+	{
+		glCopyImageSubData(SrcName, SrcTarget, SrcLevel, SrcX, SrcY, SrcZ, DstName, DstTarget, DstLevel, DstX, DstY, DstZ, Width, Height, Depth);
+	}
+
+	void GLRenderDevice::GetTexImage(uint32_t Target, int32_t Level, uint32_t Format, uint32_t Type, void* Pixels)
+	{
+		glGetTexImage(Target, Level, Format, Type, Pixels);
+	}
+
+	/****** Frame Buffers ******/
+
+	void GLRenderDevice::GenFramebuffers(int32_t Count, uint32_t* IDs)
+	{
+		glGenFramebuffers(Count, IDs);
+	}
+
+	void GLRenderDevice::DeleteFramebuffers(int32_t Count, const uint32_t* IDs)
+	{
+		glDeleteFramebuffers(Count, IDs);
+	}
+
+	void GLRenderDevice::BindFramebuffer(uint32_t Target, uint32_t ID)
+	{
+		glBindFramebuffer(Target, ID);
+	}
+
+	void GLRenderDevice::FramebufferTexture2D(uint32_t Target, uint32_t Attachment, uint32_t TextureTarget, uint32_t Texture, int32_t Level)
+	{
+		glFramebufferTexture2D(Target, Attachment, TextureTarget, Texture, Level);
+	}
+
+	void GLRenderDevice::FramebufferTextureLayer(uint32_t Target, uint32_t Attachment, uint32_t Texture, int32_t Level, int32_t Layer)
+	{
+		glFramebufferTextureLayer(Target, Attachment, Texture, Level, Layer);
+	}
+
+	void GLRenderDevice::DrawBuffer(uint32_t Buffer)
+	{
+		glDrawBuffer(Buffer);
+	}
+
+	void GLRenderDevice::ReadBuffer(uint32_t Buffer)
+	{
+		glReadBuffer(Buffer);
+	}
+
+	uint32_t GLRenderDevice::CheckFramebufferStatus(uint32_t Target)
+	{
+		return glCheckFramebufferStatus(Target);
+	}
+
+	/****** Shaders ******/
+
+	uint32_t GLRenderDevice::CreateShader(uint32_t Type)
+	{
+		return glCreateShader(Type);
+	}
+
+	void GLRenderDevice::ShaderSource(uint32_t Shader, int32_t Count, const char* const* Sources, const int32_t* Lengths)
+	{
+		glShaderSource(Shader, Count, Sources, Lengths);
+	}
+
+	void GLRenderDevice::CompileShader(uint32_t Shader)
+	{
+		glCompileShader(Shader);
+	}
+
+	void GLRenderDevice::GetShaderiv(uint32_t Shader, uint32_t Name, int32_t* Value)
+	{
+		glGetShaderiv(Shader, Name, Value);
+	}
+
+	void GLRenderDevice::GetShaderInfoLog(uint32_t Shader, int32_t MaxLength, int32_t* Length, char* InfoLog)
+	{
+		glGetShaderInfoLog(Shader, MaxLength, Length, InfoLog);
+	}
+
+	void GLRenderDevice::DeleteShader(uint32_t Shader)
+	{
+		glDeleteShader(Shader);
+	}
+
+	uint32_t GLRenderDevice::CreateProgram()
+	{
+		return glCreateProgram();
+	}
+
+	void GLRenderDevice::AttachShader(uint32_t Program, uint32_t Shader)
+	{
+		glAttachShader(Program, Shader);
+	}
+
+	void GLRenderDevice::LinkProgram(uint32_t Program)
+	{
+		glLinkProgram(Program);
+	}
+
+	void GLRenderDevice::ValidateProgram(uint32_t Program)
+	{
+		glValidateProgram(Program);
+	}
+
+	void GLRenderDevice::GetProgramiv(uint32_t Program, uint32_t Name, int32_t* Value)
+	{
+		glGetProgramiv(Program, Name, Value);
+	}
+
+	void GLRenderDevice::GetProgramInfoLog(uint32_t Program, int32_t MaxLength, int32_t* Length, char* InfoLog)
+	{
+		glGetProgramInfoLog(Program, MaxLength, Length, InfoLog);
+	}
+
+	void GLRenderDevice::ProgramParameteri(uint32_t Program, uint32_t Name, int32_t Value)
+	{
+		glProgramParameteri(Program, Name, Value);
+	}
+
+	void GLRenderDevice::GetProgramBinary(uint32_t Program, int32_t BufferSize, int32_t* Length, uint32_t* BinaryFormat, void* Binary)
+	{
+		glGetProgramBinary(Program, BufferSize, Length, BinaryFormat, Binary);
+	}
+
+	void GLRenderDevice::ProgramBinary(uint32_t Program, uint32_t BinaryFormat, const void* Binary, int32_t Length)
+	{
+		glProgramBinary(Program, BinaryFormat, Binary, Length);
+	}
+
+	void GLRenderDevice::MaxShaderCompilerThreads(uint32_t Count)
+	{
+		// The KHR and the ARB versions of the extension share the enums and the behaviour
+		if (GLEW_KHR_parallel_shader_compile)
+			glMaxShaderCompilerThreadsKHR(Count);
+		else if (GLEW_ARB_parallel_shader_compile)
+			glMaxShaderCompilerThreadsARB(Count);
+	}
+
+	void GLRenderDevice::DeleteProgram(uint32_t Program)
+	{
+		glDeleteProgram(Program);
+	}
+
+	void GLRenderDevice::UseProgram(uint32_t Program)
+	{
+		glUseProgram(Program);
+	}
+
+	int32_t GLRenderDevice::GetUniformLocation(uint32_t Program, const char* Name)
+	{
+		return glGetUniformLocation(Program, Name);
+	}
+
+	void GLRenderDevice::Uniform1i(int32_t Location, int32_t V0)
+	{
+		glUniform1i(Location, V0);
+	}
+
+	void GLRenderDevice::Uniform1iv(int32_t Location, int32_t Count, const int32_t* Values)
+	{
+		glUniform1iv(Location, Count, Values);
+	}
+
+	void GLRenderDevice::Uniform2i(int32_t Location, int32_t V0, int32_t V1)
+	{
+		glUniform2i(Location, V0, V1);
+	}
+
+	void GLRenderDevice::Uniform3i(int32_t Location, int32_t V0, int32_t V1, int32_t V2)
+	{
+		glUniform3i(Location, V0, V1, V2);
+	}
+
+	void GLRenderDevice::Uniform1f(int32_t Location, float V0)
+	{
+		glUniform1f(Location, V0);
+	}
+
+	void GLRenderDevice::Uniform2f(int32_t Location, float V0, float V1)
+	{
+		glUniform2f(Location, V0, V1);
+	}
+
+	void GLRenderDevice::Uniform3f(int32_t Location, float V0, float V1, float V2)
+	{
+		glUniform3f(Location, V0, V1, V2);
+	}
+
+	void GLRenderDevice::Uniform4f(int32_t Location, float V0, float V1, float V2, float V3)
+	{
+		glUniform4f(Location, V0, V1, V2, V3);
+	}
+
+	void GLRenderDevice::UniformMatrix3fv(int32_t Location, int32_t Count, bool Transpose, const float* Values)
+	{
+		glUniformMatrix3fv(Location, Count, Transpose ? GL_TRUE : GL_FALSE, Values);
+	}
+
+	void GLRenderDevice::UniformMatrix4fv(int32_t Location, int32_t Count, bool Transpose, const float* Values)
+	{
+		glUniformMatrix4fv(Location, Count, Transpose ? GL_TRUE : GL_FALSE, Values);
+	}
+
+	/****** Render State ******/
+
+	void GLRenderDevice::Enable(uint32_t Capability)
+	{
+		glEnable(Capability);
+	}
+
+	void GLRenderDevice::Disable(uint32_t Capability)
+	{
+		glDisable(Capability);
+	}
+
+	void GLRenderDevice::DepthMask(bool Flag)
+	{
+		glDepthMask(Flag ? GL_TRUE : GL_FALSE);
+	}
+
+	void GLRenderDevice::DepthFunc(uint32_t Func)
+	{
+		glDepthFunc(Func);
+	}
+
+	void GLRenderDevice::ColorMask(bool Red, bool Green, bool Blue, bool Alpha)
+	{
+		glColorMask(Red ? GL_TRUE : GL_FALSE, Green ? GL_TRUE : GL_FALSE, Blue ? GL_TRUE : GL_FALSE, Alpha ? GL_TRUE : GL_FALSE);
+	}
+
+	void GLRenderDevice::BlendFunc(uint32_t SrcFactor, uint32_t DstFactor)
+	{
+		glBlendFunc(SrcFactor, DstFactor);
+	}
+
+	void GLRenderDevice::BlendEquation(uint32_t Mode)
+	{
+		glBlendEquation(Mode);
+	}
+
+	void GLRenderDevice::CullFace(uint32_t Mode)
+	{
+		glCullFace(Mode);
+	}
+
+	void GLRenderDevice::Viewport(int32_t X, int32_t Y, int32_t Width, int32_t Height)
+	{
+		glViewport(X, Y, Width, Height);
+	}
+
+	void GLRenderDevice::ClearColor(float Red, float Green, float Blue, float Alpha)
+	{
+		glClearColor(Red, Green, Blue, Alpha);
+	}
+
+	void GLRenderDevice::Clear(uint32_t Mask)
+	{
+		glClear(Mask);
+	}
+
+	void GLRenderDevice::GetIntegerv(uint32_t Name, int32_t* Values)
+	{
+		glGetIntegerv(Name, Values);
+	}
+
+	void GLRenderDevice::GetFloatv(uint32_t Name, float* Values)
+	{
+		glGetFloatv(Name, Values);
+	}
+
+	const char* GLRenderDevice::GetString(uint32_t Name)
+	{
+		return (const char*)glGetString(Name);
+	}
+
+	/****** Draw Calls ******/
+
+	void GLRenderDevice::DrawArrays(uint32_t Mode, int32_t First, int32_t Count)
+	{
+		glDrawArrays(Mode, First, Count);
+	}
+
+	void GLRenderDevice::DrawArraysInstanced(uint32_t Mode, int32_t First, int32_t Count, int32_t InstanceCount)
+	{
+		glDrawArraysInstanced(Mode, First, Count, InstanceCount);
+	}
+
+	void GLRenderDevice::DrawElements(uint32_t Mode, int32_t Count, uint32_t Type, const void* Indices)
+	{
+		glDrawElements(Mode, Count, Type, Indices);
+	}
+
+	void GLRenderDevice::DrawElementsBaseVertex(uint32_t Mode, int32_t Count, uint32_t Type, const void* Indices, int32_t BaseVertex)
+	{
+		glDrawElementsBaseVertex(Mode, Count, Type, (void*)Indices, BaseVertex);
+	}
+
+	/****** Queries ******/
+
+	void GLRenderDevice::GenQueries(int32_t Count, uint32_t* IDs)
+	{
+		glGenQueries(Count, IDs);
+	}
+
+	void GLRenderDevice::DeleteQueries(int32_t Count, const uint32_t* IDs)
+	{
+		glDeleteQueries(Count, IDs);
+	}
+
+	void GLRenderDevice::QueryCounter(uint32_t ID, uint32_t Target)
+	{
+		glQueryCounter(ID, Target);
+	}
+
+	void GLRenderDevice::GetQueryObjectiv(uint32_t ID, uint32_t Name, int32_t* Value)
+	{
+		glGetQueryObjectiv(ID, Name, Value);
+	}
+
+	void GLRenderDevice::GetQueryObjectui64v(uint32_t ID, uint32_t Name, uint64_t* Value)
+	{
+		glGetQueryObjectui64v(ID, Name, Value);
+	}
+
+	void GLRenderDevice::GetInteger64v(uint32_t Name, int64_t* Value)
+	{
+		glGetInteger64v(Name, Value);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "RenderDevice.h"
+
+namespace GraphX
+{
+	/* Passes the commands straight to the OpenGL context current on the calling thread */
+	class GLRenderDevice
+		: public RenderDevice
+	{
+	public:
+		/****** Buffers ******/
+		virtual void GenBuffers(int32_t Count, uint32_t* IDs) override;
+		virtual void DeleteBuffers(int32_t Count, const uint32_t* IDs) override;
+		virtual void BindBuffer(uint32_t Target, uint32_t ID) override;
+		virtual void BufferData(uint32_t Target, intptr_t Size, const void* Data, uint32_t Usage) override;
+		virtual void BufferSubData(uint32_t Target, intptr_t Offset, intptr_t Size, const void* Data) override;
+		virtual void CopyBufferSubData(uint32_t ReadTarget, uint32_t WriteTarget, intptr_t ReadOffset, intptr_t WriteOffset, intptr_t Size) override;
+		virtual void* MapBufferRange(uint32_t Target, intptr_t Offset, intptr_t Length, uint32_t Access) override;
+		virtual bool UnmapBuffer(uint32_t Target) override;
+
+		/****** Vertex Arrays ******/
+		virtual void GenVertexArrays(int32_t Count, uint32_t* IDs) override;
+		virtual void DeleteVertexArrays(int32_t Count, const uint32_t* IDs) override;
+		virtual void BindVertexArray(uint32_t ID) override;
+		virtual void EnableVertexAttribArray(uint32_t Index) override;
+		virtual void VertexAttribPointer(uint32_t Index, int32_t Size, uint32_t Type, bool Normalised, int32_t Stride, const void* Offset) override;
+		virtual void VertexAttribIPointer(uint32_t Index, int32_t Size, uint32_t Type, int32_t Stride, const void* Offset) override;
+		virtual void VertexAttribDivisor(uint32_t Index, uint32_t Divisor) override;
+
+		/****** Textures ******/
+		virtual void GenTextures(int32_t Count, uint32_t* IDs) override;
+		virtual void DeleteTextures(int32_t Count, const uint32_t* IDs) override;
+		virtual void BindTexture(uint32_t Target, uint32_t ID) override;
+		virtual void ActiveTexture(uint32_t Unit) override;
+		virtual void BindTextureUnit(uint32_t Unit, uint32_t ID) override;
+		virtual void TexParameteri(uint32_t Target, uint32_t Name, int32_t Value) override;
+		virtual void TexParameterf(uint32_t Target, uint32_t Name, float Value) override;
+		virtual void TextureParameteri(uint32_t Texture, uint32_t Name, int32_t Value) override;
+		virtual void TextureParameterfv(uint32_t Texture, uint32_t Name, const float* Values) override;
+		virtual void TexImage2D(uint32_t Target, int32_t Level, int32_t InternalFormat, int32_t Width, int32_t Height, int32_t Border, uint32_t Format, uint32_t Type, const void* Data) override;
+		virtual void CompressedTexImage2D(uint32_t Target, int32_t Level, uint32_t InternalFormat, int32_t Width, int32_t Height, int32_t Border, int32_t ImageSize, const void* Data) override;
+		virtual void TexSubImage2D(uint32_t Target, int32_t Level, int32_t XOffset, int32_t YOffset, int32_t Width, int32_t Height, uint32_t Format, uint32_t Type, const void* Data) override;
+		virtual void TexStorage3D(uint32_t Target, int32_t Levels, uint32_t InternalFormat, int32_t Width, int32_t Height, int32_t Depth) override;
+		virtual void TexSubImage3D(uint32_t Target, int32_t Level, int32_t XOffset, int32_t YOffset, int32_t ZOffset, int32_t Width, int32_t Height, int32_t Depth, uint32_t Format, uint32_t Type, const void* Data) override;
+		virtual void TexBuffer(uint32_t Target, uint32_t InternalFormat, uint32_t Buffer) override;
+		virtual void GenerateMipmap(uint32_t Target) override;
+		virtual void PixelStorei(uint32_t Name, int32_t Value) override;
+		virtual void CopyImageSubData(uint32_t SrcName, uint32_t SrcTarget, int32_t SrcLevel, int32_t SrcX, int32_t SrcY, int32_t SrcZ, uint32_t DstName, uint32_t DstTarget, int32_t DstLevel, int32_t DstX, int32_t DstY, int32_t DstZ, int32_t Width, int32_t Height, int32_t Depth) override;
+		virtual void GetTexImage(uint32_t Target, int32_t Level, uint32_t Format, uint32_t Type, void* Pixels) override;
+
+		/****** Frame Buffers ******/
+		virtual void GenFramebuffers(int32_t Count, uint32_t* IDs) override;
+		virtual void DeleteFramebuffers(int32_t Count, const uint32_t* IDs) override;
+		virtual void BindFramebuffer(uint32_t Target, uint32_t ID) override;
+		virtual void FramebufferTexture2D(uint32_t Target, uint32_t Attachment, uint32_t TextureTarget, uint32_t Texture, int32_t Level) override;
+		virtual void FramebufferTextureLayer(uint32_t Target, uint32_t Attachment, uint32_t Texture, int32_t Level, int32_t Layer) override;
+		virtual void DrawBuffer(uint32_t Buffer) override;
+		virtual void ReadBuffer(uint32_t Buffer) override;
+		virtual uint32_t CheckFramebufferStatus(uint32_t Target) override;
+
+		/****** Shaders ******/
+		virtual uint32_t CreateShader(uint32_t Type) override;
+		virtual void ShaderSource(uint32_t Shader, int32_t Count, const char* const* Sources, const int32_t* Lengths) override;
+		virtual void CompileShader(uint32_t Shader) override;
+		virtual void GetShaderiv(uint32_t Shader, uint32_t Name, int32_t* Value) override;
+		virtual void GetShaderInfoLog(uint32_t Shader, int32_t MaxLength, int32_t* Length, char* InfoLog) override;
+		virtual void DeleteShader(uint32_t Shader) override;
+		virtual uint32_t CreateProgram() override;
+		virtual void AttachShader(uint32_t Program, uint32_t Shader) override;
+		virtual void LinkProgram(uint32_t Program) override;
+		virtual void ValidateProgram(uint32_t Program) override;
+		virtual void GetProgramiv(uint32_t Program, uint32_t Name, int32_t* Value) override;
+		virtual void GetProgramInfoLog(uint32_t Program, int32_t MaxLength, int32_t* Length, char* InfoLog) override;
+		virtual void ProgramParameteri(uint32_t Program, uint32_t Name, int32_t Value) override;
+		virtual void GetProgramBinary(uint32_t Program, int32_t BufferSize, int32_t* Length, uint32_t* BinaryFormat, void* Binary) override;
+		virtual void ProgramBinary(uint32_t Program, uint32_t BinaryFormat, const void* Binary, int32_t Length) override;
+		virtual void MaxShaderCompilerThreads(uint32_t Count) override;
+		virtual void DeleteProgram(uint32_t Program) override;
+		virtual void UseProgram(uint32_t Program) override;
+		virtual int32_t GetUniformLocation(uint32_t Program, const char* Name) override;
+		virtual void Uniform1i(int32_t Location, int32_t V0) override;
+		virtual void Uniform1iv(int32_t Location, int32_t Count, const int32_t* Values) override;
+		virtual void Uniform2i(int32_t Location, int32_t V0, int32_t V1) override;
+		virtual void Uniform3i(int32_t Location, int32_t V0, int32_t V1, int32_t V2) override;
+		virtual void Uniform1f(int32_t Location, float V0) override;
+		virtual void Uniform2f(int32_t Location, float V0, float V1) override;
+		virtual void Uniform3f(int32_t Location, float V0, float V1, float V2) override;
+		virtual void Uniform4f(int32_t Location, float V0, float V1, float V2, float V3) override;
+		virtual void UniformMatrix3fv(int32_t Location, int32_t Count, bool Transpose, const float* Values) override;
+		virtual void UniformMatrix4fv(int32_t Location, int32_t Count, bool Transpose, const float* Values) override;
+
+		/****** Render State ******/
+		virtual void Enable(uint32_t Capability) override;
+		virtual void Disable(uint32_t Capability) override;
+		virtual void DepthMask(bool Flag) override;
+		virtual void DepthFunc(uint32_t Func) override;
+		virtual void ColorMask(bool Red, bool Green, bool Blue, bool Alpha) override;
+		virtual void BlendFunc(uint32_t SrcFactor, uint32_t DstFactor) override;
+		virtual void BlendEquation(uint32_t Mode) override;
+		virtual void CullFace(uint32_t Mode) override;
+		virtual void Viewport(int32_t X, int32_t Y, int32_t Width, int32_t Height) override;
+		virtual void ClearColor(float Red, float Green, float Blue, float Alpha) override;
+		virtual void Clear(uint32_t Mask) override;
+		virtual void GetIntegerv(uint32_t Name, int32_t* Values) override;
+		virtual void GetFloatv(uint32_t Name, float* Values) override;
+		virtual const char* GetString(uint32_t Name) override;
+
+		/****** Draw Calls ******/
+		virtual void DrawArrays(uint32_t Mode, int32_t First, int32_t Count) override;
+		virtual void DrawArraysInstanced(uint32_t Mode, int32_t First, int32_t Count, int32_t InstanceCount) override;
+		virtual void DrawElements(uint32_t Mode, int32_t Count, uint32_t Type, const void* Indices) override;
+		virtual void DrawElementsBaseVertex(uint32_t Mode, int32_t Count, uint32_t Type, const void* Indices, int32_t BaseVertex) override;
+
+		/****** Queries ******/
+		virtual void GenQueries(int32_t Count, uint32_t* IDs) override;
+		virtual void DeleteQueries(int32_t Count, const uint32_t* IDs) override;
+		virtual void QueryCounter(uint32_t ID, uint32_t Target) override;
+		virtual void GetQueryObjectiv(uint32_t ID, uint32_t Name, int32_t* Value) override;
+		virtual void GetQueryObjectui64v(uint32_t ID, uint32_t Name, uint64_t* Value) override;
+		virtual void GetInteger64v(uint32_t Name, int64_t* Value) override;
+	};
+}
\ No newline at end of file
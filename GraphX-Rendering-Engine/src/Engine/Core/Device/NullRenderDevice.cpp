@@ -0,0 +1,724 @@
+#include "pch.h"
+#include "NullRenderDevice.h"
+#include "GL/glew.h"
+
+#include <algorithm>
+
+namespace GraphX
+{
+	/* Returns the size (in bytes) of a texel of the data passed to the texture uploads */
+	static uint64_t GetTexelSize(uint32_t Format, uint32_t Type)
+	{
+		uint64_t Components = 4;
+		switch (Format)
+		{
+			case GL_RED: case GL_RED_INTEGER: case GL_DEPTH_COMPONENT:	Components = 1; break;
+			case GL_RG: case GL_RG_INTEGER:								Components = 2; break;
+			case GL_RGB: case GL_BGR: case GL_RGB_INTEGER:				Components = 3; break;
+		}
+
+		switch (Type)
+		{
+			case GL_UNSIGNED_BYTE: case GL_BYTE:						return Components;
+			case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT:	return Components * 2;
+			default:													return Components * 4;
+		}
+	}
+
+	NullRenderDevice::NullRenderDevice()
+		: m_IsRecording(false), m_LastObjectID(0), m_LastUniformLocation(-1), m_ActiveTextureUnit(0), m_Program(0), m_VertexArray(0), m_Framebuffer(0), 
+		m_DepthMask(true), m_DepthFunc(GL_LESS), m_BlendFunc{ { GL_ONE, GL_ZERO } }, m_BlendEquation(GL_FUNC_ADD), m_CullFace(GL_BACK), m_ColorMask{ { true, true, true, true } }, m_Viewport{ { 0, 0, 0, 0 } }
+	{
+	}
+
+	void NullRenderDevice::ResetStats()
+	{
+		m_Stats = RenderDeviceStats();
+		m_RecordedCalls.clear();
+	}
+
+	void NullRenderDevice::Record(const char* Name, uint64_t Bytes)
+	{
+		m_Stats.Calls++;
+		m_Stats.BytesUploaded += Bytes;
+
+		if (m_IsRecording)
+			m_RecordedCalls.push_back({ Name, Bytes });
+	}
+
+	uint32_t NullRenderDevice::CreateObject()
+	{
+		m_Stats.ObjectsCreated++;
+		return ++m_LastObjectID;
+	}
+
+	uint32_t& NullRenderDevice::GetTextureBinding(uint32_t Unit, uint32_t Target)
+	{
+		return m_TextureBindings[((uint64_t)Unit << 32) | Target];
+	}
+
+	/****** Buffers ******/
+
+	void NullRenderDevice::GenBuffers(int32_t Count, uint32_t* IDs)
+	{
+		Record("GenBuffers");
+		for (int32_t i = 0; i < Count; i++)
+			IDs[i] = CreateObject();
+	}
+
+	void NullRenderDevice::DeleteBuffers(int32_t Count, const uint32_t* IDs)
+	{
+		Record("DeleteBuffers");
+
+		// Deleting a bound buffer reverts the binding to zero
+		for (int32_t i = 0; i < Count; i++)
+		{
+			for (auto& Binding : m_BufferBindings)
+			{
+				if (Binding.second == IDs[i])
+					Binding.second = 0;
+			}
+		}
+	}
+
+	void NullRenderDevice::BindBuffer(uint32_t Target, uint32_t ID)
+	{
+		Record("BindBuffer");
+		if (SetState(m_BufferBindings[Target], ID))
+			m_Stats.BufferBinds++;
+	}
+
+	void NullRenderDevice::BufferData(uint32_t Target, intptr_t Size, const void* Data, uint32_t Usage)
+	{
+		Record("BufferData", Data ? (uint64_t)Size : 0);
+	}
+
+	void NullRenderDevice::BufferSubData(uint32_t Target, intptr_t Offset, intptr_t Size, const void* Data)
+	{
+		Record("BufferSubData", (uint64_t)Size);
+	}
+
+	void NullRenderDevice::CopyBufferSubData(uint32_t ReadTarget, uint32_t WriteTarget, intptr_t ReadOffset, intptr_t WriteOffset, intptr_t Size)
+	{
+		// Copies stay on the GPU, nothing is uploaded
+		Record("CopyBufferSubData");
+	}
+
+	void* NullRenderDevice::MapBufferRange(uint32_t Target, intptr_t Offset, intptr_t Length, uint32_t Access)
+	{
+		Record("MapBufferRange");
+
+		m_MappedBuffer.resize((size_t)Length);
+		return m_MappedBuffer.data();
+	}
+
+	bool NullRenderDevice::UnmapBuffer(uint32_t Target)
+	{
+		Record("UnmapBuffer", m_MappedBuffer.size());
+
+		m_MappedBuffer.clear();
+		return true;
+	}
+
+	/****** Vertex Arrays ******/
+
+	void NullRenderDevice::GenVertexArrays(int32_t Count, uint32_t* IDs)
+	{
+		Record("GenVertexArrays");
+		for (int32_t i = 0; i < Count; i++)
+			IDs[i] = CreateObject();
+	}
+
+	void NullRenderDevice::DeleteVertexArrays(int32_t Count, const uint32_t* IDs)
+	{
+		Record("DeleteVertexArrays");
+		for (int32_t i = 0; i < Count; i++)
+		{
+			if (m_VertexArray == IDs[i])
+				m_VertexArray = 0;
+		}
+	}
+
+	void NullRenderDevice::BindVertexArray(uint32_t ID)
+	{
+		Record("BindVertexArray");
+		if (SetState(m_VertexArray, ID))
+			m_Stats.VertexArrayBinds++;
+	}
+
+	void NullRenderDevice::EnableVertexAttribArray(uint32_t Index)
+	{
+		Record("EnableVertexAttribArray");
+	}
+
+	void NullRenderDevice::VertexAttribPointer(uint32_t Index, int32_t Size, uint32_t Type, bool Normalised, int32_t Stride, const void* Offset)
+	{
+		Record("VertexAttribPointer");
+	}
+
+	void NullRenderDevice::VertexAttribIPointer(uint32_t Index, int32_t Size, uint32_t Type, int32_t Stride, const void* Offset)
+	{
+		Record("VertexAttribIPointer");
+	}
+
+	void NullRenderDevice::VertexAttribDivisor(uint32_t Index, uint32_t Divisor)
+	{
+		Record("VertexAttribDivisor");
+	}
+
+	/****** Textures ******/
+
+	void NullRenderDevice::GenTextures(int32_t Count, uint32_t* IDs)
+	{
+		Record("GenTextures");
+		for (int32_t i = 0; i < Count; i++)
+			IDs[i] = CreateObject();
+	}
+
+	void NullRenderDevice::DeleteTextures(int32_t Count, const uint32_t* IDs)
+	{
+		Record("DeleteTextures");
+		for (int32_t i = 0; i < Count; i++)
+		{
+			for (auto& Binding : m_TextureBindings)
+			{
+				if (Binding.second == IDs[i])
+					Binding.second = 0;
+			}
+		}
+	}
+
+	void NullRenderDevice::BindTexture(uint32_t Target, uint32_t ID)
+	{
+		Record("BindTexture");
+		if (SetState(GetTextureBinding(m_ActiveTextureUnit, Target), ID))
+			m_Stats.TextureBinds++;
+	}
+
+	void NullRenderDevice::ActiveTexture(uint32_t Unit)
+	{
+		Record("ActiveTexture");
+		SetState(m_ActiveTextureUnit, Unit - GL_TEXTURE0);
+	}
+
+	void NullRenderDevice::BindTextureUnit(uint32_t Unit, uint32_t ID)
+	{
+		// Binds the texture to the target of the texture (which is not tracked here), so a 0 target is used for all of them
+		Record("BindTextureUnit");
+		if (SetState(GetTextureBinding(Unit, 0), ID))
+			m_Stats.TextureBinds++;
+	}
+
+	void NullRenderDevice::TexParameteri(uint32_t Target, uint32_t Name, int32_t Value)
+	{
+		Record("TexParameteri");
+	}
+
+	void NullRenderDevice::TexParameterf(uint32_t Target, uint32_t Name, float Value)
+	{
+		Record("TexParameterf");
+	}
+
+	void NullRenderDevice::TextureParameteri(uint32_t Texture, uint32_t Name, int32_t Value)
+	{
+		Record("TextureParameteri");
+	}
+
+	void NullRenderDevice::TextureParameterfv(uint32_t Texture, uint32_t Name, const float* Values)
+	{
+		Record("TextureParameterfv");
+	}
+
+	void NullRenderDevice::TexImage2D(uint32_t Target, int32_t Level, int32_t InternalFormat, int32_t Width, int32_t Height, int32_t Border, uint32_t Format, uint32_t Type, const void* Data)
+	{
+		Record("TexImage2D", Data ? (uint64_t)Width * Height * GetTexelSize(Format, Type) : 0);
+	}
+
+	void NullRenderDevice::CompressedTexImage2D(uint32_t Target, int32_t Level, uint32_t InternalFormat, int32_t Width, int32_t Height, int32_t Border, int32_t ImageSize, const void* Data)
+	{
+		Record("CompressedTexImage2D", Data ? (uint64_t)ImageSize : 0);
+	}
+
+	void NullRenderDevice::TexSubImage2D(uint32_t Target, int32_t Level, int32_t XOffset, int32_t YOffset, int32_t Width, int32_t Height, uint32_t Format, uint32_t Type, const void* Data)
+	{
+		Record("TexSubImage2D", (uint64_t)Width * Height * GetTexelSize(Format, Type));
+	}
+
+	void NullRenderDevice::TexStorage3D(uint32_t Target, int32_t Levels, uint32_t InternalFormat, int32_t Width, int32_t Height, int32_t Depth)
+	{
+		Record("TexStorage3D");
+	}
+
+	void NullRenderDevice::TexSubImage3D(uint32_t Target, int32_t Level, int32_t XOffset, int32_t YOffset, int32_t ZOffset, int32_t Width, int32_t Height, int32_t Depth, uint32_t Format, uint32_t Type, const void* Data)
+	{
+		Record("TexSubImage3D", (uint64_t)Width * Height * Depth * GetTexelSize(Format, Type));
+	}
+
+	void NullRenderDevice::TexBuffer(uint32_t Target, uint32_t InternalFormat, uint32_t Buffer)
+	{
+		Record("TexBuffer");
+	}
+
+	void NullRenderDevice::GenerateMipmap(uint32_t Target)
+	{
+		Record("GenerateMipmap");
+	}
+
+	void NullRenderDevice::PixelStorei(uint32_t Name, int32_t Value)
+	{
+		Record("PixelStorei");
+	}
+
+	void NullRenderDevice::CopyImageSubData(uint32_t SrcName, uint32_t SrcTarget, int32_t SrcLevel, int32_t SrcX, int32_t SrcY, int32_t SrcZ, uint32_t DstName, uint32_t DstTarget, int32_t DstLevel, int32_t DstX, int32_t DstY, int32_t DstZ, int32_t Width, int32_t Height, int32_t Depth)
+	{
+		Record("CopyImageSubData");
+	}
+
+	void NullRenderDevice::GetTexImage(uint32_t Target, int32_t Level, uint32_t Format, uint32_t Type, void* Pixels)
+	{
+		Record("GetTexImage");
+	}
+
+	/****** Frame Buffers ******/
+
+	void NullRenderDevice::GenFramebuffers(int32_t Count, uint32_t* IDs)
+	{
+		Record("GenFramebuffers");
+		for (int32_t i = 0; i < Count; i++)
+			IDs[i] = CreateObject();
+	}
+
+	void NullRenderDevice::DeleteFramebuffers(int32_t Count, const uint32_t* IDs)
+	{
+		Record("DeleteFramebuffers");
+		for (int32_t i = 0; i < Count; i++)
+		{
+			if (m_Framebuffer == IDs[i])
+				m_Framebuffer = 0;
+		}
+	}
+
+	void NullRenderDevice::BindFramebuffer(uint32_t Target, uint32_t ID)
+	{
+		Record("BindFramebuffer");
+		if (SetState(m_Framebuffer, ID))
+			m_Stats.FramebufferBinds++;
+	}
+
+	void NullRenderDevice::FramebufferTexture2D(uint32_t Target, uint32_t Attachment, uint32_t TextureTarget, uint32_t Texture, int32_t Level)
+	{
+		Record("FramebufferTexture2D");
+	}
+
+	void NullRenderDevice::FramebufferTextureLayer(uint32_t Target, uint32_t Attachment, uint32_t Texture, int32_t Level, int32_t Layer)
+	{
+		Record("FramebufferTextureLayer");
+	}
+
+	void NullRenderDevice::DrawBuffer(uint32_t Buffer)
+	{
+		Record("DrawBuffer");
+	}
+
+	void NullRenderDevice::ReadBuffer(uint32_t Buffer)
+	{
+		Record("ReadBuffer");
+	}
+
+	uint32_t NullRenderDevice::CheckFramebufferStatus(uint32_t Target)
+	{
+		Record("CheckFramebufferStatus");
+		return GL_FRAMEBUFFER_COMPLETE;
+	}
+
+	/****** Shaders ******/
+
+	uint32_t NullRenderDevice::CreateShader(uint32_t Type)
+	{
+		Record("CreateShader");
+		return CreateObject();
+	}
+
+	void NullRenderDevice::ShaderSource(uint32_t Shader, int32_t Count, const char* const* Sources, const int32_t* Lengths)
+	{
+		Record("ShaderSource");
+	}
+
+	void NullRenderDevice::CompileShader(uint32_t Shader)
+	{
+		Record("CompileShader");
+	}
+
+	void NullRenderDevice::GetShaderiv(uint32_t Shader, uint32_t Name, int32_t* Value)
+	{
+		Record("GetShaderiv");
+
+		// Every shader compiles without any log
+		*Value = (Name == GL_COMPILE_STATUS) ? GL_TRUE : 0;
+	}
+
+	void NullRenderDevice::GetShaderInfoLog(uint32_t Shader, int32_t MaxLength, int32_t* Length, char* InfoLog)
+	{
+		Record("GetShaderInfoLog");
+
+		if (Length)
+			*Length = 0;
+		if (InfoLog && MaxLength > 0)
+			InfoLog[0] = '\0';
+	}
+
+	void NullRenderDevice::DeleteShader(uint32_t Shader)
+	{
+		Record("DeleteShader");
+	}
+
+	uint32_t NullRenderDevice::CreateProgram()
+	{
+		Record("CreateProgram");
+		return CreateObject();
+	}
+
+	void NullRenderDevice::AttachShader(uint32_t Program, uint32_t Shader)
+	{
+		Record("AttachShader");
+	}
+
+	void NullRenderDevice::LinkProgram(uint32_t Program)
+	{
+		Record("LinkProgram");
+	}
+
+	void NullRenderDevice::ValidateProgram(uint32_t Program)
+	{
+		Record("ValidateProgram");
+	}
+
+	void NullRenderDevice::GetProgramiv(uint32_t Program, uint32_t Name, int32_t* Value)
+	{
+		Record("GetProgramiv");
+
+		// Every program links (immediately) without any log, and has no binary to retrieve
+		*Value = (Name == GL_LINK_STATUS || Name == GL_VALIDATE_STATUS || Name == GL_COMPLETION_STATUS_KHR) ? GL_TRUE : 0;
+	}
+
+	void NullRenderDevice::GetProgramInfoLog(uint32_t Program, int32_t MaxLength, int32_t* Length, char* InfoLog)
+	{
+		Record("GetProgramInfoLog");
+
+		if (Length)
+			*Length = 0;
+		if (InfoLog && MaxLength > 0)
+			InfoLog[0] = '\0';
+	}
+
+	void NullRenderDevice::ProgramParameteri(uint32_t Program, uint32_t Name, int32_t Value)
+	{
+		Record("ProgramParameteri");
+	}
+
+	void NullRenderDevice::GetProgramBinary(uint32_t Program, int32_t BufferSize, int32_t* Length, uint32_t* BinaryFormat, void* Binary)
+	{
+		Record("GetProgramBinary");
+
+		if (Length)
+			*Length = 0;
+		*BinaryFormat = 0;
+	}
+
+	void NullRenderDevice::ProgramBinary(uint32_t Program, uint32_t BinaryFormat, const void* Binary, int32_t Length)
+	{
+		Record("ProgramBinary", Length);
+	}
+
+	void NullRenderDevice::MaxShaderCompilerThreads(uint32_t Count)
+	{
+		Record("MaxShaderCompilerThreads");
+	}
+
+	void NullRenderDevice::DeleteProgram(uint32_t Program)
+	{
+		Record("DeleteProgram");
+		if (m_Program == Program)
+			m_Program = 0;
+	}
+
+	void NullRenderDevice::UseProgram(uint32_t Program)
+	{
+		Record("UseProgram");
+		if (SetState(m_Program, Program))
+			m_Stats.ProgramBinds++;
+	}
+
+	int32_t NullRenderDevice::GetUniformLocation(uint32_t Program, const char* Name)
+	{
+		// Every uniform exists (the shaders cache the locations, so a new one is given on each call)
+		Record("GetUniformLocation");
+		return ++m_LastUniformLocation;
+	}
+
+	void NullRenderDevice::Uniform1i(int32_t Location, int32_t V0)
+	{
+		Record("Uniform1i", sizeof(int32_t));
+		m_Stats.UniformUpdates++;
+	}
+
+	void NullRenderDevice::Uniform1iv(int32_t Location, int32_t Count, const int32_t* Values)
+	{
+		Record("Uniform1iv", Count * sizeof(int32_t));
+		m_Stats.UniformUpdates++;
+	}
+
+	void NullRenderDevice::Uniform2i(int32_t Location, int32_t V0, int32_t V1)
+	{
+		Record("Uniform2i", 2 * sizeof(int32_t));
+		m_Stats.UniformUpdates++;
+	}
+
+	void NullRenderDevice::Uniform3i(int32_t Location, int32_t V0, int32_t V1, int32_t V2)
+	{
+		Record("Uniform3i", 3 * sizeof(int32_t));
+		m_Stats.UniformUpdates++;
+	}
+
+	void NullRenderDevice::Uniform1f(int32_t Location, float V0)
+	{
+		Record("Uniform1f", sizeof(float));
+		m_Stats.UniformUpdates++;
+	}
+
+	void NullRenderDevice::Uniform2f(int32_t Location, float V0, float V1)
+	{
+		Record("Uniform2f", 2 * sizeof(float));
+		m_Stats.UniformUpdates++;
+	}
+
+	void NullRenderDevice::Uniform3f(int32_t Location, float V0, float V1, float V2)
+	{
+		Record("Uniform3f", 3 * sizeof(float));
+		m_Stats.UniformUpdates++;
+	}
+
+	void NullRenderDevice::Uniform4f(int32_t Location, float V0, float V1, float V2, float V3)
+	{
+		Record("Uniform4f", 4 * sizeof(float));
+		m_Stats.UniformUpdates++;
+	}
+
+	void NullRenderDevice::UniformMatrix3fv(int32_t Location, int32_t Count, bool Transpose, const float* Values)
+	{
+		Record("UniformMatrix3fv", Count * 9 * sizeof(float));
+		m_Stats.UniformUpdates++;
+	}
+
+	void NullRenderDevice::UniformMatrix4fv(int32_t Location, int32_t Count, bool Transpose, const float* Values)
+	{
+		Record("UniformMatrix4fv", Count * 16 * sizeof(float));
+		m_Stats.UniformUpdates++;
+	}
+
+	/****** Render State ******/
+
+	void NullRenderDevice::Enable(uint32_t Capability)
+	{
+		Record("Enable");
+		if (SetState(m_Capabilities[Capability], true))
+			m_Stats.StateChanges++;
+	}
+
+	void NullRenderDevice::Disable(uint32_t Capability)
+	{
+		Record("Disable");
+		if (SetState(m_Capabilities[Capability], false))
+			m_Stats.StateChanges++;
+	}
+
+	void NullRenderDevice::DepthMask(bool Flag)
+	{
+		Record("DepthMask");
+		if (SetState(m_DepthMask, Flag))
+			m_Stats.StateChanges++;
+	}
+
+	void NullRenderDevice::DepthFunc(uint32_t Func)
+	{
+		Record("DepthFunc");
+		if (SetState(m_DepthFunc, Func))
+			m_Stats.StateChanges++;
+	}
+
+	void NullRenderDevice::ColorMask(bool Red, bool Green, bool Blue, bool Alpha)
+	{
+		Record("ColorMask");
+		if (SetState(m_ColorMask, std::array<bool, 4>{ { Red, Green, Blue, Alpha } }))
+			m_Stats.StateChanges++;
+	}
+
+	void NullRenderDevice::BlendFunc(uint32_t SrcFactor, uint32_t DstFactor)
+	{
+		Record("BlendFunc");
+		if (SetState(m_BlendFunc, std::array<uint32_t, 2>{ { SrcFactor, DstFactor } }))
+			m_Stats.StateChanges++;
+	}
+
+	void NullRenderDevice::BlendEquation(uint32_t Mode)
+	{
+		Record("BlendEquation");
+		if (SetState(m_BlendEquation, Mode))
+			m_Stats.StateChanges++;
+	}
+
+	void NullRenderDevice::CullFace(uint32_t Mode)
+	{
+		Record("CullFace");
+		if (SetState(m_CullFace, Mode))
+			m_Stats.StateChanges++;
+	}
+
+	void NullRenderDevice::Viewport(int32_t X, int32_t Y, int32_t Width, int32_t Height)
+	{
+		Record("Viewport");
+		if (SetState(m_Viewport, std::array<int32_t, 4>{ { X, Y, Width, Height } }))
+			m_Stats.StateChanges++;
+	}
+
+	void NullRenderDevice::ClearColor(float Red, float Green, float Blue, float Alpha)
+	{
+		Record("ClearColor");
+	}
+
+	void NullRenderDevice::Clear(uint32_t Mask)
+	{
+		Record("Clear");
+	}
+
+	void NullRenderDevice::GetIntegerv(uint32_t Name, int32_t* Values)
+	{
+		Record("GetIntegerv");
+
+		switch (Name)
+		{
+			case GL_VIEWPORT:
+				std::copy(m_Viewport.begin(), m_Viewport.end(), Values);
+				break;
+
+			// Minimum required by OpenGL 4.5
+			case GL_MAX_ARRAY_TEXTURE_LAYERS:
+				*Values = 2048;
+				break;
+
+			case GL_MAX_TEXTURE_SIZE:
+				*Values = 16384;
+				break;
+
+			default:
+				*Values = 0;
+				break;
+		}
+	}
+
+	void NullRenderDevice::GetFloatv(uint32_t Name, float* Values)
+	{
+		Record("GetFloatv");
+
+		switch (Name)
+		{
+			// Maximum exposed by the common drivers
+			case GL_MAX_TEXTURE_MAX_ANISOTROPY:
+				*Values = 16.0f;
+				break;
+
+			default:
+				*Values = 0.0f;
+				break;
+		}
+	}
+
+	const char* NullRenderDevice::GetString(uint32_t Name)
+	{
+		Record("GetString");
+
+		switch (Name)
+		{
+			case GL_VENDOR:
+				return "GraphX";
+			case GL_RENDERER:
+				return "Null Render Device";
+			case GL_VERSION:
+				return "4.5";
+			default:
+				return "";
+		}
+	}
+
+	/****** Draw Calls ******/
+
+	void NullRenderDevice::DrawArrays(uint32_t Mode, int32_t First, int32_t Count)
+	{
+		Record("DrawArrays");
+		m_Stats.DrawCalls++;
+		m_Stats.VerticesDrawn += Count;
+		m_Stats.InstancesDrawn++;
+	}
+
+	void NullRenderDevice::DrawArraysInstanced(uint32_t Mode, int32_t First, int32_t Count, int32_t InstanceCount)
+	{
+		Record("DrawArraysInstanced");
+		m_Stats.DrawCalls++;
+		m_Stats.VerticesDrawn += (uint64_t)Count * InstanceCount;
+		m_Stats.InstancesDrawn += InstanceCount;
+	}
+
+	void NullRenderDevice::DrawElements(uint32_t Mode, int32_t Count, uint32_t Type, const void* Indices)
+	{
+		Record("DrawElements");
+		m_Stats.DrawCalls++;
+		m_Stats.VerticesDrawn += Count;
+		m_Stats.InstancesDrawn++;
+	}
+
+	void NullRenderDevice::DrawElementsBaseVertex(uint32_t Mode, int32_t Count, uint32_t Type, const void* Indices, int32_t BaseVertex)
+	{
+		Record("DrawElementsBaseVertex");
+		m_Stats.DrawCalls++;
+		m_Stats.VerticesDrawn += Count;
+		m_Stats.InstancesDrawn++;
+	}
+
+	/****** Queries ******/
+
+	void NullRenderDevice::GenQueries(int32_t Count, uint32_t* IDs)
+	{
+		Record("GenQueries");
+		for (int32_t i = 0; i < Count; i++)
+			IDs[i] = CreateObject();
+	}
+
+	void NullRenderDevice::DeleteQueries(int32_t Count, const uint32_t* IDs)
+	{
+		Record("DeleteQueries");
+	}
+
+	void NullRenderDevice::QueryCounter(uint32_t ID, uint32_t Target)
+	{
+		Record("QueryCounter");
+	}
+
+	void NullRenderDevice::GetQueryObjectiv(uint32_t ID, uint32_t Name, int32_t* Value)
+	{
+		// Results are always available (and zero)
+		Record("GetQueryObjectiv");
+		*Value = (Name == GL_QUERY_RESULT_AVAILABLE) ? GL_TRUE : 0;
+	}
+
+	void NullRenderDevice::GetQueryObjectui64v(uint32_t ID, uint32_t Name, uint64_t* Value)
+	{
+		Record("GetQueryObjectui64v");
+		*Value = (Name == GL_QUERY_RESULT_AVAILABLE) ? GL_TRUE : 0;
+	}
+
+	void NullRenderDevice::GetInteger64v(uint32_t Name, int64_t* Value)
+	{
+		Record("GetInteger64v");
+		*Value = 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include "pch.h"
+#include "RenderDevice.h"
+
+#include "GLRenderDevice.h"
+#include "NullRenderDevice.h"
+
+#include <thread>
+
+namespace GraphX
+{
+	RenderDevice* RenderDevice::s_Instance = nullptr;
+	RenderDeviceType RenderDevice::s_Type = RenderDeviceType::OpenGL;
+
+	/* Thread the device was created on (The graphics context is current on this thread) */
+	static std::thread::id s_RenderThread;
+
+	void RenderDevice::Init(RenderDeviceType Type)
+	{
+		GX_PROFILE_FUNCTION()
+
+		GX_ENGINE_ASSERT(!s_Instance, "Render device is already initialised");
+
+		switch (Type)
+		{
+			case RenderDeviceType::OpenGL:
+				s_Instance = new GLRenderDevice();
+				break;
+
+			case RenderDeviceType::Null:
+				GX_ENGINE_INFO("Render Device: Using the null device. Nothing will be rendered");
+				s_Instance = new NullRenderDevice();
+				break;
+
+			default:
+				GX_ENGINE_ASSERT(false, "Unknown render device type");
+				return;
+		}
+
+		s_Type = Type;
+		s_RenderThread = std::this_thread::get_id();
+	}
+
+	bool RenderDevice::IsRenderThread()
+	{
+		return std::this_thread::get_id() == s_RenderThread;
+	}
+
+	void RenderDevice::Shutdown()
+	{
+		GX_PROFILE_FUNCTION()
+
+		delete s_Instance;
+		s_Instance = nullptr;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,158 @@
+#pragma once
+
+namespace GraphX
+{
+	/* Backends the renderer can submit its commands to */
+	enum class RenderDeviceType
+	{
+		/* Submits the commands to the OpenGL context of the window */
+		OpenGL = 0,
+
+		/* Does not need a GPU or a window. Records the commands and counts the work submitted */
+		Null
+	};
+
+	/* 
+	* Thin layer between the renderer and the graphics API. The renderer classes talk only to the device.
+	* The calls mirror the OpenGL ones (and take the same enum values) so the OpenGL device is a direct passthrough
+	*/
+	class RenderDevice
+	{
+	public:
+		/* Creates the device (Must be done before the window and any renderer asset is created) */
+		static void Init(RenderDeviceType Type);
+
+		/* Destroys the device */
+		static void Shutdown();
+
+		/* Returns the current device */
+		static RenderDevice& Get() { return *s_Instance; }
+
+		/* Returns the type of the current device */
+		static RenderDeviceType GetType() { return s_Type; }
+
+		/* Returns whether the calling thread is the one the device was created on (The only thread which can submit the commands) */
+		static bool IsRenderThread();
+
+		virtual ~RenderDevice() = default;
+
+		/****** Buffers ******/
+		virtual void GenBuffers(int32_t Count, uint32_t* IDs) = 0;
+		virtual void DeleteBuffers(int32_t Count, const uint32_t* IDs) = 0;
+		virtual void BindBuffer(uint32_t Target, uint32_t ID) = 0;
+		virtual void BufferData(uint32_t Target, intptr_t Size, const void* Data, uint32_t Usage) = 0;
+		virtual void BufferSubData(uint32_t Target, intptr_t Offset, intptr_t Size, const void* Data) = 0;
+		virtual void CopyBufferSubData(uint32_t ReadTarget, uint32_t WriteTarget, intptr_t ReadOffset, intptr_t WriteOffset, intptr_t Size) = 0;
+		virtual void* MapBufferRange(uint32_t Target, intptr_t Offset, intptr_t Length, uint32_t Access) = 0;
+		virtual bool UnmapBuffer(uint32_t Target) = 0;
+
+		/****** Vertex Arrays ******/
+		virtual void GenVertexArrays(int32_t Count, uint32_t* IDs) = 0;
+		virtual void DeleteVertexArrays(int32_t Count, const uint32_t* IDs) = 0;
+		virtual void BindVertexArray(uint32_t ID) = 0;
+		virtual void EnableVertexAttribArray(uint32_t Index) = 0;
+		virtual void VertexAttribPointer(uint32_t Index, int32_t Size, uint32_t Type, bool Normalised, int32_t Stride, const void* Offset) = 0;
+		virtual void VertexAttribIPointer(uint32_t Index, int32_t Size, uint32_t Type, int32_t Stride, const void* Offset) = 0;
+		virtual void VertexAttribDivisor(uint32_t Index, uint32_t Divisor) = 0;
+
+		/****** Textures ******/
+		virtual void GenTextures(int32_t Count, uint32_t* IDs) = 0;
+		virtual void DeleteTextures(int32_t Count, const uint32_t* IDs) = 0;
+		virtual void BindTexture(uint32_t Target, uint32_t ID) = 0;
+		virtual void ActiveTexture(uint32_t Unit) = 0;
+		virtual void BindTextureUnit(uint32_t Unit, uint32_t ID) = 0;
+		virtual void TexParameteri(uint32_t Target, uint32_t Name, int32_t Value) = 0;
+		virtual void TexParameterf(uint32_t Target, uint32_t Name, float Value) = 0;
+		virtual void TextureParameteri(uint32_t Texture, uint32_t Name, int32_t Value) = 0;
+		virtual void TextureParameterfv(uint32_t Texture, uint32_t Name, const float* Values) = 0;
+		virtual void TexImage2D(uint32_t Target, int32_t Level, int32_t InternalFormat, int32_t Width, int32_t Height, int32_t Border, uint32_t Format, uint32_t Type, const void* Data) = 0;
+		virtual void CompressedTexImage2D(uint32_t Target, int32_t Level, uint32_t InternalFormat, int32_t Width, int32_t Height, int32_t Border, int32_t ImageSize, const void* Data) = 0;
+		virtual void TexSubImage2D(uint32_t Target, int32_t Level, int32_t XOffset, int32_t YOffset, int32_t Width, int32_t Height, uint32_t Format, uint32_t Type, const void* Data) = 0;
+		virtual void TexStorage3D(uint32_t Target, int32_t Levels, uint32_t InternalFormat, int32_t Width, int32_t Height, int32_t Depth) = 0;
+		virtual void TexSubImage3D(uint32_t Target, int32_t Level, int32_t XOffset, int32_t YOffset, int32_t ZOffset, int32_t Width, int32_t Height, int32_t Depth, uint32_t Format, uint32_t Type, const void* Data) = 0;
+		virtual void TexBuffer(uint32_t Target, uint32_t InternalFormat, uint32_t Buffer) = 0;
+		virtual void GenerateMipmap(uint32_t Target) = 0;
+		virtual void PixelStorei(uint32_t Name, int32_t Value) = 0;
+		virtual void CopyImageSubData(uint32_t SrcName, uint32_t SrcTarget, int32_t SrcLevel, int32_t SrcX, int32_t SrcY, int32_t SrcZ, uint32_t DstName, uint32_t DstTarget, int32_t DstLevel, int32_t DstX, int32_t DstY, int32_t DstZ, int32_t Width, int32_t Height, int32_t Depth) = 0;
+		virtual void GetTexImage(uint32_t Target, int32_t Level, uint32_t Format, uint32_t Type, void* Pixels) = 0;
+
+		/****** Frame Buffers ******/
+		virtual void GenFramebuffers(int32_t Count, uint32_t* IDs) = 0;
+		virtual void DeleteFramebuffers(int32_t Count, const uint32_t* IDs) = 0;
+		virtual void BindFramebuffer(uint32_t Target, uint32_t ID) = 0;
+		virtual void FramebufferTexture2D(uint32_t Target, uint32_t Attachment, uint32_t TextureTarget, uint32_t Texture, int32_t Level) = 0;
+		virtual void FramebufferTextureLayer(uint32_t Target, uint32_t Attachment, uint32_t Texture, int32_t Level, int32_t Layer) = 0;
+		virtual void DrawBuffer(uint32_t Buffer) = 0;
+		virtual void ReadBuffer(uint32_t Buffer) = 0;
+		virtual uint32_t CheckFramebufferStatus(uint32_t Target) = 0;
+
+		/****** Shaders ******/
+		virtual uint32_t CreateShader(uint32_t Type) = 0;
+		virtual void ShaderSource(uint32_t Shader, int32_t Count, const char* const* Sources, const int32_t* Lengths) = 0;
+		virtual void CompileShader(uint32_t Shader) = 0;
+		virtual void GetShaderiv(uint32_t Shader, uint32_t Name, int32_t* Value) = 0;
+		virtual void GetShaderInfoLog(uint32_t Shader, int32_t MaxLength, int32_t* Length, char* InfoLog) = 0;
+		virtual void DeleteShader(uint32_t Shader) = 0;
+		virtual uint32_t CreateProgram() = 0;
+		virtual void AttachShader(uint32_t Program, uint32_t Shader) = 0;
+		virtual void LinkProgram(uint32_t Program) = 0;
+		virtual void ValidateProgram(uint32_t Program) = 0;
+		virtual void GetProgramiv(uint32_t Program, uint32_t Name, int32_t* Value) = 0;
+		virtual void GetProgramInfoLog(uint32_t Program, int32_t MaxLength, int32_t* Length, char* InfoLog) = 0;
+		virtual void ProgramParameteri(uint32_t Program, uint32_t Name, int32_t Value) = 0;
+		virtual void GetProgramBinary(uint32_t Program, int32_t BufferSize, int32_t* Length, uint32_t* BinaryFormat, void* Binary) = 0;
+		virtual void ProgramBinary(uint32_t Program, uint32_t BinaryFormat, const void* Binary, int32_t Length) = 0;
+		/* Number of driver threads the shaders are compiled (and linked) on. Does nothing without parallel shader compile support */
+		virtual void MaxShaderCompilerThreads(uint32_t Count) = 0;
+		virtual void DeleteProgram(uint32_t Program) = 0;
+		virtual void UseProgram(uint32_t Program) = 0;
+		virtual int32_t GetUniformLocation(uint32_t Program, const char* Name) = 0;
+		virtual void Uniform1i(int32_t Location, int32_t V0) = 0;
+		virtual void Uniform1iv(int32_t Location, int32_t Count, const int32_t* Values) = 0;
+		virtual void Uniform2i(int32_t Location, int32_t V0, int32_t V1) = 0;
+		virtual void Uniform3i(int32_t Location, int32_t V0, int32_t V1, int32_t V2) = 0;
+		virtual void Uniform1f(int32_t Location, float V0) = 0;
+		virtual void Uniform2f(int32_t Location, float V0, float V1) = 0;
+		virtual void Uniform3f(int32_t Location, float V0, float V1, float V2) = 0;
+		virtual void Uniform4f(int32_t Location, float V0, float V1, float V2, float V3) = 0;
+		virtual void UniformMatrix3fv(int32_t Location, int32_t Count, bool Transpose, const float* Values) = 0;
+		virtual void UniformMatrix4fv(int32_t Location, int32_t Count, bool Transpose, const float* Values) = 0;
+
+		/****** Render State ******/
+		virtual void Enable(uint32_t Capability) = 0;
+		virtual void Disable(uint32_t Capability) = 0;
+		virtual void DepthMask(bool Flag) = 0;
+		virtual void DepthFunc(uint32_t Func) = 0;
+		virtual void ColorMask(bool Red, bool Green, bool Blue, bool Alpha) = 0;
+		virtual void BlendFunc(uint32_t SrcFactor, uint32_t DstFactor) = 0;
+		virtual void BlendEquation(uint32_t Mode) = 0;
+		virtual void CullFace(uint32_t Mode) = 0;
+		virtual void Viewport(int32_t X, int32_t Y, int32_t Width, int32_t Height) = 0;
+		virtual void ClearColor(float Red, float Green, float Blue, float Alpha) = 0;
+		virtual void Clear(uint32_t Mask) = 0;
+		virtual void GetIntegerv(uint32_t Name, int32_t* Values) = 0;
+		virtual void GetFloatv(uint32_t Name, float* Values) = 0;
+		virtual const char* GetString(uint32_t Name) = 0;
+
+		/****** Draw Calls ******/
+		virtual void DrawArrays(uint32_t Mode, int32_t First, int32_t Count) = 0;
+		virtual void DrawArraysInstanced(uint32_t Mode, int32_t First, int32_t Count, int32_t InstanceCount) = 0;
+		virtual void DrawElements(uint32_t Mode, int32_t Count, uint32_t Type, const void* Indices) = 0;
+		virtual void DrawElementsBaseVertex(uint32_t Mode, int32_t Count, uint32_t Type, const void* Indices, int32_t BaseVertex) = 0;
+
+		/****** Queries ******/
+		virtual void GenQueries(int32_t Count, uint32_t* IDs) = 0;
+		virtual void DeleteQueries(int32_t Count, const uint32_t* IDs) = 0;
+		virtual void QueryCounter(uint32_t ID, uint32_t Target) = 0;
+		virtual void GetQueryObjectiv(uint32_t ID, uint32_t Name, int32_t* Value) = 0;
+		virtual void GetQueryObjectui64v(uint32_t ID, uint32_t Name, uint64_t* Value) = 0;
+		virtual void GetInteger64v(uint32_t Name, int64_t* Value) = 0;
+
+	private:
+		/* Device used by the renderer */
+		static RenderDevice* s_Instance;
+
+		/* Type of the device used by the renderer */
+		static RenderDeviceType s_Type;
+	};
+}
\ No newline at end of file
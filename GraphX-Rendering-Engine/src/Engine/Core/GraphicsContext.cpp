@@ -2,7 +2,7 @@
 #include "GraphicsContext.h"
 #include "GL/glew.h"
 
-#include "GLFW\glfw3.h"
+#include "GLFW/glfw3.h"
 
 namespace GraphX
 {
@@ -90,9 +90,9 @@ namespace GraphX
 
 		// Print the gl version
 		GX_ENGINE_INFO("OpenGL Info:");
-		GX_ENGINE_INFO("	Vendor: {0}", glGetString(GL_VENDOR));
-		GX_ENGINE_INFO("	Renderer: {0}", glGetString(GL_RENDERER));
-		GX_ENGINE_INFO("	Version: {0}", glGetString(GL_VERSION));
+		GX_ENGINE_INFO("	Vendor: {0}", (const char*)glGetString(GL_VENDOR));
+		GX_ENGINE_INFO("	Renderer: {0}", (const char*)glGetString(GL_RENDERER));
+		GX_ENGINE_INFO("	Version: {0}", (const char*)glGetString(GL_VERSION));
 
 		// Enable Debugging
 		glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
@@ -16,18 +16,23 @@ namespace GraphX
 	{}
 
 	Material::Material(const Material& Other)
-		: m_BaseColor(Other.m_BaseColor), m_Specular(Other.m_Specular), m_Shininess(Other.m_Shininess), m_Shader(Other.m_Shader)
+		: m_BaseColor(Other.m_BaseColor), m_Specular(Other.m_Specular), m_Shininess(Other.m_Shininess), m_Shader(Other.m_Shader), m_ShaderFeatures(Other.m_ShaderFeatures)
 	{
 	}
 
 	void Material::Bind()
+	{
+		Bind(*m_Shader);
+	}
+
+	void Material::Bind(Shader& shader)
 	{
 		GX_PROFILE_FUNCTION()
 
-		m_Shader->Bind();
-		m_Shader->SetUniform1f("u_Reflectivity", m_Specular);
-		m_Shader->SetUniform1f("u_Shininess", m_Shininess);
-		m_Shader->SetUniform4f("u_TintColor", m_BaseColor);
+		shader.Bind();
+		shader.SetUniform1f("u_Reflectivity", m_Specular);
+		shader.SetUniform1f("u_Shininess", m_Shininess);
+		shader.SetUniform4f("u_TintColor", m_BaseColor);
 
 		// Bind the textures
 		int NumTex = m_Textures.size();
@@ -39,7 +44,7 @@ namespace GraphX
 			const Ref<const Texture2D>& texture = m_Textures[i];
 			texture->Bind(i);
 			TexName[TexName.length() - 1] = '0' + i;
-			m_Shader->SetUniform1i(TexName.c_str(), i);
+			shader.SetUniform1i(TexName.c_str(), i);
 		}
 	}
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Engine/Core/Shaders/ShaderLibrary.h"
+
 namespace GraphX
 {
 	using namespace GM;
@@ -19,6 +21,9 @@ namespace GraphX
 
 		void Bind();
 
+		/* Binds the shader (a variant of the material shader) and sets the material properties on it */
+		void Bind(Shader& shader);
+
 		/* Add another texture to the material */
 		void AddTexture(const Ref<const Texture2D>& Tex);
 		void AddTexture(const std::vector<Ref<const Texture2D>>& Textures);
@@ -56,6 +61,15 @@ namespace GraphX
 		/* Returns textures used in the material */
 		inline const std::vector<Ref<const Texture2D>>& GetTextures() const { return m_Textures; }
 
+		/* Sets the shader features the material can use (ShaderFeature flags) */
+		inline void SetShaderFeatures(uint32_t Features) { m_ShaderFeatures = Features; }
+
+		/* Returns the shader features used by the material (A material without textures is never textured) */
+		inline uint32_t GetShaderFeatures() const
+		{
+			return m_Textures.empty() ? (m_ShaderFeatures & ~ShaderFeature::Textured) : m_ShaderFeatures;
+		}
+
 		~Material() {};
 
 	protected:
@@ -73,5 +87,8 @@ namespace GraphX
 
 		/* Textures for the material */
 		std::vector<Ref<const Texture2D>> m_Textures;
+
+		/* Shader features the material can use (The renderer picks the variant with the features used by both the scene and the material) */
+		uint32_t m_ShaderFeatures = ShaderFeature::All;
 	};
 }
\ No newline at end of file
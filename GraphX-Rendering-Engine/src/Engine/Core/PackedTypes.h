@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstring>
+
+namespace GraphX
+{
+	/* Utilities to pack vertex attributes into compact (quantized) formats */
+	namespace Pack
+	{
+		/* Converts a 32-bit float to a 16-bit IEEE half float (rounded to nearest) */
+		inline uint16_t FloatToHalf(float Value)
+		{
+			uint32_t Bits;
+			std::memcpy(&Bits, &Value, sizeof(float));
+
+			uint32_t Sign = (Bits >> 16) & 0x8000;
+			uint32_t FloatExponent = (Bits >> 23) & 0xff;
+			uint32_t Mantissa = Bits & 0x7fffff;
+			int32_t Exponent = (int32_t)FloatExponent - 127 + 15;
+
+			// Infinity and NaN
+			if (FloatExponent == 0xff)
+				return (uint16_t)(Sign | 0x7c00 | (Mantissa ? 0x200 : 0));
+
+			// Too large to be represented, clamp to infinity
+			if (Exponent >= 31)
+				return (uint16_t)(Sign | 0x7c00);
+
+			// Too small to be represented as a normalised half
+			if (Exponent <= 0)
+			{
+				if (Exponent < -10)
+					return (uint16_t)Sign;
+
+				Mantissa |= 0x800000;
+				uint32_t Shift = 14 - Exponent;
+				uint32_t Half = Mantissa >> Shift;
+				if ((Mantissa >> (Shift - 1)) & 1)
+					Half++;
+
+				return (uint16_t)(Sign | Half);
+			}
+
+			// Rounding can carry in to the exponent, which still gives the right result
+			uint32_t Half = Sign | ((uint32_t)Exponent << 10) | (Mantissa >> 13);
+			if (Mantissa & 0x1000)
+				Half++;
+
+			return (uint16_t)Half;
+		}
+
+		/* Converts a [0, 1] float to an 8-bit normalised integer */
+		inline uint8_t Unorm8(float Value)
+		{
+			GM::Utility::Clamp(Value, 0.0f, 1.0f);
+			return (uint8_t)(Value * 255.0f + 0.5f);
+		}
+
+		/* Converts a [0, 1] float to a 16-bit normalised integer */
+		inline uint16_t Unorm16(float Value)
+		{
+			GM::Utility::Clamp(Value, 0.0f, 1.0f);
+			return (uint16_t)(Value * 65535.0f + 0.5f);
+		}
+
+		/* Packs the color in to RGBA8 (Red in the lowest byte, same as the memory order expected by the GPU) */
+		inline uint32_t Color(const GM::Vector4& Color)
+		{
+			return (uint32_t)Unorm8(Color.x) | ((uint32_t)Unorm8(Color.y) << 8) | ((uint32_t)Unorm8(Color.z) << 16) | ((uint32_t)Unorm8(Color.w) << 24);
+		}
+	}
+
+	/* Two component vector of half floats */
+	struct HalfVector2
+	{
+		uint16_t x = 0, y = 0;
+
+		HalfVector2() = default;
+
+		HalfVector2(const GM::Vector2& Vec)
+			: x(Pack::FloatToHalf(Vec.x)), y(Pack::FloatToHalf(Vec.y))
+		{}
+	};
+}
\ No newline at end of file
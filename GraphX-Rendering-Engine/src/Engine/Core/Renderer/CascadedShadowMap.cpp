@@ -0,0 +1,291 @@
+#include "pch.h"
+#include "CascadedShadowMap.h"
+#include "GL/glew.h"
+#include "Device/RenderDevice.h"
+
+#include "Textures/Texture2DArray.h"
+#include "Shaders/Shader.h"
+#include "Entities/Camera.h"
+
+#include "Engine/Controllers/CameraController.h"
+
+namespace GraphX
+{
+	using namespace GM;
+
+	/* Uniform names for the cascade data (avoids building the strings every frame) */
+	static const char* s_LightSpaceMatrixNames[CascadedShadowMap::MaxCascades] = { "u_LightSpaceMatrices[0]", "u_LightSpaceMatrices[1]", "u_LightSpaceMatrices[2]", "u_LightSpaceMatrices[3]" };
+	static const char* s_CascadeSplitNames[CascadedShadowMap::MaxCascades] = { "u_CascadeSplits[0]", "u_CascadeSplits[1]", "u_CascadeSplits[2]", "u_CascadeSplits[3]" };
+
+	bool ShadowCascade::Overlaps(const BoundingBox& Box) const
+	{
+		// Find the extents of the box in the light space
+		Vector3 Min(std::numeric_limits<float>::max()), Max(std::numeric_limits<float>::lowest());
+		for (int i = 0; i < 8; i++)
+		{
+			Vector3 Corner((i & 1) ? Box.Max.x : Box.Min.x, (i & 2) ? Box.Max.y : Box.Min.y, (i & 4) ? Box.Max.z : Box.Min.z);
+			Vector3 LightSpaceCorner = LightViewMat * Corner;
+
+			Min.x = std::min(Min.x, LightSpaceCorner.x);
+			Min.y = std::min(Min.y, LightSpaceCorner.y);
+			Max.x = std::max(Max.x, LightSpaceCorner.x);
+			Max.y = std::max(Max.y, LightSpaceCorner.y);
+			Max.z = std::max(Max.z, LightSpaceCorner.z);
+		}
+
+		// Only the far plane is tested in depth, casters between the light and the near plane are clamped on to it (depth clamp)
+		return Min.x <= LightSpaceMax.x && Max.x >= LightSpaceMin.x 
+			&& Min.y <= LightSpaceMax.y && Max.y >= LightSpaceMin.y 
+			&& Max.z >= LightSpaceMin.z;
+	}
+
+	CascadedShadowMap::CascadedShadowMap(uint32_t Resolution, uint32_t CascadeCount)
+		: RendererAsset(), m_StaticCacheSupported(Texture2DArray::IsCopySupported()), m_StaticCastersSignature(0), m_LightDirection(Vector3::ZeroVector), m_Resolution(Resolution), m_CascadeCount(CascadeCount), 
+		m_SplitLambda(EngineConstants::ShadowCascadeSplitLambda), m_ShadowDistance(EngineConstants::ShadowDistance), m_IsBound(false)
+	{
+		GX_PROFILE_FUNCTION()
+
+		GX_ENGINE_ASSERT(m_CascadeCount >= 2 && m_CascadeCount <= MaxCascades, "Number of shadow cascades should be between 2 and 4");
+
+		if (!m_StaticCacheSupported)
+			GX_ENGINE_WARN("Shadow Map: Copying textures is not supported (Needs OpenGL 4.3 or ARB_copy_image), the static casters are rendered every frame");
+
+		RenderDevice::Get().GenFramebuffers(1, &m_RendererID);
+		CreateDepthMaps();
+
+		m_Viewport[0] = m_Viewport[1] = 0;
+		m_Viewport[2] = m_Viewport[3] = m_Resolution;
+	}
+
+	void CascadedShadowMap::CreateDepthMaps()
+	{
+		GX_PROFILE_FUNCTION()
+
+		m_DepthMaps = CreateScope<Texture2DArray>(m_Resolution, m_Resolution, m_CascadeCount, GL_DEPTH_COMPONENT32F);
+		if (m_StaticCacheSupported)
+			m_StaticDepthMaps = CreateScope<Texture2DArray>(m_Resolution, m_Resolution, m_CascadeCount, GL_DEPTH_COMPONENT32F);
+
+		InvalidateStaticCache();
+
+		// Depth is compared manually in the shaders, so no filtering. Everything outside the map is lit
+		const float BorderColor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+		RenderDevice::Get().TextureParameteri(m_DepthMaps->GetID(), GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		RenderDevice::Get().TextureParameteri(m_DepthMaps->GetID(), GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		RenderDevice::Get().TextureParameteri(m_DepthMaps->GetID(), GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+		RenderDevice::Get().TextureParameteri(m_DepthMaps->GetID(), GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+		RenderDevice::Get().TextureParameterfv(m_DepthMaps->GetID(), GL_TEXTURE_BORDER_COLOR, BorderColor);
+
+		RenderDevice::Get().BindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
+		RenderDevice::Get().FramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_DepthMaps->GetID(), 0, 0);
+		RenderDevice::Get().DrawBuffer(GL_NONE);
+		RenderDevice::Get().ReadBuffer(GL_NONE);
+
+		GX_ENGINE_ASSERT(RenderDevice::Get().CheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Unable to Create Framebuffer for the shadow cascades");
+		RenderDevice::Get().BindFramebuffer(GL_FRAMEBUFFER, 0);
+	}
+
+	void CascadedShadowMap::SetCascadeCount(uint32_t CascadeCount)
+	{
+		GX_PROFILE_FUNCTION()
+
+		GX_ENGINE_ASSERT(CascadeCount >= 2 && CascadeCount <= MaxCascades, "Number of shadow cascades should be between 2 and 4");
+		if (CascadeCount != m_CascadeCount)
+		{
+			m_CascadeCount = CascadeCount;
+			CreateDepthMaps();
+		}
+	}
+
+	void CascadedShadowMap::CalculateSplits(float Near, float Far)
+	{
+		// Practical split scheme (blend of the logarithmic and the uniform split)
+		for (uint32_t i = 0; i < m_CascadeCount; i++)
+		{
+			float Fraction = (float)(i + 1) / m_CascadeCount;
+			float LogSplit = Near * std::pow(Far / Near, Fraction);
+			float UniformSplit = Near + (Far - Near) * Fraction;
+
+			m_Cascades[i].SplitDepth = m_SplitLambda * LogSplit + (1.0f - m_SplitLambda) * UniformSplit;
+		}
+	}
+
+	void CascadedShadowMap::Update(const CameraController& Controller, const Vector3& LightDirection)
+	{
+		GX_PROFILE_FUNCTION()
+
+		const Camera& Cam = Controller.GetCamera();
+		const float Near = Controller.GetNearClipPlane();
+		const float Far = std::min(Controller.GetFarClipPlane(), m_ShadowDistance);
+		CalculateSplits(Near, Far);
+
+		// Half size of the frustum slices (at unit depth for perspective projection)
+		const Matrix4& Projection = Cam.GetProjectionMatrix();
+		const bool IsPerspective = Controller.GetProjectionMode() == ProjectionMode::Perspective;
+		const float HalfWidth = 1.0f / Projection(0, 0);
+		const float HalfHeight = 1.0f / Projection(1, 1);
+		const Matrix4 InverseView = Cam.GetViewMatrix().Inverse();
+
+		// Small movements of the light are ignored, so that the cascades (and the static cache) stay the same
+		Vector3 LightDir = LightDirection;
+		LightDir.Normalize();
+		if (Vector3::DotProduct(LightDir, m_LightDirection) < Utility::Cos(EngineConstants::ShadowLightDirectionThreshold))
+		{
+			m_LightDirection = LightDir;
+		}
+
+		// Light view only rotates the world, so the cascades can be snapped to the texels in the light space
+		const Vector3& Up = std::abs(Vector3::DotProduct(m_LightDirection, EngineConstants::UpAxis)) > 0.99f ? EngineConstants::ForwardAxis : EngineConstants::UpAxis;
+		const Matrix4 LightView = ViewMatrix::LookAt(Vector3::ZeroVector, m_LightDirection, Up);
+
+		float SliceNear = Near;
+		for (uint32_t i = 0; i < m_CascadeCount; i++)
+		{
+			ShadowCascade& Cascade = m_Cascades[i];
+			const float SliceFar = Cascade.SplitDepth;
+
+			// Corners of the frustum slice in the world space
+			Vector3 Corners[8];
+			Vector3 Center = Vector3::ZeroVector;
+			for (int c = 0; c < 8; c++)
+			{
+				float Depth = (c & 4) ? SliceFar : SliceNear;
+				float Scale = IsPerspective ? Depth : 1.0f;
+				Vector3 ViewCorner((c & 1 ? 1.0f : -1.0f) * HalfWidth * Scale, (c & 2 ? 1.0f : -1.0f) * HalfHeight * Scale, -Depth);
+
+				Corners[c] = InverseView * ViewCorner;
+				Center = Center + Corners[c];
+			}
+			Center = Center / 8.0f;
+
+			// Bounding sphere keeps the size of the cascade constant as the camera rotates
+			float Radius = 0.0f;
+			for (int c = 0; c < 8; c++)
+				Radius = std::max(Radius, Vector3::Distance(Center, Corners[c]));
+			Radius = std::ceil(Radius * 16.0f) / 16.0f;
+
+			// The cascade covers the sphere with a margin, so that its center can be snapped to a coarse grid (a multiple of the texel size, 
+			// so that the shadow edges do not shimmer). The cascade then only moves after the camera has moved a good distance, keeping the static cache valid
+			const float HalfSize = Radius * 1.125f;
+			const float TexelSize = 2.0f * HalfSize / m_Resolution;
+			const float SnapStep = TexelSize * std::max(1u, m_Resolution / 32);
+
+			Vector3 LightSpaceCenter = LightView * Center;
+			LightSpaceCenter.x = std::floor(LightSpaceCenter.x / SnapStep) * SnapStep;
+			LightSpaceCenter.y = std::floor(LightSpaceCenter.y / SnapStep) * SnapStep;
+			LightSpaceCenter.z = std::floor(LightSpaceCenter.z / SnapStep) * SnapStep;
+
+			// Light looks down the -ve z-axis, extend the near plane towards the light to include casters outside the slice
+			const float NearPlane = -LightSpaceCenter.z - HalfSize - EngineConstants::ShadowCasterExtension;
+			const float FarPlane = -LightSpaceCenter.z + HalfSize;
+
+			Cascade.LightSpaceMin = Vector3(LightSpaceCenter.x - HalfSize, LightSpaceCenter.y - HalfSize, -FarPlane);
+			Cascade.LightSpaceMax = Vector3(LightSpaceCenter.x + HalfSize, LightSpaceCenter.y + HalfSize, -NearPlane);
+
+			Cascade.LightViewMat = LightView;
+			Cascade.LightViewProjMat = ProjectionMatrix::Ortho(Cascade.LightSpaceMin.x, Cascade.LightSpaceMax.x, Cascade.LightSpaceMin.y, Cascade.LightSpaceMax.y, NearPlane, FarPlane) * LightView;
+
+			// Static casters need to be rendered again if the cascade has moved
+			if (Cascade.LightViewProjMat != m_StaticCacheMatrices[i])
+				m_StaticCacheValid[i] = false;
+
+			SliceNear = SliceFar;
+		}
+	}
+
+	void CascadedShadowMap::BindLayer(const Texture2DArray& DepthMaps, uint32_t Index)
+	{
+		GX_ENGINE_ASSERT(Index < m_CascadeCount, "Shadow cascade index out of range");
+
+		// Save the viewport before rendering the first cascade
+		if (!m_IsBound)
+		{
+			RenderDevice::Get().GetIntegerv(GL_VIEWPORT, m_Viewport);
+			m_IsBound = true;
+		}
+
+		RenderDevice::Get().BindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
+		RenderDevice::Get().FramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, DepthMaps.GetID(), 0, Index);
+		RenderDevice::Get().Viewport(0, 0, m_Resolution, m_Resolution);
+
+		// Casters in front of the near plane are flattened on to it instead of being clipped
+		RenderDevice::Get().Enable(GL_DEPTH_CLAMP);
+	}
+
+	void CascadedShadowMap::BindCascade(uint32_t Index, bool CopyStaticCache)
+	{
+		GX_PROFILE_FUNCTION()
+
+		if (CopyStaticCache)
+		{
+			GX_ENGINE_ASSERT(m_StaticCacheSupported, "Static shadow cache is not supported by the device");
+			GX_ENGINE_ASSERT(m_StaticCacheValid[Index], "Static shadow cache copied before being rendered");
+			RenderDevice::Get().CopyImageSubData(m_StaticDepthMaps->GetID(), GL_TEXTURE_2D_ARRAY, 0, 0, 0, Index, m_DepthMaps->GetID(), GL_TEXTURE_2D_ARRAY, 0, 0, 0, Index, m_Resolution, m_Resolution, 1);
+		}
+
+		BindLayer(*m_DepthMaps, Index);
+	}
+
+	void CascadedShadowMap::BindStaticCascade(uint32_t Index)
+	{
+		GX_PROFILE_FUNCTION()
+
+		GX_ENGINE_ASSERT(m_StaticCacheSupported, "Static shadow cache is not supported by the device");
+		BindLayer(*m_StaticDepthMaps, Index);
+
+		m_StaticCacheMatrices[Index] = m_Cascades[Index].LightViewProjMat;
+		m_StaticCacheValid[Index] = true;
+	}
+
+	void CascadedShadowMap::UnBind()
+	{
+		GX_PROFILE_FUNCTION()
+
+		RenderDevice::Get().Disable(GL_DEPTH_CLAMP);
+		RenderDevice::Get().BindFramebuffer(GL_FRAMEBUFFER, 0);
+		RenderDevice::Get().Viewport(m_Viewport[0], m_Viewport[1], m_Viewport[2], m_Viewport[3]);
+
+		m_IsBound = false;
+	}
+
+	void CascadedShadowMap::SetStaticCastersSignature(size_t Signature)
+	{
+		if (Signature != m_StaticCastersSignature)
+		{
+			m_StaticCastersSignature = Signature;
+			InvalidateStaticCache();
+		}
+	}
+
+	void CascadedShadowMap::InvalidateStaticCache()
+	{
+		for (uint32_t i = 0; i < MaxCascades; i++)
+			m_StaticCacheValid[i] = false;
+	}
+
+	void CascadedShadowMap::BindDepthMap(unsigned int slot) const
+	{
+		GX_PROFILE_FUNCTION()
+
+		m_DepthMaps->Bind(slot);
+	}
+
+	void CascadedShadowMap::SetShaderUniforms(Shader& shader, unsigned int slot) const
+	{
+		GX_PROFILE_FUNCTION()
+
+		shader.SetUniform1i("u_ShadowMap", slot);
+		shader.SetUniform1i("u_CascadeCount", m_CascadeCount);
+		for (uint32_t i = 0; i < m_CascadeCount; i++)
+		{
+			shader.SetUniformMat4f(s_LightSpaceMatrixNames[i], m_Cascades[i].LightViewProjMat);
+			shader.SetUniform1f(s_CascadeSplitNames[i], m_Cascades[i].SplitDepth);
+		}
+	}
+
+	CascadedShadowMap::~CascadedShadowMap()
+	{
+		GX_PROFILE_FUNCTION()
+
+		RenderDevice::Get().DeleteFramebuffers(1, &m_RendererID);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "Engine/Core/RendererAsset.h"
+
+namespace GraphX
+{
+	class Shader;
+	class Texture2DArray;
+	class CameraController;
+
+	/* Shadow information for a single cascade (slice of the camera frustum) */
+	struct ShadowCascade
+	{
+		/* Rotation only view matrix of the light (shared by all the cascades) */
+		GM::Matrix4 LightViewMat;
+
+		/* Combined View and projection matrix used to render the cascade */
+		GM::Matrix4 LightViewProjMat;
+
+		/* Extents of the cascade in the light view space (Light looks down the -ve z-axis, so Max.z is the near plane) */
+		GM::Vector3 LightSpaceMin, LightSpaceMax;
+
+		/* Distance from the camera (along the view direction) at which the cascade ends */
+		float SplitDepth = 0.0f;
+
+		/* 
+		* Returns whether the box (in world space) can cast a shadow in the cascade 
+		* The volume of the cascade is extended all the way towards the light, so that the casters outside the cascade shadowing the receivers inside it are kept
+		*/
+		bool Overlaps(const GM::BoundingBox& Box) const;
+	};
+
+	/* 
+	* Shadow map for a directional light split in to multiple cascades 
+	* Each cascade covers a slice of the camera frustum and is rendered in to a separate layer of a depth texture array
+	*/
+	class CascadedShadowMap
+		: public RendererAsset
+	{
+	public:
+		/**
+		* @param Resolution Width and height of each cascade
+		* @param CascadeCount Number of cascades to split the camera frustum in to (2 - 4)
+		*/
+		CascadedShadowMap(uint32_t Resolution, uint32_t CascadeCount);
+
+		/* Fits the cascades to the slices of the camera frustum, as seen by a light along LightDirection */
+		void Update(const CameraController& Controller, const GM::Vector3& LightDirection);
+
+		/* 
+		* Binds the framebuffer for rendering the cascade (Viewport is changed to the cascade resolution) 
+		* If CopyStaticCache is set, the cascade starts with the cached depth of the static casters (and should not be cleared)
+		*/
+		void BindCascade(uint32_t Index, bool CopyStaticCache = false);
+
+		/* Binds the framebuffer for rendering the static casters of the cascade in to the cache (Cache is considered up to date afterwards) */
+		void BindStaticCascade(uint32_t Index);
+
+		/* Un binds the framebuffer and restores the viewport */
+		void UnBind();
+
+		/* Returns whether the device can copy the static cache in to the cascades (Needs OpenGL 4.3 or ARB_copy_image), otherwise all the casters are rendered every frame */
+		inline bool IsStaticCacheSupported() const { return m_StaticCacheSupported; }
+
+		/* Returns whether the cached depth of the static casters of the cascade is up to date */
+		inline bool IsStaticCacheValid(uint32_t Index) const { return m_StaticCacheValid[Index]; }
+
+		/* Invalidates the static cache if the signature of the static casters has changed */
+		void SetStaticCastersSignature(size_t Signature);
+
+		/* Forces the static casters to be rendered again */
+		void InvalidateStaticCache();
+
+		/* Binds the depth maps of all the cascades */
+		void BindDepthMap(unsigned int slot = 0) const;
+
+		/* Sets the uniforms required for sampling the shadow map in the shader (shader should be bound) */
+		void SetShaderUniforms(Shader& shader, unsigned int slot) const;
+
+		/* Changes the number of cascades used (2 - 4) */
+		void SetCascadeCount(uint32_t CascadeCount);
+
+		/* Sets the blend factor between the logarithmic (1) and the uniform (0) split scheme */
+		inline void SetSplitLambda(float Lambda) { m_SplitLambda = Lambda; }
+
+		/* Sets the maximum distance from the camera upto which the shadows are rendered */
+		inline void SetShadowDistance(float Distance) { m_ShadowDistance = Distance; }
+
+		/* Returns the cascade at the index */
+		inline const ShadowCascade& GetCascade(uint32_t Index) const { return m_Cascades[Index]; }
+
+		/* Returns the number of cascades used */
+		inline uint32_t GetCascadeCount() const { return m_CascadeCount; }
+
+		/* Returns the resolution of each cascade */
+		inline uint32_t GetResolution() const { return m_Resolution; }
+
+		/* Returns the depth maps of the cascades */
+		inline const Scope<Texture2DArray>& GetDepthMaps() const { return m_DepthMaps; }
+
+		~CascadedShadowMap();
+
+	public:
+		/* Maximum number of cascades supported */
+		static constexpr uint32_t MaxCascades = 4;
+
+	private:
+		/* (Re) Creates the depth texture array for the current cascade count */
+		void CreateDepthMaps();
+
+		/* Calculates the far depth of each cascade using the practical split scheme */
+		void CalculateSplits(float Near, float Far);
+
+		/* Attaches the layer of the depth maps to the framebuffer and binds it */
+		void BindLayer(const Texture2DArray& DepthMaps, uint32_t Index);
+
+	private:
+		/* Depth maps of the cascades (one layer per cascade) */
+		Scope<Texture2DArray> m_DepthMaps;
+
+		/* Depth of only the static casters for each cascade, copied in to the cascades before rendering the dynamic casters (Only when the copy is supported) */
+		Scope<Texture2DArray> m_StaticDepthMaps;
+
+		/* Whether the static cache can be copied in to the cascades */
+		bool m_StaticCacheSupported;
+
+		/* Whether the static cache of the cascade is up to date */
+		bool m_StaticCacheValid[MaxCascades];
+
+		/* Matrices of the cascades at the time their static cache was rendered */
+		GM::Matrix4 m_StaticCacheMatrices[MaxCascades];
+
+		/* Signature of the static casters in the cache */
+		size_t m_StaticCastersSignature;
+
+		/* Direction of the light used for the cascades (Only updated once the light moves past a threshold) */
+		GM::Vector3 m_LightDirection;
+
+		/* Cascades in the order of increasing distance from the camera */
+		ShadowCascade m_Cascades[MaxCascades];
+
+		/* Width and height of each cascade */
+		uint32_t m_Resolution;
+
+		/* Number of cascades currently used */
+		uint32_t m_CascadeCount;
+
+		/* Blend factor between the logarithmic and the uniform split scheme */
+		float m_SplitLambda;
+
+		/* Distance from the camera upto which the shadows are rendered */
+		float m_ShadowDistance;
+
+		/* Viewport to restore after the cascades have been rendered */
+		int m_Viewport[4];
+
+		/* Whether the framebuffer is currently bound */
+		bool m_IsBound;
+	};
+}
\ No newline at end of file
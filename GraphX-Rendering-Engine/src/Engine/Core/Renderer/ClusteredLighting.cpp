@@ -0,0 +1,84 @@
+#include "pch.h"
+#include "ClusteredLighting.h"
+#include "GL/glew.h"
+
+#include "Buffers/TextureBuffer.h"
+#include "Shaders/Shader.h"
+#include "Entities/Camera.h"
+#include "Entities/Lights/PointLight.h"
+
+#include "Engine/Controllers/CameraController.h"
+
+namespace GraphX
+{
+	ClusteredLighting::ClusteredLighting()
+		: m_Grid(EngineConstants::LightClusterTilesX, EngineConstants::LightClusterTilesY, EngineConstants::LightClusterSlices), m_ViewportSize(1.0f, 1.0f)
+	{
+		GX_PROFILE_FUNCTION()
+
+		m_LightDataBuffer = CreateScope<TextureBuffer>(GL_RGBA32F);
+		m_ClusterDataBuffer = CreateScope<TextureBuffer>(GL_RG32UI);
+		m_LightIndicesBuffer = CreateScope<TextureBuffer>(GL_R32UI);
+	}
+
+	void ClusteredLighting::Update(const CameraController& Controller, const std::vector<Ref<PointLight>>& Lights, const GM::Vector2& ViewportSize)
+	{
+		GX_PROFILE_FUNCTION()
+
+		m_ViewportSize = ViewportSize;
+
+		m_LightData.resize(Lights.size());
+		for (uint32_t i = 0; i < Lights.size(); i++)
+		{
+			const PointLight& Light = *Lights[i];
+			ClusterLightData& Data = m_LightData[i];
+
+			Data.PositionRange = GM::Vector4(Light.Position.x, Light.Position.y, Light.Position.z, Light.GetRange());
+			Data.Color = Light.Color * Light.Intensity;
+			Data.AttenuationFactors = GM::Vector4(Light.GetAttenuationFactors(), 0.0f);
+		}
+
+		// View of the camera (Half extents from the projection work for both the perspective and the orthographic projection)
+		const Camera& Cam = Controller.GetCamera();
+		const GM::Matrix4& Projection = Cam.GetProjectionMatrix();
+
+		ClusterView View;
+		View.ViewMatrix = Cam.GetViewMatrix();
+		View.HalfWidth = 1.0f / Projection(0, 0);
+		View.HalfHeight = 1.0f / Projection(1, 1);
+		View.IsPerspective = Controller.GetProjectionMode() == ProjectionMode::Perspective;
+		View.Near = Controller.GetNearClipPlane();
+		View.Far = Controller.GetFarClipPlane();
+
+		m_Grid.AssignLights(View, m_LightData, EngineConstants::GThreadPoolThreadCount);
+
+		// Upload the light lists
+		const std::vector<uint32_t>& ClusterData = m_Grid.GetClusterData();
+		const std::vector<uint32_t>& LightIndices = m_Grid.GetLightIndices();
+
+		m_LightDataBuffer->SetData(m_LightData.data(), (uint32_t)(m_LightData.size() * sizeof(ClusterLightData)));
+		m_ClusterDataBuffer->SetData(ClusterData.data(), (uint32_t)(ClusterData.size() * sizeof(uint32_t)));
+		m_LightIndicesBuffer->SetData(LightIndices.data(), (uint32_t)(LightIndices.size() * sizeof(uint32_t)));
+	}
+
+	void ClusteredLighting::Enable(Shader& shader) const
+	{
+		GX_PROFILE_FUNCTION()
+
+		m_LightDataBuffer->Bind(EngineConstants::LightDataTextureSlot);
+		m_ClusterDataBuffer->Bind(EngineConstants::LightClusterDataTextureSlot);
+		m_LightIndicesBuffer->Bind(EngineConstants::LightIndicesTextureSlot);
+
+		shader.SetUniform1i("u_LightData", EngineConstants::LightDataTextureSlot);
+		shader.SetUniform1i("u_ClusterData", EngineConstants::LightClusterDataTextureSlot);
+		shader.SetUniform1i("u_LightIndices", EngineConstants::LightIndicesTextureSlot);
+
+		shader.SetUniform3i("u_ClusterGridSize", m_Grid.GetTilesX(), m_Grid.GetTilesY(), m_Grid.GetSlices());
+		shader.SetUniform2f("u_ClusterDepthParams", m_Grid.GetDepthSliceParams());
+		shader.SetUniform2f("u_ViewportSize", m_ViewportSize);
+	}
+
+	ClusteredLighting::~ClusteredLighting()
+	{
+	}
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "LightClusterGrid.h"
+
+namespace GraphX
+{
+	class Shader;
+	class PointLight;
+	class TextureBuffer;
+	class CameraController;
+
+	/*
+	* Forward shading with many point lights
+	* The camera view is split in to clusters and each fragment only shades the lights affecting its cluster
+	* Light data and the light lists are passed to the shaders through buffer textures
+	*/
+	class ClusteredLighting
+	{
+	public:
+		ClusteredLighting();
+
+		/* Assigns the point lights to the clusters of the camera view and uploads the light lists (once per frame before the lit passes) */
+		void Update(const CameraController& Controller, const std::vector<Ref<PointLight>>& Lights, const GM::Vector2& ViewportSize);
+
+		/* Binds the light lists and sets the uniforms required for the clustered shading */
+		void Enable(Shader& shader) const;
+
+		/* Returns the number of point lights submitted in the last update */
+		inline uint32_t GetLightCount() const { return (uint32_t)m_LightData.size(); }
+
+		/* Returns the cluster grid */
+		inline const LightClusterGrid& GetGrid() const { return m_Grid; }
+
+		~ClusteredLighting();
+
+	private:
+		/* Grid the lights are assigned to */
+		LightClusterGrid m_Grid;
+
+		/* Data of the point lights (in the format used by the shaders) */
+		std::vector<ClusterLightData> m_LightData;
+
+		/* Size of the viewport the clusters are laid over */
+		GM::Vector2 m_ViewportSize;
+
+		/* Buffers for the light data, the (offset, count) of each cluster and the light indices */
+		Scope<TextureBuffer> m_LightDataBuffer;
+		Scope<TextureBuffer> m_ClusterDataBuffer;
+		Scope<TextureBuffer> m_LightIndicesBuffer;
+	};
+}
\ No newline at end of file
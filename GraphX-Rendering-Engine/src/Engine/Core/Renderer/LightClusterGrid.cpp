@@ -0,0 +1,190 @@
+#include "pch.h"
+#include "LightClusterGrid.h"
+
+#include "Subsystems/Multithreading/Multithreading.h"
+
+namespace GraphX
+{
+	LightClusterGrid::LightClusterGrid(uint32_t TilesX, uint32_t TilesY, uint32_t Slices)
+		: m_TilesX(TilesX), m_TilesY(TilesY), m_Slices(Slices), m_DepthSliceParams(0.0f, 0.0f)
+	{
+		GX_ENGINE_ASSERT(TilesX > 0 && TilesY > 0 && Slices > 0, "Light cluster grid must have atleast one cluster");
+
+		m_SliceLights.resize(m_Slices);
+		m_ClusterData.resize(2 * GetClusterCount(), 0);
+	}
+
+	void LightClusterGrid::AssignLights(const ClusterView& View, const std::vector<ClusterLightData>& Lights, uint32_t WorkerCount)
+	{
+		GX_PROFILE_FUNCTION()
+
+		GX_ENGINE_ASSERT(View.Near > 0.0f && View.Far > View.Near, "Invalid view depth range for the light clusters");
+
+		m_View = View;
+
+		// Slice = log(Depth / Near) / log(Far / Near) * Slices
+		float LogDepthRange = std::log(m_View.Far / m_View.Near);
+		m_DepthSliceParams.x = (float)m_Slices / LogDepthRange;
+		m_DepthSliceParams.y = -(float)m_Slices * std::log(m_View.Near) / LogDepthRange;
+
+		// Bin the lights in to the slices they overlap
+		for (std::vector<ViewLight>& SliceLights : m_SliceLights)
+			SliceLights.clear();
+
+		for (uint32_t i = 0; i < Lights.size(); i++)
+		{
+			const GM::Vector4& PositionRange = Lights[i].PositionRange;
+			GM::Vector4 ViewPosition = m_View.ViewMatrix * GM::Vector4(PositionRange.x, PositionRange.y, PositionRange.z, 1.0f);
+			float Depth = -ViewPosition.z;
+			float Range = PositionRange.w;
+
+			// Light is completely behind the camera or beyond the far plane
+			if (Depth + Range < m_View.Near || Depth - Range > m_View.Far)
+				continue;
+
+			uint32_t FirstSlice = GetSlice(Depth - Range);
+			uint32_t LastSlice = GetSlice(Depth + Range);
+			for (uint32_t Slice = FirstSlice; Slice <= LastSlice; Slice++)
+				m_SliceLights[Slice].push_back({ i, GM::Vector3(ViewPosition.x, ViewPosition.y, ViewPosition.z), Range });
+		}
+
+		// Split the slices across the workers, calling thread works on the first range of slices
+		WorkerCount = WorkerCount < 1 ? 1 : (WorkerCount > m_Slices ? m_Slices : WorkerCount);
+		uint32_t SlicesPerWorker = (m_Slices + WorkerCount - 1) / WorkerCount;
+
+		std::vector<std::vector<uint32_t>> WorkerIndices(WorkerCount);
+		std::vector<std::future<void>> Workers;
+		Workers.reserve(WorkerCount);
+
+		for (uint32_t Worker = 1; Worker < WorkerCount; Worker++)
+		{
+			uint32_t FirstSlice = Worker * SlicesPerWorker;
+			uint32_t LastSlice = std::min(FirstSlice + SlicesPerWorker, m_Slices);
+			std::vector<uint32_t>* Indices = &WorkerIndices[Worker];
+
+			if (FirstSlice < LastSlice)
+				Workers.push_back(Async<void>(AsyncExecutionPolicy::ThreadPool, [this, FirstSlice, LastSlice, Indices]() { AssignSlices(FirstSlice, LastSlice, *Indices); }));
+		}
+
+		AssignSlices(0, std::min(SlicesPerWorker, m_Slices), WorkerIndices[0]);
+
+		for (std::future<void>& Worker : Workers)
+			Worker.wait();
+
+		// Merge the light indices of all the workers, offsetting the clusters of each worker to the merged list
+		m_LightIndices.clear();
+		for (uint32_t Worker = 0; Worker < WorkerCount; Worker++)
+		{
+			uint32_t Offset = (uint32_t)m_LightIndices.size();
+			uint32_t FirstSlice = Worker * SlicesPerWorker;
+			uint32_t LastSlice = std::min(FirstSlice + SlicesPerWorker, m_Slices);
+
+			if (Offset > 0)
+			{
+				for (uint32_t Cluster = GetClusterIndex(0, 0, FirstSlice); Cluster < GetClusterIndex(0, 0, LastSlice); Cluster++)
+					m_ClusterData[2 * Cluster] += Offset;
+			}
+
+			m_LightIndices.insert(m_LightIndices.end(), WorkerIndices[Worker].begin(), WorkerIndices[Worker].end());
+		}
+	}
+
+	uint32_t LightClusterGrid::GetSlice(float Depth) const
+	{
+		if (Depth <= m_View.Near)
+			return 0;
+
+		int32_t Slice = (int32_t)(std::log(Depth) * m_DepthSliceParams.x + m_DepthSliceParams.y);
+		return (uint32_t)std::min(std::max(Slice, 0), (int32_t)m_Slices - 1);
+	}
+
+	float LightClusterGrid::GetSliceDepth(uint32_t Slice) const
+	{
+		return m_View.Near * std::pow(m_View.Far / m_View.Near, (float)Slice / m_Slices);
+	}
+
+	void LightClusterGrid::AssignSlices(uint32_t FirstSlice, uint32_t LastSlice, std::vector<uint32_t>& OutIndices)
+	{
+		GX_PROFILE_FUNCTION()
+
+		OutIndices.clear();
+
+		// Range of the tiles each light in the slice can affect
+		std::vector<uint32_t> TileRanges;
+
+		for (uint32_t Slice = FirstSlice; Slice < LastSlice; Slice++)
+		{
+			const std::vector<ViewLight>& SliceLights = m_SliceLights[Slice];
+			float NearDepth = GetSliceDepth(Slice);
+			float FarDepth = GetSliceDepth(Slice + 1);
+
+			TileRanges.resize(4 * SliceLights.size());
+			for (uint32_t i = 0; i < SliceLights.size(); i++)
+			{
+				const ViewLight& Light = SliceLights[i];
+				float LightNear = std::max(NearDepth, -Light.Position.z - Light.Range);
+				float LightFar = std::min(FarDepth, -Light.Position.z + Light.Range);
+
+				GetTileRange(Light.Position.x - Light.Range, Light.Position.x + Light.Range, LightNear, LightFar, m_View.HalfWidth, m_TilesX, TileRanges[4 * i], TileRanges[4 * i + 1]);
+				GetTileRange(Light.Position.y - Light.Range, Light.Position.y + Light.Range, LightNear, LightFar, m_View.HalfHeight, m_TilesY, TileRanges[4 * i + 2], TileRanges[4 * i + 3]);
+			}
+
+			for (uint32_t y = 0; y < m_TilesY; y++)
+			{
+				// Extents of the tile row in the NDC
+				float MinY = 2.0f * y / m_TilesY - 1.0f;
+				float MaxY = 2.0f * (y + 1) / m_TilesY - 1.0f;
+
+				for (uint32_t x = 0; x < m_TilesX; x++)
+				{
+					uint32_t Cluster = GetClusterIndex(x, y, Slice);
+					m_ClusterData[2 * Cluster] = (uint32_t)OutIndices.size();
+
+					float MinX = 2.0f * x / m_TilesX - 1.0f;
+					float MaxX = 2.0f * (x + 1) / m_TilesX - 1.0f;
+
+					// Bounding box of the cluster in the view space
+					float NearScale = m_View.IsPerspective ? NearDepth : 1.0f;
+					float FarScale = m_View.IsPerspective ? FarDepth : 1.0f;
+					GM::Vector3 BoxMin(std::min(MinX * NearScale, MinX * FarScale) * m_View.HalfWidth, std::min(MinY * NearScale, MinY * FarScale) * m_View.HalfHeight, -FarDepth);
+					GM::Vector3 BoxMax(std::max(MaxX * NearScale, MaxX * FarScale) * m_View.HalfWidth, std::max(MaxY * NearScale, MaxY * FarScale) * m_View.HalfHeight, -NearDepth);
+
+					for (uint32_t i = 0; i < SliceLights.size(); i++)
+					{
+						if (x < TileRanges[4 * i] || x > TileRanges[4 * i + 1] || y < TileRanges[4 * i + 2] || y > TileRanges[4 * i + 3])
+							continue;
+
+						// Sphere vs box test using the closest point on the box to the light
+						const ViewLight& Light = SliceLights[i];
+						float dx = Light.Position.x - std::min(std::max(Light.Position.x, BoxMin.x), BoxMax.x);
+						float dy = Light.Position.y - std::min(std::max(Light.Position.y, BoxMin.y), BoxMax.y);
+						float dz = Light.Position.z - std::min(std::max(Light.Position.z, BoxMin.z), BoxMax.z);
+
+						if (dx * dx + dy * dy + dz * dz <= Light.Range * Light.Range)
+							OutIndices.push_back(Light.Index);
+					}
+
+					m_ClusterData[2 * Cluster + 1] = (uint32_t)OutIndices.size() - m_ClusterData[2 * Cluster];
+				}
+			}
+		}
+	}
+
+	void LightClusterGrid::GetTileRange(float Min, float Max, float NearDepth, float FarDepth, float HalfSize, uint32_t Tiles, uint32_t& OutFirst, uint32_t& OutLast) const
+	{
+		// Extents of the light in the NDC (Conservative over the depth range for perspective projection)
+		float MinNDC = Min / HalfSize;
+		float MaxNDC = Max / HalfSize;
+		if (m_View.IsPerspective)
+		{
+			MinNDC = std::min(MinNDC / NearDepth, MinNDC / FarDepth);
+			MaxNDC = std::max(MaxNDC / NearDepth, MaxNDC / FarDepth);
+		}
+
+		float First = std::floor((MinNDC + 1.0f) * 0.5f * Tiles);
+		float Last = std::floor((MaxNDC + 1.0f) * 0.5f * Tiles);
+
+		OutFirst = (uint32_t)std::min(std::max(First, 0.0f), (float)Tiles - 1);
+		OutLast = (uint32_t)std::min(std::max(Last, 0.0f), (float)Tiles - 1);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+#pragma once
+
+namespace GraphX
+{
+	/* Point light data as uploaded to the GPU (3 RGBA32F texels per light) */
+	struct ClusterLightData
+	{
+		/* World position (xyz) and range (w) of the light */
+		GM::Vector4 PositionRange;
+
+		/* Color of the light (multiplied by the intensity) */
+		GM::Vector4 Color;
+
+		/* Attenuation factors (constant, linear & quadratic) of the light */
+		GM::Vector4 AttenuationFactors;
+	};
+
+	/* View of the camera for which the lights are assigned to the clusters */
+	struct ClusterView
+	{
+		/* View matrix of the camera (Camera looks down the -ve z-axis) */
+		GM::Matrix4 ViewMatrix;
+
+		/* Half width and height of the view (at unit depth for perspective projection) */
+		float HalfWidth = 1.0f, HalfHeight = 1.0f;
+
+		/* Whether the view uses perspective projection */
+		bool IsPerspective = true;
+
+		/* Near and far planes of the view */
+		float Near = 0.1f, Far = 1000.0f;
+	};
+
+	/*
+	* Splits the view frustum in to a 3D grid of clusters (froxels): screen space tiles along x & y and exponential slices along the depth
+	* and finds the point lights affecting each cluster. Only the CPU side of the clustered lighting (no rendering API calls)
+	*/
+	class LightClusterGrid
+	{
+	public:
+		/**
+		* @param TilesX Number of tiles along the width of the screen
+		* @param TilesY Number of tiles along the height of the screen
+		* @param Slices Number of slices along the depth of the view
+		*/
+		LightClusterGrid(uint32_t TilesX, uint32_t TilesY, uint32_t Slices);
+
+		/**
+		* Assigns the lights to the clusters they affect
+		* @param WorkerCount Number of threads the slices are split across (calling thread is one of the workers)
+		*/
+		void AssignLights(const ClusterView& View, const std::vector<ClusterLightData>& Lights, uint32_t WorkerCount = 1);
+
+		/* Returns the index of the cluster */
+		inline uint32_t GetClusterIndex(uint32_t X, uint32_t Y, uint32_t Slice) const { return X + m_TilesX * (Y + m_TilesY * Slice); }
+
+		/* Returns the slice containing the view depth (distance along the view direction) */
+		uint32_t GetSlice(float Depth) const;
+
+		/* Returns the view depth at which the slice starts */
+		float GetSliceDepth(uint32_t Slice) const;
+
+		/* Returns the offset (in to the light indices) and the number of lights for each cluster (2 values per cluster) */
+		inline const std::vector<uint32_t>& GetClusterData() const { return m_ClusterData; }
+
+		/* Returns the indices of the lights affecting the clusters */
+		inline const std::vector<uint32_t>& GetLightIndices() const { return m_LightIndices; }
+
+		/* Returns the scale (x) and the bias (y) converting the log of the view depth to the slice (Slice = log(Depth) * x + y) */
+		inline const GM::Vector2& GetDepthSliceParams() const { return m_DepthSliceParams; }
+
+		/* Returns the number of clusters in the grid */
+		inline uint32_t GetClusterCount() const { return m_TilesX * m_TilesY * m_Slices; }
+
+		inline uint32_t GetTilesX() const { return m_TilesX; }
+		inline uint32_t GetTilesY() const { return m_TilesY; }
+		inline uint32_t GetSlices() const { return m_Slices; }
+
+	private:
+		/* Light in the view space, binned in to the slices it overlaps */
+		struct ViewLight
+		{
+			/* Index of the light in the lights passed for assignment */
+			uint32_t Index;
+
+			/* Position of the light in the view space */
+			GM::Vector3 Position;
+
+			/* Range of the light */
+			float Range;
+		};
+
+		/* Assigns the lights to the clusters in the range of slices (Cluster offsets are relative to OutIndices) */
+		void AssignSlices(uint32_t FirstSlice, uint32_t LastSlice, std::vector<uint32_t>& OutIndices);
+
+		/* Returns the range of tiles (along an axis) the extents of the light can overlap in the depth range */
+		void GetTileRange(float Min, float Max, float NearDepth, float FarDepth, float HalfSize, uint32_t Tiles, uint32_t& OutFirst, uint32_t& OutLast) const;
+
+	private:
+		/* Dimensions of the grid */
+		uint32_t m_TilesX, m_TilesY, m_Slices;
+
+		/* View for which the lights are being assigned */
+		ClusterView m_View;
+
+		/* Scale and bias converting log of the view depth to the slice */
+		GM::Vector2 m_DepthSliceParams;
+
+		/* Lights overlapping each slice */
+		std::vector<std::vector<ViewLight>> m_SliceLights;
+
+		/* Offset and count of the lights for each cluster */
+		std::vector<uint32_t> m_ClusterData;
+
+		/* Indices of the lights affecting the clusters */
+		std::vector<uint32_t> m_LightIndices;
+	};
+}
\ No newline at end of file
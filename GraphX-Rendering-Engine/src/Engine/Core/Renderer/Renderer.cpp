@@ -4,21 +4,27 @@
 #include "Renderer3D.h"
 #include "Renderer2D.h"
 #include "SimpleRenderer.h"
+#include "Device/RenderDevice.h"
 
-#include "Model\Mesh\Mesh2D.h"
-#include "Model\Mesh\Mesh3D.h"
+#include "Model/Mesh/Mesh2D.h"
+#include "Model/Mesh/Mesh3D.h"
 #include "Model/Cube.h"
 
 #include "Core/Buffers/VertexBuffer.h"
 #include "Core/Buffers/IndexBuffer.h"
 #include "Core/VertexArray.h"
 
-#include "Shaders\Shader.h"
+#include "Shaders/Shader.h"
+#include "Shaders/ShaderCache.h"
+#include "Textures/Texture2D.h"
+#include "Textures/TextureStreamer.h"
+#include "Materials/Material.h"
 
 #include "Entities/Camera.h"
 #include "Entities/Skybox.h"
 
 #include "Engine/Controllers/CameraController.h"
+#include "Engine/Profiler/GPUProfiler.h"
 
 #include "GL/glew.h"
 
@@ -38,16 +44,34 @@ namespace GraphX
 	Renderer::SceneInfo* Renderer::s_SceneInfo = nullptr;
 	SkyboxRenderData* Renderer::s_SkyboxData = nullptr;
 	Ref<Shader> Renderer::s_DebugShader = nullptr;
+	Ref<Material> Renderer::s_FallbackMaterial = nullptr;
 
 	void Renderer::Init()
 	{
 		GX_PROFILE_FUNCTION()
 
+		// Shaders are loaded from the cache (or compiled in the background) from here on
+		ShaderCache::Init();
+
+		// Streamed textures are decoded on the thread pool and uploaded from the frame loop
+		TextureStreamer::Init();
+
+		// Decoders check the sizes against the device limit from the worker threads
+		Texture2D::GetMaxSize();
+
 		s_Renderer   = new SimpleRenderer();
 
+		// Fallback has to be usable straight away, so it is the only shader waited for
+		Ref<Shader> FallbackShader = s_ShaderLibrary.Load("res/Shaders/FallbackShader.glsl", "Fallback");
+		FallbackShader->WaitUntilReady();
+		s_FallbackMaterial = CreateRef<Material>(FallbackShader);
+		s_FallbackMaterial->SetBaseColor(GM::Vector4(0.5f, 0.5f, 0.5f, 1.0f));
+
 		Renderer2D::Init();
 		Renderer3D::Init();
 
+		GPUProfiler::Init();
+
 		s_SceneInfo = new Renderer::SceneInfo();
 
 		// Setup the skybox render data
@@ -94,6 +118,10 @@ namespace GraphX
 		Renderer2D::Shutdown();
 		Renderer3D::Shutdown();
 
+		GPUProfiler::Shutdown();
+
+		TextureStreamer::Shutdown();
+
 		if (!s_Renderer)
 		{
 			GX_ENGINE_WARN("Renderer::Shutdown called more than once.");
@@ -121,6 +149,10 @@ namespace GraphX
 		{
 			s_DebugShader.reset();
 		}
+
+		s_FallbackMaterial.reset();
+
+		ShaderCache::Shutdown();
 	}
 
 	void Renderer::BeginScene(const Ref<Camera>& MainCamera)
@@ -137,6 +169,10 @@ namespace GraphX
 			s_DebugShader->SetUniformMat4f("u_ViewProjection", MainCamera->GetProjectionViewMatrix());
 			s_DebugShader->SetUniform4f("u_DebugColor", 1.0f, 0.0f, 0.0f, 1.0f);
 		}
+
+		const Ref<Shader>& FallbackShader = s_FallbackMaterial->GetShader();
+		FallbackShader->Bind();
+		FallbackShader->SetUniformMat4f("u_ProjectionView", MainCamera->GetProjectionViewMatrix());
 	}
 
 	void Renderer::EndScene()
@@ -167,8 +203,8 @@ namespace GraphX
 		skybox->Enable();
 
 		// TODO: Think about doing it using render commands
-		glDepthMask(GL_FALSE);
-		glDisable(GL_CULL_FACE);
+		RenderDevice::Get().DepthMask(false);
+		RenderDevice::Get().Disable(GL_CULL_FACE);
 
 		// Set the uniforms
 		s_SkyboxData->SkyboxShader->Bind();
@@ -187,8 +223,8 @@ namespace GraphX
 
 		skybox->Disable();
 
-		glDepthMask(GL_TRUE);
-		glEnable(GL_CULL_FACE);
+		RenderDevice::Get().DepthMask(true);
+		RenderDevice::Get().Enable(GL_CULL_FACE);
 	}
 
 	void Renderer::Render()
@@ -197,10 +233,53 @@ namespace GraphX
 		Renderer2D::Render();
 	}
 
-	void Renderer::RenderDepth(Shader& DepthShader)
+	void Renderer::RenderDepth(Shader& DepthShader, DepthPassType Pass, const ShadowCascade* Cascade, ShadowCasterType Casters)
+	{
+		Renderer3D::Render(DepthShader, Pass, Cascade, Casters);
+
+		// 2D meshes are always treated as dynamic
+		if (Casters != ShadowCasterType::Static)
+			Renderer2D::Render(DepthShader);
+	}
+
+	void Renderer::BeginDepthPrePass(Shader& DepthShader)
+	{
+		GX_PROFILE_FUNCTION()
+
+		CheckRenderer();
+
+		DepthShader.Bind();
+		DepthShader.SetUniformMat4f("u_LightSpaceMatrix", s_SceneInfo->SceneCamera->GetProjectionViewMatrix());
+
+		RenderDevice::Get().ColorMask(false, false, false, false);
+	}
+
+	void Renderer::EndDepthPrePass()
+	{
+		GX_PROFILE_FUNCTION()
+
+		RenderDevice::Get().ColorMask(true, true, true, true);
+	}
+
+	void Renderer::BeginPrePassedColorPass()
 	{
-		Renderer3D::Render(DepthShader);
-		Renderer2D::Render(DepthShader);
+		GX_PROFILE_FUNCTION()
+
+		// Depth is already in the buffer, fragments hidden behind other meshes fail the test before shading
+		RenderDevice::Get().DepthFunc(GL_EQUAL);
+		RenderDevice::Get().DepthMask(false);
+
+		s_SceneInfo->IsPrePassedColorPass = true;
+	}
+
+	void Renderer::EndPrePassedColorPass()
+	{
+		GX_PROFILE_FUNCTION()
+
+		RenderDevice::Get().DepthFunc(GL_LESS);
+		RenderDevice::Get().DepthMask(true);
+
+		s_SceneInfo->IsPrePassedColorPass = false;
 	}
 
 	void Renderer::Render(unsigned int Count)
@@ -8,6 +8,7 @@ namespace GraphX
 	class Mesh2D;
 	class Mesh3D;
 	class Shader;
+	class Material;
 	class IndexBuffer;
 
 	class Camera;
@@ -50,8 +51,20 @@ namespace GraphX
 		/* Renders all the submitted meshes in the scene */
 		static void Render();
 
-		/* Renders all the submitted meshes in the scene to the depth buffer */
-		static void RenderDepth(class Shader& DepthShader);
+		/* Renders all the submitted meshes (of the type of casters) in the scene to the depth buffer (Only the meshes overlapping the shadow cascade, if provided) */
+		static void RenderDepth(class Shader& DepthShader, DepthPassType Pass, const struct ShadowCascade* Cascade = nullptr, ShadowCasterType Casters = ShadowCasterType::All);
+
+		/* Begins the depth only pre pass from the camera (Colour writes are disabled and DepthShader is bound) */
+		static void BeginDepthPrePass(class Shader& DepthShader);
+
+		/* Ends the depth pre pass */
+		static void EndDepthPrePass();
+
+		/* Begins the colour pass for the pre passed meshes. Only the visible fragments are shaded (GL_EQUAL depth test with depth writes off) */
+		static void BeginPrePassedColorPass();
+
+		/* Ends the colour pass for the pre passed meshes (Restores the default depth test) */
+		static void EndPrePassedColorPass();
 
 		/* Directly renders (without queuing) the current bound vertex array having Count number of vertices
 		* NOTE: This is not for indexed rendering
@@ -67,6 +80,9 @@ namespace GraphX
 		/* Returns the shader library */
 		static ShaderLibrary& GetShaderLibrary() { return s_ShaderLibrary; }
 
+		/* Returns the material the meshes are rendered with, while the shader of their own material is still being compiled */
+		static const Ref<Material>& GetFallbackMaterial() { return s_FallbackMaterial; }
+
 	public:
 		// Maximum number of texture slots available for the renderer 
 		static constexpr uint32_t MaxTextureImageUnits = 32;	// TODO: Move this to a more appropriate location
@@ -77,6 +93,9 @@ namespace GraphX
 			/* Main Camera of the scene */
 			Ref<Camera> SceneCamera;
 
+			/* Whether the meshes being rendered have their depth already written by the pre pass */
+			bool IsPrePassedColorPass = false;
+
 			/* Resets the scene info */
 			void Reset() {}
 		};
@@ -86,6 +105,9 @@ namespace GraphX
 
 		static Ref<Shader> s_DebugShader;
 
+		/* Always ready (compiled at the start) */
+		static Ref<Material> s_FallbackMaterial;
+
 		/* Info required for rendering current scene */
 		static SceneInfo* s_SceneInfo;
 		
@@ -1,6 +1,7 @@
 #include "pch.h"
 #include "Renderer2D.h"
-#include "Gl/glew.h"
+#include "GL/glew.h"
+#include "Engine/Core/Device/RenderDevice.h"
 
 #include "Engine/Core/Renderer/Renderer.h"
 
@@ -14,11 +15,16 @@
 #include "Engine/Core/Buffers/VertexBuffer.h"
 #include "Engine/Core/Buffers/IndexBuffer.h"
 #include "Engine/Core/Textures/Texture2D.h"
+#include "Engine/Core/Textures/Texture2DArray.h"
+#include "Engine/Core/Textures/Texture2DArrayPool.h"
+#include "Engine/Core/Textures/TextureAtlas.h"
+#include "Engine/Core/Textures/SubTexture2D.h"
 
 #include "Engine/Entities/Camera.h"
 #include "Engine/Entities/Particles/ParticleSystem.h"
 
 #include "Engine/Core/Batches/Batch2D.h"
+#include "Engine/Core/Batches/InstancedBatch2D.h"
 #include "Engine/Core/Batches/ParticleBatch.h"
 
 namespace GraphX
@@ -60,16 +66,26 @@ namespace GraphX
 		s_Data->QuadVA = CreateScope<VertexArray>();
 		s_Data->QuadVA->AddVertexBuffer(vbo, Vertex2D::VertexLayout());
 		s_Data->QuadVA->AddIndexBuffer(ibo);
+		s_Data->QuadIndexDrawType = ibo.GetDrawType();
 
 		s_Data->Batch = CreateScope<Batch2D>(MaxQuadCount);
 		s_Data->Batch->m_TextureIDs[0] = s_Data->WhiteTexture->GetID();
+
+		s_Data->InstancedBatch = CreateScope<InstancedBatch2D>(MaxQuadCount);
+		s_Data->InstancedBatch->m_TextureIDs[0] = s_Data->WhiteTexture->GetID();
+		s_Data->TextureArrays = CreateScope<Texture2DArrayPool>();
+		s_Data->SpriteAtlas = CreateScope<TextureAtlas>(EngineConstants::SpriteAtlasInitialSize, EngineConstants::SpriteAtlasMaxSize, EngineConstants::SpriteAtlasPadding);
 		
 		s_Data->ParticleBatch = CreateScope<ParticleBatch>(MaxParticlesCount);
 		s_Data->ParticleBatch->m_TextureIDs[0] = s_Data->WhiteTexture->GetID();
 
 		s_Data->BatchShader = Renderer::GetShaderLibrary().Load("res/Shaders/BatchShader2D.glsl", "Batch2D");
+		s_Data->ArrayBatchShader = Renderer::GetShaderLibrary().Load("res/Shaders/ArrayBatchShader2D.glsl", "ArrayBatch2D");
+		s_Data->InstancedBatchShader = Renderer::GetShaderLibrary().Load("res/Shaders/InstancedBatchShader2D.glsl", "InstancedBatch2D");
+		s_Data->InstancedArrayBatchShader = Renderer::GetShaderLibrary().Load("res/Shaders/InstancedArrayBatchShader2D.glsl", "InstancedArrayBatch2D");
 		s_Data->ParticleShader = Renderer::GetShaderLibrary().Load("res/Shaders/ParticleShader.glsl", "Particle");
 		s_Data->ParticleBatchShader = Renderer::GetShaderLibrary().Load("res/Shaders/ParticleBatchShader.glsl", "ParticleBatch");
+		s_Data->ParticleArrayBatchShader = Renderer::GetShaderLibrary().Load("res/Shaders/ParticleArrayBatchShader.glsl", "ParticleArrayBatch");
 
 		// Setup texture slots in the shader
 		int samplers[32];
@@ -81,8 +97,20 @@ namespace GraphX
 		s_Data->BatchShader->Bind();
 		s_Data->BatchShader->SetUniform1iv("u_Textures", 32, samplers);
 
+		s_Data->ArrayBatchShader->Bind();
+		s_Data->ArrayBatchShader->SetUniform1iv("u_TextureArrays", 32, samplers);
+
+		s_Data->InstancedBatchShader->Bind();
+		s_Data->InstancedBatchShader->SetUniform1iv("u_Textures", 32, samplers);
+
+		s_Data->InstancedArrayBatchShader->Bind();
+		s_Data->InstancedArrayBatchShader->SetUniform1iv("u_TextureArrays", 32, samplers);
+
 		s_Data->ParticleBatchShader->Bind();
 		s_Data->ParticleBatchShader->SetUniform1iv("u_Textures", 32, samplers);
+
+		s_Data->ParticleArrayBatchShader->Bind();
+		s_Data->ParticleArrayBatchShader->SetUniform1iv("u_TextureArrays", 32, samplers);
 	}
 
 	void Renderer2D::Shutdown()
@@ -100,9 +128,20 @@ namespace GraphX
 
 		GX_ENGINE_ASSERT(s_Data != nullptr, "Renderer2D not Initialised!!");
 
+		CommitSpriteAtlas();
+
+		// All the batches of the last frame are flushed, so the layers of the destroyed textures can be reused now
+		s_Data->TextureArrays->RecycleLayers();
+
 		if (GX_ENABLE_BATCH_RENDERING)
 		{
+			Texture2DArrayPool* TextureArrays = GetTextureArrayPool();
+
+			s_Data->Batch->SetTextureArrayPool(TextureArrays);
 			s_Data->Batch->BeginBatch();
+
+			s_Data->InstancedBatch->SetTextureArrayPool(TextureArrays);
+			s_Data->InstancedBatch->BeginBatch();
 		}
 
 		Ref<Camera> Cam = Renderer::s_SceneInfo->SceneCamera;
@@ -117,8 +156,20 @@ namespace GraphX
 				s_Data->BatchShader->Bind();
 				s_Data->BatchShader->SetUniformMat4f("u_ProjectionView", Cam->GetProjectionViewMatrix());
 
+				s_Data->ArrayBatchShader->Bind();
+				s_Data->ArrayBatchShader->SetUniformMat4f("u_ProjectionView", Cam->GetProjectionViewMatrix());
+
+				s_Data->InstancedBatchShader->Bind();
+				s_Data->InstancedBatchShader->SetUniformMat4f("u_ProjectionView", Cam->GetProjectionViewMatrix());
+
+				s_Data->InstancedArrayBatchShader->Bind();
+				s_Data->InstancedArrayBatchShader->SetUniformMat4f("u_ProjectionView", Cam->GetProjectionViewMatrix());
+
 				s_Data->ParticleBatchShader->Bind();
 				s_Data->ParticleBatchShader->SetUniformMat4f("u_Projection", Cam->GetProjectionMatrix());
+
+				s_Data->ParticleArrayBatchShader->Bind();
+				s_Data->ParticleArrayBatchShader->SetUniformMat4f("u_Projection", Cam->GetProjectionMatrix());
 			}
 			else
 			{
@@ -142,7 +193,10 @@ namespace GraphX
 	{
 		if (GX_ENABLE_BATCH_RENDERING)
 		{
-			s_Data->Batch->AddQuad(position, size, color);
+			if (GX_ENABLE_INSTANCED_QUADS)
+				s_Data->InstancedBatch->AddQuad(position, size, color);
+			else
+				s_Data->Batch->AddQuad(position, size, color);
 		}
 		else
 		{
@@ -160,7 +214,10 @@ namespace GraphX
 	{
 		if (GX_ENABLE_BATCH_RENDERING)
 		{
-			s_Data->Batch->AddQuad(position, size, texture, tintColor, tiling);
+			if (GX_ENABLE_INSTANCED_QUADS)
+				s_Data->InstancedBatch->AddQuad(position, size, texture, tintColor, tiling);
+			else
+				s_Data->Batch->AddQuad(position, size, texture, tintColor, tiling);
 		}
 		else
 		{
@@ -178,7 +235,10 @@ namespace GraphX
 	{
 		if (GX_ENABLE_BATCH_RENDERING)
 		{
-			s_Data->Batch->AddQuad(position, size, rotation, color);
+			if (GX_ENABLE_INSTANCED_QUADS)
+				s_Data->InstancedBatch->AddQuad(position, size, rotation, color);
+			else
+				s_Data->Batch->AddQuad(position, size, rotation, color);
 		}
 		else
 		{
@@ -196,7 +256,10 @@ namespace GraphX
 	{
 		if (GX_ENABLE_BATCH_RENDERING)
 		{
-			s_Data->Batch->AddQuad(position, size, rotation, texture, tintColor, tiling);
+			if (GX_ENABLE_INSTANCED_QUADS)
+				s_Data->InstancedBatch->AddQuad(position, size, rotation, texture, tintColor, tiling);
+			else
+				s_Data->Batch->AddQuad(position, size, rotation, texture, tintColor, tiling);
 		}
 		else
 		{
@@ -205,6 +268,21 @@ namespace GraphX
 		}
 	}
 
+	void Renderer2D::DrawQuad(const GM::Vector3& position, const GM::Vector2& size, const Ref<SubTexture2D>& subTexture, const GM::Vector4& tintColor)
+	{
+		DrawRotatedQuad(position, size, GM::Vector3::ZeroVector, subTexture, tintColor);
+	}
+
+	void Renderer2D::DrawRotatedQuad(const GM::Vector3& position, const GM::Vector2& size, const GM::Vector3& rotation, const Ref<SubTexture2D>& subTexture, const GM::Vector4& tintColor)
+	{
+		GX_ENGINE_ASSERT(GX_ENABLE_BATCH_RENDERING, "Sub textures can only be rendered with batch rendering");
+
+		if (GX_ENABLE_INSTANCED_QUADS)
+			s_Data->InstancedBatch->AddQuad(position, size, rotation, subTexture, tintColor);
+		else
+			s_Data->Batch->AddQuad(position, size, rotation, subTexture, tintColor);
+	}
+
 	void Renderer2D::DrawQuad_Internal(const GM::Matrix4& transform, const GM::Vector4& color)
 	{
 		s_Data->WhiteTexture->Bind();
@@ -215,7 +293,7 @@ namespace GraphX
 		s_Data->TextureShader->SetUniformMat4f("u_Model", transform);
 
 		s_Data->QuadVA->Bind();
-		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+		RenderDevice::Get().DrawElements(GL_TRIANGLES, 6, s_Data->QuadIndexDrawType, nullptr);
 
 		// Maintain stats
 		s_Data->Stats.QuadCount++;
@@ -235,7 +313,7 @@ namespace GraphX
 		s_Data->TextureShader->SetUniformMat4f("u_Model", transform);
 
 		s_Data->QuadVA->Bind();
-		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+		RenderDevice::Get().DrawElements(GL_TRIANGLES, 6, s_Data->QuadIndexDrawType, nullptr);
 
 		// Maintain stats
 		s_Data->Stats.QuadCount++;
@@ -255,7 +333,7 @@ namespace GraphX
 		s_Data->ShadowDebugShader->SetUniformMat4f("u_Model", model);
 
 		s_Data->QuadVA->Bind();
-		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+		RenderDevice::Get().DrawElements(GL_TRIANGLES, 6, s_Data->QuadIndexDrawType, nullptr);
 
 		// Maintain stats
 		s_Data->Stats.QuadCount++;
@@ -264,13 +342,13 @@ namespace GraphX
 		texture->UnBind();
 	}
 
-	void Renderer2D::RenderParticles(const std::unordered_map<std::string, Ref<ParticleSystem>>& ParticleSystems)
+	void Renderer2D::RenderParticles(const std::unordered_map<std::string, Ref<ParticleSystem>>& ParticleSystems, float InterpolationAlpha)
 	{
 		GX_PROFILE_FUNCTION()
 
 		if(GX_ENABLE_BATCH_RENDERING)
 		{
-			RenderParticlesBatched_Internal(ParticleSystems);
+			RenderParticlesBatched_Internal(ParticleSystems, InterpolationAlpha);
 		}
 		else
 		{
@@ -281,10 +359,10 @@ namespace GraphX
 				s_Data->ParticleShader->Bind();
 				s_Data->QuadVA->Bind();
 
-				glDepthMask(false);		// Don't render the particles to the depth buffer
+				RenderDevice::Get().DepthMask(false);		// Don't render the particles to the depth buffer
 
-				glEnable(GL_BLEND);		// To enable blending
-				glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+				RenderDevice::Get().Enable(GL_BLEND);		// To enable blending
+				RenderDevice::Get().BlendFunc(GL_SRC_ALPHA, GL_ONE);
 			}
 
 			{
@@ -314,7 +392,7 @@ namespace GraphX
 						if (particle.IsActive())
 						{
 							particle.Enable(*(s_Data->ParticleShader));
-							glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+							RenderDevice::Get().DrawElements(GL_TRIANGLES, 6, s_Data->QuadIndexDrawType, nullptr);
 							
 							// Maintain stats
 							s_Data->Stats.QuadCount++;
@@ -331,24 +409,83 @@ namespace GraphX
 				s_Data->ParticleShader->UnBind();
 				s_Data->QuadVA->UnBind();
 
-				glDepthMask(true);
-				glDisable(GL_BLEND);
+				RenderDevice::Get().DepthMask(true);
+				RenderDevice::Get().Disable(GL_BLEND);
 			}
 		}
 	}
 
-	void Renderer2D::RenderParticlesBatched_Internal(const std::unordered_map<std::string, Ref<ParticleSystem>>& ParticleSystems)
+	Ref<SubTexture2D> Renderer2D::PackInSpriteAtlas(const Texture2D& Texture)
+	{
+		GX_PROFILE_FUNCTION()
+
+		if (!GX_ENABLE_SPRITE_ATLAS || s_Data == nullptr || Texture.GetFilePath().empty())
+			return nullptr;
+
+		GX_ENGINE_ASSERT(RenderDevice::IsRenderThread(), "Sprite atlas can only be used on the render thread");
+
+		// Streamed texture has no pixels to pack yet, it is drawn on its own
+		if (!Texture.IsResident())
+			return nullptr;
+
+		// Large textures would fill the atlas up and gain little, since they are drawn on their own anyway
+		if (Texture.GetWidth() > EngineConstants::SpriteAtlasMaxImageSize || Texture.GetHeight() > EngineConstants::SpriteAtlasMaxImageSize)
+			return nullptr;
+
+		return s_Data->SpriteAtlas->Add(Texture);
+	}
+
+	Ref<SubTexture2D> Renderer2D::GetSpriteAtlasRegion(const Ref<SubTexture2D>& Image, const GM::Vector2& Min, const GM::Vector2& Max)
 	{
+		GX_ENGINE_ASSERT(RenderDevice::IsRenderThread(), "Sprite atlas can only be used on the render thread");
+
+		return s_Data->SpriteAtlas->AddRegion(Image, Min, Max);
+	}
+
+	void Renderer2D::CommitSpriteAtlas()
+	{
+		if (s_Data->SpriteAtlas->IsDirty())
+			s_Data->SpriteAtlas->Commit();
+	}
+
+	Texture2DArrayPool* Renderer2D::GetTextureArrayPool()
+	{
+		// Textures are copied in to the layers on the GPU, without the copy support the batches fall back to the texture slots
+		static const bool IsSupported = Texture2DArray::IsCopySupported();
+
+		return (GX_ENABLE_TEXTURE_ARRAY_BATCHING && IsSupported) ? s_Data->TextureArrays.get() : nullptr;
+	}
+
+	void Renderer2D::RenderParticlesBatched_Internal(const std::unordered_map<std::string, Ref<ParticleSystem>>& ParticleSystems, float InterpolationAlpha)
+	{
+		CommitSpriteAtlas();
+
 		// Current Camera rotation plus the Rotation offset used for transforming coordinate axes
 		const GM::Matrix4& ViewMatrix = Renderer::s_SceneInfo->SceneCamera->GetViewMatrix();
+		s_Data->ParticleBatch->SetTextureArrayPool(GetTextureArrayPool());
 		s_Data->ParticleBatch->BeginBatch();
 
 		for (const auto& pair : ParticleSystems)
 		{
 			const Ref<ParticleSystem>& System = pair.second;
 			const Ref<Texture2D>& Texture = System->GetConfig().ParticleProperties.Texture;
+			const Ref<SubTexture2D>& AtlasImage = System->GetAtlasImage();
 
-			if (Texture)
+			if (AtlasImage)
+			{
+				for (const Particle& particle : System.operator*())
+				{
+					if (particle.IsActive())
+					{
+						const ParticleProps& props = particle.GetProps();
+						GM::Rotator ParticleRotation(0.0f, 0.0f, props.Rotation);
+						GM::Vector3 ParticlePosition = ViewMatrix * particle.GetInterpolatedPosition(InterpolationAlpha);
+						float scale = GM::Utility::Lerp(props.SizeBegin, props.SizeEnd, particle.GetLifeProgress());
+						s_Data->ParticleBatch->AddParticle(ParticlePosition, { scale, scale }, ParticleRotation, AtlasImage, GM::Vector4::UnitVector);
+					}
+				}
+			}
+			else if (Texture)
 			{
 				for (const Particle& particle : System.operator*())
 				{
@@ -356,7 +493,7 @@ namespace GraphX
 					{
 						const ParticleProps& props = particle.GetProps();
 						GM::Rotator ParticleRotation(0.0f, 0.0f, props.Rotation);
-						GM::Vector3 ParticlePosition = ViewMatrix * props.Position;
+						GM::Vector3 ParticlePosition = ViewMatrix * particle.GetInterpolatedPosition(InterpolationAlpha);
 						float scale = GM::Utility::Lerp(props.SizeBegin, props.SizeEnd, particle.GetLifeProgress());
 						s_Data->ParticleBatch->AddParticle(ParticlePosition, { scale, scale }, ParticleRotation, Texture, particle.GetSubTextureIndex1(), particle.GetSubTextureIndex2(), GM::Vector4::UnitVector, particle.GetBlendFactor());
 					}
@@ -370,7 +507,7 @@ namespace GraphX
 					{
 						const ParticleProps& props = particle.GetProps();
 						GM::Rotator ParticleRotation(0.0f, 0.0f, props.Rotation);
-						GM::Vector3 ParticlePosition = ViewMatrix * props.Position;
+						GM::Vector3 ParticlePosition = ViewMatrix * particle.GetInterpolatedPosition(InterpolationAlpha);
 						float scale = GM::Utility::Lerp(props.SizeBegin, props.SizeEnd, particle.GetLifeProgress());
 						GM::Vector4 color = GM::Utility::Lerp(props.ColorBegin, props.ColorEnd, particle.GetLifeProgress());
 						s_Data->ParticleBatch->AddParticle(ParticlePosition, { scale, scale }, ParticleRotation, color);
@@ -395,6 +532,9 @@ namespace GraphX
 		{
 			s_Data->Batch->EndBatch();
 			s_Data->Batch->Flush();
+
+			s_Data->InstancedBatch->EndBatch();
+			s_Data->InstancedBatch->Flush();
 		}
 
 		// While the queue is not empty
@@ -420,7 +560,7 @@ namespace GraphX
 			shader->SetUniformMat3f("u_Normal", Normal);
 
 			// Draw the object
-			glDrawElements(GL_TRIANGLES, mesh->GetIBO()->GetCount(), GL_UNSIGNED_INT, nullptr);
+			RenderDevice::Get().DrawElements(GL_TRIANGLES, mesh->GetIBO()->GetCount(), mesh->GetIBO()->GetDrawType(), nullptr);
 			
 			// Maintain Stats
 			s_Data->Stats.QuadCount++;
@@ -444,7 +584,7 @@ namespace GraphX
 			DepthShader.SetUniformMat4f("u_Model", Model);
 
 			// Draw the object
-			glDrawElements(GL_TRIANGLES, Mesh->GetIBO()->GetCount(), GL_UNSIGNED_INT, nullptr);
+			RenderDevice::Get().DrawElements(GL_TRIANGLES, Mesh->GetIBO()->GetCount(), Mesh->GetIBO()->GetDrawType(), nullptr);
 
 			Mesh->UnBindBuffers();
 		}
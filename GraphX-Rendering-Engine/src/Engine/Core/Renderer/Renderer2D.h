@@ -5,10 +5,12 @@ namespace GraphX
 	class Mesh2D;
 	class Shader;
 	class Texture2D;
+	class SubTexture2D;
 
 	class Renderer2D
 	{
 		friend class Batch2D;
+		friend class InstancedBatch2D;
 		friend class ParticleBatch;
 	public:
 		/* Renderer2D Statistics */
@@ -40,11 +42,25 @@ namespace GraphX
 		static void DrawRotatedQuad(const GM::Vector2& position, const GM::Vector2& size, const GM::Vector3& rotation, const Ref<Texture2D>& texture, const GM::Vector4& tintColor = GM::Vector4::UnitVector, float tiling = 1.0f, uint32_t textureSlot = 0);
 		static void DrawRotatedQuad(const GM::Vector3& position, const GM::Vector2& size, const GM::Vector3& rotation, const Ref<Texture2D>& texture, const GM::Vector4& tintColor = GM::Vector4::UnitVector, float tiling = 1.0f, uint32_t textureSlot = 0);
 
+		/* Sub textures (sprites, texture atlas images) are only supported with batch rendering */
+		static void DrawQuad(const GM::Vector3& position, const GM::Vector2& size, const Ref<SubTexture2D>& subTexture, const GM::Vector4& tintColor = GM::Vector4::UnitVector);
+		static void DrawRotatedQuad(const GM::Vector3& position, const GM::Vector2& size, const GM::Vector3& rotation, const Ref<SubTexture2D>& subTexture, const GM::Vector4& tintColor = GM::Vector4::UnitVector);
+
 		// Only for debug Purpose
 		static void DrawDebugQuad(const GM::Vector3& position, const GM::Vector2& size, const Ref<Texture2D>& texture, uint32_t textureSlot);
 
+		/**
+		* Packs a small texture loaded from a file in to the sprite atlas shared by the batches
+		* @return Subtexture of the texture in the atlas, or nullptr if it is not packed (too large, not loaded from an image, still streaming or the atlas is disabled)
+		* NOTE: Only on the render thread, the image is read back from the texture
+		*/
+		static Ref<SubTexture2D> PackInSpriteAtlas(const Texture2D& Texture);
+
+		/* Returns a subtexture for a part (texture coords within the image) of an image packed in the sprite atlas */
+		static Ref<SubTexture2D> GetSpriteAtlasRegion(const Ref<SubTexture2D>& Image, const GM::Vector2& Min, const GM::Vector2& Max);
+
 		/* Renders the active particles from the pool of particles */
-		static void RenderParticles(const std::unordered_map<std::string, Ref<class ParticleSystem>>& ParticleSystems);
+		static void RenderParticles(const std::unordered_map<std::string, Ref<class ParticleSystem>>& ParticleSystems, float InterpolationAlpha = 1.0f);
 
 		/* Submit the mesh to be rendered to the render */
 		static void Submit(const Ref<Mesh2D>& mesh);
@@ -66,14 +82,23 @@ namespace GraphX
 		static void DrawQuad_Internal(const GM::Matrix4& transform, const GM::Vector4& color);
 		static void DrawQuad_Internal(const Ref<Texture2D>& texture, const GM::Matrix4& transform, const GM::Vector4& color, float tiling, uint32_t textureSlot);
 
+		/* Uploads the changes to the sprite atlas (Needs to be done before any of its subtextures are drawn) */
+		static void CommitSpriteAtlas();
+
+		/* Returns the pool of texture arrays used by the batches (nullptr when the batches use separate texture slots) */
+		static class Texture2DArrayPool* GetTextureArrayPool();
+
 		/* Internal method to render particles in batches */
-		static void RenderParticlesBatched_Internal(const std::unordered_map<std::string, Ref<ParticleSystem>>& ParticleSystems);
+		static void RenderParticlesBatched_Internal(const std::unordered_map<std::string, Ref<ParticleSystem>>& ParticleSystems, float InterpolationAlpha);
 	private:
 		struct Renderer2DData
 		{
 			// Vertex Array to store the quad vertices and indices
 			Scope<class VertexArray> QuadVA;
 
+			// Type of the quad indices, for the draw calls
+			uint32_t QuadIndexDrawType = 0;
+
 			// One Shader for rendering all 2D stuff
 			Ref<Shader> TextureShader;
 
@@ -89,6 +114,24 @@ namespace GraphX
 			// Shader used to render the batch
 			Ref<class Shader> BatchShader;
 
+			// Shader used to render the batch with texture arrays
+			Ref<class Shader> ArrayBatchShader;
+
+			// Batch object for batching quads as instances
+			Scope<class InstancedBatch2D> InstancedBatch;
+
+			// Shader used to render the instanced batch
+			Ref<class Shader> InstancedBatchShader;
+
+			// Shader used to render the instanced batch with texture arrays
+			Ref<class Shader> InstancedArrayBatchShader;
+
+			// Texture arrays used by the batches (when batching with texture arrays)
+			Scope<class Texture2DArrayPool> TextureArrays;
+
+			// Atlas of the sprite sheets and the small particle textures, shared by the batches
+			Scope<class TextureAtlas> SpriteAtlas;
+
 			// Batch object for batching particles together
 			Scope<class ParticleBatch> ParticleBatch;
 
@@ -98,6 +141,9 @@ namespace GraphX
 			// Shader to render the particle batch
 			Ref<class Shader> ParticleBatchShader;
 
+			// Shader to render the particle batch with texture arrays
+			Ref<class Shader> ParticleArrayBatchShader;
+
 			/* Queue containing the objects to be rendered */
 			std::deque<Ref<Mesh2D>> RenderQueue;
 			
@@ -1,8 +1,10 @@
 #include "pch.h"
 #include "Renderer3D.h"
 #include "GL/glew.h"
+#include "Device/RenderDevice.h"
 
 #include "Renderer.h"
+#include "CascadedShadowMap.h"
 #include "Model/Mesh/Mesh3D.h"
 #include "Shaders/Shader.h"
 #include "Materials/Material.h"
@@ -15,6 +17,8 @@
 
 #include "Entities/Terrain.h"
 
+#include <algorithm>
+
 namespace GraphX
 {
 	using namespace GM;
@@ -53,6 +57,7 @@ namespace GraphX
 
 		s_Data->DebugData.VAO->AddVertexBuffer(*(s_Data->DebugData.VBO), layout);
 		s_Data->DebugData.VAO->AddIndexBuffer(ibo);
+		s_Data->DebugData.IndexDrawType = ibo.GetDrawType();
 	}
 
 	void Renderer3D::Shutdown()
@@ -64,11 +69,15 @@ namespace GraphX
 		s_Data = nullptr;
 	}
 
-	void Renderer3D::BeginScene()
+	void Renderer3D::BeginScene(uint32_t SceneFeatures, const std::function<void(Shader&)>& ConfigureShader)
 	{
 		GX_PROFILE_FUNCTION()
 
 		GX_ENGINE_ASSERT(s_Data != nullptr, "Renderer3D not Initialised!!");
+
+		s_Data->SceneFeatures = SceneFeatures;
+		s_Data->ConfigureShader = ConfigureShader;
+		s_Data->ConfiguredShaders.clear();
 	}
 
 	void Renderer3D::EndScene()
@@ -96,10 +105,23 @@ namespace GraphX
 			// Enable the object for rendering
 			mesh->Enable();
 
-			// Render the object
-			const Ref<Material>& Mat = mesh->GetMaterial();
-			Mat->Bind();
-			const Ref<Shader>& shader = Mat->GetShader();	// NOTE: No Need to bind the shader again (Material binds the shader)
+			// Render the object with the variant having only the features used by both the scene and the material
+			const Ref<Material>& MeshMaterial = mesh->GetMaterial();
+			Shader* shader = Renderer::GetShaderLibrary().GetVariant(MeshMaterial->GetShader(), s_Data->SceneFeatures & MeshMaterial->GetShaderFeatures()).get();
+
+			// Fallback material is used until the variant is compiled
+			const bool IsReady = shader->IsReady();
+			const Ref<Material>& Mat = IsReady ? MeshMaterial : Renderer::GetFallbackMaterial();
+			if (!IsReady)
+				shader = Mat->GetShader().get();
+
+			Mat->Bind(*shader);	// NOTE: No Need to bind the shader again (Material binds the shader)
+
+			if (s_Data->ConfigureShader && std::find(s_Data->ConfiguredShaders.begin(), s_Data->ConfiguredShaders.end(), shader) == s_Data->ConfiguredShaders.end())
+			{
+				s_Data->ConfigureShader(*shader);
+				s_Data->ConfiguredShaders.push_back(shader);
+			}
 			
 			// Set the transformation matrix
 			const Matrix4& Model = mesh->GetModelMatrix();
@@ -110,7 +132,7 @@ namespace GraphX
 			shader->SetUniformMat3f("u_Normal", Normal);
 
 			// Draw the object
-			glDrawElements(GL_TRIANGLES, mesh->GetIBO()->GetCount(), GL_UNSIGNED_INT, nullptr);
+			s_Data->Stats.DrawCalls += DrawSections(*mesh);
 
 			// Disable the mesh after drawing
 			mesh->Disable();
@@ -123,14 +145,26 @@ namespace GraphX
 		}
 	}
 
-	void Renderer3D::Render(Shader& DepthShader)
+	void Renderer3D::Render(Shader& DepthShader, DepthPassType Pass, const ShadowCascade* Cascade, ShadowCasterType Casters)
 	{
+		GX_ENGINE_ASSERT(Pass == DepthPassType::Shadow || Cascade == nullptr, "Shadow cascade used in a depth pre pass");
+
 		DepthShader.Bind();
 
 		for (unsigned int i = 0; i < s_Data->RenderQueue.size(); i++)
 		{
 			const Ref<Mesh3D>& Mesh = s_Data->RenderQueue.at(i);
 
+			if ((Casters == ShadowCasterType::Static && !Mesh->bIsStatic) || (Casters == ShadowCasterType::Dynamic && Mesh->bIsStatic))
+				continue;
+
+			// Skip the meshes which can not cast a shadow in the cascade
+			if (Cascade && Mesh->GetBoundingBox() && !Cascade->Overlaps(*Mesh->GetBoundingBox()))
+			{
+				s_Data->Stats.ShadowCastersCulled++;
+				continue;
+			}
+
 			Mesh->Enable();
 
 			// Set the transformation matrix
@@ -138,12 +172,75 @@ namespace GraphX
 			DepthShader.SetUniformMat4f("u_Model", Model);
 
 			// Draw the object
-			glDrawElements(GL_TRIANGLES, Mesh->GetIBO()->GetCount(), GL_UNSIGNED_INT, nullptr);
+			const uint32_t DrawCalls = DrawSections(*Mesh);
+			if (Pass == DepthPassType::Shadow)
+				s_Data->Stats.ShadowDrawCalls += DrawCalls;
+			else
+				s_Data->Stats.DepthPrePassDrawCalls += DrawCalls;
 
 			Mesh->Disable();
 		}
 	}
 
+	uint32_t Renderer3D::DrawSections(const Mesh3D& Mesh)
+	{
+		GX_PROFILE_FUNCTION()
+
+		// Indices of a section are relative to its first vertex, so that the sections under 65536 vertices use 16 bit indices
+		const IndexBuffer& IBO = *Mesh.GetIBO();
+		const uint32_t IndexDrawType = IBO.GetDrawType();
+		const uint32_t NumSections = Mesh.GetNumSections();
+
+		for (uint32_t i = 0; i < NumSections; i++)
+		{
+			const MeshSection& Section = Mesh.GetMeshSection(i);
+			const uintptr_t IndexOffset = (uintptr_t)Section.FirstIndex * IBO.GetIndexSize();
+			RenderDevice::Get().DrawElementsBaseVertex(GL_TRIANGLES, Section.GetNumIndices(), IndexDrawType, (const void*)IndexOffset, Section.FirstVertexIndex);
+		}
+
+		return NumSections;
+	}
+
+	size_t Renderer3D::GetStaticCastersSignature()
+	{
+		GX_PROFILE_FUNCTION()
+
+		// Combine the address and the bounds of all the static meshes
+		std::hash<float> FloatHash;
+		size_t Signature = 0;
+		auto Combine = [&Signature](size_t Value) { Signature ^= Value + 0x9e3779b9 + (Signature << 6) + (Signature >> 2); };
+
+		for (const Ref<Mesh3D>& Mesh : s_Data->RenderQueue)
+		{
+			if (!Mesh->bIsStatic)
+				continue;
+
+			Combine(std::hash<const Mesh3D*>()(Mesh.get()));
+			if (const Ref<BoundingBox>& Box = Mesh->GetBoundingBox())
+			{
+				Combine(FloatHash(Box->Min.x)); Combine(FloatHash(Box->Min.y)); Combine(FloatHash(Box->Min.z));
+				Combine(FloatHash(Box->Max.x)); Combine(FloatHash(Box->Max.y)); Combine(FloatHash(Box->Max.z));
+			}
+		}
+
+		return Signature;
+	}
+
+	void Renderer3D::ResetStats()
+	{
+		memset(&s_Data->Stats, 0, sizeof(Renderer3D::Statistics));
+	}
+
+	uint32_t Renderer3D::GetSceneFeatures()
+	{
+		return s_Data->SceneFeatures;
+	}
+
+	Renderer3D::Statistics Renderer3D::GetStats()
+	{
+		return s_Data->Stats;
+	}
+
 	void Renderer3D::RenderDebugCollisions(const Ref<GM::BoundingBox>& Box)
 	{
 		GX_PROFILE_FUNCTION()
@@ -168,7 +265,15 @@ namespace GraphX
 
 			s_Data->DebugData.VAO->Bind();
 			Renderer::s_DebugShader->Bind();
-			glDrawElements(GL_LINES, 24, GL_UNSIGNED_INT, nullptr);
+
+			// Debug boxes are not in the depth pre pass, so they can not be equal to the depth in the buffer
+			if (Renderer::s_SceneInfo->IsPrePassedColorPass)
+				RenderDevice::Get().DepthFunc(GL_LESS);
+
+			RenderDevice::Get().DrawElements(GL_LINES, 24, s_Data->DebugData.IndexDrawType, nullptr);
+
+			if (Renderer::s_SceneInfo->IsPrePassedColorPass)
+				RenderDevice::Get().DepthFunc(GL_EQUAL);
 		}
 	}
 }
\ No newline at end of file
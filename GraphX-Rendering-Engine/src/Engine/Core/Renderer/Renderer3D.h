@@ -1,19 +1,45 @@
 #pragma once
 
+#include "RendererResources.h"
+#include "Engine/Core/Shaders/ShaderLibrary.h"
+
 namespace GraphX
 {
 	class Shader;
 	class Mesh3D;
 	class Terrain;
+	struct ShadowCascade;
 
 	class Renderer3D
 	{
+	public:
+		/* Renderer3D Statistics */
+		struct Statistics
+		{
+			uint32_t DrawCalls = 0;
+
+			/* Draw calls made for the shadow maps (for all the cascades) */
+			uint32_t ShadowDrawCalls = 0;
+
+			/* Draw calls made for the depth pre pass */
+			uint32_t DepthPrePassDrawCalls = 0;
+
+			/* Number of shadow casters skipped because they could not cast a shadow in the cascade */
+			uint32_t ShadowCastersCulled = 0;
+		};
+
 	public:
 		static void Init();
 		static void Shutdown();
 
-		static void BeginScene();
+		/* Meshes are rendered with the shader variants having the scene features (that their material uses)
+		*  ConfigureShader sets the scene uniforms on a variant, the first time it is bound in the scene
+		*/
+		static void BeginScene(uint32_t SceneFeatures = ShaderFeature::All, const std::function<void(Shader&)>& ConfigureShader = nullptr);
 		static void EndScene();
+
+		/* Returns the shader features enabled for the current scene */
+		static uint32_t GetSceneFeatures();
 		
 		/* Submit the object to be rendered */
 		static void Submit(const Ref<Mesh3D>& mesh);
@@ -24,8 +50,22 @@ namespace GraphX
 		/* Renders the objects submitted to the rendered*/
 		static void Render();
 
-		/* Renders the objects submitted to the renderer to the depth framebuffer (Shader should be bound before calling the render method) */
-		static void Render(Shader& DepthShader);
+		/* Renders the objects submitted to the renderer to the depth framebuffer (Shader should be bound before calling the render method) 
+		*  Objects outside the shadow cascade (if provided) are skipped. Pass decides which stats the draw calls are counted in
+		*/
+		static void Render(Shader& DepthShader, DepthPassType Pass, const ShadowCascade* Cascade = nullptr, ShadowCasterType Casters = ShadowCasterType::All);
+
+		/* Draws the sections of the mesh (The mesh should be enabled and its shader bound). Returns the number of draw calls made */
+		static uint32_t DrawSections(const Mesh3D& Mesh);
+
+		/* Returns a signature of the static meshes submitted to the renderer (changes if a static mesh is added, removed or moved) */
+		static size_t GetStaticCastersSignature();
+
+		/* Resets the stats back to 0 */
+		static void ResetStats();
+
+		/* Returns the renderer stats */
+		static Renderer3D::Statistics GetStats();
 
 	private:
 		/* Renders the collision bounds for debugging */
@@ -37,12 +77,25 @@ namespace GraphX
 			/* Queue containing the objects to be rendered */
 			std::deque<Ref<Mesh3D>> RenderQueue;
 
+			/* Shader features enabled for the scene */
+			uint32_t SceneFeatures = ShaderFeature::All;
+
+			/* Sets the scene uniforms on the shader variants */
+			std::function<void(Shader&)> ConfigureShader;
+
+			/* Shader variants configured in the current scene */
+			std::vector<const Shader*> ConfiguredShaders;
+
 			struct Debug
 			{
 				Scope<class VertexArray> VAO;
 				Scope<class VertexBuffer> VBO;
+
+				/* Type of the box indices, for the draw call */
+				uint32_t IndexDrawType = 0;
 			} DebugData;
 
+			Renderer3D::Statistics Stats;
 		};
 
 		static Renderer3DData* s_Data;
@@ -2,6 +2,21 @@
 
 namespace GraphX
 {
+	/* Purpose of a depth pass (Draw calls of each are counted separately in the stats) */
+	enum class DepthPassType
+	{
+		Shadow,		/* Depth from the light, for the shadow map (or one of its cascades) */
+		PrePass		/* Depth from the camera, before the color pass */
+	};
+
+	/* Which shadow casters to render in a depth pass */
+	enum class ShadowCasterType
+	{
+		All,		/* Every caster submitted to the renderer */
+		Static,		/* Only the casters that never move (rendered in to the cached shadow map) */
+		Dynamic		/* Only the casters that can move (rendered on top of the cached shadow map every frame) */
+	};
+
 	/**
 	 * Data required for rendering the skybox
 	 */
@@ -1,6 +1,7 @@
 #include "pch.h"
 #include "SimpleRenderer.h"
-#include "Gl/glew.h"
+#include "GL/glew.h"
+#include "Device/RenderDevice.h"
 
 #include "Buffers/IndexBuffer.h"
 
@@ -10,13 +11,13 @@ namespace GraphX
 	{
 		GX_PROFILE_FUNCTION()
 
-		glDrawArrays(GL_TRIANGLES, 0, count);
+		RenderDevice::Get().DrawArrays(GL_TRIANGLES, 0, count);
 	}
 
 	void SimpleRenderer::DrawIndexed(const IndexBuffer& ibo) const
 	{
 		GX_PROFILE_FUNCTION()
 
-		glDrawElements(GL_TRIANGLES, ibo.GetCount(), GL_UNSIGNED_INT, nullptr);
+		RenderDevice::Get().DrawElements(GL_TRIANGLES, ibo.GetCount(), ibo.GetDrawType(), nullptr);
 	}
 }
\ No newline at end of file
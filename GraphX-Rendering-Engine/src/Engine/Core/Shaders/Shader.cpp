@@ -1,14 +1,39 @@
 #include "pch.h"
 #include "Shader.h"
 #include "GL/glew.h"
+#include "Device/RenderDevice.h"
 
+#include "ShaderCache.h"
 #include "Utilities/EngineUtil.h"
 #include "Timer/Timer.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace GraphX
 {
-	Shader::Shader(const std::string& filePath, const std::string& name)
-		: RendererAsset(), m_Name(name)
+	/* Reads the whole file in to the string */
+	static bool ReadShaderFile(const std::string& FilePath, std::string& OutSource)
+	{
+		std::ifstream stream(FilePath, std::ios::binary | std::ios::ate);
+		if (!stream)
+			return false;
+
+		OutSource.assign((size_t)stream.tellg(), '\0');
+		stream.seekg(0);
+		stream.read(&OutSource[0], OutSource.size());
+		return true;
+	}
+
+	/* Returns whether the line starting at the position is the directive (ignoring the indentation) */
+	static bool IsDirective(const std::string& Source, size_t LineStart, size_t LineEnd, const char* Directive, size_t& OutDirectivePos)
+	{
+		OutDirectivePos = Source.find_first_not_of(" \t", LineStart);
+		return OutDirectivePos < LineEnd && Source.compare(OutDirectivePos, std::strlen(Directive), Directive) == 0;
+	}
+
+	Shader::Shader(const std::string& filePath, const std::string& name, const std::vector<std::string>& defines)
+		: RendererAsset(), m_Name(name), m_FilePath(filePath)
 	{
 		GX_PROFILE_FUNCTION()
 
@@ -17,12 +42,16 @@ namespace GraphX
 			m_Name = EngineUtil::ExtractFileName(filePath);
 		}
 
-		ShaderSource source = ParseShaderSource(filePath);
+		ShaderSource source = ParseShaderSource(filePath, defines);
 		
 		if (source.FragmentShaderSource.length() > 0 && source.VertexShaderSource.length() > 0)
 			m_RendererID = CreateShader(source.VertexShaderSource, source.FragmentShaderSource);
 		else
 			GX_ENGINE_ERROR("Error while creating the shader {0}, Source not found", m_Name);
+
+		// Without the parallel compile, the link status can not be polled (the driver blocks on the first query anyway)
+		if (m_Status == ShaderStatus::Compiling && !ShaderCache::IsParallelCompileSupported())
+			FinishLinking();
 	}
 
 	Shader::Shader(const std::string& name, const std::string& vertexShaderSrc, const std::string& fragShaderSrc)
@@ -31,95 +60,135 @@ namespace GraphX
 		GX_PROFILE_FUNCTION()
 
 		m_RendererID = CreateShader(vertexShaderSrc, fragShaderSrc);
+
+		if (m_Status == ShaderStatus::Compiling && !ShaderCache::IsParallelCompileSupported())
+			FinishLinking();
 	}
 
 	Shader::~Shader()
 	{
 		GX_PROFILE_FUNCTION()
 
-		glDeleteProgram(m_RendererID);
+		if (m_VertexShaderID != 0)
+			RenderDevice::Get().DeleteShader(m_VertexShaderID);
+		if (m_FragmentShaderID != 0)
+			RenderDevice::Get().DeleteShader(m_FragmentShaderID);
+
+		RenderDevice::Get().DeleteProgram(m_RendererID);
 	}
 
-	void Shader::Bind() const
+	void Shader::Bind()
 	{
 		GX_PROFILE_FUNCTION()
 
-		if (m_RendererID == 0)
+		// Shaders used before they are ready stall here (Use IsReady to render with something else in the mean time)
+		if (m_Status == ShaderStatus::Compiling)
+			WaitUntilReady();
+
+		if (m_Status != ShaderStatus::Ready)
 			GX_ENGINE_ERROR("'{0}' shader could not be bound", m_Name);
 		else
-			glUseProgram(m_RendererID);
+			RenderDevice::Get().UseProgram(m_RendererID);
 	}
 
 	void Shader::UnBind() const
 	{
 		GX_PROFILE_FUNCTION()
 
-		glUseProgram(0);
+		RenderDevice::Get().UseProgram(0);
 	}
 
 	void Shader::SetUniform1i(const char* Name, int Val)
 	{
-		glUniform1i(GetLocation(Name), Val);
+		RenderDevice::Get().Uniform1i(GetLocation(Name), Val);
 	}
 
 	void Shader::SetUniform1iv(const char* Name, uint32_t count, const int* vals)
 	{
-		glUniform1iv(GetLocation(Name), count, vals);
+		RenderDevice::Get().Uniform1iv(GetLocation(Name), count, vals);
 	}
 
 	void Shader::SetUniform2i(const char* Name, int v1, int v2)
 	{
-		glUniform2i(GetLocation(Name), v1, v2);
+		RenderDevice::Get().Uniform2i(GetLocation(Name), v1, v2);
+	}
+
+	void Shader::SetUniform3i(const char* Name, int v1, int v2, int v3)
+	{
+		RenderDevice::Get().Uniform3i(GetLocation(Name), v1, v2, v3);
 	}
 
 	void Shader::SetUniform1f(const char* Name, float Val)
 	{
-		glUniform1f(GetLocation(Name), Val);
+		RenderDevice::Get().Uniform1f(GetLocation(Name), Val);
 	}
 
 	void Shader::SetUniform3f(const char* Name, float r, float g, float b)
 	{
-		glUniform3f(GetLocation(Name), r, g, b);
+		RenderDevice::Get().Uniform3f(GetLocation(Name), r, g, b);
 	}
 
 	void Shader::SetUniform2f(const char* Name, float r, float g)
 	{
-		glUniform2f(GetLocation(Name), r, g);
+		RenderDevice::Get().Uniform2f(GetLocation(Name), r, g);
 	}
 
 	void Shader::SetUniform2f(const char* Name, const GM::Vector2& Vec)
 	{
-		glUniform2f(GetLocation(Name), Vec.x, Vec.y);
+		RenderDevice::Get().Uniform2f(GetLocation(Name), Vec.x, Vec.y);
 	}
 
 	void Shader::SetUniform3f(const char* Name, const GM::Vector3& Vec)
 	{
-		glUniform3f(GetLocation(Name), Vec.x, Vec.y, Vec.z);
+		RenderDevice::Get().Uniform3f(GetLocation(Name), Vec.x, Vec.y, Vec.z);
 	}
 
 	void Shader::SetUniform4f(const char* Name, float r, float g, float b, float a)
 	{
-		glUniform4f(GetLocation(Name), r, g, b, a);
+		RenderDevice::Get().Uniform4f(GetLocation(Name), r, g, b, a);
 	}
 
 	void Shader::SetUniform4f(const char* Name, const GM::Vector4& Vec)
 	{
-		glUniform4f(GetLocation(Name), Vec.x, Vec.y, Vec.z, Vec.w);
+		RenderDevice::Get().Uniform4f(GetLocation(Name), Vec.x, Vec.y, Vec.z, Vec.w);
 	}
 
 	void Shader::SetUniform4f(const char* Name, const GM::Vector2& Vec1, const GM::Vector2& Vec2)
 	{
-		glUniform4f(GetLocation(Name), Vec1.x, Vec1.y, Vec2.x, Vec2.y);
+		RenderDevice::Get().Uniform4f(GetLocation(Name), Vec1.x, Vec1.y, Vec2.x, Vec2.y);
 	}
 
 	void Shader::SetUniformMat3f(const char* Name, const GM::Matrix3& Mat)
 	{
-		glUniformMatrix3fv(GetLocation(Name), 1, GL_TRUE, &Mat(0, 0));
+		RenderDevice::Get().UniformMatrix3fv(GetLocation(Name), 1, true, &Mat(0, 0));
 	}
 
 	void Shader::SetUniformMat4f(const char* Name, const GM::Matrix4& Mat)
 	{
-		glUniformMatrix4fv(GetLocation(Name), 1, GL_TRUE, &Mat(0, 0));
+		RenderDevice::Get().UniformMatrix4fv(GetLocation(Name), 1, true, &Mat(0, 0));
+	}
+
+	bool Shader::IsReady()
+	{
+		if (m_Status == ShaderStatus::Compiling)
+		{
+			// Does not block (unlike the link status)
+			int IsComplete = GL_FALSE;
+			RenderDevice::Get().GetProgramiv(m_RendererID, GL_COMPLETION_STATUS_KHR, &IsComplete);
+
+			if (IsComplete == GL_TRUE)
+				FinishLinking();
+		}
+
+		return m_Status == ShaderStatus::Ready;
+	}
+
+	void Shader::WaitUntilReady()
+	{
+		GX_PROFILE_FUNCTION()
+
+		if (m_Status == ShaderStatus::Compiling)
+			FinishLinking();
 	}
 
 	int Shader::GetLocation(const char* Name)
@@ -132,7 +201,7 @@ namespace GraphX
 		else
 		{
 			// Get the location of the uniform
-			int location = glGetUniformLocation(m_RendererID, Name);
+			int location = RenderDevice::Get().GetUniformLocation(m_RendererID, Name);
 				
 			//If the name is invalid
 			if (location == -1)
@@ -149,7 +218,7 @@ namespace GraphX
 		}
 	}
 
-	ShaderSource Shader::ParseShaderSource(const std::string& filePath)
+	ShaderSource Shader::ParseShaderSource(const std::string& filePath, const std::vector<std::string>& defines)
 	{
 		GX_ENGINE_INFO("'{0}' shader : Parsing Shader source", m_Name);
 		GX_PROFILE_FUNCTION()
@@ -159,27 +228,132 @@ namespace GraphX
 			NONE = -1, VERTEX = 0, FRAGMENT = 1
 		};
 
-		std::stringstream shaderStrings[2];
+		std::string shaderStrings[2];
 
-		std::fstream stream(filePath);
-		std::string line;
+		// Read the whole file at once and split it at the '#shader' lines
+		std::string source;
+		if (!ReadShaderFile(filePath, source))
+		{
+			GX_ENGINE_ERROR("'{0}' shader : Could not open {1}", m_Name, filePath);
+			return {};
+		}
 
 		ShaderType type = ShaderType::NONE;
 
-		while (getline(stream, line))
+		size_t lineStart = 0;
+		while (lineStart < source.size())
 		{
-			if (line.find("#shader") != std::string::npos)
+			size_t lineEnd = source.find('\n', lineStart);
+			if (lineEnd == std::string::npos)
+				lineEnd = source.size();
+
+			size_t markerPos;
+			if (IsDirective(source, lineStart, lineEnd, "#shader", markerPos))
 			{
+				const std::string line = source.substr(lineStart, lineEnd - lineStart);
 				if (line.find("vertex") != std::string::npos)
 					type = ShaderType::VERTEX;
 				else if (line.find("fragment") != std::string::npos)
 					type = ShaderType::FRAGMENT;
 			}
-			else
-				shaderStrings[(int)type] << line << "\n";
+			else if (type != ShaderType::NONE)
+			{
+				shaderStrings[(int)type].append(source, lineStart, lineEnd - lineStart).push_back('\n');
+			}
+
+			lineStart = lineEnd + 1;
+		}
+
+		// Includes are relative to the file including them
+		const std::string directory = EngineUtil::ExtractFileLocation(filePath);
+		for (std::string& stageSource : shaderStrings)
+		{
+			if (stageSource.empty())
+				continue;
+
+			std::vector<std::string> includedFiles;
+			ExpandIncludes(stageSource, directory, includedFiles);
+			InjectDefines(stageSource, defines);
+		}
+
+		return { shaderStrings[0], shaderStrings[1] };
+	}
+
+	void Shader::ExpandIncludes(std::string& source, const std::string& directory, std::vector<std::string>& includedFiles)
+	{
+		GX_PROFILE_FUNCTION()
+
+		std::string expanded;
+		expanded.reserve(source.size());
+
+		size_t lineStart = 0;
+		while (lineStart < source.size())
+		{
+			size_t lineEnd = source.find('\n', lineStart);
+			if (lineEnd == std::string::npos)
+				lineEnd = source.size();
+
+			size_t directivePos;
+			if (!IsDirective(source, lineStart, lineEnd, "#include", directivePos))
+			{
+				expanded.append(source, lineStart, lineEnd - lineStart).push_back('\n');
+				lineStart = lineEnd + 1;
+				continue;
+			}
+
+			const size_t nameStart = source.find('"', directivePos);
+			const size_t nameEnd = nameStart < lineEnd ? source.find('"', nameStart + 1) : std::string::npos;
+			if (nameEnd >= lineEnd)
+			{
+				GX_ENGINE_ERROR("'{0}' shader : Invalid include directive '{1}'", m_Name, source.substr(lineStart, lineEnd - lineStart));
+				lineStart = lineEnd + 1;
+				continue;
+			}
+
+			const std::string includePath = (directory.empty() ? "" : directory + "/") + source.substr(nameStart + 1, nameEnd - nameStart - 1);
+
+			// Files already included are skipped (so the included files need no guards, and can not include each other endlessly)
+			if (std::find(includedFiles.begin(), includedFiles.end(), includePath) == includedFiles.end())
+			{
+				includedFiles.push_back(includePath);
+
+				std::string includedSource;
+				if (ReadShaderFile(includePath, includedSource))
+				{
+					ExpandIncludes(includedSource, EngineUtil::ExtractFileLocation(includePath), includedFiles);
+					expanded.append(includedSource);
+				}
+				else
+				{
+					GX_ENGINE_ERROR("'{0}' shader : Could not open the included file {1}", m_Name, includePath);
+				}
+			}
+
+			lineStart = lineEnd + 1;
 		}
 
-		return { shaderStrings[0].str(), shaderStrings[1].str() };
+		source.swap(expanded);
+	}
+
+	void Shader::InjectDefines(std::string& source, const std::vector<std::string>& defines)
+	{
+		if (defines.empty())
+			return;
+
+		std::string defineLines;
+		for (const std::string& define : defines)
+			defineLines.append("#define ").append(define).push_back('\n');
+
+		// Nothing but the comments can come before the #version directive
+		size_t insertPos = 0;
+		const size_t versionPos = source.find("#version");
+		if (versionPos != std::string::npos)
+		{
+			insertPos = source.find('\n', versionPos);
+			insertPos = (insertPos == std::string::npos) ? source.size() : insertPos + 1;
+		}
+
+		source.insert(insertPos, defineLines);
 	}
 
 	unsigned int Shader::CompileShader(unsigned int type, const std::string& source)
@@ -187,48 +361,102 @@ namespace GraphX
 		GX_ENGINE_INFO("'{0}' shader : Compiling {1} Shader", m_Name, type == GL_VERTEX_SHADER ? "Vertex" : "Fragment");
 		GX_PROFILE_FUNCTION()
 
-		int shaderID = glCreateShader(type);
+		int shaderID = RenderDevice::Get().CreateShader(type);
 		const char* src = source.c_str();
-		glShaderSource(shaderID, 1, &src, nullptr);
-		glCompileShader(shaderID);
+		RenderDevice::Get().ShaderSource(shaderID, 1, &src, nullptr);
+		RenderDevice::Get().CompileShader(shaderID);
+
+		return shaderID;
+	}
+
+	bool Shader::CheckCompileStatus(unsigned int type, unsigned int shaderID)
+	{
+		GX_PROFILE_FUNCTION()
 
 		int result;
-		glGetShaderiv(shaderID, GL_COMPILE_STATUS, &result);
+		RenderDevice::Get().GetShaderiv(shaderID, GL_COMPILE_STATUS, &result);
 
 		if (result == GL_FALSE)
 		{
 			int length;
-			glGetShaderiv(shaderID, GL_INFO_LOG_LENGTH, &length);
+			RenderDevice::Get().GetShaderiv(shaderID, GL_INFO_LOG_LENGTH, &length);
 
 			char* infoLog = (char*)alloca(length * sizeof(char));
-			glGetShaderInfoLog(shaderID, length, &length, infoLog);
+			RenderDevice::Get().GetShaderInfoLog(shaderID, length, &length, infoLog);
 
 			GX_ENGINE_ERROR("'{0}' shader : Failed to compile {1} shader",m_Name, (type == GL_VERTEX_SHADER) ? "Vertex " : "Fragment ");
 			GX_ENGINE_ERROR(infoLog);
 
-			glDeleteShader(shaderID);
-			return 0;
+			return false;
 		}
 
-		return shaderID;
+		return true;
 	}
 
 	unsigned int Shader::CreateShader(const std::string& vertexSource, const std::string& fragmentSource)
 	{
 		GX_PROFILE_FUNCTION()
 
-		int programID = glCreateProgram();
-		unsigned int vs = CompileShader(GL_VERTEX_SHADER, vertexSource);
-		unsigned int fs = CompileShader(GL_FRAGMENT_SHADER, fragmentSource);
+		int programID = RenderDevice::Get().CreateProgram();
 
-		glAttachShader(programID, vs);
-		glAttachShader(programID, fs);
-		glLinkProgram(programID);
-		glValidateProgram(programID);
+		// Skip the compilation if the driver has linked the same source before
+		m_CacheKey = ShaderCache::GetKey(vertexSource, fragmentSource);
+		if (ShaderCache::LoadProgram(m_CacheKey, programID))
+		{
+			GX_ENGINE_INFO("'{0}' shader : Loaded from the shader cache", m_Name);
+			m_Status = ShaderStatus::Ready;
+			return programID;
+		}
+
+		m_VertexShaderID = CompileShader(GL_VERTEX_SHADER, vertexSource);
+		m_FragmentShaderID = CompileShader(GL_FRAGMENT_SHADER, fragmentSource);
+
+		RenderDevice::Get().AttachShader(programID, m_VertexShaderID);
+		RenderDevice::Get().AttachShader(programID, m_FragmentShaderID);
+		RenderDevice::Get().ProgramParameteri(programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		RenderDevice::Get().LinkProgram(programID);
 
-		glDeleteShader(vs);
-		glDeleteShader(fs);
+		// Results are checked once the program is needed (or polled, with the parallel compile), so the driver compiles in the mean time
+		m_Status = ShaderStatus::Compiling;
 
 		return programID;
 	}
+
+	void Shader::FinishLinking()
+	{
+		GX_PROFILE_FUNCTION()
+
+		const bool isCompiled = CheckCompileStatus(GL_VERTEX_SHADER, m_VertexShaderID) & CheckCompileStatus(GL_FRAGMENT_SHADER, m_FragmentShaderID);
+
+		int isLinked = GL_FALSE;
+		RenderDevice::Get().GetProgramiv(m_RendererID, GL_LINK_STATUS, &isLinked);
+
+		// Link errors only make sense when both the stages compiled
+		if (isCompiled && isLinked == GL_FALSE)
+		{
+			int length;
+			RenderDevice::Get().GetProgramiv(m_RendererID, GL_INFO_LOG_LENGTH, &length);
+
+			char* infoLog = (char*)alloca(length * sizeof(char));
+			RenderDevice::Get().GetProgramInfoLog(m_RendererID, length, &length, infoLog);
+
+			GX_ENGINE_ERROR("'{0}' shader : Failed to link the program", m_Name);
+			GX_ENGINE_ERROR(infoLog);
+		}
+
+		RenderDevice::Get().DeleteShader(m_VertexShaderID);
+		RenderDevice::Get().DeleteShader(m_FragmentShaderID);
+		m_VertexShaderID = 0;
+		m_FragmentShaderID = 0;
+
+		if (isCompiled && isLinked == GL_TRUE)
+		{
+			ShaderCache::StoreProgram(m_CacheKey, m_RendererID);
+			m_Status = ShaderStatus::Ready;
+		}
+		else
+		{
+			m_Status = ShaderStatus::Failed;
+		}
+	}
 }
\ No newline at end of file
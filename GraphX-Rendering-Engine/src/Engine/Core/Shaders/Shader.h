@@ -11,19 +11,32 @@ namespace GraphX
 		std::string FragmentShaderSource;
 	};
 
+	/* Compilation state of a shader program */
+	enum class ShaderStatus
+	{
+		/* Driver is still compiling (and linking) the program */
+		Compiling = 0,
+
+		/* Program can be used for rendering */
+		Ready,
+
+		/* Program failed to compile or link */
+		Failed
+	};
+
 	class Shader
 		: public RendererAsset
 	{
 	public:
-		/* filePath is the path to the source file */
-		Shader(const std::string& filePath, const std::string& name = "");
+		/* filePath is the path to the source file. The defines are added to both the stages (after the #version directive) */
+		Shader(const std::string& filePath, const std::string& name = "", const std::vector<std::string>& defines = {});
 
 		Shader(const std::string& name, const std::string& vertexShaderSrc, const std::string& fragShaderSrc);
 
 		~Shader();
 
-		/* Bind the shader */
-		void Bind() const;
+		/* Bind the shader (Waits for the program to be linked, if it is still being compiled) */
+		void Bind();
 
 		/* Un Bind the shader */
 		void UnBind() const;
@@ -35,6 +48,8 @@ namespace GraphX
 
 		void SetUniform2i(const char* Name, int v1, int v2);
 
+		void SetUniform3i(const char* Name, int v1, int v2, int v3);
+
 		void SetUniform1f(const char* Name, float val);
 
 		void SetUniform2f(const char* Name, float a, float b);
@@ -58,16 +73,40 @@ namespace GraphX
 		// Returns the name for the shader
 		const std::string& GetName() const { return m_Name; }
 
+		/* Returns the path to the source file (empty for the shaders created from the source) */
+		const std::string& GetFilePath() const { return m_FilePath; }
+
+		/* Returns whether the program is linked and ready for use, without waiting for the driver (Finalises the program once the driver is done) */
+		bool IsReady();
+
+		/* Waits for the driver to finish compiling the program */
+		void WaitUntilReady();
+
+		/* Returns the compilation state of the program (as of the last check) */
+		ShaderStatus GetStatus() const { return m_Status; }
+
 	private:
-		/* Parse the source file and get the shader source codes */
-		ShaderSource ParseShaderSource(const std::string& filePath);
+		/* Parse the source file and get the shader source codes (with the includes expanded and the defines added) */
+		ShaderSource ParseShaderSource(const std::string& filePath, const std::vector<std::string>& defines);
+
+		/* Replaces the #include "file" lines with the contents of the files (relative to the directory). Each file is included only once in a stage */
+		void ExpandIncludes(std::string& source, const std::string& directory, std::vector<std::string>& includedFiles);
+
+		/* Adds the defines after the #version directive */
+		static void InjectDefines(std::string& source, const std::vector<std::string>& defines);
 
-		/* Compile the shader source extracted from the file */
+		/* Submits the shader source for compilation (The result is checked once the program is linked) */
 		unsigned int CompileShader(unsigned int type, const std::string& shaderSouce);
 
-		/* Create a program and attach the shaders to it */
+		/* Create a program and attach the shaders to it. The program is loaded from the shader cache if possible, else it is linked in the background */
 		unsigned int CreateShader(const std::string& vertexSource, const std::string& fragmentSource);
 
+		/* Checks the result of the compilation of a shader stage, and logs the errors */
+		bool CheckCompileStatus(unsigned int type, unsigned int shaderID);
+
+		/* Checks the result of the link (blocks if the driver is not done yet), releases the shader stages and stores the binary in the cache */
+		void FinishLinking();
+
 		/* Returns the location of the uniform with the given name */
 		int GetLocation(const char* Name);
 
@@ -75,7 +114,20 @@ namespace GraphX
 		/* Name to the shader source file */
 		std::string m_Name;
 
+		/* Path to the shader source file */
+		std::string m_FilePath;
+
 		/* To cache the uniform locations */
 		std::unordered_map<std::string, int> m_UniformLocations;
+
+		/* Compilation state of the program */
+		ShaderStatus m_Status = ShaderStatus::Failed;
+
+		/* Shader stages attached to the program while it is being linked */
+		unsigned int m_VertexShaderID = 0;
+		unsigned int m_FragmentShaderID = 0;
+
+		/* Key of the program in the shader cache */
+		uint64_t m_CacheKey = 0;
 	};
 }
\ No newline at end of file
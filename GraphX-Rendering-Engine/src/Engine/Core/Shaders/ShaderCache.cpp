@@ -0,0 +1,205 @@
+#include "pch.h"
+#include "ShaderCache.h"
+#include "GL/glew.h"
+#include "Device/RenderDevice.h"
+
+#include <iomanip>
+
+namespace GraphX
+{
+	/* Header written before the binary in a cache file */
+	struct ShaderCacheFileHeader
+	{
+		/* 'GXSB' */
+		uint32_t Magic = 0x42535847;
+
+		/* Bumped whenever the layout of the file changes */
+		uint32_t Version = 1;
+
+		/* Key the binary was stored with (guards against the hash collisions in the file names) */
+		uint64_t Key = 0;
+
+		/* Format of the binary returned by the driver */
+		uint32_t BinaryFormat = 0;
+
+		/* Size of the binary (in bytes) */
+		uint32_t Length = 0;
+	};
+
+	struct ShaderCacheData
+	{
+		/* Directory the binaries are written to */
+		std::string CacheDirectory = "res/ShaderCache/";
+
+		/* Hash of the vendor, renderer and version strings of the driver */
+		uint64_t DriverHash = 0;
+
+		/* Whether the driver can save and load the program binaries */
+		bool IsBinarySupported = false;
+
+		bool IsParallelCompileSupported = false;
+
+		/* Programs loaded from the cache and the programs compiled from the source */
+		uint32_t Hits = 0;
+		uint32_t Misses = 0;
+	};
+
+	/* 64-bit FNV-1a (stable across the runs and the compilers, unlike std::hash) */
+	static uint64_t HashString(const std::string& String, uint64_t Hash = 14695981039346656037ULL)
+	{
+		for (const char Char : String)
+		{
+			Hash ^= (uint8_t)Char;
+			Hash *= 1099511628211ULL;
+		}
+
+		return Hash;
+	}
+
+	ShaderCacheData* ShaderCache::s_Data = nullptr;
+
+	void ShaderCache::Init()
+	{
+		GX_PROFILE_FUNCTION()
+
+		GX_ENGINE_ASSERT(!s_Data, "Shader cache is already initialised");
+		s_Data = new ShaderCacheData();
+
+		RenderDevice& Device = RenderDevice::Get();
+
+		s_Data->DriverHash = HashString(Device.GetString(GL_VENDOR));
+		s_Data->DriverHash = HashString(Device.GetString(GL_RENDERER), s_Data->DriverHash);
+		s_Data->DriverHash = HashString(Device.GetString(GL_VERSION), s_Data->DriverHash);
+
+		// Some drivers expose the program binaries without supporting a single format
+		int32_t NumBinaryFormats = 0;
+		Device.GetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &NumBinaryFormats);
+		s_Data->IsBinarySupported = NumBinaryFormats > 0;
+
+		// The null device links every program immediately, so the shaders go through the same (non-blocking) path there
+		s_Data->IsParallelCompileSupported = RenderDevice::GetType() == RenderDeviceType::Null || GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
+		if (s_Data->IsParallelCompileSupported)
+		{
+			// Let the driver pick the number of threads
+			Device.MaxShaderCompilerThreads(0xFFFFFFFF);
+		}
+
+		GX_ENGINE_INFO("Shader Cache: Program binaries {0}, Parallel shader compile {1}", s_Data->IsBinarySupported ? "supported" : "not supported", s_Data->IsParallelCompileSupported ? "supported" : "not supported");
+	}
+
+	void ShaderCache::Shutdown()
+	{
+		GX_PROFILE_FUNCTION()
+
+		if (!s_Data)
+			return;
+
+		GX_ENGINE_INFO("Shader Cache: {0} programs loaded from the cache, {1} compiled", s_Data->Hits, s_Data->Misses);
+
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	uint64_t ShaderCache::GetKey(const std::string& VertexSource, const std::string& FragmentSource)
+	{
+		GX_ENGINE_ASSERT(s_Data, "Shader cache is not initialised");
+
+		// The stage separator keeps "ab" + "c" from colliding with "a" + "bc"
+		uint64_t Key = HashString(VertexSource, s_Data->DriverHash);
+		Key = HashString("#shader fragment", Key);
+		return HashString(FragmentSource, Key);
+	}
+
+	bool ShaderCache::LoadProgram(uint64_t Key, uint32_t Program)
+	{
+		GX_PROFILE_FUNCTION()
+
+		if (!s_Data)
+			return false;
+
+		std::ifstream Stream;
+		if (s_Data->IsBinarySupported)
+			Stream.open(GetCacheFilePath(Key), std::ios::binary);
+
+		if (!Stream.is_open())
+		{
+			s_Data->Misses++;
+			return false;
+		}
+
+		ShaderCacheFileHeader Expected;
+		ShaderCacheFileHeader Header;
+		Stream.read((char*)&Header, sizeof(Header));
+
+		if (!Stream || Header.Magic != Expected.Magic || Header.Version != Expected.Version || Header.Key != Key || Header.Length == 0)
+		{
+			GX_ENGINE_WARN("Shader Cache: Ignoring the invalid cache file {0}", GetCacheFilePath(Key));
+			s_Data->Misses++;
+			return false;
+		}
+
+		std::vector<char> Binary(Header.Length);
+		Stream.read(Binary.data(), Header.Length);
+		if (!Stream)
+		{
+			s_Data->Misses++;
+			return false;
+		}
+
+		RenderDevice::Get().ProgramBinary(Program, Header.BinaryFormat, Binary.data(), (int32_t)Header.Length);
+
+		// The driver rejects the binaries it can not use anymore (The program is then compiled and stored again)
+		int32_t IsLinked = GL_FALSE;
+		RenderDevice::Get().GetProgramiv(Program, GL_LINK_STATUS, &IsLinked);
+		if (IsLinked == GL_FALSE)
+		{
+			s_Data->Misses++;
+			return false;
+		}
+
+		s_Data->Hits++;
+		return true;
+	}
+
+	void ShaderCache::StoreProgram(uint64_t Key, uint32_t Program)
+	{
+		GX_PROFILE_FUNCTION()
+
+		if (!s_Data || !s_Data->IsBinarySupported)
+			return;
+
+		int32_t Length = 0;
+		RenderDevice::Get().GetProgramiv(Program, GL_PROGRAM_BINARY_LENGTH, &Length);
+		if (Length <= 0)
+			return;
+
+		ShaderCacheFileHeader Header;
+		Header.Key = Key;
+
+		std::vector<char> Binary(Length);
+		RenderDevice::Get().GetProgramBinary(Program, Length, &Length, &Header.BinaryFormat, Binary.data());
+		Header.Length = (uint32_t)Length;
+
+		std::ofstream Stream(GetCacheFilePath(Key), std::ios::binary | std::ios::trunc);
+		if (!Stream)
+		{
+			GX_ENGINE_WARN("Shader Cache: Could not write to {0}", GetCacheFilePath(Key));
+			return;
+		}
+
+		Stream.write((const char*)&Header, sizeof(Header));
+		Stream.write(Binary.data(), Header.Length);
+	}
+
+	bool ShaderCache::IsParallelCompileSupported()
+	{
+		return s_Data && s_Data->IsParallelCompileSupported;
+	}
+
+	std::string ShaderCache::GetCacheFilePath(uint64_t Key)
+	{
+		std::stringstream Path;
+		Path << s_Data->CacheDirectory << std::hex << std::setw(16) << std::setfill('0') << Key << ".bin";
+		return Path.str();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+
+namespace GraphX
+{
+	struct ShaderCacheData;
+
+	/*
+	* Disk cache of the linked shader programs (the driver binaries), so the shaders are compiled only on the first launch
+	* Binaries are keyed by the hash of the shader source and the driver (vendor, renderer and version), since a binary is only valid for the driver that created it
+	*/
+	class ShaderCache
+	{
+	public:
+		/* Checks the driver support for the program binaries and the parallel shader compilation */
+		static void Init();
+		static void Shutdown();
+
+		/* Returns the key of a program with the given source for the current driver */
+		static uint64_t GetKey(const std::string& VertexSource, const std::string& FragmentSource);
+
+		/* Loads the cached binary of the program in to it. Returns false if there is no (valid) binary and the program has to be compiled */
+		static bool LoadProgram(uint64_t Key, uint32_t Program);
+
+		/* Writes the binary of the linked program to the cache */
+		static void StoreProgram(uint64_t Key, uint32_t Program);
+
+		/* Whether the driver compiles and links the shaders on its own threads (the link status can be polled without blocking) */
+		static bool IsParallelCompileSupported();
+
+	private:
+		/* Returns the path of the cached binary for the key */
+		static std::string GetCacheFilePath(uint64_t Key);
+
+	private:
+		static ShaderCacheData* s_Data;
+	};
+}
\ No newline at end of file
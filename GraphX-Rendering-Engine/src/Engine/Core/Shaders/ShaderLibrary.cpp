@@ -41,4 +41,41 @@ namespace GraphX
 	{
 		return m_Shaders.find(name) != m_Shaders.end();
 	}
+
+	Ref<Shader> ShaderLibrary::GetVariant(const Ref<Shader>& Base, uint32_t Features)
+	{
+		if (Features == ShaderFeature::None || Base->GetFilePath().empty())
+			return Base;
+
+		Ref<Shader>& Variant = m_Variants[Base->GetFilePath()][Features];
+		if (!Variant)
+		{
+			GX_PROFILE_SCOPE("Compile Shader Variant")
+
+			// Compiled in the background (like any other shader), the caller checks whether it is ready
+			const std::vector<std::string> Defines = GetFeatureDefines(Features);
+
+			std::string Name = Base->GetName();
+			for (const std::string& Define : Defines)
+				Name.append(" ").append(Define);
+
+			Variant = CreateRef<Shader>(Base->GetFilePath(), Name, Defines);
+		}
+
+		return Variant;
+	}
+
+	std::vector<std::string> ShaderLibrary::GetFeatureDefines(uint32_t Features)
+	{
+		std::vector<std::string> Defines;
+
+		if (Features & ShaderFeature::Shadows)
+			Defines.emplace_back("GX_SHADOWS");
+		if (Features & ShaderFeature::PointLights)
+			Defines.emplace_back("GX_POINT_LIGHTS");
+		if (Features & ShaderFeature::Textured)
+			Defines.emplace_back("GX_TEXTURED");
+
+		return Defines;
+	}
 }
\ No newline at end of file
@@ -4,6 +4,26 @@ namespace GraphX
 {
 	class Shader;
 
+	/* Optional features compiled in to the shader variants (Each one adds a define to the shader source) */
+	namespace ShaderFeature
+	{
+		enum Type : uint32_t
+		{
+			None = 0,
+
+			/* GX_SHADOWS : Shadows of the sun from the cascaded shadow map */
+			Shadows = 1 << 0,
+
+			/* GX_POINT_LIGHTS : Lighting from the point lights of the view clusters */
+			PointLights = 1 << 1,
+
+			/* GX_TEXTURED : Colour from the texture of the material */
+			Textured = 1 << 2,
+
+			All = Shadows | PointLights | Textured
+		};
+	}
+
 	class ShaderLibrary
 	{
 	public:
@@ -20,7 +40,19 @@ namespace GraphX
 
 		// Returns whether the shader with the give name exists or not
 		bool Exists(const std::string& name) const;
+
+		/* Returns the variant of the base shader (loaded from a file without any features) with the features, compiling it on the first request
+		*  The base shader is returned for no features (and for the shaders created from the source, which can not be recompiled)
+		*/
+		Ref<Shader> GetVariant(const Ref<Shader>& Base, uint32_t Features);
+
+		/* Returns the defines added to the shader source for the features */
+		static std::vector<std::string> GetFeatureDefines(uint32_t Features);
+
 	private:
 		std::unordered_map<std::string, Ref<Shader>> m_Shaders;
+
+		/* Variants by the source file of the base shader and the features */
+		std::unordered_map<std::string, std::unordered_map<uint32_t, Ref<Shader>>> m_Variants;
 	};
 }
\ No newline at end of file
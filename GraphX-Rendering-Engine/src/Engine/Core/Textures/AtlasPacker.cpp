@@ -0,0 +1,164 @@
+#include "pch.h"
+#include "AtlasPacker.h"
+
+#include <algorithm>
+
+namespace GraphX
+{
+	AtlasPacker::AtlasPacker(uint32_t Width, uint32_t Height)
+		: m_Width(Width), m_Height(Height)
+	{
+		Reset();
+	}
+
+	bool AtlasPacker::Insert(uint32_t Width, uint32_t Height, Rect& OutRect)
+	{
+		if (Width == 0 || Height == 0 || Width > m_Width || Height > m_Height)
+			return false;
+
+		// Find the position with the lowest top edge, leftmost in case of a tie
+		uint32_t BestIndex = UINT32_MAX;
+		uint32_t BestY = UINT32_MAX, BestTop = UINT32_MAX;
+		for (uint32_t i = 0; i < m_Skyline.size(); i++)
+		{
+			uint32_t Y;
+			if (Fit(i, Width, Height, Y) && Y + Height < BestTop)
+			{
+				BestIndex = i;
+				BestY = Y;
+				BestTop = Y + Height;
+			}
+		}
+
+		if (BestIndex == UINT32_MAX)
+			return false;
+
+		OutRect.X = m_Skyline[BestIndex].X;
+		OutRect.Y = BestY;
+		OutRect.Width = Width;
+		OutRect.Height = Height;
+
+		AddSkylineLevel(BestIndex, OutRect);
+		m_UsedArea += (uint64_t)Width * Height;
+
+		return true;
+	}
+
+	bool AtlasPacker::Repack(const std::vector<Request>& Requests, std::vector<Rect>& OutRects)
+	{
+		GX_PROFILE_FUNCTION()
+
+		Reset();
+		OutRects.resize(Requests.size());
+
+		// Taller (then wider) rects first, gives a flatter skyline
+		std::vector<uint32_t> Order(Requests.size());
+		for (uint32_t i = 0; i < Order.size(); i++)
+		{
+			Order[i] = i;
+		}
+
+		std::sort(Order.begin(), Order.end(), [&Requests](uint32_t A, uint32_t B) {
+			const Request& RA = Requests[A];
+			const Request& RB = Requests[B];
+			return RA.Height != RB.Height ? RA.Height > RB.Height : RA.Width > RB.Width;
+		});
+
+		for (uint32_t Index : Order)
+		{
+			if (!Insert(Requests[Index].Width, Requests[Index].Height, OutRects[Index]))
+			{
+				Reset();
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void AtlasPacker::Reset()
+	{
+		m_Skyline.clear();
+		m_Skyline.push_back({ 0, 0, m_Width });
+		m_UsedArea = 0;
+	}
+
+	void AtlasPacker::Resize(uint32_t Width, uint32_t Height)
+	{
+		m_Width = Width;
+		m_Height = Height;
+		Reset();
+	}
+
+	float AtlasPacker::GetOccupancy() const
+	{
+		return (float)((double)m_UsedArea / ((double)m_Width * m_Height));
+	}
+
+	bool AtlasPacker::Fit(uint32_t NodeIndex, uint32_t Width, uint32_t Height, uint32_t& OutY) const
+	{
+		uint32_t X = m_Skyline[NodeIndex].X;
+		if (X + Width > m_Width)
+			return false;
+
+		// The rect rests on the highest node it spans
+		uint32_t Y = 0;
+		int64_t WidthLeft = Width;
+		uint32_t i = NodeIndex;
+		while (WidthLeft > 0)
+		{
+			Y = GM::Utility::Max(Y, m_Skyline[i].Y);
+			if (Y + Height > m_Height)
+				return false;
+
+			WidthLeft -= m_Skyline[i].Width;
+			i++;
+		}
+
+		OutY = Y;
+		return true;
+	}
+
+	void AtlasPacker::AddSkylineLevel(uint32_t NodeIndex, const Rect& NewRect)
+	{
+		m_Skyline.insert(m_Skyline.begin() + NodeIndex, { NewRect.X, NewRect.Y + NewRect.Height, NewRect.Width });
+
+		// Shrink or remove the nodes now covered by the new node
+		uint32_t i = NodeIndex + 1;
+		while (i < m_Skyline.size())
+		{
+			uint32_t PreviousEnd = m_Skyline[i - 1].X + m_Skyline[i - 1].Width;
+			SkylineNode& Node = m_Skyline[i];
+
+			if (Node.X >= PreviousEnd)
+				break;
+
+			uint32_t Shrink = PreviousEnd - Node.X;
+			if (Node.Width <= Shrink)
+			{
+				m_Skyline.erase(m_Skyline.begin() + i);
+			}
+			else
+			{
+				Node.X += Shrink;
+				Node.Width -= Shrink;
+				break;
+			}
+		}
+
+		// Merge the neighbouring nodes at the same height
+		i = 0;
+		while (i + 1 < m_Skyline.size())
+		{
+			if (m_Skyline[i].Y == m_Skyline[i + 1].Y)
+			{
+				m_Skyline[i].Width += m_Skyline[i + 1].Width;
+				m_Skyline.erase(m_Skyline.begin() + i + 1);
+			}
+			else
+			{
+				i++;
+			}
+		}
+	}
+}
\ No newline at end of file
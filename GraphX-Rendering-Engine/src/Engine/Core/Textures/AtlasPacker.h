@@ -0,0 +1,80 @@
+#pragma once
+
+namespace GraphX
+{
+	/**
+	* Skyline (bottom left) rectangle packer used to build texture atlases
+	* Works only with the rectangle sizes, so it does not need a graphics context
+	*/
+	class AtlasPacker
+	{
+	public:
+		/* Rectangle allocated in the atlas (includes the padding) */
+		struct Rect
+		{
+			uint32_t X = 0, Y = 0;
+			uint32_t Width = 0, Height = 0;
+		};
+
+		/* Size of a rectangle to be packed along with an id to identify it after packing */
+		struct Request
+		{
+			uint32_t ID = 0;
+			uint32_t Width = 0, Height = 0;
+		};
+
+	public:
+		AtlasPacker(uint32_t Width, uint32_t Height);
+
+		/**
+		* Inserts a new rectangle in the atlas, without moving the already inserted rectangles
+		* @return false if the rectangle does not fit in the remaining space
+		*/
+		bool Insert(uint32_t Width, uint32_t Height, Rect& OutRect);
+
+		/**
+		* Clears the atlas and packs all the requests again (sorted by size for a tighter fit)
+		* @param OutRects Packed rects in the same order as the requests
+		* @return false if all the requests do not fit in the atlas (Atlas is left cleared)
+		*/
+		bool Repack(const std::vector<Request>& Requests, std::vector<Rect>& OutRects);
+
+		/* Removes all the rectangles from the atlas */
+		void Reset();
+
+		/* Changes the size of the atlas (clears the atlas) */
+		void Resize(uint32_t Width, uint32_t Height);
+
+		/* Returns the width of the atlas */
+		inline uint32_t GetWidth() const { return m_Width; }
+
+		/* Returns the height of the atlas */
+		inline uint32_t GetHeight() const { return m_Height; }
+
+		/* Returns the ratio of the area used by the rectangles to the total area of the atlas */
+		float GetOccupancy() const;
+
+	private:
+		/* Segment of the skyline */
+		struct SkylineNode
+		{
+			uint32_t X, Y, Width;
+		};
+
+		/* Returns the height at which the rect can be placed starting at the node or false if it does not fit there */
+		bool Fit(uint32_t NodeIndex, uint32_t Width, uint32_t Height, uint32_t& OutY) const;
+
+		/* Raises the skyline to the top of the newly placed rect */
+		void AddSkylineLevel(uint32_t NodeIndex, const Rect& NewRect);
+
+	private:
+		/* Size of the atlas */
+		uint32_t m_Width, m_Height;
+
+		/* Current skyline, sorted from left to right and covering the entire width of the atlas */
+		std::vector<SkylineNode> m_Skyline;
+
+		/* Area used by the rectangles */
+		uint64_t m_UsedArea = 0;
+	};
+}
\ No newline at end of file
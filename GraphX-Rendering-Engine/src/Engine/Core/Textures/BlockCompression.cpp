@@ -0,0 +1,507 @@
+#include "pch.h"
+#include "BlockCompression.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace GraphX
+{
+	/* RGBA pixels of a 4x4 block (Row by row) */
+	typedef uint8_t BlockPixels[16][4];
+
+	/* Interpolation weights (out of 64) of the 4 bit indices of BC7 */
+	static const int BC7IndexWeights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	/* Writes the fields of a block, starting from the least significant bit */
+	class BlockBitWriter
+	{
+	public:
+		BlockBitWriter(uint8_t* Data)
+			: m_Data(Data), m_Position(0)
+		{}
+
+		void Write(uint32_t Value, uint32_t BitCount)
+		{
+			for (uint32_t i = 0; i < BitCount; i++, m_Position++)
+			{
+				if ((Value >> i) & 1)
+					m_Data[m_Position / 8] |= (uint8_t)(1 << (m_Position % 8));
+			}
+		}
+
+	private:
+		uint8_t* m_Data;
+		uint32_t m_Position;
+	};
+
+	/* Finds the mean of the block and the axis along which its pixels spread the most (in the first Channels channels) */
+	static void ComputePrincipalAxis(const BlockPixels Block, uint32_t Channels, float Mean[4], float Axis[4])
+	{
+		for (uint32_t c = 0; c < 4; c++)
+		{
+			Mean[c] = 0.0f;
+			Axis[c] = 0.0f;
+		}
+
+		for (uint32_t i = 0; i < 16; i++)
+			for (uint32_t c = 0; c < Channels; c++)
+				Mean[c] += Block[i][c] / 16.0f;
+
+		float Covariance[4][4] = {};
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			for (uint32_t r = 0; r < Channels; r++)
+				for (uint32_t c = 0; c < Channels; c++)
+					Covariance[r][c] += (Block[i][r] - Mean[r]) * (Block[i][c] - Mean[c]);
+		}
+
+		// Power iteration, starting from the column of the channel that varies the most
+		uint32_t Widest = 0;
+		for (uint32_t c = 1; c < Channels; c++)
+		{
+			if (Covariance[c][c] > Covariance[Widest][Widest])
+				Widest = c;
+		}
+
+		if (Covariance[Widest][Widest] <= 0.0f)
+		{
+			// Flat block (Any axis works)
+			for (uint32_t c = 0; c < Channels; c++)
+				Axis[c] = 1.0f / std::sqrt((float)Channels);
+			return;
+		}
+
+		for (uint32_t c = 0; c < Channels; c++)
+			Axis[c] = Covariance[c][Widest];
+
+		for (uint32_t Iteration = 0; Iteration < 8; Iteration++)
+		{
+			float Next[4] = {};
+			float Largest = 0.0f;
+			for (uint32_t r = 0; r < Channels; r++)
+			{
+				for (uint32_t c = 0; c < Channels; c++)
+					Next[r] += Covariance[r][c] * Axis[c];
+
+				Largest = std::max(Largest, std::abs(Next[r]));
+			}
+
+			if (Largest <= 0.0f)
+				break;
+
+			for (uint32_t c = 0; c < Channels; c++)
+				Axis[c] = Next[c] / Largest;
+		}
+
+		float Length = 0.0f;
+		for (uint32_t c = 0; c < Channels; c++)
+			Length += Axis[c] * Axis[c];
+
+		Length = std::sqrt(Length);
+		for (uint32_t c = 0; c < Channels; c++)
+			Axis[c] /= Length;
+	}
+
+	/* Projects the pixels of the block on the axis and returns the range of the projections */
+	static void ComputeProjectionRange(const BlockPixels Block, uint32_t Channels, const float Mean[4], const float Axis[4], float& OutMin, float& OutMax)
+	{
+		OutMin = FLT_MAX;
+		OutMax = -FLT_MAX;
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			float Projection = 0.0f;
+			for (uint32_t c = 0; c < Channels; c++)
+				Projection += (Block[i][c] - Mean[c]) * Axis[c];
+
+			OutMin = std::min(OutMin, Projection);
+			OutMax = std::max(OutMax, Projection);
+		}
+	}
+
+	/****** BC1 ******/
+
+	static uint16_t PackRGB565(const float Color[3])
+	{
+		const uint32_t r = (uint32_t)std::min(std::max(Color[0] * 31.0f / 255.0f + 0.5f, 0.0f), 31.0f);
+		const uint32_t g = (uint32_t)std::min(std::max(Color[1] * 63.0f / 255.0f + 0.5f, 0.0f), 63.0f);
+		const uint32_t b = (uint32_t)std::min(std::max(Color[2] * 31.0f / 255.0f + 0.5f, 0.0f), 31.0f);
+
+		return (uint16_t)((r << 11) | (g << 5) | b);
+	}
+
+	static void UnpackRGB565(uint16_t Packed, int Color[3])
+	{
+		const int r = (Packed >> 11) & 31, g = (Packed >> 5) & 63, b = Packed & 31;
+
+		Color[0] = (r << 3) | (r >> 2);
+		Color[1] = (g << 2) | (g >> 4);
+		Color[2] = (b << 3) | (b >> 2);
+	}
+
+	/**
+	* Picks the closest of the four colors of the endpoints for each pixel (Endpoints are ordered for the four color mode)
+	* @return Squared error of the block
+	*/
+	static uint32_t ComputeBC1Indices(const BlockPixels Block, uint16_t& Color0, uint16_t& Color1, uint32_t& OutIndices)
+	{
+		// Color0 must be the greater one, else the block is decoded with three colors and transparent black
+		if (Color0 < Color1)
+			std::swap(Color0, Color1);
+
+		int Palette[4][3];
+		UnpackRGB565(Color0, Palette[0]);
+		UnpackRGB565(Color1, Palette[1]);
+		for (uint32_t c = 0; c < 3; c++)
+		{
+			Palette[2][c] = (2 * Palette[0][c] + Palette[1][c]) / 3;
+			Palette[3][c] = (Palette[0][c] + 2 * Palette[1][c]) / 3;
+		}
+
+		// Both the endpoints are same, so every pixel uses the first one
+		const uint32_t PaletteSize = Color0 == Color1 ? 1 : 4;
+
+		OutIndices = 0;
+		uint32_t TotalError = 0;
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			uint32_t BestIndex = 0, BestError = UINT32_MAX;
+			for (uint32_t p = 0; p < PaletteSize; p++)
+			{
+				uint32_t Error = 0;
+				for (uint32_t c = 0; c < 3; c++)
+				{
+					const int Difference = Block[i][c] - Palette[p][c];
+					Error += Difference * Difference;
+				}
+
+				if (Error < BestError)
+				{
+					BestError = Error;
+					BestIndex = p;
+				}
+			}
+
+			OutIndices |= BestIndex << (2 * i);
+			TotalError += BestError;
+		}
+
+		return TotalError;
+	}
+
+	/* Solves for the endpoints that best fit the pixels with the chosen indices (Least squares), returns false if they can not be solved for */
+	static bool RefineBC1Endpoints(const BlockPixels Block, uint32_t Indices, uint16_t& OutColor0, uint16_t& OutColor1)
+	{
+		// Weight of the first endpoint for each index (second one gets the rest)
+		static const float EndpointWeights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+
+		float AA = 0.0f, BB = 0.0f, AB = 0.0f;
+		float AX[3] = {}, BX[3] = {};
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			const float a = EndpointWeights[(Indices >> (2 * i)) & 3];
+			const float b = 1.0f - a;
+
+			AA += a * a;
+			BB += b * b;
+			AB += a * b;
+			for (uint32_t c = 0; c < 3; c++)
+			{
+				AX[c] += a * Block[i][c];
+				BX[c] += b * Block[i][c];
+			}
+		}
+
+		const float Determinant = AA * BB - AB * AB;
+		if (std::abs(Determinant) < 1e-6f)
+			return false;
+
+		float End0[3], End1[3];
+		for (uint32_t c = 0; c < 3; c++)
+		{
+			End0[c] = (AX[c] * BB - BX[c] * AB) / Determinant;
+			End1[c] = (BX[c] * AA - AX[c] * AB) / Determinant;
+		}
+
+		OutColor0 = PackRGB565(End0);
+		OutColor1 = PackRGB565(End1);
+		return true;
+	}
+
+	static void EncodeBC1Block(const BlockPixels Block, uint8_t* Out)
+	{
+		float Mean[4], Axis[4];
+		ComputePrincipalAxis(Block, 3, Mean, Axis);
+
+		float MinProjection, MaxProjection;
+		ComputeProjectionRange(Block, 3, Mean, Axis, MinProjection, MaxProjection);
+
+		// Endpoints are inset slightly, since the extremes are rarely hit exactly by the interpolated colors
+		const float Inset = (MaxProjection - MinProjection) / 16.0f;
+
+		float End0[3], End1[3];
+		for (uint32_t c = 0; c < 3; c++)
+		{
+			End0[c] = Mean[c] + Axis[c] * (MaxProjection - Inset);
+			End1[c] = Mean[c] + Axis[c] * (MinProjection + Inset);
+		}
+
+		uint16_t Color0 = PackRGB565(End0), Color1 = PackRGB565(End1);
+		uint32_t Indices;
+		uint32_t Error = ComputeBC1Indices(Block, Color0, Color1, Indices);
+
+		// Refit the endpoints to the chosen indices once (kept only if it lowers the error)
+		uint16_t RefinedColor0, RefinedColor1;
+		if (Error > 0 && RefineBC1Endpoints(Block, Indices, RefinedColor0, RefinedColor1))
+		{
+			uint32_t RefinedIndices;
+			const uint32_t RefinedError = ComputeBC1Indices(Block, RefinedColor0, RefinedColor1, RefinedIndices);
+			if (RefinedError < Error)
+			{
+				Color0 = RefinedColor0;
+				Color1 = RefinedColor1;
+				Indices = RefinedIndices;
+			}
+		}
+
+		Out[0] = (uint8_t)(Color0 & 0xFF);
+		Out[1] = (uint8_t)(Color0 >> 8);
+		Out[2] = (uint8_t)(Color1 & 0xFF);
+		Out[3] = (uint8_t)(Color1 >> 8);
+		for (uint32_t i = 0; i < 4; i++)
+			Out[4 + i] = (uint8_t)((Indices >> (8 * i)) & 0xFF);
+	}
+
+	/****** BC4 ******/
+
+	/* Encodes a channel of the block (Used for the alpha of BC3 and the channels of BC4 / BC5) */
+	static void EncodeBC4Block(const BlockPixels Block, uint32_t Channel, uint8_t* Out)
+	{
+		int Min = 255, Max = 0;
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			Min = std::min(Min, (int)Block[i][Channel]);
+			Max = std::max(Max, (int)Block[i][Channel]);
+		}
+
+		std::fill(Out, Out + 8, (uint8_t)0);
+
+		// Greater first endpoint selects the eight value mode (six interpolated values between the endpoints)
+		Out[0] = (uint8_t)Max;
+		Out[1] = (uint8_t)Min;
+		if (Min == Max)
+			return;
+
+		int Palette[8];
+		Palette[0] = Max;
+		Palette[1] = Min;
+		for (int p = 2; p < 8; p++)
+			Palette[p] = ((8 - p) * Max + (p - 1) * Min) / 7;
+
+		BlockBitWriter Writer(Out + 2);
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			uint32_t BestIndex = 0;
+			int BestError = INT32_MAX;
+			for (uint32_t p = 0; p < 8; p++)
+			{
+				const int Error = std::abs(Block[i][Channel] - Palette[p]);
+				if (Error < BestError)
+				{
+					BestError = Error;
+					BestIndex = p;
+				}
+			}
+
+			Writer.Write(BestIndex, 3);
+		}
+	}
+
+	/****** BC7 ******/
+
+	/* Quantizes an RGBA endpoint to 7 bits per channel with a shared least significant bit (Picks the bit with the lower error) */
+	static void QuantizeBC7Endpoint(const float Endpoint[4], uint32_t Quantized[4], uint32_t& OutPBit)
+	{
+		float BestError = FLT_MAX;
+		for (uint32_t PBit = 0; PBit < 2; PBit++)
+		{
+			uint32_t Candidate[4];
+			float Error = 0.0f;
+			for (uint32_t c = 0; c < 4; c++)
+			{
+				Candidate[c] = (uint32_t)std::min(std::max((Endpoint[c] - PBit) / 2.0f + 0.5f, 0.0f), 127.0f);
+
+				const float Difference = (float)((Candidate[c] << 1) | PBit) - Endpoint[c];
+				Error += Difference * Difference;
+			}
+
+			if (Error < BestError)
+			{
+				BestError = Error;
+				OutPBit = PBit;
+				std::copy(Candidate, Candidate + 4, Quantized);
+			}
+		}
+	}
+
+	/* Encodes the block in mode 6 (Single subset, RGBA endpoints and 4 bit indices) */
+	static void EncodeBC7Block(const BlockPixels Block, uint8_t* Out)
+	{
+		float Mean[4], Axis[4];
+		ComputePrincipalAxis(Block, 4, Mean, Axis);
+
+		float MinProjection, MaxProjection;
+		ComputeProjectionRange(Block, 4, Mean, Axis, MinProjection, MaxProjection);
+
+		const float Inset = (MaxProjection - MinProjection) / 32.0f;
+
+		float End0[4], End1[4];
+		for (uint32_t c = 0; c < 4; c++)
+		{
+			End0[c] = Mean[c] + Axis[c] * (MinProjection + Inset);
+			End1[c] = Mean[c] + Axis[c] * (MaxProjection - Inset);
+		}
+
+		uint32_t Quantized[2][4], PBits[2];
+		QuantizeBC7Endpoint(End0, Quantized[0], PBits[0]);
+		QuantizeBC7Endpoint(End1, Quantized[1], PBits[1]);
+
+		int Endpoints[2][4];
+		for (uint32_t e = 0; e < 2; e++)
+			for (uint32_t c = 0; c < 4; c++)
+				Endpoints[e][c] = (int)((Quantized[e][c] << 1) | PBits[e]);
+
+		int Palette[16][4];
+		for (uint32_t p = 0; p < 16; p++)
+			for (uint32_t c = 0; c < 4; c++)
+				Palette[p][c] = ((64 - BC7IndexWeights[p]) * Endpoints[0][c] + BC7IndexWeights[p] * Endpoints[1][c] + 32) >> 6;
+
+		uint32_t Indices[16];
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			int BestError = INT32_MAX;
+			for (uint32_t p = 0; p < 16; p++)
+			{
+				int Error = 0;
+				for (uint32_t c = 0; c < 4; c++)
+				{
+					const int Difference = Block[i][c] - Palette[p][c];
+					Error += Difference * Difference;
+				}
+
+				if (Error < BestError)
+				{
+					BestError = Error;
+					Indices[i] = p;
+				}
+			}
+		}
+
+		// Most significant bit of the first index is not stored (it must be 0), so the endpoints are swapped if needed
+		if (Indices[0] & 8)
+		{
+			for (uint32_t c = 0; c < 4; c++)
+				std::swap(Quantized[0][c], Quantized[1][c]);
+
+			std::swap(PBits[0], PBits[1]);
+			for (uint32_t i = 0; i < 16; i++)
+				Indices[i] = 15 - Indices[i];
+		}
+
+		std::fill(Out, Out + 16, (uint8_t)0);
+
+		BlockBitWriter Writer(Out);
+		Writer.Write(1 << 6, 7);
+		for (uint32_t c = 0; c < 4; c++)
+		{
+			Writer.Write(Quantized[0][c], 7);
+			Writer.Write(Quantized[1][c], 7);
+		}
+
+		Writer.Write(PBits[0], 1);
+		Writer.Write(PBits[1], 1);
+
+		Writer.Write(Indices[0], 3);
+		for (uint32_t i = 1; i < 16; i++)
+			Writer.Write(Indices[i], 4);
+	}
+
+	uint32_t BlockCompression::GetBlockSize(BlockFormat Format)
+	{
+		return Format == BlockFormat::BC1 || Format == BlockFormat::BC4 ? 8 : 16;
+	}
+
+	uint64_t BlockCompression::GetImageSize(BlockFormat Format, uint32_t Width, uint32_t Height)
+	{
+		const uint64_t BlocksX = std::max(Width / 4 + (Width % 4 != 0), 1u);
+		const uint64_t BlocksY = std::max(Height / 4 + (Height % 4 != 0), 1u);
+		return BlocksX * BlocksY * GetBlockSize(Format);
+	}
+
+	const char* BlockCompression::GetFormatName(BlockFormat Format)
+	{
+		switch (Format)
+		{
+			case BlockFormat::BC1: return "BC1";
+			case BlockFormat::BC3: return "BC3";
+			case BlockFormat::BC4: return "BC4";
+			case BlockFormat::BC5: return "BC5";
+			case BlockFormat::BC7: return "BC7";
+		}
+
+		return "Unknown";
+	}
+
+	std::vector<uint8_t> BlockCompression::Compress(const uint8_t* Pixels, uint32_t Width, uint32_t Height, BlockFormat Format)
+	{
+		GX_PROFILE_FUNCTION()
+
+		std::vector<uint8_t> Compressed((size_t)GetImageSize(Format, Width, Height));
+		uint8_t* Out = Compressed.data();
+
+		const uint32_t BlockSize = GetBlockSize(Format);
+		for (uint32_t BlockY = 0; BlockY < Height; BlockY += 4)
+		{
+			for (uint32_t BlockX = 0; BlockX < Width; BlockX += 4)
+			{
+				// Blocks crossing the edges repeat the last row / column
+				BlockPixels Block;
+				for (uint32_t i = 0; i < 16; i++)
+				{
+					const uint32_t x = std::min(BlockX + i % 4, Width - 1);
+					const uint32_t y = std::min(BlockY + i / 4, Height - 1);
+					std::copy(Pixels + ((size_t)y * Width + x) * 4, Pixels + ((size_t)y * Width + x) * 4 + 4, Block[i]);
+				}
+
+				switch (Format)
+				{
+					case BlockFormat::BC1:
+						EncodeBC1Block(Block, Out);
+						break;
+
+					case BlockFormat::BC3:
+						EncodeBC4Block(Block, 3, Out);
+						EncodeBC1Block(Block, Out + 8);
+						break;
+
+					case BlockFormat::BC4:
+						EncodeBC4Block(Block, 0, Out);
+						break;
+
+					case BlockFormat::BC5:
+						EncodeBC4Block(Block, 0, Out);
+						EncodeBC4Block(Block, 1, Out + 8);
+						break;
+
+					case BlockFormat::BC7:
+						EncodeBC7Block(Block, Out);
+						break;
+				}
+
+				Out += BlockSize;
+			}
+		}
+
+		return Compressed;
+	}
+}
\ No newline at end of file
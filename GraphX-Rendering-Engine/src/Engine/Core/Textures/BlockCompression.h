@@ -0,0 +1,37 @@
+#pragma once
+
+namespace GraphX
+{
+	/* Block compressed formats (Every format stores 4x4 pixel blocks) */
+	enum class BlockFormat
+	{
+		BC1 = 0,		/* RGB at 4 bits per pixel */
+		BC3,			/* RGBA at 8 bits per pixel (BC1 color with a BC4 alpha) */
+		BC4,			/* Single channel at 4 bits per pixel (Height, roughness maps) */
+		BC5,			/* Two channels at 8 bits per pixel (Normal maps) */
+		BC7				/* RGBA at 8 bits per pixel (Better quality than BC1 / BC3) */
+	};
+
+	/**
+	* Encodes the images in to the block compressed formats
+	* Works only with the pixels, so it does not need a graphics context (Used by the offline texture compressor)
+	*/
+	class BlockCompression
+	{
+	public:
+		/* Returns the size of a 4x4 block of the format (in bytes) */
+		static uint32_t GetBlockSize(BlockFormat Format);
+
+		/* Returns the size of an image of the format (Partial blocks at the edges take up a whole block, 64 bit so the large images do not wrap) */
+		static uint64_t GetImageSize(BlockFormat Format, uint32_t Width, uint32_t Height);
+
+		/* Returns the name of the format (e.g. "BC7") */
+		static const char* GetFormatName(BlockFormat Format);
+
+		/**
+		* Encodes an RGBA8 image (Tightly packed) in to the format
+		* BC4 keeps the red channel and BC5 the red and green channels
+		*/
+		static std::vector<uint8_t> Compress(const uint8_t* Pixels, uint32_t Width, uint32_t Height, BlockFormat Format);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,415 @@
+#include "pch.h"
+#include "CompressedImage.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+
+namespace GraphX
+{
+	static constexpr uint32_t MakeFourCC(char a, char b, char c, char d)
+	{
+		return (uint32_t)(uint8_t)a | ((uint32_t)(uint8_t)b << 8) | ((uint32_t)(uint8_t)c << 16) | ((uint32_t)(uint8_t)d << 24);
+	}
+
+	/****** DDS ******/
+
+	static constexpr uint32_t DDSMagic = MakeFourCC('D', 'D', 'S', ' ');
+
+	/* Size of the magic and the header, and of the extended header (present when the four cc is DX10) */
+	static constexpr size_t DDSHeaderSize = 4 + 124;
+	static constexpr size_t DDSHeaderDX10Size = 20;
+
+	/* Flags of the header (Only the ones written by the engine) */
+	static constexpr uint32_t DDSD_CAPS = 0x1, DDSD_HEIGHT = 0x2, DDSD_WIDTH = 0x4, DDSD_PIXELFORMAT = 0x1000, DDSD_MIPMAPCOUNT = 0x20000, DDSD_LINEARSIZE = 0x80000;
+	static constexpr uint32_t DDPF_FOURCC = 0x4;
+	static constexpr uint32_t DDSCAPS_COMPLEX = 0x8, DDSCAPS_TEXTURE = 0x1000, DDSCAPS_MIPMAP = 0x400000;
+	static constexpr uint32_t DDSCAPS2_CUBEMAP = 0x200, DDSCAPS2_CUBEMAP_ALLFACES = 0xFC00;
+	static constexpr uint32_t DDS_RESOURCE_MISC_TEXTURECUBE = 0x4, DDS_DIMENSION_TEXTURE2D = 3;
+
+	/****** KTX2 ******/
+
+	static const uint8_t KTX2Identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+	/* Size of the identifier and the header (up to the level index), and of an entry of the level index */
+	static constexpr size_t KTX2HeaderSize = 80;
+	static constexpr size_t KTX2LevelIndexEntrySize = 24;
+
+	static uint32_t ReadUInt32(const std::vector<uint8_t>& Data, size_t Offset)
+	{
+		uint32_t Value;
+		std::memcpy(&Value, Data.data() + Offset, sizeof(Value));
+		return Value;
+	}
+
+	static uint64_t ReadUInt64(const std::vector<uint8_t>& Data, size_t Offset)
+	{
+		uint64_t Value;
+		std::memcpy(&Value, Data.data() + Offset, sizeof(Value));
+		return Value;
+	}
+
+	static void WriteUInt32(std::vector<uint8_t>& Data, size_t Offset, uint32_t Value)
+	{
+		std::memcpy(Data.data() + Offset, &Value, sizeof(Value));
+	}
+
+	/* Largest width / height accepted from a header (Above what any device can create, the device limit is checked when the texture is decoded) */
+	static constexpr uint32_t MaxImageSize = 65536;
+
+	/* Checks the size and the number of mip levels read from a header, before the levels are allocated or their sizes are shifted */
+	static bool IsValidImageSize(uint32_t Width, uint32_t Height, uint32_t LevelCount, const std::string& FilePath)
+	{
+		if (Width == 0 || Height == 0)
+		{
+			GX_ENGINE_ERROR("CompressedImage: {0} has an empty image ({1}x{2})", FilePath, Width, Height);
+			return false;
+		}
+
+		if (Width > MaxImageSize || Height > MaxImageSize)
+		{
+			GX_ENGINE_ERROR("CompressedImage: {0} is too large ({1}x{2})", FilePath, Width, Height);
+			return false;
+		}
+
+		// Full mip chain goes down to 1x1 : floor(log2(max(Width, Height))) + 1 levels
+		uint32_t MaxLevelCount = 1;
+		for (uint32_t Size = std::max(Width, Height); Size > 1; Size >>= 1)
+			MaxLevelCount++;
+
+		if (LevelCount > MaxLevelCount)
+		{
+			GX_ENGINE_ERROR("CompressedImage: {0} has {1} mip levels, more than the {2} levels of a {3}x{4} image", FilePath, LevelCount, MaxLevelCount, Width, Height);
+			return false;
+		}
+
+		return true;
+	}
+
+	/* Maps the format of a DDS file (four cc, or the DXGI format for the extended header) to the block format */
+	static bool GetDDSFormat(uint32_t FourCC, uint32_t DXGIFormat, BlockFormat& OutFormat)
+	{
+		switch (FourCC)
+		{
+			case MakeFourCC('D', 'X', 'T', '1'): OutFormat = BlockFormat::BC1; return true;
+			case MakeFourCC('D', 'X', 'T', '5'): OutFormat = BlockFormat::BC3; return true;
+			case MakeFourCC('A', 'T', 'I', '1'):
+			case MakeFourCC('B', 'C', '4', 'U'): OutFormat = BlockFormat::BC4; return true;
+			case MakeFourCC('A', 'T', 'I', '2'):
+			case MakeFourCC('B', 'C', '5', 'U'): OutFormat = BlockFormat::BC5; return true;
+		}
+
+		if (FourCC != MakeFourCC('D', 'X', '1', '0'))
+			return false;
+
+		// sRGB variants are read as the linear ones, since the engine shades in gamma space (same as the uncompressed textures)
+		switch (DXGIFormat)
+		{
+			case 71: case 72: OutFormat = BlockFormat::BC1; return true;
+			case 77: case 78: OutFormat = BlockFormat::BC3; return true;
+			case 80:		  OutFormat = BlockFormat::BC4; return true;
+			case 83:		  OutFormat = BlockFormat::BC5; return true;
+			case 98: case 99: OutFormat = BlockFormat::BC7; return true;
+		}
+
+		return false;
+	}
+
+	/* Maps the vulkan format of a KTX2 file to the block format */
+	static bool GetKTX2Format(uint32_t VkFormat, BlockFormat& OutFormat)
+	{
+		switch (VkFormat)
+		{
+			case 131: case 132: case 133: case 134: OutFormat = BlockFormat::BC1; return true;
+			case 137: case 138: OutFormat = BlockFormat::BC3; return true;
+			case 139:			OutFormat = BlockFormat::BC4; return true;
+			case 141:			OutFormat = BlockFormat::BC5; return true;
+			case 145: case 146: OutFormat = BlockFormat::BC7; return true;
+		}
+
+		return false;
+	}
+
+	CompressedImage::CompressedImage()
+		: m_Format(BlockFormat::BC1), m_Width(0), m_Height(0), m_FaceCount(0), m_LevelCount(0)
+	{
+	}
+
+	CompressedImage::CompressedImage(BlockFormat Format, uint32_t Width, uint32_t Height)
+		: m_Format(Format), m_Width(Width), m_Height(Height), m_FaceCount(1), m_LevelCount(0)
+	{
+	}
+
+	bool CompressedImage::IsCompressedFile(const std::string& FilePath)
+	{
+		const size_t ExtensionStart = FilePath.find_last_of('.');
+		if (ExtensionStart == std::string::npos)
+			return false;
+
+		std::string Extension = FilePath.substr(ExtensionStart + 1);
+		std::transform(Extension.begin(), Extension.end(), Extension.begin(), ::tolower);
+
+		return Extension == "dds" || Extension == "ktx2";
+	}
+
+	bool CompressedImage::Load(const std::string& FilePath)
+	{
+		GX_PROFILE_FUNCTION()
+
+		std::ifstream File(FilePath, std::ios::in | std::ios::binary | std::ios::ate);
+		if (!File)
+		{
+			GX_ENGINE_ERROR("CompressedImage: Couldn't open {0}", FilePath);
+			return false;
+		}
+
+		m_Data.resize((size_t)File.tellg());
+		File.seekg(0);
+		File.read((char*)m_Data.data(), m_Data.size());
+
+		m_Levels.clear();
+
+		const bool IsLoaded = m_Data.size() >= 12 && std::memcmp(m_Data.data(), KTX2Identifier, sizeof(KTX2Identifier)) == 0 ? ParseKTX2(FilePath) : ParseDDS(FilePath);
+		if (!IsLoaded)
+		{
+			m_Data.clear();
+			m_Levels.clear();
+			m_FaceCount = m_LevelCount = 0;
+		}
+
+		return IsLoaded;
+	}
+
+	bool CompressedImage::ParseDDS(const std::string& FilePath)
+	{
+		if (m_Data.size() < DDSHeaderSize || ReadUInt32(m_Data, 0) != DDSMagic)
+		{
+			GX_ENGINE_ERROR("CompressedImage: {0} is not a DDS or KTX2 file", FilePath);
+			return false;
+		}
+
+		const uint32_t Flags = ReadUInt32(m_Data, 4 + 4);
+		m_Height = ReadUInt32(m_Data, 4 + 8);
+		m_Width = ReadUInt32(m_Data, 4 + 12);
+		const uint32_t MipMapCount = ReadUInt32(m_Data, 4 + 24);
+		const uint32_t FourCC = ReadUInt32(m_Data, 4 + 80);
+		const uint32_t Caps2 = ReadUInt32(m_Data, 4 + 108);
+
+		size_t DataOffset = DDSHeaderSize;
+		uint32_t DXGIFormat = 0;
+		m_FaceCount = (Caps2 & DDSCAPS2_CUBEMAP) ? 6 : 1;
+
+		if (FourCC == MakeFourCC('D', 'X', '1', '0'))
+		{
+			if (m_Data.size() < DDSHeaderSize + DDSHeaderDX10Size)
+			{
+				GX_ENGINE_ERROR("CompressedImage: {0} is truncated", FilePath);
+				return false;
+			}
+
+			DXGIFormat = ReadUInt32(m_Data, DDSHeaderSize);
+			const uint32_t MiscFlag = ReadUInt32(m_Data, DDSHeaderSize + 8);
+			const uint32_t ArraySize = ReadUInt32(m_Data, DDSHeaderSize + 12);
+
+			if (ArraySize > 1)
+			{
+				GX_ENGINE_ERROR("CompressedImage: Texture arrays are not supported ({0})", FilePath);
+				return false;
+			}
+
+			m_FaceCount = (MiscFlag & DDS_RESOURCE_MISC_TEXTURECUBE) ? 6 : 1;
+			DataOffset += DDSHeaderDX10Size;
+		}
+		else if ((Caps2 & DDSCAPS2_CUBEMAP) && (Caps2 & DDSCAPS2_CUBEMAP_ALLFACES) != DDSCAPS2_CUBEMAP_ALLFACES)
+		{
+			GX_ENGINE_ERROR("CompressedImage: Cube maps with missing faces are not supported ({0})", FilePath);
+			return false;
+		}
+
+		if (!GetDDSFormat(FourCC, DXGIFormat, m_Format))
+		{
+			GX_ENGINE_ERROR("CompressedImage: {0} is not BC1, BC3, BC4, BC5 or BC7 compressed", FilePath);
+			return false;
+		}
+
+		m_LevelCount = (Flags & DDSD_MIPMAPCOUNT) ? std::max(MipMapCount, 1u) : 1;
+		if (!IsValidImageSize(m_Width, m_Height, m_LevelCount, FilePath))
+			return false;
+
+		// Each face is stored with all of its mip levels, before the next face
+		m_Levels.resize(m_FaceCount * m_LevelCount);
+		size_t Offset = DataOffset;
+		for (uint32_t Face = 0; Face < m_FaceCount; Face++)
+		{
+			for (uint32_t Level = 0; Level < m_LevelCount; Level++)
+			{
+				CompressedImageLevel& MipLevel = m_Levels[Face * m_LevelCount + Level];
+				MipLevel.Width = std::max(m_Width >> Level, 1u);
+				MipLevel.Height = std::max(m_Height >> Level, 1u);
+				MipLevel.Offset = Offset;
+
+				// Offset never passes the end of the data, so the remaining size can not wrap
+				const uint64_t LevelSize = BlockCompression::GetImageSize(m_Format, MipLevel.Width, MipLevel.Height);
+				if (LevelSize > m_Data.size() - Offset)
+				{
+					GX_ENGINE_ERROR("CompressedImage: {0} is truncated", FilePath);
+					return false;
+				}
+
+				MipLevel.Size = (size_t)LevelSize;
+				Offset += MipLevel.Size;
+			}
+		}
+
+		return true;
+	}
+
+	bool CompressedImage::ParseKTX2(const std::string& FilePath)
+	{
+		if (m_Data.size() < KTX2HeaderSize)
+		{
+			GX_ENGINE_ERROR("CompressedImage: {0} is truncated", FilePath);
+			return false;
+		}
+
+		const uint32_t VkFormat = ReadUInt32(m_Data, 12);
+		m_Width = ReadUInt32(m_Data, 20);
+		m_Height = ReadUInt32(m_Data, 24);
+		const uint32_t Depth = ReadUInt32(m_Data, 28);
+		const uint32_t LayerCount = ReadUInt32(m_Data, 32);
+		m_FaceCount = ReadUInt32(m_Data, 36);
+		m_LevelCount = std::max(ReadUInt32(m_Data, 40), 1u);
+		const uint32_t SupercompressionScheme = ReadUInt32(m_Data, 44);
+
+		if (!GetKTX2Format(VkFormat, m_Format))
+		{
+			GX_ENGINE_ERROR("CompressedImage: {0} is not BC1, BC3, BC4, BC5 or BC7 compressed", FilePath);
+			return false;
+		}
+
+		if (Depth > 1 || LayerCount > 1 || (m_FaceCount != 1 && m_FaceCount != 6))
+		{
+			GX_ENGINE_ERROR("CompressedImage: Only 2D textures and cube maps are supported ({0})", FilePath);
+			return false;
+		}
+
+		if (SupercompressionScheme != 0)
+		{
+			GX_ENGINE_ERROR("CompressedImage: Supercompressed KTX2 files are not supported ({0})", FilePath);
+			return false;
+		}
+
+		if (!IsValidImageSize(m_Width, m_Height, m_LevelCount, FilePath))
+			return false;
+
+		if (m_Data.size() < KTX2HeaderSize + m_LevelCount * KTX2LevelIndexEntrySize)
+		{
+			GX_ENGINE_ERROR("CompressedImage: {0} is truncated", FilePath);
+			return false;
+		}
+
+		// Each level stores all the faces, before the next level
+		m_Levels.resize(m_FaceCount * m_LevelCount);
+		for (uint32_t Level = 0; Level < m_LevelCount; Level++)
+		{
+			const size_t IndexEntry = KTX2HeaderSize + Level * KTX2LevelIndexEntrySize;
+			const uint64_t LevelOffset = ReadUInt64(m_Data, IndexEntry);
+			const uint64_t LevelSize = ReadUInt64(m_Data, IndexEntry + 8);
+
+			if (LevelOffset > m_Data.size() || LevelSize > m_Data.size() - LevelOffset)
+			{
+				GX_ENGINE_ERROR("CompressedImage: {0} is truncated", FilePath);
+				return false;
+			}
+
+			const size_t FaceSize = (size_t)(LevelSize / m_FaceCount);
+			for (uint32_t Face = 0; Face < m_FaceCount; Face++)
+			{
+				CompressedImageLevel& MipLevel = m_Levels[Face * m_LevelCount + Level];
+				MipLevel.Width = std::max(m_Width >> Level, 1u);
+				MipLevel.Height = std::max(m_Height >> Level, 1u);
+				MipLevel.Offset = (size_t)LevelOffset + Face * FaceSize;
+				MipLevel.Size = FaceSize;
+
+				if (MipLevel.Size < BlockCompression::GetImageSize(m_Format, MipLevel.Width, MipLevel.Height))
+				{
+					GX_ENGINE_ERROR("CompressedImage: Level {0} of {1} is smaller than its size", Level, FilePath);
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	bool CompressedImage::SaveDDS(const std::string& FilePath) const
+	{
+		GX_PROFILE_FUNCTION()
+
+		// BC7 has no four cc, so it needs the extended header
+		const bool IsDX10 = m_Format == BlockFormat::BC7;
+
+		std::vector<uint8_t> Header(DDSHeaderSize + (IsDX10 ? DDSHeaderDX10Size : 0), 0);
+		WriteUInt32(Header, 0, DDSMagic);
+		WriteUInt32(Header, 4 + 0, 124);
+		WriteUInt32(Header, 4 + 4, DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_LINEARSIZE | (m_LevelCount > 1 ? DDSD_MIPMAPCOUNT : 0));
+		WriteUInt32(Header, 4 + 8, m_Height);
+		WriteUInt32(Header, 4 + 12, m_Width);
+		WriteUInt32(Header, 4 + 16, (uint32_t)BlockCompression::GetImageSize(m_Format, m_Width, m_Height));
+		WriteUInt32(Header, 4 + 24, m_LevelCount);
+
+		// Pixel format
+		WriteUInt32(Header, 4 + 72, 32);
+		WriteUInt32(Header, 4 + 76, DDPF_FOURCC);
+
+		uint32_t FourCC = 0;
+		switch (m_Format)
+		{
+			case BlockFormat::BC1: FourCC = MakeFourCC('D', 'X', 'T', '1'); break;
+			case BlockFormat::BC3: FourCC = MakeFourCC('D', 'X', 'T', '5'); break;
+			case BlockFormat::BC4: FourCC = MakeFourCC('A', 'T', 'I', '1'); break;
+			case BlockFormat::BC5: FourCC = MakeFourCC('A', 'T', 'I', '2'); break;
+			case BlockFormat::BC7: FourCC = MakeFourCC('D', 'X', '1', '0'); break;
+		}
+
+		WriteUInt32(Header, 4 + 80, FourCC);
+		WriteUInt32(Header, 4 + 104, DDSCAPS_TEXTURE | (m_LevelCount > 1 ? DDSCAPS_MIPMAP | DDSCAPS_COMPLEX : 0));
+
+		if (IsDX10)
+		{
+			WriteUInt32(Header, DDSHeaderSize + 0, 98);
+			WriteUInt32(Header, DDSHeaderSize + 4, DDS_DIMENSION_TEXTURE2D);
+			WriteUInt32(Header, DDSHeaderSize + 12, 1);
+		}
+
+		std::ofstream File(FilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!File)
+		{
+			GX_ENGINE_ERROR("CompressedImage: Couldn't create {0}", FilePath);
+			return false;
+		}
+
+		File.write((const char*)Header.data(), Header.size());
+		for (uint32_t Level = 0; Level < m_LevelCount; Level++)
+			File.write((const char*)GetLevelData(0, Level), GetLevel(0, Level).Size);
+
+		return File.good();
+	}
+
+	void CompressedImage::AddLevel(uint32_t Width, uint32_t Height, const std::vector<uint8_t>& Blocks)
+	{
+		GX_ENGINE_ASSERT(m_FaceCount == 1, "Levels can only be added to the 2D images");
+		GX_ENGINE_ASSERT(Blocks.size() == BlockCompression::GetImageSize(m_Format, Width, Height), "Size of the level does not match its format");
+
+		CompressedImageLevel MipLevel;
+		MipLevel.Width = Width;
+		MipLevel.Height = Height;
+		MipLevel.Offset = m_Data.size();
+		MipLevel.Size = Blocks.size();
+
+		m_Data.insert(m_Data.end(), Blocks.begin(), Blocks.end());
+		m_Levels.push_back(MipLevel);
+		m_LevelCount++;
+	}
+}
\ No newline at end of file
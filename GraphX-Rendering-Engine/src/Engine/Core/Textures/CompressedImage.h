@@ -0,0 +1,82 @@
+#pragma once
+
+#include "BlockCompression.h"
+
+namespace GraphX
+{
+	/* A mip level of a face of the compressed image */
+	struct CompressedImageLevel
+	{
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+
+		/* Location of the blocks of the level in the image data */
+		size_t Offset = 0;
+		size_t Size = 0;
+	};
+
+	/**
+	* Block compressed image along with its mip chain (and the faces of a cube map), read from a DDS or a KTX2 file
+	* Only reads and writes the files, so it does not need a graphics context
+	*/
+	class CompressedImage
+	{
+	public:
+		/* Empty image (To be loaded from a file) */
+		CompressedImage();
+
+		/* Image to be filled level by level (Used to write the compressed textures) */
+		CompressedImage(BlockFormat Format, uint32_t Width, uint32_t Height);
+
+		/* Returns whether the file is a DDS or a KTX2 file (by its extension) */
+		static bool IsCompressedFile(const std::string& FilePath);
+
+		/**
+		* Loads a DDS or a KTX2 file
+		* @return false (with the reason logged) if the file can not be read or its format is not supported
+		*/
+		bool Load(const std::string& FilePath);
+
+		/* Writes the image to a DDS file, returns false if the file can not be written */
+		bool SaveDDS(const std::string& FilePath) const;
+
+		/* Appends the next mip level of the image (The size must be of the format) */
+		void AddLevel(uint32_t Width, uint32_t Height, const std::vector<uint8_t>& Blocks);
+
+		inline BlockFormat GetFormat() const { return m_Format; }
+
+		/* Returns the size of the first mip level */
+		inline uint32_t GetWidth() const { return m_Width; }
+		inline uint32_t GetHeight() const { return m_Height; }
+
+		/* Returns the number of faces (6 for cube maps, else 1) */
+		inline uint32_t GetFaceCount() const { return m_FaceCount; }
+
+		/* Returns the number of mip levels of each face */
+		inline uint32_t GetLevelCount() const { return m_LevelCount; }
+
+		/* Returns a mip level of a face */
+		inline const CompressedImageLevel& GetLevel(uint32_t Face, uint32_t Level) const { return m_Levels[Face * m_LevelCount + Level]; }
+
+		/* Returns the blocks of a mip level of a face */
+		inline const uint8_t* GetLevelData(uint32_t Face, uint32_t Level) const { return m_Data.data() + GetLevel(Face, Level).Offset; }
+
+	private:
+		/* Parsers for the contents of the files */
+		bool ParseDDS(const std::string& FilePath);
+		bool ParseKTX2(const std::string& FilePath);
+
+	private:
+		BlockFormat m_Format;
+
+		uint32_t m_Width, m_Height;
+
+		uint32_t m_FaceCount, m_LevelCount;
+
+		/* Mip levels of the first face, followed by the levels of the next face and so on */
+		std::vector<CompressedImageLevel> m_Levels;
+
+		/* Contents of the file (The levels point in to it) */
+		std::vector<uint8_t> m_Data;
+	};
+}
\ No newline at end of file
@@ -1,86 +1,248 @@
 #include "pch.h"
 #include "CubeMap.h"
 #include "GL/glew.h"
+#include "Device/RenderDevice.h"
+
+#include "Texture2D.h"
+#include "CompressedImage.h"
+#include "Subsystems/Multithreading/Async/AsyncTask.h"
 
 #include "stb/stb_image.h"
 
+#include <chrono>
+
 namespace GraphX
 {
+	/* Pixels of a face decoded with stb_image */
+	struct CubeMapFaceData
+	{
+		stbi_uc* Pixels = nullptr;
+
+		int Width = 0, Height = 0, Channels = 0;
+	};
+
+	/* Decodes the image of a face, can be called from any thread */
+	static CubeMapFaceData DecodeFace(const std::string& FilePath)
+	{
+		GX_PROFILE_SCOPE("CubeMap::LoadTexFile")
+
+		CubeMapFaceData Data;
+		Data.Pixels = stbi_load(FilePath.c_str(), &Data.Width, &Data.Height, &Data.Channels, 0);
+		return Data;
+	}
+
 	CubeMap::CubeMap(const std::string& FilePath, const std::vector<std::string>& FileNames)
-		: RendererAsset(), m_FilePath(FilePath), m_FileNames(FileNames)
+		: RendererAsset(), m_FilePath(FilePath), m_FileNames(FileNames), m_Width(0), m_Height(0), m_InternalFormat(0), m_DataFormat(0)
 	{
 		GX_PROFILE_FUNCTION()
 		GX_ENGINE_INFO("Loading CubeMap: {0}", FilePath);
 
-		// To flip the textures on load
-		stbi_set_flip_vertically_on_load(0);
+		CreateTexture();
 
-		glGenTextures(1, &m_RendererID);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, m_RendererID);
+		if (m_FileNames.size() == 1 && CompressedImage::IsCompressedFile(m_FileNames[0]))
+			LoadCompressedFile(m_FilePath + m_FileNames[0]);
+		else
+			LoadFaces();
+
+		UnBind();
+	}
+
+	CubeMap::CubeMap(const std::string& FilePath)
+		: RendererAsset(), m_FilePath(FilePath), m_Width(0), m_Height(0), m_InternalFormat(0), m_DataFormat(0)
+	{
+		GX_PROFILE_FUNCTION()
+		GX_ENGINE_INFO("Loading CubeMap: {0}", FilePath);
+
+		CreateTexture();
+		LoadCompressedFile(m_FilePath);
+		UnBind();
+	}
+
+	void CubeMap::CreateTexture()
+	{
+		GX_PROFILE_FUNCTION()
+
+		RenderDevice::Get().GenTextures(1, &m_RendererID);
+		RenderDevice::Get().BindTexture(GL_TEXTURE_CUBE_MAP, m_RendererID);
 
 		// Specify the parameters for texture wrapping
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+		RenderDevice::Get().TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		RenderDevice::Get().TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		RenderDevice::Get().TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 
 		// Specify the parameters for texture filtering (min - max)
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		RenderDevice::Get().TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		RenderDevice::Get().TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		RenderDevice::Get().TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, 0);
+	}
+
+	void CubeMap::LoadFaces()
+	{
+		GX_PROFILE_FUNCTION()
 
-		stbi_uc* localBuffer = nullptr;
+		// Flip is a global of stb_image, so it is set before any of the faces start decoding
+		stbi_set_flip_vertically_on_load(0);
 
-		int channels;
+		const uint32_t FaceCount = (uint32_t)m_FileNames.size();
 
-		for (unsigned int i = 0; i < m_FileNames.size(); i++)
+		// All the faces but the first are decoded on the thread pool (once it is running), the first one is decoded here meanwhile
+		std::vector<std::future<CubeMapFaceData>> PendingFaces(FaceCount);
+		if (g_GlobalThreadPool != nullptr)
 		{
+			for (uint32_t i = 1; i < FaceCount; i++)
 			{
-				GX_PROFILE_SCOPE("CubeMap::LoadTexFile")
+				const std::string FaceFilePath = m_FilePath + m_FileNames[i];
+				PendingFaces[i] = Async<CubeMapFaceData>(AsyncExecutionPolicy::ThreadPool, [FaceFilePath]() { return DecodeFace(FaceFilePath); });
+			}
+		}
 
-				localBuffer = stbi_load((m_FilePath + m_FileNames[i]).c_str(), &m_Width, &m_Height, &channels, 0);
-				GX_ENGINE_ASSERT(localBuffer, "Failed to load texture data!");
+		for (uint32_t i = 0; i < FaceCount; i++)
+		{
+			if (!PendingFaces[i].valid())
+			{
+				CubeMapFaceData Data = DecodeFace(m_FilePath + m_FileNames[i]);
+				UploadFace(i, Data);
 			}
+		}
+
+		// Faces are uploaded in the order they finish decoding (A future is no longer valid once its face is uploaded)
+		uint32_t RemainingFaces = 0;
+		for (const std::future<CubeMapFaceData>& Face : PendingFaces)
+			RemainingFaces += Face.valid() ? 1 : 0;
 
-			if (channels == 4)
+		while (RemainingFaces > 0)
+		{
+			bool UploadedAny = false;
+			for (uint32_t i = 0; i < FaceCount; i++)
 			{
-				m_InternalFormat = GL_RGBA8;
-				m_DataFormat = GL_RGBA;
+				if (PendingFaces[i].valid() && PendingFaces[i].wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+				{
+					CubeMapFaceData Data = PendingFaces[i].get();
+					UploadFace(i, Data);
+					RemainingFaces--;
+					UploadedAny = true;
+				}
 			}
-			else if (channels == 3)
+
+			// Nothing is ready yet, so wait for the next face in order instead of spinning
+			if (!UploadedAny)
 			{
-				m_InternalFormat = GL_RGB8;
-				m_DataFormat = GL_RGB;
+				for (const std::future<CubeMapFaceData>& Face : PendingFaces)
+				{
+					if (Face.valid())
+					{
+						Face.wait();
+						break;
+					}
+				}
 			}
+		}
+	}
 
-			GX_ENGINE_ASSERT(m_InternalFormat & m_DataFormat, " Texture Format not supported!");
+	void CubeMap::UploadFace(uint32_t Face, CubeMapFaceData& Data)
+	{
+		GX_PROFILE_FUNCTION()
 
-			glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, m_InternalFormat, m_Width, m_Height, 0, m_DataFormat, GL_UNSIGNED_BYTE, localBuffer);
+		if (!Data.Pixels)
+		{
+			GX_ENGINE_ERROR("CubeMap: Failed to load {0}", m_FilePath + m_FileNames[Face]);
+			GX_ENGINE_ASSERT(false, "Failed to load texture data!");
+			return;
+		}
 
-			// Free the texture data
-			stbi_image_free(localBuffer);
+		if (Data.Channels == 4)
+		{
+			m_InternalFormat = GL_RGBA8;
+			m_DataFormat = GL_RGBA;
+		}
+		else if (Data.Channels == 3)
+		{
+			m_InternalFormat = GL_RGB8;
+			m_DataFormat = GL_RGB;
 		}
 
-		UnBind();
+		GX_ENGINE_ASSERT(m_InternalFormat & m_DataFormat, " Texture Format not supported!");
+
+		m_Width = Data.Width;
+		m_Height = Data.Height;
+
+		RenderDevice::Get().TexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + Face, 0, m_InternalFormat, m_Width, m_Height, 0, m_DataFormat, GL_UNSIGNED_BYTE, Data.Pixels);
+
+		// Free the texture data
+		stbi_image_free(Data.Pixels);
+		Data.Pixels = nullptr;
+	}
+
+	bool CubeMap::LoadCompressedFile(const std::string& FilePath)
+	{
+		GX_PROFILE_FUNCTION()
+
+		CompressedImage Image;
+		if (!Image.Load(FilePath))
+			return false;
+
+		if (Image.GetFaceCount() != 6)
+		{
+			GX_ENGINE_ERROR("CubeMap: {0} is not a cube map", FilePath);
+			return false;
+		}
+
+		if (Image.GetWidth() > Texture2D::GetMaxSize() || Image.GetHeight() > Texture2D::GetMaxSize())
+		{
+			GX_ENGINE_ERROR("CubeMap: {0} is larger than the maximum texture size of the device ({1})", FilePath, Texture2D::GetMaxSize());
+			return false;
+		}
+
+		if (!Texture2D::IsBlockFormatSupported(Image.GetFormat()))
+		{
+			GX_ENGINE_ERROR("CubeMap: {0} is not supported by the device ({1})", BlockCompression::GetFormatName(Image.GetFormat()), FilePath);
+			return false;
+		}
+
+		m_InternalFormat = Texture2D::GetCompressedInternalFormat(Image.GetFormat());
+		m_DataFormat = 0;
+		m_Width = (int)Image.GetWidth();
+		m_Height = (int)Image.GetHeight();
+
+		// Faces are stored in the order of the cube map targets (+X, -X, +Y, -Y, +Z, -Z), each followed by its mip chain
+		for (uint32_t Face = 0; Face < 6; Face++)
+		{
+			for (uint32_t Level = 0; Level < Image.GetLevelCount(); Level++)
+			{
+				const CompressedImageLevel& ImageLevel = Image.GetLevel(Face, Level);
+				RenderDevice::Get().CompressedTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + Face, (int32_t)Level, m_InternalFormat, ImageLevel.Width, ImageLevel.Height, 0, (int32_t)ImageLevel.Size, Image.GetLevelData(Face, Level));
+			}
+		}
+
+		// Mips of a prefiltered cube map are sampled as they are in the file
+		if (Image.GetLevelCount() > 1)
+		{
+			RenderDevice::Get().TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+			RenderDevice::Get().TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, (int32_t)Image.GetLevelCount() - 1);
+		}
+
+		return true;
 	}
 
 	void CubeMap::Bind(unsigned int slot) const
 	{
 		GX_PROFILE_FUNCTION()
 
-		glActiveTexture(GL_TEXTURE0 + slot);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, m_RendererID);
+		RenderDevice::Get().ActiveTexture(GL_TEXTURE0 + slot);
+		RenderDevice::Get().BindTexture(GL_TEXTURE_CUBE_MAP, m_RendererID);
 	}
 
 	void CubeMap::UnBind() const
 	{
 		GX_PROFILE_FUNCTION()
 
-		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+		RenderDevice::Get().BindTexture(GL_TEXTURE_CUBE_MAP, 0);
 	}
 
 	CubeMap::~CubeMap()
 	{
 		GX_PROFILE_FUNCTION()
 
-		glDeleteTextures(1, &m_RendererID);
+		RenderDevice::Get().DeleteTextures(1, &m_RendererID);
 	}
 }
\ No newline at end of file
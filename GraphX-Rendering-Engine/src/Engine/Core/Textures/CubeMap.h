@@ -12,9 +12,13 @@ namespace GraphX
 		*	Creates a cubemap
 		* @param FilePath Path to the folder containing the textures to be used to draw the cubemap
 		* @param FileNames names of the files to be used as textures for the six faces of the cubemap. Order of the names should be right, left, top, bottom, front, back faces
+		*	A single DDS / KTX2 cube map file can be given in place of the six faces (Its faces and mips are uploaded as is)
 		*/
 		CubeMap(const std::string& FilePath, const std::vector<std::string>& FileNames);
 
+		/* Creates a cubemap from a block compressed DDS / KTX2 cube map file (Prefiltered, so nothing is decoded on load) */
+		CubeMap(const std::string& FilePath);
+
 		/* Bind the cubemap to specified slot */
 		void Bind(unsigned int slot = 0) const;
 
@@ -29,6 +33,19 @@ namespace GraphX
 
 		~CubeMap();
 
+	private:
+		/* Creates the texture and sets its wrapping and filtering */
+		void CreateTexture();
+
+		/* Decodes the six faces on the thread pool and uploads each face as soon as it is decoded */
+		void LoadFaces();
+
+		/* Uploads all the faces and mips of a DDS / KTX2 cube map file */
+		bool LoadCompressedFile(const std::string& FilePath);
+
+		/* Uploads a decoded face (and frees its pixels) */
+		void UploadFace(uint32_t Face, struct CubeMapFaceData& Data);
+
 	private:
 		/* Path to the cubemap texture */
 		std::string m_FilePath;
@@ -42,7 +59,7 @@ namespace GraphX
 		// Internal format of opengl texture
 		uint32_t m_InternalFormat;
 
-		// Format of the data in the texture file
+		// Format of the data in the texture file (0 for the block compressed cube maps)
 		uint32_t m_DataFormat;
 	};
 }
\ No newline at end of file
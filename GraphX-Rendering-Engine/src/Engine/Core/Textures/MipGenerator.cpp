@@ -0,0 +1,162 @@
+#include "pch.h"
+#include "MipGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace GraphX
+{
+	/* Radius of the Kaiser filter (in the pixels of the smaller level) and the shape of its window */
+	static constexpr float KaiserRadius = 3.0f;
+	static constexpr float KaiserAlpha = 4.0f;
+
+	/* A source pixel and its weight in a destination pixel (along an axis) */
+	struct FilterTap
+	{
+		uint32_t Index;
+		float Weight;
+	};
+
+	/* Zeroth order modified bessel function of the first kind (Series expansion) */
+	static float BesselI0(float x)
+	{
+		const float QuarterXSquared = 0.25f * x * x;
+
+		float Sum = 1.0f, Term = 1.0f;
+		for (int k = 1; k < 32 && Term > 1e-7f * Sum; k++)
+		{
+			Term *= QuarterXSquared / (float)(k * k);
+			Sum += Term;
+		}
+
+		return Sum;
+	}
+
+	/* Kaiser windowed sinc at a distance (in the pixels of the smaller level) from the center of the pixel */
+	static float KaiserWeight(float x)
+	{
+		const float t = x / KaiserRadius;
+		if (t * t >= 1.0f)
+			return 0.0f;
+
+		const float Sinc = std::abs(x) < 1e-5f ? 1.0f : std::sin(GM::PI * x) / (GM::PI * x);
+		return Sinc * BesselI0(KaiserAlpha * std::sqrt(1.0f - t * t)) / BesselI0(KaiserAlpha);
+	}
+
+	/* Computes the normalized taps of every destination pixel along an axis */
+	static std::vector<std::vector<FilterTap>> ComputeTaps(uint32_t SrcSize, uint32_t DstSize, MipFilter Filter, bool Wrap)
+	{
+		std::vector<std::vector<FilterTap>> Taps(DstSize);
+
+		const float Scale = (float)SrcSize / (float)DstSize;
+		const float Support = Filter == MipFilter::Box ? 0.5f * Scale : KaiserRadius * Scale;
+
+		for (uint32_t i = 0; i < DstSize; i++)
+		{
+			const float Center = (i + 0.5f) * Scale;
+			const int First = (int)std::floor(Center - Support);
+			const int Last = (int)std::ceil(Center + Support);
+
+			float Total = 0.0f;
+			for (int s = First; s < Last; s++)
+			{
+				// Box filter weighs the pixels by how much of them is covered, Kaiser by the distance of their centers
+				const float Weight = Filter == MipFilter::Box ?
+					std::max(0.0f, std::min(s + 1.0f, Center + Support) - std::max((float)s, Center - Support)) :
+					KaiserWeight((s + 0.5f - Center) / Scale);
+
+				if (Weight == 0.0f)
+					continue;
+
+				const int Size = (int)SrcSize;
+				const uint32_t Index = Wrap ? (uint32_t)(((s % Size) + Size) % Size) : (uint32_t)std::min(std::max(s, 0), Size - 1);
+
+				Taps[i].push_back({ Index, Weight });
+				Total += Weight;
+			}
+
+			for (FilterTap& Tap : Taps[i])
+				Tap.Weight /= Total;
+		}
+
+		return Taps;
+	}
+
+	uint32_t MipGenerator::GetLevelCount(uint32_t Width, uint32_t Height)
+	{
+		uint32_t Levels = 1;
+		for (uint32_t Size = std::max(Width, Height); Size > 1; Size /= 2)
+			Levels++;
+
+		return Levels;
+	}
+
+	std::vector<MipLevel> MipGenerator::Generate(const uint8_t* Pixels, uint32_t Width, uint32_t Height, uint32_t Channels, MipFilter Filter, bool Wrap)
+	{
+		GX_PROFILE_FUNCTION()
+
+		std::vector<MipLevel> Levels;
+		Levels.reserve(GetLevelCount(Width, Height) - 1);
+
+		// Each level is downsampled from the one above it (kept in floats, so the rounding does not build up down the chain)
+		std::vector<float> Source(Pixels, Pixels + (size_t)Width * Height * Channels);
+		uint32_t SrcWidth = Width, SrcHeight = Height;
+
+		while (SrcWidth > 1 || SrcHeight > 1)
+		{
+			const uint32_t DstWidth = std::max(SrcWidth / 2, 1u);
+			const uint32_t DstHeight = std::max(SrcHeight / 2, 1u);
+
+			const std::vector<std::vector<FilterTap>> ColumnTaps = ComputeTaps(SrcWidth, DstWidth, Filter, Wrap);
+			const std::vector<std::vector<FilterTap>> RowTaps = ComputeTaps(SrcHeight, DstHeight, Filter, Wrap);
+
+			// Filter is separable, so the rows are downsampled first and then the columns
+			std::vector<float> Horizontal((size_t)DstWidth * SrcHeight * Channels, 0.0f);
+			for (uint32_t y = 0; y < SrcHeight; y++)
+			{
+				const float* SrcRow = &Source[(size_t)y * SrcWidth * Channels];
+				float* DstRow = &Horizontal[(size_t)y * DstWidth * Channels];
+
+				for (uint32_t x = 0; x < DstWidth; x++)
+				{
+					for (const FilterTap& Tap : ColumnTaps[x])
+					{
+						for (uint32_t c = 0; c < Channels; c++)
+							DstRow[x * Channels + c] += Tap.Weight * SrcRow[Tap.Index * Channels + c];
+					}
+				}
+			}
+
+			const size_t RowSize = (size_t)DstWidth * Channels;
+			std::vector<float> Destination(RowSize * DstHeight, 0.0f);
+			for (uint32_t y = 0; y < DstHeight; y++)
+			{
+				float* DstRow = &Destination[y * RowSize];
+
+				for (const FilterTap& Tap : RowTaps[y])
+				{
+					const float* SrcRow = &Horizontal[Tap.Index * RowSize];
+					for (size_t i = 0; i < RowSize; i++)
+						DstRow[i] += Tap.Weight * SrcRow[i];
+				}
+			}
+
+			MipLevel Level;
+			Level.Width = DstWidth;
+			Level.Height = DstHeight;
+			Level.Pixels.resize(Destination.size());
+
+			// Negative lobes of the Kaiser filter can overshoot the range
+			for (size_t i = 0; i < Destination.size(); i++)
+				Level.Pixels[i] = (uint8_t)std::min(std::max(Destination[i] + 0.5f, 0.0f), 255.0f);
+
+			Levels.push_back(std::move(Level));
+
+			Source.swap(Destination);
+			SrcWidth = DstWidth;
+			SrcHeight = DstHeight;
+		}
+
+		return Levels;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+namespace GraphX
+{
+	/* Filter used to downsample the mip levels */
+	enum class MipFilter
+	{
+		/* Average of the pixels covered by the smaller pixel (Same as what the drivers use for glGenerateMipmap) */
+		Box = 0,
+
+		/* Kaiser windowed sinc (Keeps the distant textures sharper than the box filter, at the cost of slight ringing) */
+		Kaiser
+	};
+
+	/* A level of the mip chain (Tightly packed, 8 bits per channel) */
+	struct MipLevel
+	{
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		std::vector<uint8_t> Pixels;
+	};
+
+	/**
+	* Builds the mip chain of a texture on the CPU, so it can be done on the loading thread (with a choice of the filter)
+	* Works only with the pixels, so it does not need a graphics context
+	*/
+	class MipGenerator
+	{
+	public:
+		/* Returns the number of levels in the full mip chain of a texture (down to 1x1, including the full resolution level) */
+		static uint32_t GetLevelCount(uint32_t Width, uint32_t Height);
+
+		/**
+		* Downsamples the image to all the levels below it (The full resolution level is not included)
+		* @param Wrap Whether the filter wraps around the edges (for the tiled textures) or clamps to them
+		*/
+		static std::vector<MipLevel> Generate(const uint8_t* Pixels, uint32_t Width, uint32_t Height, uint32_t Channels, MipFilter Filter, bool Wrap);
+	};
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "SpriteSheet.h"
 
 #include "SubTexture2D.h"
+#include "Engine/Core/Renderer/Renderer2D.h"
 
 namespace GraphX
 {
@@ -23,12 +24,31 @@ namespace GraphX
 			CellIndex.y = i / m_NumSpritesInRow;
 			m_Sprites.emplace_back(SubTexture2D::Create(BaseTexture, CellIndex, InSpriteSize, GM::IntVector2::UnitVector, false));
 		}
+
+		// Sprites in the atlas cover the same part of the sheet, as they do of this texture
+		Ref<SubTexture2D> AtlasImage = Renderer2D::PackInSpriteAtlas(*this);
+		if (AtlasImage)
+		{
+			m_AtlasSprites.reserve(m_NumSprites);
+			for (const Ref<SubTexture2D>& Sprite : m_Sprites)
+			{
+				const GM::Vector2* TexCoords = Sprite->GetTexCoords();
+				m_AtlasSprites.emplace_back(Renderer2D::GetSpriteAtlasRegion(AtlasImage, TexCoords[0], TexCoords[2]));
+			}
+		}
 	}
 
 	Ref<SubTexture2D> SpriteSheet::GetSprite(const uint32_t InSpriteIndex) const
 	{
 		GX_ENGINE_ASSERT(InSpriteIndex < m_Sprites.size(), "Invalid Sprite index!")
 
+		return m_AtlasSprites.empty() ? m_Sprites[InSpriteIndex] : m_AtlasSprites[InSpriteIndex];
+	}
+
+	Ref<SubTexture2D> SpriteSheet::GetSheetSprite(const uint32_t InSpriteIndex) const
+	{
+		GX_ENGINE_ASSERT(InSpriteIndex < m_Sprites.size(), "Invalid Sprite index!")
+
 		return m_Sprites[InSpriteIndex];
 	}
 }
\ No newline at end of file
@@ -9,6 +9,7 @@ namespace GraphX
 	* 
 	* This Sprite sheet class is supposed to be used for representing multiple sub textures of same size in a tight arrangement
 	* (starting from top right) in the parent texture
+	* Small sprite sheets are also packed in to the sprite atlas of the 2D renderer, so their sprites are batched along with the other atlased sprites
 	*/
 	class SpriteSheet
 		: public Texture2D
@@ -27,9 +28,15 @@ namespace GraphX
 		// # of rows containing sprites can be less than total rows
 		inline uint32_t GetNumSpriteRows() const { return m_NumSprites / m_NumSpritesInRow; }
 
-		/* Returns a sprite specified by the SpriteIndex */
+		/* Returns a sprite specified by the SpriteIndex (Part of the sprite atlas when the sheet is packed in to it) */
 		Ref<class SubTexture2D> GetSprite(const uint32_t InSpriteIndex) const;
 
+		/* Returns a sprite specified by the SpriteIndex as a part of this texture (For drawing with the sprite sheet itself bound) */
+		Ref<class SubTexture2D> GetSheetSprite(const uint32_t InSpriteIndex) const;
+
+		/* Returns whether the sprites are packed in to the sprite atlas */
+		inline bool IsInSpriteAtlas() const { return !m_AtlasSprites.empty(); }
+
 		// Overrides
 		virtual uint32_t GetRowsInAtlas() const override { return m_Rows; }
 		virtual bool IsSpriteSheet() const override { return true; }
@@ -49,5 +56,8 @@ namespace GraphX
 
 		/* All the sub textures in the sprite sheet */
 		std::vector<Ref<class SubTexture2D>> m_Sprites;
+
+		/* Sub textures of the sprites in the sprite atlas (Empty if the sheet is not packed) */
+		std::vector<Ref<class SubTexture2D>> m_AtlasSprites;
 	};
 }
\ No newline at end of file
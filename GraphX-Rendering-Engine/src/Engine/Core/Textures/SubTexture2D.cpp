@@ -6,8 +6,14 @@
 namespace GraphX
 {
 	SubTexture2D::SubTexture2D(const Ref<Texture2D>& InTexture, const GM::Vector2& Min, const GM::Vector2& Max)
-		: m_Texture(InTexture)
 	{
+		Set(InTexture, Min, Max);
+	}
+
+	void SubTexture2D::Set(const Ref<Texture2D>& InTexture, const GM::Vector2& Min, const GM::Vector2& Max)
+	{
+		m_Texture = InTexture;
+
 		m_TexCoords[0].x = Min.x; m_TexCoords[0].y = Min.y;
 		m_TexCoords[1].x = Max.x; m_TexCoords[1].y = Min.y;
 		m_TexCoords[2].x = Max.x; m_TexCoords[2].y = Max.y;
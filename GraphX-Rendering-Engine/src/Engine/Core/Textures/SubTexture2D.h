@@ -6,6 +6,9 @@ namespace GraphX
 
 	class SubTexture2D
 	{
+		/* Atlas updates its subtextures when it is repacked */
+		friend class TextureAtlas;
+
 	public:
 		/*
 		* Creates subtexture which is a part of a bigger texture (sprite sheets)
@@ -31,6 +34,10 @@ namespace GraphX
 		/* Returns the texture coords that represent this subtexture within the given texture */
 		const GM::Vector2* GetTexCoords() const { return m_TexCoords; }
 
+	private:
+		/* Updates the texture and the region of the texture used by this subtexture */
+		void Set(const Ref<Texture2D>& InTexture, const GM::Vector2& Min, const GM::Vector2& Max);
+
 	private:
 		/* Texture of which this is a part of */
 		Ref<Texture2D> m_Texture;
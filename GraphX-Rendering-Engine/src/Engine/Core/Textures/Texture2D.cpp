@@ -1,143 +1,489 @@
 #include "pch.h"
 #include "Texture2D.h"
 #include "GL/glew.h"
+#include "Device/RenderDevice.h"
 
+#include "MipGenerator.h"
+#include "CompressedImage.h"
+#include "TextureStreamer.h"
+#include "Texture2DArrayPool.h"
 #include "stb/stb_image.h"
 #include "Utilities/EngineUtil.h"
+#include "Utilities/EngineProperties.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iterator>
 
 namespace GraphX
 {
-	Texture2D::Texture2D(const std::string& filePath, bool InTileTexture)
-		: RendererAsset(), m_FilePath(filePath), m_Width(0), m_Height(0), m_InternalFormat(0), m_DataFormat(0), m_TileTexture(InTileTexture)
+	// Textures can be created from the worker threads (e.g. while importing meshes)
+	static std::atomic<uint32_t> s_TextureHandleCounter(0);
+
+	static TextureSamplingSettings s_SamplingSettings;
+
+	/* Returns the maximum anisotropy supported by the device (1 if the anisotropic filtering is not supported) */
+	static float GetMaxSupportedAnisotropy()
+	{
+		static const float MaxAnisotropy = []() {
+			float Value = 1.0f;
+			if (RenderDevice::GetType() == RenderDeviceType::Null || GLEW_ARB_texture_filter_anisotropic || GLEW_EXT_texture_filter_anisotropic)
+				RenderDevice::Get().GetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &Value);
+
+			return std::max(Value, 1.0f);
+		}();
+
+		return MaxAnisotropy;
+	}
+
+	bool Texture2D::IsBlockFormatSupported(BlockFormat Format)
+	{
+		if (RenderDevice::GetType() == RenderDeviceType::Null)
+			return true;
+
+		switch (Format)
+		{
+			case BlockFormat::BC1:
+			case BlockFormat::BC3:
+				return GLEW_EXT_texture_compression_s3tc != 0;
+
+			// Core since OpenGL 3.0
+			case BlockFormat::BC4:
+			case BlockFormat::BC5:
+				return true;
+
+			case BlockFormat::BC7:
+				return GLEW_VERSION_4_2 || GLEW_ARB_texture_compression_bptc;
+		}
+
+		return false;
+	}
+
+	uint32_t Texture2D::GetCompressedInternalFormat(BlockFormat Format)
+	{
+		switch (Format)
+		{
+			// BC1 with alpha decodes the opaque blocks the same way, so it works for both the variants
+			case BlockFormat::BC1: return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+			case BlockFormat::BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+			case BlockFormat::BC4: return GL_COMPRESSED_RED_RGTC1;
+			case BlockFormat::BC5: return GL_COMPRESSED_RG_RGTC2;
+			case BlockFormat::BC7: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+		}
+
+		return 0;
+	}
+
+	uint32_t Texture2D::GetMaxSize()
+	{
+		static std::atomic<uint32_t> MaxSize(0);
+		if (MaxSize == 0)
+		{
+			GX_ENGINE_ASSERT(RenderDevice::IsRenderThread(), "Maximum texture size has to be queried on the render thread first");
+
+			int32_t Value = 0;
+			RenderDevice::Get().GetIntegerv(GL_MAX_TEXTURE_SIZE, &Value);
+			MaxSize = (uint32_t)std::max(Value, 1);
+		}
+
+		return MaxSize;
+	}
+
+	/* Logs an error if the image is larger than the device can create */
+	static bool IsWithinMaxSize(const std::string& FilePath, uint32_t Width, uint32_t Height)
+	{
+		const uint32_t MaxSize = Texture2D::GetMaxSize();
+		if (Width > MaxSize || Height > MaxSize)
+		{
+			GX_ENGINE_ERROR("Texture2D: {0} is {1}x{2}, larger than the maximum texture size of the device ({3})", FilePath, Width, Height, MaxSize);
+			return false;
+		}
+
+		return true;
+	}
+
+	/* Returns the precompressed version of an image written by the texture compressor (next to the image), or an empty string if there is none */
+	static std::string FindCompressedFile(const std::string& ImageFilePath)
+	{
+		const size_t ExtensionStart = ImageFilePath.find_last_of('.');
+		const std::string BasePath = ImageFilePath.substr(0, ExtensionStart);
+
+		for (const char* Extension : { ".dds", ".ktx2" })
+		{
+			if (std::ifstream(BasePath + Extension).good())
+				return BasePath + Extension;
+		}
+
+		return std::string();
+	}
+
+	/* Decodes an image file with stb_image and builds its mip chain */
+	static bool DecodeImageFile(const std::string& FilePath, bool TileTexture, const TextureSamplingSettings& Sampling, TextureFileData& OutData)
 	{
 		GX_PROFILE_FUNCTION()
-		GX_ENGINE_INFO("Loading Texture2D: {0}", filePath);
 
 		// To flip the texture
 		stbi_set_flip_vertically_on_load(0);
 
 		int width, height, channels;
+		if (stbi_info(FilePath.c_str(), &width, &height, &channels) && !IsWithinMaxSize(FilePath, width, height))
+			return false;
+
 		stbi_uc* localBuffer = nullptr;
 		{
 			GX_PROFILE_SCOPE("Texture2D::LoadTexFile")
 
-			localBuffer = stbi_load(m_FilePath.c_str(), &width, &height, &channels, 0);	// No desired channels 
-			GX_ENGINE_ASSERT(localBuffer, "Failed to load texture data!");
+			localBuffer = stbi_load(FilePath.c_str(), &width, &height, &channels, 0);	// No desired channels 
+		}
+
+		if (!localBuffer)
+		{
+			GX_ENGINE_ERROR("Texture2D: Failed to load texture data from {0}", FilePath);
+			return false;
 		}
 
 		if (channels == 4)
 		{
-			m_InternalFormat = GL_RGBA8;
-			m_DataFormat = GL_RGBA;
+			OutData.InternalFormat = GL_RGBA8;
+			OutData.DataFormat = GL_RGBA;
 		}
 		else if (channels == 3)
 		{
-			m_InternalFormat = GL_RGB8;
-			m_DataFormat = GL_RGB;
+			OutData.InternalFormat = GL_RGB8;
+			OutData.DataFormat = GL_RGB;
+		}
+		else
+		{
+			GX_ENGINE_ERROR("Texture2D: Texture format of {0} is not supported ({1} channels)", FilePath, channels);
+			stbi_image_free(localBuffer);
+			return false;
+		}
+
+		OutData.IsCompressed = false;
+		OutData.GenerateMips = Sampling.Mipmaps == MipmapMode::GPU;
+
+		MipLevel BaseLevel;
+		BaseLevel.Width = width;
+		BaseLevel.Height = height;
+		BaseLevel.Pixels.assign(localBuffer, localBuffer + (size_t)width * height * channels);
+		OutData.Levels.push_back(std::move(BaseLevel));
+
+		// Mip chain is precomputed with the chosen filter, unless it is left to the driver
+		if (Sampling.Mipmaps == MipmapMode::CPUBox || Sampling.Mipmaps == MipmapMode::CPUKaiser)
+		{
+			GX_PROFILE_SCOPE("Texture2D::GenerateMipChain")
+
+			const MipFilter Filter = Sampling.Mipmaps == MipmapMode::CPUKaiser ? MipFilter::Kaiser : MipFilter::Box;
+			std::vector<MipLevel> MipChain = MipGenerator::Generate(localBuffer, width, height, channels, Filter, TileTexture);
+			std::move(MipChain.begin(), MipChain.end(), std::back_inserter(OutData.Levels));
+		}
+
+		// Free the local image data
+		stbi_image_free(localBuffer);
+		return true;
+	}
+
+	/* Reads the blocks of a DDS / KTX2 file along with its mip chain */
+	static bool DecodeCompressedFile(const std::string& FilePath, const TextureSamplingSettings& Sampling, TextureFileData& OutData)
+	{
+		GX_PROFILE_FUNCTION()
+
+		CompressedImage Image;
+		if (!Image.Load(FilePath))
+			return false;
+
+		if (Image.GetFaceCount() != 1)
+		{
+			GX_ENGINE_ERROR("Texture2D: {0} is a cube map", FilePath);
+			return false;
 		}
 
-		m_Width = width;
-		m_Height = height;
+		if (!IsWithinMaxSize(FilePath, Image.GetWidth(), Image.GetHeight()))
+			return false;
 
-		GX_ENGINE_ASSERT(m_InternalFormat & m_DataFormat, " Texture Format not supported!");
+		if (!Texture2D::IsBlockFormatSupported(Image.GetFormat()))
+		{
+			GX_ENGINE_ERROR("Texture2D: {0} is not supported by the device ({1})", BlockCompression::GetFormatName(Image.GetFormat()), FilePath);
+			return false;
+		}
+
+		OutData.InternalFormat = Texture2D::GetCompressedInternalFormat(Image.GetFormat());
+		OutData.DataFormat = 0;
+		OutData.IsCompressed = true;
 
-		glGenTextures(1, &m_RendererID);
-		glBindTexture(GL_TEXTURE_2D, m_RendererID);
+		// Compressed formats can not be rendered to, so the driver can not generate the mips (The chain in the file is used as is)
+		OutData.GenerateMips = false;
+		if (Sampling.Mipmaps != MipmapMode::None && Image.GetLevelCount() == 1)
+			GX_ENGINE_WARN("Texture2D: {0} has no mip chain", FilePath);
+
+		const uint32_t LevelCount = Sampling.Mipmaps == MipmapMode::None ? 1 : Image.GetLevelCount();
+		for (uint32_t Level = 0; Level < LevelCount; Level++)
+		{
+			const CompressedImageLevel& ImageLevel = Image.GetLevel(0, Level);
+
+			MipLevel CompressedLevel;
+			CompressedLevel.Width = ImageLevel.Width;
+			CompressedLevel.Height = ImageLevel.Height;
+			CompressedLevel.Pixels.assign(Image.GetLevelData(0, Level), Image.GetLevelData(0, Level) + ImageLevel.Size);
+			OutData.Levels.push_back(std::move(CompressedLevel));
+		}
+
+		return true;
+	}
+
+	Texture2D::Texture2D(const std::string& filePath, bool InTileTexture, TextureLoadMode LoadMode)
+		: RendererAsset(), m_Handle(GenerateHandle()), m_FilePath(filePath), m_Width(0), m_Height(0), m_InternalFormat(0), m_DataFormat(0), m_MipLevels(1), m_IsCompressed(false), m_IsResident(false), m_TileTexture(InTileTexture)
+	{
+		GX_PROFILE_FUNCTION()
+		GX_ENGINE_INFO("Loading Texture2D: {0}", filePath);
+
+		// Textures created off the render thread (e.g. while importing meshes) can not create their texture object, so they are always streamed
+		const bool IsRenderThread = RenderDevice::IsRenderThread();
+		GX_ENGINE_ASSERT(IsRenderThread || TextureStreamer::IsRunning(), "Textures can only be created off the render thread once the renderer is initialised");
+
+		// Decoded on the thread pool (Streamer is not running before the renderer is initialised)
+		if ((LoadMode == TextureLoadMode::Streamed || !IsRenderThread) && TextureStreamer::IsRunning())
+		{
+			// Placeholder is created by the streamer on the render thread otherwise
+			if (IsRenderThread)
+				CreatePlaceholder();
+
+			TextureStreamer::Request(*this);
+			return;
+		}
+
+		// Copy, since the settings can be changed while the texture is loading
+		const TextureSamplingSettings Sampling = s_SamplingSettings;
+
+		TextureFileData Data;
+		if (DecodeFile(m_FilePath, m_TileTexture, Sampling, Data))
+			Upload(Data, Sampling.MaxAnisotropy);
+		else
+			CreatePlaceholder();
+	}
+
+	bool Texture2D::DecodeFile(const std::string& FilePath, bool TileTexture, const TextureSamplingSettings& Sampling, TextureFileData& OutData)
+	{
+		GX_PROFILE_FUNCTION()
+
+		if (CompressedImage::IsCompressedFile(FilePath))
+			return DecodeCompressedFile(FilePath, Sampling, OutData);
+
+		// Blocks stay compressed in the video memory, so the precompressed version of the image is preferred
+		const std::string CompressedFilePath = GX_ENABLE_COMPRESSED_TEXTURES ? FindCompressedFile(FilePath) : std::string();
+		if (!CompressedFilePath.empty())
+		{
+			if (DecodeCompressedFile(CompressedFilePath, Sampling, OutData))
+				return true;
+
+			OutData = TextureFileData();
+		}
+
+		return DecodeImageFile(FilePath, TileTexture, Sampling, OutData);
+	}
+
+	void Texture2D::Upload(const TextureFileData& Data, float MaxAnisotropy)
+	{
+		GX_PROFILE_FUNCTION()
+
+		m_Width = Data.Levels[0].Width;
+		m_Height = Data.Levels[0].Height;
+		m_InternalFormat = Data.InternalFormat;
+		m_DataFormat = Data.DataFormat;
+		m_IsCompressed = Data.IsCompressed;
+		m_MipLevels = Data.GenerateMips ? MipGenerator::GetLevelCount(m_Width, m_Height) : (uint32_t)Data.Levels.size();
+
+		RenderDevice::Get().GenTextures(1, &m_RendererID);
+		RenderDevice::Get().BindTexture(GL_TEXTURE_2D, m_RendererID);
 
 		// Specify the parameters for texture wrapping
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_TileTexture ? GL_REPEAT : GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_TileTexture ? GL_REPEAT : GL_CLAMP_TO_EDGE);
+		RenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_TileTexture ? GL_REPEAT : GL_CLAMP_TO_EDGE);
+		RenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_TileTexture ? GL_REPEAT : GL_CLAMP_TO_EDGE);
 
-		// Specify the parameters for texture filtering (min - max)
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		SetFiltering(MaxAnisotropy);
 
-		glTexImage2D(GL_TEXTURE_2D, 0, m_InternalFormat, m_Width, m_Height, 0, m_DataFormat, GL_UNSIGNED_BYTE, localBuffer);
-		glBindTexture(GL_TEXTURE_2D, 0);
+		// Rows of the RGB textures (and of the smaller mip levels) are not aligned to 4 bytes
+		RenderDevice::Get().PixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
-		// Free the local image data
-		if (localBuffer)
-			stbi_image_free(localBuffer);
+		for (size_t i = 0; i < Data.Levels.size(); i++)
+		{
+			const MipLevel& Level = Data.Levels[i];
+			if (m_IsCompressed)
+				RenderDevice::Get().CompressedTexImage2D(GL_TEXTURE_2D, (int32_t)i, m_InternalFormat, Level.Width, Level.Height, 0, (int32_t)Level.Pixels.size(), Level.Pixels.data());
+			else
+				RenderDevice::Get().TexImage2D(GL_TEXTURE_2D, (int32_t)i, m_InternalFormat, Level.Width, Level.Height, 0, m_DataFormat, GL_UNSIGNED_BYTE, Level.Pixels.data());
+		}
+
+		if (Data.GenerateMips)
+			RenderDevice::Get().GenerateMipmap(GL_TEXTURE_2D);
+
+		RenderDevice::Get().PixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		RenderDevice::Get().BindTexture(GL_TEXTURE_2D, 0);
+
+		m_IsResident = true;
+	}
+
+	void Texture2D::CreatePlaceholder()
+	{
+		GX_PROFILE_FUNCTION()
+
+		// Mid grey, so that the lighting of the surface still reads while the texture is missing
+		const uint8_t PlaceholderPixel[4] = { 128, 128, 128, 255 };
+
+		m_Width = m_Height = 1;
+		m_InternalFormat = GL_RGBA8;
+		m_DataFormat = GL_RGBA;
+		m_MipLevels = 1;
+
+		RenderDevice::Get().GenTextures(1, &m_RendererID);
+		RenderDevice::Get().BindTexture(GL_TEXTURE_2D, m_RendererID);
+
+		RenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_TileTexture ? GL_REPEAT : GL_CLAMP_TO_EDGE);
+		RenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_TileTexture ? GL_REPEAT : GL_CLAMP_TO_EDGE);
+		RenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		RenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		RenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+
+		RenderDevice::Get().TexImage2D(GL_TEXTURE_2D, 0, m_InternalFormat, 1, 1, 0, m_DataFormat, GL_UNSIGNED_BYTE, PlaceholderPixel);
+		RenderDevice::Get().BindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	void Texture2D::UploadStreamedLevel(const TextureFileData& Data, uint32_t Level, const void* Pixels, float MaxAnisotropy)
+	{
+		GX_PROFILE_FUNCTION()
+
+		RenderDevice::Get().BindTexture(GL_TEXTURE_2D, m_RendererID);
+
+		// Smallest level is the first one uploaded, it replaces the placeholder
+		if (Level + 1 == Data.Levels.size())
+		{
+			m_Width = Data.Levels[0].Width;
+			m_Height = Data.Levels[0].Height;
+			m_InternalFormat = Data.InternalFormat;
+			m_DataFormat = Data.DataFormat;
+			m_IsCompressed = Data.IsCompressed;
+			m_MipLevels = (uint32_t)Data.Levels.size();
+
+			SetFiltering(MaxAnisotropy);
+		}
+
+		const MipLevel& MipLevel = Data.Levels[Level];
+		if (m_IsCompressed)
+		{
+			RenderDevice::Get().CompressedTexImage2D(GL_TEXTURE_2D, Level, m_InternalFormat, MipLevel.Width, MipLevel.Height, 0, (int32_t)MipLevel.Pixels.size(), Pixels);
+		}
+		else
+		{
+			RenderDevice::Get().PixelStorei(GL_UNPACK_ALIGNMENT, 1);
+			RenderDevice::Get().TexImage2D(GL_TEXTURE_2D, Level, m_InternalFormat, MipLevel.Width, MipLevel.Height, 0, m_DataFormat, GL_UNSIGNED_BYTE, Pixels);
+			RenderDevice::Get().PixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		}
+
+		// Only the levels uploaded so far are sampled (The placeholder at level 0 is ignored until it is replaced)
+		RenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, Level);
+		RenderDevice::Get().BindTexture(GL_TEXTURE_2D, 0);
+
+		m_IsResident = Level == 0;
 	}
 
 	Texture2D::Texture2D(uint32_t width, uint32_t height, FramebufferAttachmentType texType)
-		: RendererAsset(), m_FilePath(std::string()), m_Width(width), m_Height(height), m_InternalFormat(0), m_DataFormat(0), m_TileTexture(false)
+		: RendererAsset(), m_Handle(GenerateHandle()), m_FilePath(std::string()), m_Width(width), m_Height(height), m_InternalFormat(0), m_DataFormat(0), m_MipLevels(1), m_IsCompressed(false), m_IsResident(true), m_TileTexture(false)
 	{
 		GX_PROFILE_FUNCTION()
 
-		glGenTextures(1, &m_RendererID);
-		glBindTexture(GL_TEXTURE_2D, m_RendererID);
+		RenderDevice::Get().GenTextures(1, &m_RendererID);
+		RenderDevice::Get().BindTexture(GL_TEXTURE_2D, m_RendererID);
 
 		if (texType == FramebufferAttachmentType::GX_TEX_COLOR)
 		{
 			m_InternalFormat = GL_RGBA8;
 			m_DataFormat = GL_RGBA;
 
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_CLAMP_TO_EDGE);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_CLAMP_TO_EDGE);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_LINEAR);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_LINEAR);
-			glTexImage2D(GL_TEXTURE_2D, 0, m_InternalFormat, m_Width, m_Height, 0, m_DataFormat, GL_UNSIGNED_BYTE, NULL);
+			RenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_CLAMP_TO_EDGE);
+			RenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_CLAMP_TO_EDGE);
+			RenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_LINEAR);
+			RenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_LINEAR);
+			RenderDevice::Get().TexImage2D(GL_TEXTURE_2D, 0, m_InternalFormat, m_Width, m_Height, 0, m_DataFormat, GL_UNSIGNED_BYTE, NULL);
 		}
 		else if (texType == FramebufferAttachmentType::GX_TEX_DEPTH)
 		{
 			m_InternalFormat = m_DataFormat = GL_DEPTH_COMPONENT;
 
-			glTexImage2D(GL_TEXTURE_2D, 0, m_InternalFormat, m_Width, m_Height, 0, m_DataFormat, GL_FLOAT, NULL);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+			RenderDevice::Get().TexImage2D(GL_TEXTURE_2D, 0, m_InternalFormat, m_Width, m_Height, 0, m_DataFormat, GL_FLOAT, NULL);
+			RenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+			RenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			RenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+			RenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 		}
 
-		glBindTexture(GL_TEXTURE_2D, 0);
+		RenderDevice::Get().BindTexture(GL_TEXTURE_2D, 0);
 	}
 
 	Texture2D::Texture2D(uint32_t width, uint32_t height)
-		: RendererAsset(), m_FilePath(std::string()), m_Width(width), m_Height(height), m_TileTexture(false)
+		: RendererAsset(), m_Handle(GenerateHandle()), m_FilePath(std::string()), m_Width(width), m_Height(height), m_MipLevels(1), m_IsCompressed(false), m_IsResident(true), m_TileTexture(false)
 	{
 		GX_PROFILE_FUNCTION()
 
 		m_InternalFormat = GL_RGBA8;
 		m_DataFormat = GL_RGBA;
 
-		glGenTextures(1, &m_RendererID);
-		glBindTexture(GL_TEXTURE_2D, m_RendererID);
-		glTexImage2D(GL_TEXTURE_2D, 0, m_InternalFormat, width, height, 0, m_DataFormat, GL_UNSIGNED_BYTE, NULL);
+		RenderDevice::Get().GenTextures(1, &m_RendererID);
+		RenderDevice::Get().BindTexture(GL_TEXTURE_2D, m_RendererID);
+		RenderDevice::Get().TexImage2D(GL_TEXTURE_2D, 0, m_InternalFormat, width, height, 0, m_DataFormat, GL_UNSIGNED_BYTE, NULL);
 
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		RenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		RenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		RenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		RenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
-		glBindTexture(GL_TEXTURE_2D, 0);
+		RenderDevice::Get().BindTexture(GL_TEXTURE_2D, 0);
 	}
 
 	void Texture2D::Bind(unsigned int slot) const
 	{
 		GX_PROFILE_FUNCTION()
 
-		glActiveTexture(GL_TEXTURE0 + slot);
-		glBindTexture(GL_TEXTURE_2D, m_RendererID);
+		RenderDevice::Get().ActiveTexture(GL_TEXTURE0 + slot);
+		RenderDevice::Get().BindTexture(GL_TEXTURE_2D, m_RendererID);
+	}
+
+	bool Texture2D::ReadPixels(std::vector<uint8_t>& OutPixels) const
+	{
+		GX_PROFILE_FUNCTION()
+
+		GX_ENGINE_ASSERT(RenderDevice::IsRenderThread(), "Texture pixels can only be read on the render thread");
+
+		if (!m_IsResident || m_Width == 0 || m_Height == 0)
+			return false;
+
+		// Block compressed textures are decompressed by the driver
+		OutPixels.resize(4 * (size_t)m_Width * m_Height);
+		RenderDevice::Get().BindTexture(GL_TEXTURE_2D, m_RendererID);
+		RenderDevice::Get().GetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, OutPixels.data());
+
+		return true;
 	}
 
 	void Texture2D::UnBind() const
 	{
 		GX_PROFILE_FUNCTION()
 
-		glBindTexture(GL_TEXTURE_2D, 0);
+		RenderDevice::Get().BindTexture(GL_TEXTURE_2D, 0);
 	}
 
 	void Texture2D::SetData(void* data, uint32_t size)
 	{
 		GX_PROFILE_FUNCTION()
 
+		GX_ENGINE_ASSERT(!m_IsCompressed, "Compressed textures can not be updated");
+
 		uint32_t bpp = m_DataFormat == GL_RGBA ? 4 : 3;
 		GX_ENGINE_ASSERT(size == bpp * m_Width * m_Height, "Data must be for entire texture!");
 
-		glBindTexture(GL_TEXTURE_2D, m_RendererID);
-		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
+		RenderDevice::Get().BindTexture(GL_TEXTURE_2D, m_RendererID);
+		RenderDevice::Get().TexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
 	}
 
 	bool Texture2D::operator==(const Texture2D& OtherTex) const
@@ -149,7 +495,49 @@ namespace GraphX
 	{
 		GX_PROFILE_FUNCTION()
 
-		glDeleteTextures(1, &m_RendererID);
+		// Levels of the texture still being decoded are dropped
+		if (!m_IsResident)
+			TextureStreamer::Cancel(*this);
+
+		// Layers of the texture in the texture arrays can be reused
+		Texture2DArrayPool::OnTextureDestroyed(m_Handle);
+
+		RenderDevice::Get().DeleteTextures(1, &m_RendererID);
+	}
+
+	void Texture2D::SetFiltering(float MaxAnisotropy)
+	{
+		GX_PROFILE_FUNCTION()
+
+		// Trilinear filtering blends between the two closest mip levels, so the distant surfaces do not alias
+		RenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_MipLevels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+		RenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		RenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, m_MipLevels - 1);
+
+		// Anisotropic filtering keeps the surfaces at grazing angles (e.g. the terrain) sharp
+		const float Anisotropy = std::min(MaxAnisotropy, GetMaxSupportedAnisotropy());
+		if (m_MipLevels > 1 && Anisotropy > 1.0f)
+			RenderDevice::Get().TexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY, Anisotropy);
+	}
+
+	uint32_t Texture2D::GenerateHandle()
+	{
+		return ++s_TextureHandleCounter;
+	}
+
+	uint32_t Texture2D::GetHandleCount()
+	{
+		return s_TextureHandleCounter.load();
+	}
+
+	void Texture2D::SetSamplingSettings(const TextureSamplingSettings& Settings)
+	{
+		s_SamplingSettings = Settings;
+	}
+
+	const TextureSamplingSettings& Texture2D::GetSamplingSettings()
+	{
+		return s_SamplingSettings;
 	}
 
 	bool operator==(const std::reference_wrapper<Texture2D>& Ref1, const std::reference_wrapper<Texture2D>& Ref2)
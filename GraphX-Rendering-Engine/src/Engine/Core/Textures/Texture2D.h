@@ -1,9 +1,12 @@
 #pragma once
 
 #include "Engine/Core/RendererAsset.h"
+#include "MipGenerator.h"
 
 namespace GraphX
 {
+	enum class BlockFormat;
+
 	/* Type of the texture used for the frame buffer */
 	enum class FramebufferAttachmentType
 	{
@@ -12,16 +15,61 @@ namespace GraphX
 		GX_TEX_DEPTH		/* Texture is used as a depth buffer for a framebuffer */
 	};
 
+	/* How the mip chain of the textures loaded from the files is built */
+	enum class MipmapMode
+	{
+		None = 0,		/* Only the full resolution level (Sampled with bilinear filtering) */
+		GPU,			/* Generated by the driver after the upload */
+		CPUBox,			/* Downsampled with a box filter on the loading thread */
+		CPUKaiser		/* Downsampled with a Kaiser filter on the loading thread (Sharper in the distance) */
+	};
+
+	/* Sampling of the textures loaded from the files */
+	struct TextureSamplingSettings
+	{
+		MipmapMode Mipmaps = MipmapMode::GPU;
+
+		/* Anisotropic filtering level (1 disables it, clamped to the maximum supported by the device) */
+		float MaxAnisotropy = 8.0f;
+	};
+
+	/* How the data of a texture loaded from a file is uploaded */
+	enum class TextureLoadMode
+	{
+		Immediate = 0,	/* Decoded and uploaded in the constructor */
+		Streamed		/* Decoded on the thread pool and uploaded over the next frames (A placeholder is sampled until then) */
+	};
+
+	/* Texture file decoded on the CPU, ready to be uploaded (Decoding does not need a graphics context, so it can be done on any thread) */
+	struct TextureFileData
+	{
+		/* OpenGL formats of the storage and the data (Data format is 0 for the block compressed textures) */
+		uint32_t InternalFormat = 0;
+		uint32_t DataFormat = 0;
+
+		bool IsCompressed = false;
+
+		/* Whether the mips are left to the driver (Generated after the full resolution level is uploaded) */
+		bool GenerateMips = false;
+
+		/* Mip chain, starting from the full resolution level */
+		std::vector<MipLevel> Levels;
+	};
+
 	class Texture2D
 		: public RendererAsset
 	{
 		/* Required to access the rendererID for the texture to bind to the framebuffer */
 		friend class FrameBuffer;
 
+		/* Uploads the levels of the streamed textures */
+		friend class TextureStreamer;
+
 	public:
-		/* Constructor */
+		/* Constructor (Loads the images and the block compressed DDS / KTX2 files) */
 		/* @Param TileTexture - Whether the texture will be used for tilling or not */
-		Texture2D(const std::string& filePath, bool TileTexture = false);
+		/* @Param LoadMode - Whether the file is loaded now or streamed in the background */
+		Texture2D(const std::string& filePath, bool TileTexture = false, TextureLoadMode LoadMode = TextureLoadMode::Immediate);
 
 		/* Constructor for the framebuffer textures */
 		Texture2D(uint32_t width, uint32_t height, FramebufferAttachmentType texType);
@@ -38,15 +86,33 @@ namespace GraphX
 		// Set Data of the texture
 		void SetData(void* data, uint32_t size);
 
+		/* Reads the full resolution level back from the GPU as RGBA8 (Only on the render thread, false if the texture is not resident yet) */
+		bool ReadPixels(std::vector<uint8_t>& OutPixels) const;
+
 		/* Returns the width of the texture */
 		inline uint32_t GetWidth() const { return m_Width; }
 
 		/* Returns the height of the texture */
 		inline uint32_t GetHeight() const { return m_Height; }
 
+		/* Returns the OpenGL format used to store the texture */
+		inline uint32_t GetInternalFormat() const { return m_InternalFormat; }
+
 		/* Returns the file path of the texture */
 		inline const std::string& GetFilePath() const { return m_FilePath; }
 
+		/* Returns the engine wide unique handle of the texture (Used by the batches for constant time texture slot lookups) */
+		inline uint32_t GetHandle() const { return m_Handle; }
+
+		/* Returns the number of mip levels of the texture */
+		inline uint32_t GetMipLevelCount() const { return m_MipLevels; }
+
+		/* Returns whether the texture is block compressed (Loaded from a DDS or a KTX2 file) */
+		inline bool IsCompressed() const { return m_IsCompressed; }
+
+		/* Returns whether the data of the texture is uploaded (Streamed textures sample a placeholder until then) */
+		inline bool IsResident() const { return m_IsResident; }
+
 		/* Returns whether the texture will be used for tiling */
 		inline bool IsTileTexture() const { return m_TileTexture; }
 
@@ -62,7 +128,54 @@ namespace GraphX
 		/* Destroy the texture */
 		virtual ~Texture2D();
 
+		/* Returns the total number of handles given out to the textures so far */
+		static uint32_t GetHandleCount();
+
+		/**
+		* Decodes a texture file (and its mip chain) without uploading it, can be called from any thread
+		* Precompressed version of an image is decoded in its place when present
+		* @return false (with the reason logged) if the file can not be decoded
+		*/
+		static bool DecodeFile(const std::string& FilePath, bool TileTexture, const TextureSamplingSettings& Sampling, TextureFileData& OutData);
+
+		/* Sets the sampling of the textures loaded from the files (Textures already loaded are not affected) */
+		static void SetSamplingSettings(const TextureSamplingSettings& Settings);
+
+		/* Returns the sampling of the textures loaded from the files */
+		static const TextureSamplingSettings& GetSamplingSettings();
+
+		/* Returns whether the device can sample the block compressed format */
+		static bool IsBlockFormatSupported(BlockFormat Format);
+
+		/* Returns the OpenGL format of the block compressed format */
+		static uint32_t GetCompressedInternalFormat(BlockFormat Format);
+
+		/* Returns the largest width / height of a texture on the device (Queried on the render thread when the renderer starts, readable from any thread after) */
+		static uint32_t GetMaxSize();
+
 	protected:
+		/* Returns a new unique handle for a texture */
+		static uint32_t GenerateHandle();
+
+		/* Creates the texture and uploads all the levels of the decoded file */
+		void Upload(const TextureFileData& Data, float MaxAnisotropy);
+
+		/* Creates the texture with a single pixel to be sampled until the streamed levels are uploaded (Only on the render thread) */
+		void CreatePlaceholder();
+
+		/**
+		* Uploads a level of a streamed texture (Smallest level is uploaded first, and each level is sampled as soon as it is uploaded)
+		* @param Pixels Data of the level, or the offset in to the bound pixel unpack buffer
+		*/
+		void UploadStreamedLevel(const TextureFileData& Data, uint32_t Level, const void* Pixels, float MaxAnisotropy);
+
+		/* Sets the trilinear (or bilinear without the mips) and the anisotropic filtering of the bound texture */
+		void SetFiltering(float MaxAnisotropy);
+
+	protected:
+		/* Unique handle of the texture, starting from 1 (copies of the texture share the handle along with the renderer id) */
+		uint32_t m_Handle;
+
 		/* Path to the texture file */
 		std::string m_FilePath;
 
@@ -72,6 +185,15 @@ namespace GraphX
 		/* Format of the texture storage and the supplied data */
 		uint32_t m_InternalFormat, m_DataFormat;
 
+		/* Number of levels in the mip chain (1 without the mips) */
+		uint32_t m_MipLevels;
+
+		/* Whether the texture is stored block compressed */
+		bool m_IsCompressed;
+
+		/* Whether the data of the texture is uploaded */
+		bool m_IsResident;
+
 		/* Whether the texture will be used for tiling or not */
 		bool m_TileTexture;
 	};
@@ -0,0 +1,100 @@
+#include "pch.h"
+#include "Texture2DArray.h"
+#include "GL/glew.h"
+#include "Device/RenderDevice.h"
+
+#include "Texture2D.h"
+
+namespace GraphX
+{
+	Texture2DArray::Texture2DArray(uint32_t width, uint32_t height, uint32_t layers, uint32_t InternalFormat, uint32_t Levels)
+		: RendererAsset(), m_Width(width), m_Height(height), m_Layers(layers), m_Levels(Levels), m_InternalFormat(InternalFormat)
+	{
+		GX_PROFILE_FUNCTION()
+
+		GX_ENGINE_ASSERT(m_Layers > 0 && m_Layers <= GetMaxLayers(), "Invalid number of layers for the texture array");
+		GX_ENGINE_ASSERT(m_Levels > 0, "Texture array needs at least one level");
+
+		RenderDevice::Get().GenTextures(1, &m_RendererID);
+		RenderDevice::Get().BindTexture(GL_TEXTURE_2D_ARRAY, m_RendererID);
+
+		// Immutable storage for all the layers
+		RenderDevice::Get().TexStorage3D(GL_TEXTURE_2D_ARRAY, m_Levels, m_InternalFormat, m_Width, m_Height, m_Layers);
+
+		RenderDevice::Get().TexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		RenderDevice::Get().TexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+		RenderDevice::Get().TexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, m_Levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+		RenderDevice::Get().TexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+		RenderDevice::Get().BindTexture(GL_TEXTURE_2D_ARRAY, 0);
+	}
+
+	void Texture2DArray::Bind(unsigned int slot) const
+	{
+		GX_PROFILE_FUNCTION()
+
+		RenderDevice::Get().ActiveTexture(GL_TEXTURE0 + slot);
+		RenderDevice::Get().BindTexture(GL_TEXTURE_2D_ARRAY, m_RendererID);
+	}
+
+	void Texture2DArray::UnBind() const
+	{
+		GX_PROFILE_FUNCTION()
+
+		RenderDevice::Get().BindTexture(GL_TEXTURE_2D_ARRAY, 0);
+	}
+
+	void Texture2DArray::SetLayerData(uint32_t layer, const void* data, uint32_t DataFormat)
+	{
+		GX_PROFILE_FUNCTION()
+
+		GX_ENGINE_ASSERT(layer < m_Layers, "Layer index out of range!");
+
+		RenderDevice::Get().BindTexture(GL_TEXTURE_2D_ARRAY, m_RendererID);
+		RenderDevice::Get().TexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, m_Width, m_Height, 1, DataFormat, GL_UNSIGNED_BYTE, data);
+		RenderDevice::Get().BindTexture(GL_TEXTURE_2D_ARRAY, 0);
+	}
+
+	void Texture2DArray::CopyToLayer(uint32_t layer, const Texture2D& Texture)
+	{
+		GX_PROFILE_FUNCTION()
+
+		GX_ENGINE_ASSERT(layer < m_Layers, "Layer index out of range!");
+		GX_ENGINE_ASSERT(Texture.GetWidth() == m_Width && Texture.GetHeight() == m_Height && Texture.GetInternalFormat() == m_InternalFormat && Texture.GetMipLevelCount() == m_Levels, "Texture does not match the texture array layout!");
+
+		// GPU side copy of every level, the texture data is not kept on the CPU
+		for (uint32_t Level = 0; Level < m_Levels; Level++)
+		{
+			uint32_t LevelWidth = GM::Utility::Max(m_Width >> Level, 1u);
+			uint32_t LevelHeight = GM::Utility::Max(m_Height >> Level, 1u);
+			RenderDevice::Get().CopyImageSubData(Texture.GetID(), GL_TEXTURE_2D, Level, 0, 0, 0, m_RendererID, GL_TEXTURE_2D_ARRAY, Level, 0, 0, layer, LevelWidth, LevelHeight, 1);
+		}
+	}
+
+	uint32_t Texture2DArray::GetMaxLayers()
+	{
+		static int MaxLayers = 0;
+		if (MaxLayers == 0)
+		{
+			RenderDevice::Get().GetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &MaxLayers);
+		}
+
+		return (uint32_t)MaxLayers;
+	}
+
+	bool Texture2DArray::IsCopySupported()
+	{
+		if (RenderDevice::GetType() == RenderDeviceType::Null)
+			return true;
+
+		return GLEW_VERSION_4_3 || GLEW_ARB_copy_image;
+	}
+
+	Texture2DArray::~Texture2DArray()
+	{
+		GX_PROFILE_FUNCTION()
+
+		RenderDevice::Get().DeleteTextures(1, &m_RendererID);
+	}
+}
\ No newline at end of file
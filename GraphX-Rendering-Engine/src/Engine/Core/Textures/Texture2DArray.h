@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Engine/Core/RendererAsset.h"
+
+namespace GraphX
+{
+	class Texture2D;
+
+	/* Array of same sized and same formatted 2D textures, each stored in a separate layer */
+	class Texture2DArray
+		: public RendererAsset
+	{
+	public:
+		/**
+		* Creates an empty texture array (Data for the layers needs to be set later)
+		* @param InternalFormat OpenGL format of the texture storage, all the layers share the format
+		* @param Levels Number of mip levels of each layer (Sampled with trilinear filtering when more than 1)
+		*/
+		Texture2DArray(uint32_t width, uint32_t height, uint32_t layers, uint32_t InternalFormat, uint32_t Levels = 1);
+
+		/* Bind the texture array to the indicated slot */
+		void Bind(unsigned int slot = 0) const;
+
+		/* Unbind the currently bound texture array */
+		void UnBind() const;
+
+		/* Set the data of a layer (Data needs to be for the entire layer) */
+		void SetLayerData(uint32_t layer, const void* data, uint32_t DataFormat);
+
+		/* Copies the texture (and its mip levels) into the layer on the GPU (Texture must have the same size, format and number of levels as the array) */
+		void CopyToLayer(uint32_t layer, const Texture2D& Texture);
+
+		/* Returns the width of each layer */
+		inline uint32_t GetWidth() const { return m_Width; }
+
+		/* Returns the height of each layer */
+		inline uint32_t GetHeight() const { return m_Height; }
+
+		/* Returns the number of layers in the array */
+		inline uint32_t GetLayerCount() const { return m_Layers; }
+
+		/* Returns the number of mip levels of each layer */
+		inline uint32_t GetLevelCount() const { return m_Levels; }
+
+		/* Returns the OpenGL format used to store the layers */
+		inline uint32_t GetInternalFormat() const { return m_InternalFormat; }
+
+		/* Returns the max number of layers supported by the GPU */
+		static uint32_t GetMaxLayers();
+
+		/* Returns whether the textures can be copied in to the layers on the GPU (Needs OpenGL 4.3 or ARB_copy_image) */
+		static bool IsCopySupported();
+
+		/* Destroy the texture array */
+		~Texture2DArray();
+
+	private:
+		/* Width and height of each layer */
+		uint32_t m_Width, m_Height;
+
+		/* Number of layers in the array */
+		uint32_t m_Layers;
+
+		/* Number of mip levels of each layer */
+		uint32_t m_Levels;
+
+		/* Format of the texture storage */
+		uint32_t m_InternalFormat;
+	};
+}
\ No newline at end of file
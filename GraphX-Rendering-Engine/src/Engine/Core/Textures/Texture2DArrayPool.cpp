@@ -0,0 +1,144 @@
+#include "pch.h"
+#include "Texture2DArrayPool.h"
+
+#include "Texture2D.h"
+#include "Texture2DArray.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace GraphX
+{
+	/* All the pools alive, so the textures can free their layers when destroyed */
+	static std::vector<Texture2DArrayPool*> s_Pools;
+
+	/* Guards the pools list and the destroyed textures of each pool (Textures can be destroyed on any thread) */
+	static std::mutex s_PoolsMutex;
+
+	Texture2DArrayPool::Texture2DArrayPool(uint32_t LayersPerArray)
+		: m_LayersPerArray(LayersPerArray)
+	{
+		GX_ENGINE_ASSERT(m_LayersPerArray > 0, "Texture array pool needs at least one layer per array");
+
+		std::lock_guard<std::mutex> Lock(s_PoolsMutex);
+		s_Pools.push_back(this);
+	}
+
+	const Texture2DArrayPool::Location& Texture2DArrayPool::Resolve(const Texture2D& Texture)
+	{
+		static const Location EmptyLocation;
+
+		const uint32_t Width = Texture.GetWidth(), Height = Texture.GetHeight(), Format = Texture.GetInternalFormat(), Levels = Texture.GetMipLevelCount();
+		const uint64_t GroupKey = GetGroupKey(Width, Height, Format, Levels);
+
+		auto itr = m_Entries.find(Texture.GetHandle());
+		if (itr != m_Entries.end())
+		{
+			if (itr->second.GroupKey == GroupKey)
+				return itr->second.Loc;
+
+			// Layout of the texture changed since it was copied, so the copy is stale (Handles are never reused, so a destroyed texture can not hit its stale entry either)
+			Release(Texture.GetHandle());
+		}
+
+		// Streamed texture is still the placeholder (or only has its smaller levels), it is copied once it is fully uploaded
+		if (!Texture.IsResident())
+			return EmptyLocation;
+
+		GX_PROFILE_FUNCTION()
+
+		ArrayGroup& Group = m_Groups[GroupKey];
+
+		Entry& NewEntry = m_Entries[Texture.GetHandle()];
+		NewEntry.GroupKey = GroupKey;
+
+		if (!Group.FreeLayers.empty())
+		{
+			NewEntry.Loc = Group.FreeLayers.back();
+			Group.FreeLayers.pop_back();
+		}
+		else
+		{
+			// Create a new array once the last one is full
+			if (Group.Arrays.empty() || Group.UsedLayers == Group.Arrays.back()->GetLayerCount())
+			{
+				uint32_t Layers = GM::Utility::Min(m_LayersPerArray, Texture2DArray::GetMaxLayers());
+				Group.Arrays.emplace_back(CreateRef<Texture2DArray>(Width, Height, Layers, Format, Levels));
+				Group.UsedLayers = 0;
+
+				GX_ENGINE_INFO("Created texture array {0}x{1} with {2} layers and {3} levels", Width, Height, Layers, Levels);
+			}
+
+			NewEntry.Loc.Array = Group.Arrays.back().get();
+			NewEntry.Loc.Layer = Group.UsedLayers++;
+		}
+
+		NewEntry.Loc.Array->CopyToLayer(NewEntry.Loc.Layer, Texture);
+
+		return NewEntry.Loc;
+	}
+
+	uint32_t Texture2DArrayPool::GetArrayCount() const
+	{
+		uint32_t Count = 0;
+		for (const auto& Group : m_Groups)
+		{
+			Count += (uint32_t)Group.second.Arrays.size();
+		}
+
+		return Count;
+	}
+
+	void Texture2DArrayPool::RecycleLayers()
+	{
+		std::vector<uint32_t> DestroyedTextures;
+		{
+			std::lock_guard<std::mutex> Lock(s_PoolsMutex);
+			DestroyedTextures.swap(m_DestroyedTextures);
+		}
+
+		for (uint32_t TextureHandle : DestroyedTextures)
+		{
+			Release(TextureHandle);
+		}
+
+		for (const Entry& Retired : m_RetiredLayers)
+		{
+			m_Groups[Retired.GroupKey].FreeLayers.push_back(Retired.Loc);
+		}
+
+		m_RetiredLayers.clear();
+	}
+
+	void Texture2DArrayPool::OnTextureDestroyed(uint32_t TextureHandle)
+	{
+		// Only queued here, the entries are owned by the render thread
+		std::lock_guard<std::mutex> Lock(s_PoolsMutex);
+		for (Texture2DArrayPool* Pool : s_Pools)
+		{
+			Pool->m_DestroyedTextures.push_back(TextureHandle);
+		}
+	}
+
+	void Texture2DArrayPool::Release(uint32_t TextureHandle)
+	{
+		auto itr = m_Entries.find(TextureHandle);
+		if (itr == m_Entries.end())
+			return;
+
+		m_RetiredLayers.push_back(itr->second);
+		m_Entries.erase(itr);
+	}
+
+	uint64_t Texture2DArrayPool::GetGroupKey(uint32_t Width, uint32_t Height, uint32_t InternalFormat, uint32_t Levels)
+	{
+		// Dimensions are limited to 16 bits by the GPU anyway, and the OpenGL formats fit in 16 bits too
+		return ((uint64_t)(InternalFormat & 0xffff) << 48) | ((uint64_t)(Levels & 0xffff) << 32) | ((uint64_t)(Width & 0xffff) << 16) | (uint64_t)(Height & 0xffff);
+	}
+
+	Texture2DArrayPool::~Texture2DArrayPool()
+	{
+		std::lock_guard<std::mutex> Lock(s_PoolsMutex);
+		s_Pools.erase(std::find(s_Pools.begin(), s_Pools.end(), this));
+	}
+}
\ No newline at end of file
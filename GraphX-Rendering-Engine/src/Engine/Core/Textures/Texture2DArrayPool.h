@@ -0,0 +1,94 @@
+#pragma once
+
+namespace GraphX
+{
+	class Texture2D;
+	class Texture2DArray;
+
+	/**
+	* Packs textures with the same size, format and number of mip levels into layers of shared texture arrays
+	* A texture is copied into its layer the first time it is requested, its layer is freed once the texture is destroyed
+	* NOTE: The pool is used on the render thread, only the textures can be destroyed on any thread
+	*/
+	class Texture2DArrayPool
+	{
+	public:
+		/* Location of a texture within the pool */
+		struct Location
+		{
+			/* Array containing the texture (nullptr if the texture is not in the pool) */
+			Texture2DArray* Array = nullptr;
+
+			/* Layer of the array containing the texture */
+			uint32_t Layer = 0;
+		};
+
+	public:
+		/* @param LayersPerArray Number of layers allocated for each new array */
+		Texture2DArrayPool(uint32_t LayersPerArray = 64);
+
+		/**
+		* Returns the array and the layer containing the texture
+		* Textures which are not fully uploaded yet (streamed) are not added, an empty location is returned for them until they are resident
+		*/
+		const Location& Resolve(const Texture2D& Texture);
+
+		/* Returns the number of arrays created by the pool */
+		uint32_t GetArrayCount() const;
+
+		/**
+		* Makes the layers of the destroyed (and the changed) textures available for the new textures
+		* Should only be called once all the batches using the pool are flushed, otherwise a new texture can overwrite a layer a pending draw still samples
+		*/
+		void RecycleLayers();
+
+		/* Queues the layers of a destroyed texture to be freed in all the pools (Called by the texture, from any thread) */
+		static void OnTextureDestroyed(uint32_t TextureHandle);
+
+		~Texture2DArrayPool();
+
+	private:
+		/* All the arrays of the same layout (size, format and levels) */
+		struct ArrayGroup
+		{
+			std::vector<Ref<Texture2DArray>> Arrays;
+
+			/* Number of used layers in the last array of the group */
+			uint32_t UsedLayers = 0;
+
+			/* Layers freed by the destroyed textures (Reused before the new layers) */
+			std::vector<Location> FreeLayers;
+		};
+
+		/* Texture copied in to the pool */
+		struct Entry
+		{
+			Location Loc;
+
+			/* Group the layer belongs to */
+			uint64_t GroupKey = 0;
+		};
+
+		/* Returns the key of the group for the given layout */
+		static uint64_t GetGroupKey(uint32_t Width, uint32_t Height, uint32_t InternalFormat, uint32_t Levels);
+
+		/* Moves the layer of the texture to the retired layers, which are freed by the next recycle */
+		void Release(uint32_t TextureHandle);
+
+	private:
+		/* Number of layers in each array */
+		uint32_t m_LayersPerArray;
+
+		/* Groups of arrays for each layout */
+		std::unordered_map<uint64_t, ArrayGroup> m_Groups;
+
+		/* Location of each texture in the pool (Indexed using the texture handles) */
+		std::unordered_map<uint32_t, Entry> m_Entries;
+
+		/* Layers released since the last recycle, they might still be used by the current batches */
+		std::vector<Entry> m_RetiredLayers;
+
+		/* Handles of the textures destroyed since the last recycle (Guarded by the pools mutex) */
+		std::vector<uint32_t> m_DestroyedTextures;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,223 @@
+#include "pch.h"
+#include "TextureAtlas.h"
+
+#include "Texture2D.h"
+#include "SubTexture2D.h"
+
+namespace GraphX
+{
+	TextureAtlas::TextureAtlas(uint32_t InitialSize, uint32_t MaxSize, uint32_t Padding)
+		: m_Packer(InitialSize, InitialSize), m_MaxSize(MaxSize), m_Padding(Padding), m_Pixels(4 * InitialSize * InitialSize, 0)
+	{
+		GX_ENGINE_ASSERT(InitialSize > 0 && InitialSize <= MaxSize, "Invalid texture atlas size");
+	}
+
+	Ref<SubTexture2D> TextureAtlas::Add(const uint8_t* Pixels, uint32_t Width, uint32_t Height, uint32_t Channels)
+	{
+		GX_PROFILE_FUNCTION()
+
+		GX_ENGINE_ASSERT(Pixels != nullptr && Width > 0 && Height > 0, "Invalid image added to the texture atlas");
+		GX_ENGINE_ASSERT(Channels == 3 || Channels == 4, "Texture atlas only supports RGB and RGBA images");
+
+		// Image which can not fit even in the largest atlas is rejected before touching the layout
+		if (Width + 2 * m_Padding > m_MaxSize || Height + 2 * m_Padding > m_MaxSize)
+		{
+			GX_ENGINE_WARN("Image ({0}x{1}) is larger than the texture atlas", Width, Height);
+			return nullptr;
+		}
+
+		m_Entries.emplace_back();
+		Entry& NewEntry = m_Entries.back();
+		NewEntry.Width = Width;
+		NewEntry.Height = Height;
+
+		// Store everything as RGBA8
+		NewEntry.Pixels.resize(4 * Width * Height);
+		for (uint32_t i = 0; i < Width * Height; i++)
+		{
+			NewEntry.Pixels[4 * i + 0] = Pixels[Channels * i + 0];
+			NewEntry.Pixels[4 * i + 1] = Pixels[Channels * i + 1];
+			NewEntry.Pixels[4 * i + 2] = Pixels[Channels * i + 2];
+			NewEntry.Pixels[4 * i + 3] = Channels == 4 ? Pixels[Channels * i + 3] : 255;
+		}
+
+		NewEntry.SubTexture = CreateRef<SubTexture2D>(m_Texture, GM::Vector2(0.0f, 0.0f), GM::Vector2(1.0f, 1.0f));
+
+		// Size before the repack, a failed repack grows the packer up to the max size
+		const uint32_t PreviousWidth = GetWidth(), PreviousHeight = GetHeight();
+
+		// Try to fit the image in the free space first, repack everything only if it does not fit
+		if (m_Packer.Insert(Width + 2 * m_Padding, Height + 2 * m_Padding, NewEntry.Rect))
+		{
+			Blit(NewEntry);
+			UpdateSubTexture(NewEntry);
+		}
+		else if (!Repack())
+		{
+			GX_ENGINE_WARN("Image ({0}x{1}) does not fit in the texture atlas", Width, Height);
+			m_Entries.pop_back();
+
+			// Failed repack leaves the atlas cleared, restore the previous layout at the previous size
+			m_Packer.Resize(PreviousWidth, PreviousHeight);
+			bool Restored = Repack();
+			GX_ENGINE_ASSERT(Restored, "Failed to restore the texture atlas");
+
+			m_Dirty = true;
+			return nullptr;
+		}
+
+		m_Dirty = true;
+		return m_Entries.back().SubTexture;
+	}
+
+	Ref<SubTexture2D> TextureAtlas::Add(const Texture2D& Texture)
+	{
+		GX_PROFILE_FUNCTION()
+
+		const std::string& FilePath = Texture.GetFilePath();
+
+		auto itr = m_FileEntries.find(FilePath);
+		if (itr != m_FileEntries.end())
+			return m_Entries[itr->second].SubTexture;
+
+		// Rows are read back in the order they were uploaded, so the image has the same orientation as the texture
+		std::vector<uint8_t> Pixels;
+		if (!Texture.ReadPixels(Pixels))
+		{
+			GX_ENGINE_ERROR("Failed to read the image of the texture for the texture atlas: {0}", FilePath);
+			return nullptr;
+		}
+
+		Ref<SubTexture2D> SubTexture = Add(Pixels.data(), Texture.GetWidth(), Texture.GetHeight(), 4);
+
+		if (SubTexture)
+			m_FileEntries.emplace(FilePath, (uint32_t)m_Entries.size() - 1);
+
+		return SubTexture;
+	}
+
+	Ref<SubTexture2D> TextureAtlas::AddRegion(const Ref<SubTexture2D>& Image, const GM::Vector2& Min, const GM::Vector2& Max)
+	{
+		GX_PROFILE_FUNCTION()
+
+		for (Entry& entry : m_Entries)
+		{
+			if (entry.SubTexture != Image)
+				continue;
+
+			Region NewRegion;
+			NewRegion.SubTexture = CreateRef<SubTexture2D>(m_Texture, GM::Vector2(0.0f, 0.0f), GM::Vector2(1.0f, 1.0f));
+			NewRegion.Min = Min;
+			NewRegion.Max = Max;
+			entry.Regions.push_back(NewRegion);
+
+			UpdateSubTexture(entry);
+			return NewRegion.SubTexture;
+		}
+
+		GX_ENGINE_ASSERT(false, "Region of an image which is not in the texture atlas");
+		return nullptr;
+	}
+
+	void TextureAtlas::Commit()
+	{
+		GX_PROFILE_FUNCTION()
+
+		if (!m_Dirty)
+			return;
+
+		// A new texture is required the first time and every time the atlas grows
+		if (!m_Texture || m_Texture->GetWidth() != GetWidth() || m_Texture->GetHeight() != GetHeight())
+		{
+			m_Texture = CreateRef<Texture2D>(GetWidth(), GetHeight());
+			for (const Entry& entry : m_Entries)
+			{
+				UpdateSubTexture(entry);
+			}
+		}
+
+		m_Texture->SetData(m_Pixels.data(), (uint32_t)m_Pixels.size());
+		m_Dirty = false;
+	}
+
+	bool TextureAtlas::Repack()
+	{
+		GX_PROFILE_FUNCTION()
+
+		std::vector<AtlasPacker::Request> Requests(m_Entries.size());
+		for (uint32_t i = 0; i < m_Entries.size(); i++)
+		{
+			Requests[i].ID = i;
+			Requests[i].Width = m_Entries[i].Width + 2 * m_Padding;
+			Requests[i].Height = m_Entries[i].Height + 2 * m_Padding;
+		}
+
+		std::vector<AtlasPacker::Rect> Rects;
+		uint32_t Width = m_Packer.GetWidth(), Height = m_Packer.GetHeight();
+		while (!m_Packer.Repack(Requests, Rects))
+		{
+			// Grow the smaller side, keeps the atlas close to a square
+			if (Width <= Height && 2 * Width <= m_MaxSize)
+				Width *= 2;
+			else if (2 * Height <= m_MaxSize)
+				Height *= 2;
+			else
+				return false;
+
+			m_Packer.Resize(Width, Height);
+		}
+
+		m_Pixels.assign(4 * Width * Height, 0);
+		for (uint32_t i = 0; i < m_Entries.size(); i++)
+		{
+			m_Entries[i].Rect = Rects[i];
+			Blit(m_Entries[i]);
+			UpdateSubTexture(m_Entries[i]);
+		}
+
+		return true;
+	}
+
+	void TextureAtlas::Blit(const Entry& entry)
+	{
+		const uint32_t AtlasWidth = GetWidth();
+		const int32_t Padding = (int32_t)m_Padding;
+		const int32_t Width = (int32_t)entry.Width, Height = (int32_t)entry.Height;
+
+		// Padding is filled with the nearest edge pixel of the image
+		for (int32_t y = -Padding; y < Height + Padding; y++)
+		{
+			int32_t SourceY = GM::Utility::Min(GM::Utility::Max(y, 0), Height - 1);
+			uint32_t DestY = entry.Rect.Y + Padding + y;
+
+			for (int32_t x = -Padding; x < Width + Padding; x++)
+			{
+				int32_t SourceX = GM::Utility::Min(GM::Utility::Max(x, 0), Width - 1);
+				uint32_t DestX = entry.Rect.X + Padding + x;
+
+				const uint8_t* Source = &entry.Pixels[4 * (SourceY * Width + SourceX)];
+				uint8_t* Dest = &m_Pixels[4 * (DestY * AtlasWidth + DestX)];
+				Dest[0] = Source[0];
+				Dest[1] = Source[1];
+				Dest[2] = Source[2];
+				Dest[3] = Source[3];
+			}
+		}
+	}
+
+	void TextureAtlas::UpdateSubTexture(const Entry& entry)
+	{
+		const float AtlasWidth = (float)GetWidth(), AtlasHeight = (float)GetHeight();
+
+		GM::Vector2 Min((entry.Rect.X + m_Padding) / AtlasWidth, (entry.Rect.Y + m_Padding) / AtlasHeight);
+		GM::Vector2 Max((entry.Rect.X + m_Padding + entry.Width) / AtlasWidth, (entry.Rect.Y + m_Padding + entry.Height) / AtlasHeight);
+		entry.SubTexture->Set(m_Texture, Min, Max);
+
+		// Regions are mapped from the texture coords of the image to the ones of the atlas
+		const GM::Vector2 Extent = Max - Min;
+		for (const Region& region : entry.Regions)
+		{
+			region.SubTexture->Set(m_Texture, Min + region.Min * Extent, Min + region.Max * Extent);
+		}
+	}
+}
\ No newline at end of file
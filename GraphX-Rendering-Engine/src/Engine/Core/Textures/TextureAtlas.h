@@ -0,0 +1,132 @@
+#pragma once
+
+#include "AtlasPacker.h"
+
+namespace GraphX
+{
+	class Texture2D;
+	class SubTexture2D;
+
+	/**
+	* Texture built at runtime by packing multiple small images together
+	* Images are composed on the CPU and uploaded only when the atlas is committed.
+	* Subtextures returned by the atlas stay valid when the atlas is repacked or resized.
+	* NOTE: Not thread safe, the renderer uses its atlas only on the render thread
+	*/
+	class TextureAtlas
+	{
+	public:
+		/**
+		* @param InitialSize Width and height of the atlas at the start
+		* @param MaxSize Max width and height the atlas can grow up to
+		* @param Padding Pixels around each image filled by extruding the image edges (prevents bleeding while filtering)
+		*/
+		TextureAtlas(uint32_t InitialSize = 512, uint32_t MaxSize = 4096, uint32_t Padding = 2);
+
+		/**
+		* Adds an image to the atlas
+		* @param Pixels Image data with 3 (RGB) or 4 (RGBA) channels per pixel
+		* @return Subtexture for the image or nullptr if the image does not fit in the atlas
+		*/
+		Ref<SubTexture2D> Add(const uint8_t* Pixels, uint32_t Width, uint32_t Height, uint32_t Channels);
+
+		/**
+		* Adds the image of a texture loaded from a file to the atlas (Same file is added only once)
+		* Pixels are read back from the texture, so the file is not decoded again (Only on the render thread, the texture needs to be resident)
+		*/
+		Ref<SubTexture2D> Add(const Texture2D& Texture);
+
+		/**
+		* Returns a subtexture for a part of an image in the atlas (eg. a sprite of a sprite sheet), kept in place with the image when the atlas is repacked
+		* @param Image Subtexture returned by Add()
+		* @param Min, Max Texture coords of the part within the image
+		*/
+		Ref<SubTexture2D> AddRegion(const Ref<SubTexture2D>& Image, const GM::Vector2& Min, const GM::Vector2& Max);
+
+		/* Uploads the atlas to the GPU, needs to be called before the subtextures are rendered */
+		void Commit();
+
+		/* Returns the texture of the atlas (nullptr until committed) */
+		inline const Ref<Texture2D>& GetTexture() const { return m_Texture; }
+
+		/* Returns the current width of the atlas */
+		inline uint32_t GetWidth() const { return m_Packer.GetWidth(); }
+
+		/* Returns the current height of the atlas */
+		inline uint32_t GetHeight() const { return m_Packer.GetHeight(); }
+
+		/* Returns the RGBA8 pixels of the atlas */
+		inline const std::vector<uint8_t>& GetPixels() const { return m_Pixels; }
+
+		/* Returns the number of images in the atlas */
+		inline uint32_t GetImageCount() const { return (uint32_t)m_Entries.size(); }
+
+		/* Returns whether the atlas has changes which are not uploaded to the GPU */
+		inline bool IsDirty() const { return m_Dirty; }
+
+		/* Returns the ratio of the area used by the images (including padding) to the total area of the atlas */
+		inline float GetOccupancy() const { return m_Packer.GetOccupancy(); }
+
+	private:
+		/* Part of an image handed out as a separate subtexture */
+		struct Region
+		{
+			Ref<SubTexture2D> SubTexture;
+
+			/* Texture coords within the image */
+			GM::Vector2 Min, Max;
+		};
+
+		/* Image added to the atlas */
+		struct Entry
+		{
+			/* RGBA8 pixels of the image (Kept to repack the atlas) */
+			std::vector<uint8_t> Pixels;
+
+			uint32_t Width, Height;
+
+			/* Region allocated in the atlas (including padding) */
+			AtlasPacker::Rect Rect;
+
+			/* Subtexture handed out for the image */
+			Ref<SubTexture2D> SubTexture;
+
+			/* Subtextures handed out for the parts of the image */
+			std::vector<Region> Regions;
+		};
+
+		/* Repacks all the entries, growing the atlas if required */
+		bool Repack();
+
+		/* Copies the entry into the atlas along with the extruded edges */
+		void Blit(const Entry& entry);
+
+		/* Updates the texture coords of the subtexture (and the regions) of the entry */
+		void UpdateSubTexture(const Entry& entry);
+
+	private:
+		/* Packer used to allocate the regions */
+		AtlasPacker m_Packer;
+
+		/* Max width and height of the atlas */
+		uint32_t m_MaxSize;
+
+		/* Padding around each image */
+		uint32_t m_Padding;
+
+		/* All the images in the atlas */
+		std::vector<Entry> m_Entries;
+
+		/* Index of the entries added using file paths */
+		std::unordered_map<std::string, uint32_t> m_FileEntries;
+
+		/* RGBA8 pixels of the atlas */
+		std::vector<uint8_t> m_Pixels;
+
+		/* Texture of the atlas on the GPU */
+		Ref<Texture2D> m_Texture;
+
+		/* Whether the pixels have changed since the last commit */
+		bool m_Dirty = false;
+	};
+}
\ No newline at end of file
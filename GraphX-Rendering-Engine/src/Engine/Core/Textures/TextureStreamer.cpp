@@ -0,0 +1,237 @@
+#include "pch.h"
+#include "TextureStreamer.h"
+#include "GL/glew.h"
+#include "Device/RenderDevice.h"
+
+#include "Texture2D.h"
+#include "Subsystems/Multithreading/Multithreading.h"
+#include "Subsystems/Multithreading/Async/AsyncTask.h"
+
+#include <cstring>
+#include <future>
+#include <mutex>
+
+namespace GraphX
+{
+	struct TextureStreamRequest
+	{
+		Texture2D* Texture = nullptr;
+
+		/* Sampling settings at the time of the request */
+		TextureSamplingSettings Sampling;
+
+		/* Decoded file (Waited on without blocking, until it is ready) */
+		std::future<Ref<TextureFileData>> DecodeResult;
+		Ref<TextureFileData> Data;
+
+		/* Next level to be uploaded (Counts down to the full resolution level) */
+		uint32_t NextLevel = 0;
+	};
+
+	struct TextureStreamerData
+	{
+		/* Pixel unpack buffer the levels are staged in */
+		uint32_t StagingBuffer = 0;
+
+		/* Requests in the order they were made (Textures can be requested from the worker threads, e.g. while importing meshes) */
+		std::deque<TextureStreamRequest> Requests;
+		std::mutex RequestsMutex;
+
+		uint64_t UploadedBytes = 0;
+	};
+
+	TextureStreamerData* TextureStreamer::s_Data = nullptr;
+
+	void TextureStreamer::Init()
+	{
+		GX_PROFILE_FUNCTION()
+
+		GX_ENGINE_ASSERT(!s_Data, "Texture streamer is already initialised");
+		s_Data = new TextureStreamerData();
+
+		RenderDevice::Get().GenBuffers(1, &s_Data->StagingBuffer);
+	}
+
+	void TextureStreamer::Shutdown()
+	{
+		GX_PROFILE_FUNCTION()
+
+		if (!s_Data)
+			return;
+
+		// Decoding tasks have to finish before the thread pool is shut down
+		for (TextureStreamRequest& Request : s_Data->Requests)
+		{
+			if (Request.DecodeResult.valid())
+				Request.DecodeResult.wait();
+		}
+
+		RenderDevice::Get().DeleteBuffers(1, &s_Data->StagingBuffer);
+
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	bool TextureStreamer::IsRunning()
+	{
+		return s_Data != nullptr;
+	}
+
+	void TextureStreamer::Request(Texture2D& Texture)
+	{
+		GX_PROFILE_FUNCTION()
+
+		GX_ENGINE_ASSERT(s_Data, "Texture streamer is not initialised");
+
+		TextureStreamRequest Request;
+		Request.Texture = &Texture;
+		Request.Sampling = Texture2D::GetSamplingSettings();
+
+		// Each level is sampled as soon as it is uploaded, so the mips have to be there before the full resolution level
+		if (Request.Sampling.Mipmaps == MipmapMode::GPU)
+			Request.Sampling.Mipmaps = MipmapMode::CPUBox;
+
+		const std::string FilePath = Texture.GetFilePath();
+		const bool TileTexture = Texture.m_TileTexture;
+		const TextureSamplingSettings Sampling = Request.Sampling;
+		Request.DecodeResult = Async<Ref<TextureFileData>>(AsyncExecutionPolicy::ThreadPool, [FilePath, TileTexture, Sampling]() {
+			Ref<TextureFileData> Data = CreateRef<TextureFileData>();
+			return Texture2D::DecodeFile(FilePath, TileTexture, Sampling, *Data) ? Data : nullptr;
+		});
+
+		std::lock_guard<std::mutex> Lock(s_Data->RequestsMutex);
+		s_Data->Requests.push_back(std::move(Request));
+	}
+
+	void TextureStreamer::Cancel(const Texture2D& Texture)
+	{
+		GX_PROFILE_FUNCTION()
+
+		if (!s_Data)
+			return;
+
+		std::lock_guard<std::mutex> Lock(s_Data->RequestsMutex);
+
+		// Decoding task keeps running, its result is just discarded
+		for (auto Itr = s_Data->Requests.begin(); Itr != s_Data->Requests.end(); ++Itr)
+		{
+			if (Itr->Texture == &Texture)
+			{
+				s_Data->Requests.erase(Itr);
+				return;
+			}
+		}
+	}
+
+	void TextureStreamer::Update()
+	{
+		GX_PROFILE_FUNCTION()
+
+		if (!s_Data)
+			return;
+
+		std::lock_guard<std::mutex> Lock(s_Data->RequestsMutex);
+
+		// Textures requested from the worker threads have no texture object yet
+		for (TextureStreamRequest& Request : s_Data->Requests)
+		{
+			if (Request.Texture->m_RendererID == 0)
+				Request.Texture->CreatePlaceholder();
+		}
+
+		// At least a level is uploaded each frame, so the levels larger than the budget still make progress
+		uint32_t UploadedBytes = 0;
+		while (UploadedBytes < EngineConstants::TextureStreamingBudget)
+		{
+			const uint32_t LevelSize = UploadNextLevel();
+			if (LevelSize == 0)
+				break;
+
+			UploadedBytes += LevelSize;
+		}
+	}
+
+	uint32_t TextureStreamer::UploadNextLevel()
+	{
+		GX_PROFILE_FUNCTION()
+
+		// Only the decoded files are uploaded (The ones still decoding are skipped, instead of waiting on them)
+		auto Itr = s_Data->Requests.begin();
+		while (Itr != s_Data->Requests.end())
+		{
+			if (Itr->Data)
+				break;
+
+			if (Itr->DecodeResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			{
+				++Itr;
+				continue;
+			}
+
+			Itr->Data = Itr->DecodeResult.get();
+			if (!Itr->Data)
+			{
+				// Texture keeps sampling the placeholder
+				Itr = s_Data->Requests.erase(Itr);
+				continue;
+			}
+
+			Itr->NextLevel = (uint32_t)Itr->Data->Levels.size() - 1;
+			break;
+		}
+
+		if (Itr == s_Data->Requests.end())
+			return 0;
+
+		TextureStreamRequest& Request = *Itr;
+		const MipLevel& Level = Request.Data->Levels[Request.NextLevel];
+		const uint32_t LevelSize = (uint32_t)Level.Pixels.size();
+
+		RenderDevice& Device = RenderDevice::Get();
+		Device.BindBuffer(GL_PIXEL_UNPACK_BUFFER, s_Data->StagingBuffer);
+
+		// Orphaning the storage lets the driver hand out a new block, instead of waiting for the previous upload to finish reading it
+		Device.BufferData(GL_PIXEL_UNPACK_BUFFER, LevelSize, nullptr, GL_STREAM_DRAW);
+
+		void* MappedData = Device.MapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, LevelSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+		if (MappedData)
+		{
+			std::memcpy(MappedData, Level.Pixels.data(), LevelSize);
+			Device.UnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+			// Pixels are read from the bound unpack buffer (at offset 0), so the copy to the texture does not block the CPU
+			Request.Texture->UploadStreamedLevel(*Request.Data, Request.NextLevel, nullptr, Request.Sampling.MaxAnisotropy);
+		}
+		else
+		{
+			GX_ENGINE_WARN("TextureStreamer: Failed to map the staging buffer, uploading {0} directly", Request.Texture->GetFilePath());
+
+			Device.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+			Request.Texture->UploadStreamedLevel(*Request.Data, Request.NextLevel, Level.Pixels.data(), Request.Sampling.MaxAnisotropy);
+		}
+
+		Device.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		s_Data->UploadedBytes += LevelSize;
+
+		if (Request.NextLevel == 0)
+			s_Data->Requests.erase(Itr);
+		else
+			Request.NextLevel--;
+
+		return LevelSize;
+	}
+
+	uint32_t TextureStreamer::GetPendingCount()
+	{
+		if (!s_Data)
+			return 0;
+
+		std::lock_guard<std::mutex> Lock(s_Data->RequestsMutex);
+		return (uint32_t)s_Data->Requests.size();
+	}
+
+	uint64_t TextureStreamer::GetUploadedBytes()
+	{
+		return s_Data ? s_Data->UploadedBytes : 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+
+namespace GraphX
+{
+	class Texture2D;
+	struct TextureStreamerData;
+
+	/*
+	* Loads the streamed textures without stalling the frame
+	* Files are decoded (along with their mip chain) on the thread pool, and the levels are uploaded through a pixel unpack buffer over the next frames, smallest level first
+	* Requests can be made from any thread, but they are updated on the main thread (the one with the graphics context)
+	*/
+	class TextureStreamer
+	{
+	public:
+		/* Creates the staging buffer used for the uploads */
+		static void Init();
+		static void Shutdown();
+
+		/* Whether the textures can be streamed (Streamer is initialised along with the renderer) */
+		static bool IsRunning();
+
+		/**
+		* Queues the file of the texture for decoding (The texture samples its placeholder until the first level is uploaded)
+		* Placeholders of the textures requested off the render thread are created on the next update
+		*/
+		static void Request(Texture2D& Texture);
+
+		/* Drops the pending request of the texture (Called when a texture is destroyed before it is resident) */
+		static void Cancel(const Texture2D& Texture);
+
+		/* Creates the pending placeholders and uploads the decoded levels, until the upload budget of the frame runs out */
+		static void Update();
+
+		/* Number of the textures not yet fully uploaded */
+		static uint32_t GetPendingCount();
+
+		/* Total bytes uploaded through the staging buffer */
+		static uint64_t GetUploadedBytes();
+
+	private:
+		/* Uploads a level of the request at the front of the queue through the staging buffer. Returns the number of bytes uploaded */
+		static uint32_t UploadNextLevel();
+
+	private:
+		static TextureStreamerData* s_Data;
+	};
+}
\ No newline at end of file
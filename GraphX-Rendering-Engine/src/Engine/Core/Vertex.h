@@ -2,6 +2,7 @@
 
 #include "GraphX_Vectors.h"
 #include "Buffers/VertexBufferLayout.h"
+#include "PackedTypes.h"
 
 namespace GraphX
 {
@@ -103,22 +104,29 @@ namespace GraphX
 		// Position of the vertex
 		GM::Vector3 Position;
 
-		// Color of the vertex
-		GM::Vector4 Color;
+		// Color of the vertex (RGBA8)
+		uint32_t Color = 0xffffffff;
 		
-		// Texture coordinates of the vertex
-		GM::Vector2 TexCoords;
+		// Texture coordinates of the vertex (Half floats to support tiling)
+		HalfVector2 TexCoords;
 		
 		// Texture slot used for this vertex
-		float TexIndex = 0.0f;
+		uint8_t TexIndex = 0;
+
+		// Keeps the layer 2 byte aligned
+		uint8_t Padding = 0;
+
+		// Layer of the texture array used for this vertex (Only when batching with texture arrays)
+		uint16_t TexLayer = 0;
 
 		static const VertexBufferLayout& VertexLayout()
 		{
 			static VertexBufferLayout Layout = {
-				{ BufferDataType::Float3 },	// For Position
-				{ BufferDataType::Float4 },	// For Color
-				{ BufferDataType::Float2 },	// For TexCoords
-				{ BufferDataType::Float }	// For TexIndex 
+				{ BufferDataType::Float3 },			// For Position
+				{ BufferDataType::UByte4, true },	// For Color
+				{ BufferDataType::Half2 },			// For TexCoords
+				{ BufferDataType::UByte2 },			// For TexIndex (Second component is padding)
+				{ BufferDataType::UShort }			// For TexLayer
 			};
 
 			return Layout;
@@ -131,34 +139,79 @@ namespace GraphX
 		// Position of the vertex
 		GM::Vector3 Position;
 
-		// Color of the vertex
-		GM::Vector4 Color;
+		// Color of the vertex (RGBA8)
+		uint32_t Color = 0xffffffff;
 
 		// Texture coordinates of the vertex
-		GM::Vector2 TexCoords1;
+		HalfVector2 TexCoords1;
 
 		// Texture offsets for the particle(In case the particle uses a texture atlas)
-		GM::Vector2 TexCoords2;
+		HalfVector2 TexCoords2;
+
+		// Blend factor for blending b/w two stages of the atlas (16-bit normalised)
+		uint16_t BlendFactor = 0;
+
+		// Texture slot used for this vertex
+		uint8_t TexIndex = 0;
 
 		// No. of rows in the texture atlas
-		float TexAtlasRows = 1.0f;
+		uint8_t TexAtlasRows = 1;
 
-		// Blend factor for blending b/w two stages of the atlas
-		float BlendFactor = 0.0f;
+		// Layer of the texture array used for this vertex (Only when batching with texture arrays)
+		uint16_t TexLayer = 0;
 
-		// Texture slot used for this vertex
-		float TexIndex = 0.0f;
+		// Keeps the vertex 4 byte aligned
+		uint16_t Padding = 0;
+
+		static const VertexBufferLayout& VertexLayout()
+		{
+			static VertexBufferLayout Layout = {
+				{ BufferDataType::Float3 },			// For Position
+				{ BufferDataType::UByte4, true },	// For Color
+				{ BufferDataType::Half2 },			// For TexCoords1
+				{ BufferDataType::Half2 },			// For TexCoords2 
+				{ BufferDataType::UShort, true },	// For BlendFactor 
+				{ BufferDataType::UByte2 },			// For TexIndex and TexAtlasRows
+				{ BufferDataType::UShort2 },		// For TexLayer (Second component is padding)
+			};
+
+			return Layout;
+		}
+	};
+
+	/* Structure to represent a quad of 'InstancedBatch2D' (Corners are generated in the vertex shader) */
+	struct QuadInstance2D
+	{
+		// Position of the quad center
+		GM::Vector3 Position;
+
+		// Size of the quad
+		GM::Vector2 Size;
+
+		// Rotation of the quad in degrees (xyz) and the texture tiling factor (w)
+		uint16_t RotationAndTiling[4] = { 0, 0, 0, 0 };
+
+		// Color of the quad (RGBA8)
+		uint32_t Color = 0xffffffff;
+
+		// Texture coords of the lower left and upper right corner (16-bit normalised)
+		uint16_t TexRect[4] = { 0, 0, 0xffff, 0xffff };
+
+		// Texture slot used for this quad
+		uint16_t TexIndex = 0;
+
+		// Layer of the texture array in the slot used for this quad (Only when batching with texture arrays)
+		uint16_t TexLayer = 0;
 
 		static const VertexBufferLayout& VertexLayout()
 		{
 			static VertexBufferLayout Layout = {
-				{ BufferDataType::Float3 },	// For Position
-				{ BufferDataType::Float4 },	// For Color
-				{ BufferDataType::Float2 },	// For TexCoords1
-				{ BufferDataType::Float2 },	// For TexCoords2 
-				{ BufferDataType::Float },	// For TexAtlasRows 
-				{ BufferDataType::Float },	// For BlendFactor 
-				{ BufferDataType::Float },	// For TexIndex
+				{ BufferDataType::Float3 },			// For Position
+				{ BufferDataType::Float2 },			// For Size
+				{ BufferDataType::Half4 },			// For Rotation and Tiling
+				{ BufferDataType::UByte4, true },	// For Color
+				{ BufferDataType::UShort4, true },	// For TexRect
+				{ BufferDataType::UShort2 }			// For TexIndex and TexLayer
 			};
 
 			return Layout;
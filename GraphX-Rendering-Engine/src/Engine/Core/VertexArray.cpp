@@ -1,6 +1,7 @@
 #include "pch.h"
 #include "VertexArray.h"
 #include "GL/glew.h"
+#include "Device/RenderDevice.h"
 
 #include "Buffers/VertexBuffer.h"
 #include "Buffers/VertexBufferLayout.h"
@@ -24,6 +25,13 @@ namespace GraphX
 			case BufferDataType::Int4:		return GL_INT;
 			case BufferDataType::UInt:		return GL_UNSIGNED_INT;
 			case BufferDataType::Bool:		return GL_BOOL;
+			case BufferDataType::Half2:		return GL_HALF_FLOAT;
+			case BufferDataType::Half4:		return GL_HALF_FLOAT;
+			case BufferDataType::UByte2:	return GL_UNSIGNED_BYTE;
+			case BufferDataType::UByte4:	return GL_UNSIGNED_BYTE;
+			case BufferDataType::UShort:	return GL_UNSIGNED_SHORT;
+			case BufferDataType::UShort2:	return GL_UNSIGNED_SHORT;
+			case BufferDataType::UShort4:	return GL_UNSIGNED_SHORT;
 		}
 
 		GX_ENGINE_ASSERT(false, "Unknown Buffer Data Type");
@@ -35,60 +43,74 @@ namespace GraphX
 	{
 		GX_PROFILE_FUNCTION()
 
-		glGenVertexArrays(1, &m_RendererID);
+		RenderDevice::Get().GenVertexArrays(1, &m_RendererID);
 	}
 
-	void VertexArray::AddVertexBuffer(const VertexBuffer& vbo, const VertexBufferLayout& layout)
+	void VertexArray::AddVertexBuffer(const VertexBuffer& vbo, const VertexBufferLayout& layout, bool PerInstance)
 	{
 		GX_PROFILE_FUNCTION()
 
 		// Bind both the vertex array and the buffer before specifying the layout
-		glBindVertexArray(m_RendererID);
+		RenderDevice::Get().BindVertexArray(m_RendererID);
 		vbo.Bind();
 			
 		const auto& elements = layout.GetElements();
 
-		for (unsigned int i = 0; i < elements.size(); i++)
+		for (const auto& element : elements)
 		{
+			// Attributes of this buffer follow the attributes of the previously added buffers
+			uint32_t i = m_VertexAttribIndex++;
+
 			//Enable the current vertex attribute array
-			glEnableVertexAttribArray(i);
+			RenderDevice::Get().EnableVertexAttribArray(i);
 
 			//specify the layout
-			const auto& element = elements[i];
-			glVertexAttribPointer(i, element.GetComponentCount(), BufferDataTypeToOpenGLType(element.Type), element.Normalised, layout.GetStride(), (const void*)element.Offset);
+			if (element.IsInteger())
+			{
+				// Integer attributes need to be specified with IPointer, otherwise they are converted to floats
+				RenderDevice::Get().VertexAttribIPointer(i, element.GetComponentCount(), BufferDataTypeToOpenGLType(element.Type), layout.GetStride(), (const void*)element.Offset);
+			}
+			else
+			{
+				RenderDevice::Get().VertexAttribPointer(i, element.GetComponentCount(), BufferDataTypeToOpenGLType(element.Type), element.Normalised, layout.GetStride(), (const void*)element.Offset);
+			}
+
+			// Advance the attribute once per instance instead of once per vertex
+			if (PerInstance)
+				RenderDevice::Get().VertexAttribDivisor(i, 1);
 		}
 
 		// Unbind the vertex array
-		glBindVertexArray(0);
+		RenderDevice::Get().BindVertexArray(0);
 	}
 
 	void VertexArray::AddIndexBuffer(const IndexBuffer& IBO)
 	{
 		GX_PROFILE_FUNCTION()
 
-		glBindVertexArray(m_RendererID);
+		RenderDevice::Get().BindVertexArray(m_RendererID);
 		IBO.Bind();
-		glBindVertexArray(0);
+		RenderDevice::Get().BindVertexArray(0);
 	}
 
 	void VertexArray::Bind() const
 	{
 		GX_PROFILE_FUNCTION()
 
-		glBindVertexArray(m_RendererID);
+		RenderDevice::Get().BindVertexArray(m_RendererID);
 	}
 
 	void VertexArray::UnBind() const
 	{
 		GX_PROFILE_FUNCTION()
 
-		glBindVertexArray(0);
+		RenderDevice::Get().BindVertexArray(0);
 	}
 
 	VertexArray::~VertexArray()
 	{
 		GX_PROFILE_FUNCTION()
 
-		glDeleteVertexArrays(1, &m_RendererID);
+		RenderDevice::Get().DeleteVertexArrays(1, &m_RendererID);
 	}
 }
\ No newline at end of file
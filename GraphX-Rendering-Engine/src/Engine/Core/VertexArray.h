@@ -16,8 +16,11 @@ namespace GraphX
 
 		~VertexArray();
 
-		/* Add new buffer to the vao object to be bound */
-		void AddVertexBuffer(const VertexBuffer& vbo, const VertexBufferLayout& layout);
+		/**
+		* Add new buffer to the vao object to be bound
+		* @Param PerInstance - Attributes of the buffer are advanced once per instance (for instanced rendering)
+		*/
+		void AddVertexBuffer(const VertexBuffer& vbo, const VertexBufferLayout& layout, bool PerInstance = false);
 
 		void AddIndexBuffer(const IndexBuffer& ibo);
 
@@ -26,5 +29,9 @@ namespace GraphX
 
 		/* UnBind the vao */
 		void UnBind() const;
+
+	private:
+		/* Index of the next vertex attribute (Allows multiple buffers to be added to the vao) */
+		uint32_t m_VertexAttribIndex = 0;
 	};
 }
\ No newline at end of file
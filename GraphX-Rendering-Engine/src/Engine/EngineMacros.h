@@ -1,6 +1,12 @@
 #pragma once
 
-#define GX_ENGINE_ASSERT(x, ...) { if(!(x)) { GX_ENGINE_CRITICAL("[Assertion Failed] {0}", #__VA_ARGS__); __debugbreak(); } }
+#ifdef _MSC_VER
+#define GX_DEBUG_BREAK() __debugbreak()
+#else
+#define GX_DEBUG_BREAK() __builtin_trap()
+#endif
+
+#define GX_ENGINE_ASSERT(x, ...) { if(!(x)) { GX_ENGINE_CRITICAL("[Assertion Failed] {0}", #__VA_ARGS__); GX_DEBUG_BREAK(); } }
 
 // Macro to bind the class event functions
 #define BIND_EVENT_FUNC(x) std::bind(&x, this, std::placeholders::_1)
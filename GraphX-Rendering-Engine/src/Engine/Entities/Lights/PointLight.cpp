@@ -32,6 +32,23 @@ namespace GraphX
 		Light::Disable();
 	}
 
+	float PointLight::GetRange() const
+	{
+		// Solve for the distance at which, Constant + Linear * d + Quadratic * d^2 = 256
+		const float Threshold = 256.0f;
+		float Range = EngineConstants::MaxPointLightRange;
+
+		if (m_AttenuationFactors.z > 0.0f)
+		{
+			float Discriminant = m_AttenuationFactors.y * m_AttenuationFactors.y - 4.0f * m_AttenuationFactors.z * (m_AttenuationFactors.x - Threshold);
+			Range = (-m_AttenuationFactors.y + std::sqrt(Discriminant)) / (2.0f * m_AttenuationFactors.z);
+		}
+		else if (m_AttenuationFactors.y > 0.0f)
+			Range = (Threshold - m_AttenuationFactors.x) / m_AttenuationFactors.y;
+
+		return std::min(Range, EngineConstants::MaxPointLightRange);
+	}
+
 	PointLight::~PointLight()
 	{
 	}
@@ -27,6 +27,9 @@ namespace GraphX
 			m_AttenuationFactors.x = 1.0f;
 		}
 
+		/* Returns the distance at which the light attenuates to a negligible (1/256) amount */
+		float GetRange() const;
+
 		/* Destructor */
 		virtual ~PointLight();
 
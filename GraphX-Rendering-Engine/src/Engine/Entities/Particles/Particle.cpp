@@ -28,6 +28,7 @@ namespace GraphX
 		m_Props.ColorBegin = props.ColorBegin;
 		m_Props.ColorEnd = props.ColorEnd;
 		m_Props.Position = props.Position;
+		m_PreviousPosition = props.Position;
 		m_Props.Velocity = props.Velocity;
 		m_Props.LifeSpan = props.LifeSpan;
 		m_Props.Rotation = props.Rotation;
@@ -54,6 +55,7 @@ namespace GraphX
 			float scale = GM::Utility::Lerp(m_Props.SizeBegin, m_Props.SizeEnd, m_ElapsedTime / m_Props.LifeSpan);
 			m_Props.Velocity.z += EngineConstants::GravityValue * m_Props.GravityEffect * DeltaTime;
 
+			m_PreviousPosition = m_Props.Position;
 			m_Props.Position += m_Props.Velocity * 0.1f;
 
 			if (m_Props.Texture && m_Props.Texture->IsSpriteSheet())
@@ -79,10 +81,10 @@ namespace GraphX
 			{
 				shader.SetUniform1f("u_BlendFactor", m_BlendFactor);
 
-				// Calculate the texture offsets
+				// Calculate the texture offsets (Sprite sheet itself is bound, not the sprite atlas)
 				SpriteSheet* spriteSheet = static_cast<SpriteSheet*>(m_Props.Texture.get());
-				const GM::Vector2* TexCoords1 = spriteSheet->GetSprite(m_Index1)->GetTexCoords();
-				const GM::Vector2* TexCoords2 = spriteSheet->GetSprite(m_Index2)->GetTexCoords();
+				const GM::Vector2* TexCoords1 = spriteSheet->GetSheetSprite(m_Index1)->GetTexCoords();
+				const GM::Vector2* TexCoords2 = spriteSheet->GetSheetSprite(m_Index2)->GetTexCoords();
 
 				GM::Vector4 TexOffsets(TexCoords1[0].x, TexCoords1[0].y, TexCoords2[0].x, TexCoords2[0].y);
 				shader.SetUniform4f("u_TexCoordOffsets", TexOffsets);
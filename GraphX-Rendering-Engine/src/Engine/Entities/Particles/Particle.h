@@ -54,6 +54,9 @@ namespace GraphX
 
 		inline float GetLifeProgress() const { return m_ElapsedTime / m_Props.LifeSpan; }
 
+		/* Returns the position blended between the last two simulation ticks (Alpha 0 - 1) */
+		inline GM::Vector3 GetInterpolatedPosition(float Alpha) const { return GM::Utility::Lerp(m_PreviousPosition, m_Props.Position, Alpha); }
+
 		/* Whether the particles is being used or not */
 		inline bool IsActive() const { return m_Active; }
 
@@ -73,6 +76,9 @@ namespace GraphX
 		/* Time elapsed since the creation of the particle */
 		float m_ElapsedTime = 0.0f;
 
+		/* Position before the last update */
+		GM::Vector3 m_PreviousPosition;
+
 		/* Model matrix for the particle */
 		GM::Matrix4 m_Model;
 
@@ -65,13 +65,13 @@ namespace GraphX
 		}
 	}
 
-	void ParticleManager::RenderParticles()
+	void ParticleManager::RenderParticles(float InterpolationAlpha)
 	{
 		GX_PROFILE_FUNCTION()
 
 		GX_ENGINE_ASSERT(s_Data != nullptr, "Particle Manager is not Initialised");
 
-		Renderer2D::RenderParticles(s_Data->ParticleSystems);
+		Renderer2D::RenderParticles(s_Data->ParticleSystems, InterpolationAlpha);
 	}
 
 	bool ParticleManager::Exists(const std::string& name)
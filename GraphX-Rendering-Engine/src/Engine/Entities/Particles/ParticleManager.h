@@ -15,8 +15,8 @@ namespace GraphX
 		/* Shutdown the particle manager */
 		static void Shutdown();
 
-		/* Renders the particles on the screen */
-		static void RenderParticles();
+		/* Renders the particles on the screen (positions are blended between the last two simulation ticks by the interpolation alpha) */
+		static void RenderParticles(float InterpolationAlpha = 1.0f);
 
 		/* Updates all the particles */
 		static void Update(float DeltaTime);
@@ -40,7 +40,7 @@ namespace GraphX
 			std::unordered_map<std::string, Ref<ParticleSystem>> ParticleSystems;
 
 			/* Main Camera of the engine */
-			Ref<const Camera> Camera;
+			Ref<const GraphX::Camera> Camera;
 		};
 
 		/* Particle Manager Data */
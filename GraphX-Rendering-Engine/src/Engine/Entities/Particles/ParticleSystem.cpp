@@ -4,6 +4,8 @@
 #include "ParticleManager.h"
 #include "Utilities/EngineUtil.h"
 #include "Textures/Texture2D.h"
+#include "Textures/SubTexture2D.h"
+#include "Engine/Core/Renderer/Renderer2D.h"
 
 namespace GraphX
 {
@@ -11,6 +13,22 @@ namespace GraphX
 		: Position(Pos), m_Name(name), m_Config(Config), m_Index(0)
 	{
 		m_Particles.resize(m_Config.PoolCap);
+
+		UpdateAtlasImage();
+	}
+
+	void ParticleSystem::SetParticleProperties(const ParticleProps& props)
+	{
+		m_Config.ParticleProperties = props;
+
+		UpdateAtlasImage();
+	}
+
+	void ParticleSystem::UpdateAtlasImage()
+	{
+		const Ref<Texture2D>& Texture = m_Config.ParticleProperties.Texture;
+
+		m_AtlasImage = Texture && !Texture->IsSpriteSheet() ? Renderer2D::PackInSpriteAtlas(*Texture) : nullptr;
 	}
 
 	void ParticleSystem::Update(float DeltaTime, const GM::Matrix4& ViewMatrix)
@@ -6,6 +6,7 @@ namespace GraphX
 {
 	class ParticleManager;
 	class Texture2D;
+	class SubTexture2D;
 
 	struct ParticleSystemConfig
 	{
@@ -29,7 +30,7 @@ namespace GraphX
 		/* Spawn Particles at the specified location */
 		void SpawnParticles(float DeltaTime);
 
-		void SetParticleProperties(const ParticleProps& props) { m_Config.ParticleProperties = props; }
+		void SetParticleProperties(const ParticleProps& props);
 
 		void SetParticlePerSec(const unsigned int ParticlesPerSec) { m_Config.ParticlesPerSec = ParticlesPerSec; }
 
@@ -38,6 +39,9 @@ namespace GraphX
 		/* Returns the current configuration for the particle system */
 		inline const ParticleSystemConfig& GetConfig() const { return m_Config; }
 
+		/* Returns the texture of the particles in the sprite atlas (nullptr if the texture is not packed in to it, or is a sprite sheet) */
+		inline const Ref<SubTexture2D>& GetAtlasImage() const { return m_AtlasImage; }
+
 		inline bool IsActive() const { return m_Active; }
 
 		inline void SetActive(bool active) { m_Active = active; }
@@ -66,6 +70,9 @@ namespace GraphX
 		/* Generates a random value using the average value and the offset deviation factor */
 		float GenerateRandomValue(float AverageValue, float Variation);
 
+		/* Packs the texture of the particles in to the sprite atlas (Sprite sheets pack their own sprites) */
+		void UpdateAtlasImage();
+
 	public:
 		GM::Vector3 Position;
 
@@ -79,6 +86,9 @@ namespace GraphX
 		/* Particles pool */
 		std::vector<Particle> m_Particles;
 
+		/* Texture of the particles in the sprite atlas */
+		Ref<SubTexture2D> m_AtlasImage;
+
 		/* Current Index in the pool which is supposed to be un-used */
 		unsigned int m_Index;
 
@@ -21,7 +21,7 @@ namespace GraphX
 		*	Creates a skybox
 		* @param ShaderFilePath Path to the file containing the shader code for the skybox
 		* @param FilePath Path to the folder containing the textures to be used to draw the skybox
-		* @param FileNames names of the files to be used as textures for the six faces of the skybox. Order of the names should be right, left, top, bottom, front, back faces
+		* @param FileNames names of the files to be used as textures for the six faces of the skybox. Order of the names should be right, left, top, bottom, front, back faces (or a single DDS / KTX2 cube map file)
 		*/
 		Skybox(const std::string& FilePath, const std::vector<std::string>& FileNames, const GM::Vector4& color, float factor = 0.0f, float Speed = 1.0f);
 
@@ -2,17 +2,21 @@
 #include "Terrain.h"
 
 #include "Utilities/EngineUtil.h"
+#include "Utilities/MeshOptimizer.h"
 #include "Model/Mesh/Mesh3D.h"
 
 #include "Engine/Core/Vertex.h"
 #include "Shaders/Shader.h"
 #include "Materials/Material.h"
 #include "Textures/Texture2D.h"
+#include "AssetManager/AssetManager.h"
 
 #include "VertexArray.h"
 #include "Buffers/VertexBuffer.h"
 #include "Buffers/IndexBuffer.h"
 
+#include <limits>
+
 
 namespace GraphX
 {
@@ -56,37 +60,37 @@ namespace GraphX
 	double Terrain::s_Amplitude = 5.0;
 
 	Terrain::Terrain(int TilesX, int TilesY, float TileSize, const std::vector<std::string>& TexNames, const std::string& BlendMap, const Vector3& Position, const Vector2& Scale)
-		: m_Mesh(nullptr), m_Material(nullptr), m_TilesX(TilesX), m_TilesY(TilesY), m_TileSize(TileSize), m_Vertices(nullptr), m_Indices(nullptr)
+		: m_Mesh(nullptr), m_Material(nullptr), m_TilesX(TilesX), m_TilesY(TilesY), m_TileSize(TileSize), m_Vertices(nullptr), m_MeshData(nullptr)
 	{
 		GX_PROFILE_FUNCTION()
 
 		BuildTerrain();
 		Ref<Shader> shader = CreateRef<Shader>("res/Shaders/TerrainShader.glsl");
-		shader->Bind();
-		shader->SetUniform2i("u_TerrainDimensions", m_TilesX, m_TilesY);
-		shader->SetUniform1f("u_AmbientStrength", 0.01f);
 
+		// Terrain is always textured and the shader has no untextured path, so only the lighting features have variants
 		m_Material = CreateRef<Material>(shader);
+		m_Material->SetShaderFeatures(ShaderFeature::Shadows | ShaderFeature::PointLights);
 		m_Material->SetSpecularStrength(1.0f);
 		m_Material->SetShininess(256.0f);
 		
-		m_BlendMap = CreateRef<const Texture2D>(BlendMap);
+		m_BlendMap = AssetManager::LoadTexture2D(BlendMap, false, TextureLoadMode::Streamed);
 		
 		if (TexNames.size() > 0)
 		{
 			for (unsigned int i = 0; i < TexNames.size(); i++)
 			{
-				Ref<const Texture2D> tex = CreateRef<const Texture2D>(TexNames[i], true); // All terrain textures will be tiled textures
+				Ref<const Texture2D> tex = AssetManager::LoadTexture2D(TexNames[i], true, TextureLoadMode::Streamed); // All terrain textures will be tiled textures
 				m_Material->AddTexture(tex);
 			}
 		}
 		
-		if (m_Vertices && m_Indices)
+		if (m_MeshData)
 		{
-			m_Mesh = CreateRef<Mesh3D>(Position, Rotator::ZeroRotator, Vector3(Scale.x, 1.0f, Scale.y), *m_Vertices, *m_Indices, m_Material);
+			m_Mesh = CreateRef<Mesh3D>(Position, Rotator::ZeroRotator, Vector3(Scale.x, 1.0f, Scale.y), m_MeshData, m_Material);
+			m_Mesh->bIsStatic = true;
 			
 			delete m_Vertices;
-			delete m_Indices;
+			delete m_MeshData;
 		}
 		else
 		{
@@ -101,7 +105,6 @@ namespace GraphX
 		GX_PROFILE_FUNCTION()
 		
 		m_Vertices = new std::vector<Vertex3D>();
-		m_Indices = new std::vector<unsigned int>();
 		Vertex3D vertex;
 		for (int x_New = 0; x_New < m_TilesX; x_New++)
 		{
@@ -112,20 +115,6 @@ namespace GraphX
 				vertex.Position = Vector3(-x_New * m_TileSize, y_New * m_TileSize, /*(float)yCoord*/-10.0f);
 				vertex.TexCoord = Vector2((float)y_New, (float)x_New);
 				m_Vertices->emplace_back(vertex);
-
-				// Calculate the indices for the vertices of the terrain
-				if (y_New != m_TilesX - 1 && x_New != m_TilesY - 1)
-				{
-					// Lower triangle
-					m_Indices->push_back(x_New * m_TilesX + y_New);
-					m_Indices->push_back(x_New * m_TilesX + y_New + 1);
-					m_Indices->push_back(((x_New + 1) * m_TilesX) + y_New + 1);
-
-					// Upper triangle
-					m_Indices->push_back(((x_New + 1) * m_TilesX) + y_New + 1);
-					m_Indices->push_back(((x_New + 1) * m_TilesX) + y_New);
-					m_Indices->push_back(x_New * m_TilesX + y_New);
-				}
 			}
 		}
 
@@ -137,6 +126,47 @@ namespace GraphX
 			}
 		}
 
+		// Split the grid in to chunks of rows with less than 65536 vertices each, so that they are drawn with 16 bit indices
+		// (The row on the border of two chunks is in both of them, since a section only indexes its own vertices)
+		const uint32_t RowLength = (uint32_t)Utility::Max(m_TilesY, 1);
+		const uint32_t QuadRows = (uint32_t)Utility::Max(m_TilesX - 1, 0);
+		const uint32_t ChunkRows = Utility::Max<uint32_t>((std::numeric_limits<uint16_t>::max() + 1) / RowLength, 2) - 1;
+
+		m_MeshData = new RawMeshData();
+		for (uint32_t FirstRow = 0; FirstRow < QuadRows; FirstRow += ChunkRows)
+		{
+			const uint32_t NumRows = Utility::Min(ChunkRows, QuadRows - FirstRow);
+
+			RawMeshData::MeshSectionInfo Section;
+			Section.FirstVertexIndex = (uint32_t)m_MeshData->Vertices.size();
+			Section.FirstIndex = (uint32_t)m_MeshData->Indices.size();
+			m_MeshData->SectionInfos.emplace_back(Section);
+
+			m_MeshData->Vertices.insert(m_MeshData->Vertices.end(), m_Vertices->begin() + FirstRow * RowLength, m_Vertices->begin() + (FirstRow + NumRows + 1) * RowLength);
+
+			// Indices are relative to the first vertex of the chunk
+			for (uint32_t x = 0; x < NumRows; x++)
+			{
+				for (uint32_t y = 0; y + 1 < RowLength; y++)
+				{
+					const uint32_t Corner = x * RowLength + y;
+
+					// Lower triangle
+					m_MeshData->Indices.push_back(Corner);
+					m_MeshData->Indices.push_back(Corner + 1);
+					m_MeshData->Indices.push_back(Corner + RowLength + 1);
+
+					// Upper triangle
+					m_MeshData->Indices.push_back(Corner + RowLength + 1);
+					m_MeshData->Indices.push_back(Corner + RowLength);
+					m_MeshData->Indices.push_back(Corner);
+				}
+			}
+		}
+
+		// Grid is emitted row by row, reorder each chunk for the vertex cache (once the normals are calculated, since they look up the vertices by their grid position)
+		MeshOptimizer::Optimize(*m_MeshData, "Terrain");
+
 		// Reset the seed back to default
 		EngineUtil::ResetSeed();
 	}
@@ -170,16 +200,14 @@ namespace GraphX
 	}
 
 	void Terrain::Enable(class Shader& shader, const std::string& Name) const
-	{
-	}
-
-	void Terrain::Enable() const
 	{
 		GX_PROFILE_FUNCTION()
 
-		m_Material->Bind();
+		m_Material->Bind(shader);
 		m_BlendMap->Bind(4);
-		m_Material->GetShader()->SetUniform1i("u_BlendMap", 4);
+		shader.SetUniform1i("u_BlendMap", 4);
+		shader.SetUniform2i("u_TerrainDimensions", m_TilesX, m_TilesY);
+		shader.SetUniform1f("u_AmbientStrength", 0.01f);
 
 		if (m_Mesh)
 		{
@@ -187,6 +215,11 @@ namespace GraphX
 		}
 	}
 
+	void Terrain::Enable() const
+	{
+		Enable(*m_Material->GetShader());
+	}
+
 	void Terrain::Disable() const
 	{
 		GX_PROFILE_FUNCTION()
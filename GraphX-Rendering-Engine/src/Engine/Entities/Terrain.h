@@ -21,9 +21,12 @@ namespace GraphX
 		/* @Param Scale - Scale of the mesh in the x and z direction */
 		Terrain(int TilesX, int TilesY, float TileSize, const std::vector<std::string>& TexNames, const std::string& BlendMap, const GM::Vector3& Pos, const GM::Vector2& Scale);
 
-		/* Prepares the terrain for rendering */
+		/* Prepares the terrain for rendering with the shader of its material */
 		void Enable() const;
 
+		/* Prepares the terrain for rendering with the shader (a variant of the shader of its material) */
+		virtual void Enable(class Shader& shader, const std::string& Name = "") const override;
+
 		// Entity Interface ---------
 		void Update(float DeltaTime) override;
 		virtual void Disable() const override;
@@ -48,8 +51,6 @@ namespace GraphX
 	private:
 		/* Builds the terrain */
 		void BuildTerrain();
-		
-		virtual void Enable(class Shader& shader, const std::string& Name = "") const override;
 
 		/* Calculates the y - Coordinate for the vertices of the terrain mesh */
 		double GetZCoords(int x, int y);
@@ -73,8 +74,8 @@ namespace GraphX
 		/* Vertices of the terrain mesh */
 		std::vector<struct Vertex3D>* m_Vertices;
 
-		/* Indices for the terrain mesh */
-		std::vector<unsigned int>* m_Indices;
+		/* Terrain mesh, split in to chunks (sections) of less than 65536 vertices */
+		struct RawMeshData* m_MeshData;
 
 		/* Blend map used to draw the terrain */
 		Ref<const Texture2D> m_BlendMap;
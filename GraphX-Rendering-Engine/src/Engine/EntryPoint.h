@@ -2,11 +2,20 @@
 
 #include "Engine/Log.h"
 #include "Engine/Profiler/Profiler.h"
+#include "Engine/Profiler/Benchmark.h"
+#include "Engine/Utilities/SelfTest.h"
 
 extern GraphX::Application* GraphX::CreateApplication();
 
 int main(int argc, char** argv)
 {
+	// Run the checks of the engine in place of the application if requested
+	if (GraphX::SelfTest::IsRequested(argc, argv))
+		return GraphX::SelfTest::Run() ? 0 : 1;
+
+	// Run as a benchmark if requested
+	GraphX::Benchmark::ParseCommandLine(argc, argv);
+
 	GX_PROFILER_BEGIN_SESSION("Application::Initialise", "logs/Profiling/GraphX-Initialise.json")
 	GraphX::Application* app = GraphX::CreateApplication();
 	GX_PROFILER_END_SESISON()
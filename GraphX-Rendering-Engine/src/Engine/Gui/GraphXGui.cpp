@@ -19,6 +19,8 @@
 #include "Entities/Skybox.h"
 
 #include "Engine/Controllers/CameraController.h"
+#include "Engine/Profiler/GPUProfiler.h"
+#include "Timer/FixedTimestep.h"
 
 #include "Utilities/FileOpenDialog.h"
 #include "Utilities/EngineUtil.h"
@@ -53,7 +55,7 @@ namespace GraphX
 		ImGui_ImplGlfwGL3_NewFrame();
 	}
 
-	void GraphXGui::GlobalSettings(const Ref<Skybox>& skybox, float& daytime, float& SunLightIntensity, bool& EnableParticles)
+	void GraphXGui::GlobalSettings(const Ref<Skybox>& skybox, float& daytime, float& SunLightIntensity, bool& EnableParticles, bool& EnableDepthPrePass)
 	{
 		static bool ShowGlobalSettingsWindow = true;
 		if (ShowGlobalSettingsWindow)
@@ -71,6 +73,9 @@ namespace GraphX
 
 			ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.0f, 1.0f), "Enable Particle Effects");
 			ImGui::Checkbox("Enable Particle Effects", &EnableParticles);
+
+			ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.0f, 1.0f), "Enable Depth Pre Pass");
+			ImGui::Checkbox("Enable Depth Pre Pass", &EnableDepthPrePass);
 			ImGui::End();
 		}
 	}
@@ -292,6 +297,43 @@ namespace GraphX
 		}
 	}
 
+	void GraphXGui::GPUTimings()
+	{
+		static bool ShowGPUTimingsWindow = true;
+		if (ShowGPUTimingsWindow)
+		{
+			ImGui::Begin("GPU Timings", &ShowGPUTimingsWindow);
+
+			bool EnableGPUProfiler = GPUProfiler::IsEnabled();
+			if (ImGui::Checkbox("Enable GPU Profiler", &EnableGPUProfiler))
+				GPUProfiler::SetEnabled(EnableGPUProfiler);
+
+			// Nested passes are indented under their parent pass
+			for (const GPUPassTiming& Timing : GPUProfiler::GetPassTimings())
+				ImGui::Text("%*s%s: %.3f ms", 2 * Timing.Depth, "", Timing.Name, Timing.Duration);
+
+			ImGui::End();
+		}
+	}
+
+	void GraphXGui::SimulationSettings(FixedTimestep& Timestep)
+	{
+		static bool ShowSimulationWindow = true;
+		if (ShowSimulationWindow)
+		{
+			ImGui::Begin("Simulation", &ShowSimulationWindow);
+
+			float TickRate = Timestep.GetTickRate();
+			if (ImGui::SliderFloat("Tick Rate", &TickRate, 10.0f, 240.0f, "%.0f Hz"))
+				Timestep.SetTickRate(TickRate);
+
+			ImGui::Text("Ticks Simulated: %llu", (unsigned long long)Timestep.GetTickCount());
+			ImGui::Text("Time Dropped: %.3f s", Timestep.GetDroppedTime());
+
+			ImGui::End();
+		}
+	}
+
 	void GraphXGui::AddTerrain()
 	{
 		if (ImGui::Button("Add Terrain"))
@@ -21,7 +21,7 @@ namespace GraphX
 		static void Update();
 
 		/* Create a window showing Global Settings like Day Time and Skybox */
-		static void GlobalSettings(const Ref<class Skybox>& skybox, float& daytime, float& SunlightIntensity, bool& EnableParticles);
+		static void GlobalSettings(const Ref<class Skybox>& skybox, float& daytime, float& SunlightIntensity, bool& EnableParticles, bool& EnableDepthPrePass);
 
 		/* Create a window showing the details of the Mesh3D*/
 		static void DetailsWindow(const Ref<class Mesh3D>& mesh, const std::string& Name = "Details");
@@ -41,6 +41,12 @@ namespace GraphX
 		/* Create a window for loading a model from directory */
 		static void Models();
 
+		/* Shows the GPU time taken by the render passes */
+		static void GPUTimings();
+
+		/* Shows the simulation tick rate and the time dropped by the simulation */
+		static void SimulationSettings(class FixedTimestep& Timestep);
+
 		/* Create a window showing Add Terrain Button */
 		static void AddTerrain();
 
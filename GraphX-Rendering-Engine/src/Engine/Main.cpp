@@ -1,9 +1,18 @@
 #include "pch.h"
 
 #include "Application.h"
+#include "Profiler/Benchmark.h"
+#include "Utilities/SelfTest.h"
 
-int main()
+int main(int argc, char** argv)
 {
+	// Run the checks of the engine in place of the application if requested
+	if (GraphX::SelfTest::IsRequested(argc, argv))
+		return GraphX::SelfTest::Run() ? 0 : 1;
+
+	// Run as a benchmark if requested
+	GraphX::Benchmark::ParseCommandLine(argc, argv);
+
 	//Title of the application
 	const char* title = "GraphX Rendering Engine";
 	
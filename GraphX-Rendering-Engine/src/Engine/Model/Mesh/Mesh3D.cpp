@@ -2,6 +2,7 @@
 
 #include "Mesh3D.h"
 #include "VertexArray.h"
+#include "Device/RenderDevice.h"
 #include "Textures/Texture2D.h"
 #include "Vertex.h"
 #include "Buffers/VertexBuffer.h"
@@ -10,6 +11,7 @@
 #include "Materials/Material.h"
 
 #include "Utilities/Importer.h"
+#include "AssetManager/AssetManager.h"
 
 namespace GraphX
 {
@@ -69,6 +71,18 @@ namespace GraphX
 	///////////////////////////////////
 
 	Ref<Mesh3D> Mesh3D::Load(const std::string& FilePath, const Ref<Material>& InMat)
+	{
+		GX_PROFILE_FUNCTION()
+
+		Ref<const Mesh3D> SourceMesh = AssetManager::LoadMesh(FilePath, InMat);
+
+		// Instances have their own transform, but share the raw data and the materials
+		Ref<Mesh3D> ResultMesh = CreateRef<Mesh3D>(*SourceMesh);
+		ResultMesh->m_SourceMesh = SourceMesh;
+		return ResultMesh;
+	}
+
+	Ref<Mesh3D> Mesh3D::Import(const std::string& FilePath, const Ref<Material>& InMat)
 	{
 		GX_ENGINE_INFO("Loading Model {0}", FilePath);
 		GX_PROFILE_FUNCTION()
@@ -81,7 +95,7 @@ namespace GraphX
 		{
 			GX_PROFILE_SCOPE("Assimp-Load-Model")
 
-			Loaded = Importer::Get()->ImportMesh(FilePath, ResultMesh.get(), InMat);
+			Loaded = Importer::ImportMesh(FilePath, ResultMesh.get(), InMat);
 		}
 
 		if (Loaded)
@@ -97,13 +111,13 @@ namespace GraphX
 	}
 
 	Mesh3D::Mesh3D(const GM::Vector3& Pos, const GM::Rotator& Rotation, const GM::Vector3& Scale, RawMeshData* RawData, const Ref<Material>& Mat)
-		: Position(Pos), Rotation(Rotation), Scale(Scale), bShowDetails(0), m_Model(), m_MaterialMap(), m_UpdateModelMatrix(true)
+		: Position(Pos), Rotation(Rotation), Scale(Scale), bShowDetails(0), bIsStatic(0), m_Model(), m_MaterialMap(), m_UpdateModelMatrix(true), m_PreviousPosition(Pos), m_PreviousRotation(Rotation), m_PreviousScale(Scale)
 	{
 		GX_PROFILE_FUNCTION()
 
 		if (RawData != nullptr)
 		{
-			m_RawData = CreateRef<RawMeshData>(RawData);
+			m_RawData = CreateRef<RawMeshData>(*RawData);
 			BuildMesh();
 		}
 		else
@@ -118,7 +132,7 @@ namespace GraphX
 	}
 
 	Mesh3D::Mesh3D(const GM::Vector3& Pos, const GM::Rotator& Rotation, const GM::Vector3& Scale, const std::vector<Vertex3D>& Vertices, const std::vector<unsigned int>& Indices, const Ref<Material>& Mat)
-		: Position(Pos), Rotation(Rotation), Scale(Scale), bShowDetails(0), m_Model(), m_MaterialMap(), m_UpdateModelMatrix(true)
+		: Position(Pos), Rotation(Rotation), Scale(Scale), bShowDetails(0), bIsStatic(0), m_Model(), m_MaterialMap(), m_UpdateModelMatrix(true), m_PreviousPosition(Pos), m_PreviousRotation(Rotation), m_PreviousScale(Scale)
 	{
 		GX_PROFILE_FUNCTION()
 
@@ -133,7 +147,7 @@ namespace GraphX
 	}
 
 	Mesh3D::Mesh3D(const Mesh3D& Mesh)
-		: Position(Mesh.Position), Rotation(Mesh.Rotation), Scale(Mesh.Scale), bShowDetails(0), m_Materials(Mesh.m_Materials), m_OverrideMaterial(Mesh.m_OverrideMaterial), m_Model(Mesh.m_Model), m_MaterialMap(Mesh.m_MaterialMap), m_Bounds(Mesh.m_Bounds), m_UpdateModelMatrix(true)
+		: Position(Mesh.Position), Rotation(Mesh.Rotation), Scale(Mesh.Scale), bShowDetails(0), bIsStatic(Mesh.bIsStatic), m_Materials(Mesh.m_Materials), m_OverrideMaterial(Mesh.m_OverrideMaterial), m_Model(Mesh.m_Model), m_MaterialMap(), m_Bounds(Mesh.m_Bounds), m_UpdateModelMatrix(true), m_PreviousPosition(Mesh.Position), m_PreviousRotation(Mesh.Rotation), m_PreviousScale(Mesh.Scale), m_SourceMesh(Mesh.m_SourceMesh)
 	{
 		GX_PROFILE_FUNCTION()
 
@@ -155,6 +169,40 @@ namespace GraphX
 		}
 	}
 
+	void Mesh3D::BeginTick()
+	{
+		m_PreviousPosition = Position;
+		m_PreviousRotation = Rotation;
+		m_PreviousScale = Scale;
+	}
+
+	void Mesh3D::InterpolateTransform(float Alpha)
+	{
+		const bool IsMoving = Position != m_PreviousPosition || Rotation != m_PreviousRotation || Scale != m_PreviousScale;
+
+		// Model matrix is already at the current transform
+		if (!IsMoving && !m_IsInterpolated)
+			return;
+
+		if (IsMoving)
+		{
+			// Rotations are blended along the shorter way around
+			auto LerpAngle = [Alpha](float From, float To) {
+				return From + (GM::Utility::ClampAngle(To - From + 180.0f) - 180.0f) * Alpha;
+			};
+
+			GM::Rotator BlendedRotation(LerpAngle(m_PreviousRotation.Pitch, Rotation.Pitch), LerpAngle(m_PreviousRotation.Yaw, Rotation.Yaw), LerpAngle(m_PreviousRotation.Roll, Rotation.Roll));
+			GM::ScaleRotationTranslationMatrix::Make(m_Model, GM::Utility::Lerp(m_PreviousScale, Scale, Alpha), BlendedRotation, GM::Utility::Lerp(m_PreviousPosition, Position, Alpha));
+		}
+		else
+		{
+			GM::ScaleRotationTranslationMatrix::Make(m_Model, Scale, Rotation, Position);
+		}
+
+		m_BoundingBox->Transform(m_Bounds, m_Model);
+		m_IsInterpolated = IsMoving;
+	}
+
 	void Mesh3D::Enable() const
 	{
 		GX_ENGINE_ASSERT(m_Initialised == true, "Render Data not initialised for the mesh");
@@ -183,7 +231,7 @@ namespace GraphX
 			if (SectionIndex < NumSections - 1)
 				NumIndices = m_RawData->SectionInfos[(size_t)SectionIndex + 1].FirstIndex - SectionInfo.FirstIndex;
 			else
-				NumIndices = (uint32_t)m_RawData->Indices.size() - SectionInfo.FirstVertexIndex;
+				NumIndices = (uint32_t)m_RawData->Indices.size() - SectionInfo.FirstIndex;
 
 			MeshSection Section;
 			Section.MaterialIndex = SectionInfo.MaterialIndex;
@@ -232,6 +280,8 @@ namespace GraphX
 		if (m_Initialised)
 			return true;
 
+		GX_ENGINE_ASSERT(RenderDevice::IsRenderThread(), "Mesh resources can only be initialised on the render thread");
+
 		if (m_RenderData == nullptr)
 			return false;
 		
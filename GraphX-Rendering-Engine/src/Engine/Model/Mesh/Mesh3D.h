@@ -13,7 +13,8 @@ namespace GraphX
 		/* Vertex data of the mesh */
 		std::vector<struct Vertex3D> Vertices;
 
-		/* Indices into the Vertices array (for triangle render primitive), for rendering the mesh using triangles */
+		/* Indices into the Vertices array (for triangle render primitive), relative to the first vertex of their section
+		*  Kept as 32 bit while the mesh is built, and uploaded as 16 bit indices when every section has less than 65536 vertices */
 		std::vector<uint32_t> Indices;
 
 		struct MeshSectionInfo
@@ -103,11 +104,16 @@ namespace GraphX
 	{
 	public:
 		/* Loads meshes from a file 
+		*  The file is imported once (see AssetManager), and each call returns a new instance sharing the imported data
+		*  Only the CPU data is built, so it can be called from any thread. InitResources creates the buffers on the render thread
 		*  @param FilePath Asset file path
 		*  @param Mat Material to be used for the meshes
 		*/
 		static Ref<Mesh3D> Load(const std::string& FilePath, const Ref<Material>& Mat);
 
+		/* Imports the meshes from a file, bypassing the asset cache */
+		static Ref<Mesh3D> Import(const std::string& FilePath, const Ref<Material>& Mat);
+
 	public:
 		/**
 		@param Pos Position of the mesh in the world
@@ -134,6 +140,12 @@ namespace GraphX
 		/* Updates the status of the Mesh */
 		virtual void Update(float DeltaTime);
 
+		/* Stores the current transform as the one at the start of the simulation tick */
+		void BeginTick();
+
+		/* Blends the model matrix between the transforms at the start and the end of the last simulation tick (Alpha 0 - 1) */
+		void InterpolateTransform(float Alpha);
+
 		/* Prepares the object to be rendered */
 		virtual void Enable() const;
 
@@ -173,6 +185,9 @@ namespace GraphX
 
 		/* Returns the original bounds of the mesh */
 		inline const GM::BoxBounds& GetBounds() const { return m_Bounds; }
+
+		/* Sets the original bounds of the mesh (Otherwise calculated from the vertices, when the mesh is built) */
+		inline void SetBounds(const GM::BoxBounds& Bounds) { m_Bounds = Bounds; }
 		
 		/* Returns the bounding collision box */
 		inline const Ref<struct GM::BoundingBox>& GetBoundingBox() const { return m_BoundingBox; }
@@ -194,14 +209,14 @@ namespace GraphX
 		/* Adds a new material for the mesh. Returns the material Index */
 		uint32_t AddMaterial(const Ref<Material>& InMat);
 
-		/* Intialises all the resource required by renderer (Called by the render thread, in this case - Main thread) */
+		/* Intialises all the resource required by renderer (Only on the render thread, finishes the meshes loaded on the other threads) */
 		bool InitResources();
 
 		/* Releases all the resource required by renderer (Called by the render thread, in this case - Main thread) */
 		bool ReleaseResources();
 
 	private:
-		/* Builds the mesh from the Raw mesh data (If not already built) */
+		/* Builds the sections and the bounds from the Raw mesh data (CPU only, the buffers are created by InitResources) */
 		void BuildMesh();
 
 		/* Calculate the bounding box and origin bounds of the mesh */
@@ -220,6 +235,9 @@ namespace GraphX
 		/* Whether to show the details UI window (ImGUI) or not */
 		bool bShowDetails : 1;
 
+		/* Whether the mesh never moves after placement (Its shadow is cached with the other static casters) */
+		bool bIsStatic : 1;
+
 	protected:
 		/* Raw Data of mesh */
 		Ref<RawMeshData> m_RawData;
@@ -250,5 +268,16 @@ namespace GraphX
 
 		/* Whether the mesh resources has been intialised */
 		bool m_Initialised = false;
+
+		/* Transform at the start of the last simulation tick (rendering interpolates from it to the current transform) */
+		GM::Vector3 m_PreviousPosition;
+		GM::Rotator m_PreviousRotation;
+		GM::Vector3 m_PreviousScale;
+
+		/* Whether the model matrix is in between the previous and the current transform */
+		bool m_IsInterpolated = false;
+
+		/* Imported mesh the instance was created from (Keeps it in the asset cache while its instances are alive) */
+		Ref<const Mesh3D> m_SourceMesh;
 	};
 }
\ No newline at end of file
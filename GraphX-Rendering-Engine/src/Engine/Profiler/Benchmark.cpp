@@ -0,0 +1,418 @@
+#include "pch.h"
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "Engine/Controllers/CameraController.h"
+#include "Engine/Core/Device/NullRenderDevice.h"
+
+namespace GraphX
+{
+	/* CPU times of a pass over all the measured frames */
+	struct BenchmarkPass
+	{
+		const char* Name;
+		std::vector<float> Durations;
+
+		/* Time recorded for the pass in the current frame */
+		float FrameDuration = 0.0f;
+	};
+
+	/* Named values reported by a micro benchmark */
+	struct BenchmarkMicroResult
+	{
+		std::string Name;
+		std::vector<std::pair<std::string, double>> Values;
+	};
+
+	struct BenchmarkData
+	{
+		BenchmarkSettings Settings;
+
+		Scope<BenchmarkCameraPath> CameraPath;
+
+		/* Number of frames started (including the warm up frames) */
+		uint32_t FrameIndex = 0;
+
+		std::chrono::steady_clock::time_point FrameStartTimePoint;
+
+		/* Time taken by each measured frame (in milliseconds) */
+		std::vector<float> FrameTimes;
+
+		std::vector<BenchmarkPass> Passes;
+
+		std::vector<BenchmarkMicroResult> MicroResults;
+
+		/* Work submitted to the null device over all the measured frames */
+		RenderDeviceStats DeviceStats;
+	};
+
+	/* Summary of a set of timings (in milliseconds) */
+	struct BenchmarkSummary
+	{
+		float Mean = 0.0f, P50 = 0.0f, P95 = 0.0f, P99 = 0.0f, Worst = 0.0f;
+		uint32_t WorstIndex = 0;
+	};
+
+	static BenchmarkSummary Summarize(const std::vector<float>& Times)
+	{
+		BenchmarkSummary Summary;
+		if (Times.empty())
+			return Summary;
+
+		std::vector<float> Sorted(Times);
+		std::sort(Sorted.begin(), Sorted.end());
+
+		// Nearest rank percentiles
+		auto Percentile = [&Sorted](float Percent) {
+			size_t Rank = (size_t)std::ceil(Percent / 100.0f * Sorted.size());
+			return Sorted[std::min(std::max(Rank, (size_t)1), Sorted.size()) - 1];
+		};
+
+		double Total = 0.0;
+		for (uint32_t i = 0; i < Times.size(); i++)
+		{
+			Total += Times[i];
+			if (Times[i] > Summary.Worst)
+			{
+				Summary.Worst = Times[i];
+				Summary.WorstIndex = i;
+			}
+		}
+
+		Summary.Mean = (float)(Total / Times.size());
+		Summary.P50 = Percentile(50.0f);
+		Summary.P95 = Percentile(95.0f);
+		Summary.P99 = Percentile(99.0f);
+
+		return Summary;
+	}
+
+	static void WriteSummary(std::ostream& Stream, const BenchmarkSummary& Summary)
+	{
+		Stream << "{ \"mean\" : " << Summary.Mean << ", \"p50\" : " << Summary.P50 << ", \"p95\" : " << Summary.P95 << ", \"p99\" : " << Summary.P99 << ", \"worst\" : " << Summary.Worst << ", \"worst_frame\" : " << Summary.WorstIndex << " }";
+	}
+
+	/******************* Camera Path *********************/
+
+	BenchmarkCameraPath::BenchmarkCameraPath(const std::vector<KeyPoint>& KeyPoints, float Duration)
+		: m_KeyPoints(KeyPoints), m_Duration(Duration)
+	{
+		GX_ENGINE_ASSERT(m_KeyPoints.size() >= 2, "Benchmark camera path needs atleast two key points");
+		GX_ENGINE_ASSERT(m_Duration > 0.0f, "Benchmark camera path must have a positive duration");
+	}
+
+	void BenchmarkCameraPath::Sample(float Time, GM::Vector3& OutPosition, GM::Vector3& OutTarget) const
+	{
+		const uint32_t Count = (uint32_t)m_KeyPoints.size();
+
+		// Segment of the (looped) path and the position in it
+		float PathTime = std::fmod(Time, m_Duration) / m_Duration * Count;
+		uint32_t Segment = std::min((uint32_t)PathTime, Count - 1);
+		float t = PathTime - Segment;
+
+		const KeyPoint& P0 = m_KeyPoints[(Segment + Count - 1) % Count];
+		const KeyPoint& P1 = m_KeyPoints[Segment];
+		const KeyPoint& P2 = m_KeyPoints[(Segment + 1) % Count];
+		const KeyPoint& P3 = m_KeyPoints[(Segment + 2) % Count];
+
+		// Uniform Catmull-Rom spline
+		auto CatmullRom = [t](const GM::Vector3& A, const GM::Vector3& B, const GM::Vector3& C, const GM::Vector3& D) {
+			float t2 = t * t, t3 = t2 * t;
+			return 0.5f * ((2.0f * B) + (C - A) * t + (2.0f * A - 5.0f * B + 4.0f * C - D) * t2 + (3.0f * B - A - 3.0f * C + D) * t3);
+		};
+
+		OutPosition = CatmullRom(P0.Position, P1.Position, P2.Position, P3.Position);
+		OutTarget = CatmullRom(P0.Target, P1.Target, P2.Target, P3.Target);
+	}
+
+	void BenchmarkCameraPath::Apply(CameraController& Controller, float Time) const
+	{
+		GM::Vector3 Position, Target;
+		Sample(Time, Position, Target);
+
+		GM::Vector3 Direction = Target - Position;
+		Direction.Normalize();
+
+		// Yaw turns the forward axis (+x) towards +y and pitch turns it down
+		float Yaw = std::atan2(Direction.y, Direction.x) * 180.0f / GM::PI;
+		float Pitch = -std::asin(std::min(std::max(Direction.z, -1.0f), 1.0f)) * 180.0f / GM::PI;
+
+		Controller.SetCameraPosition(Position);
+		Controller.SetCameraOrientation(GM::Rotator(Pitch, GM::Utility::ClampAngle(Yaw), 0.0f));
+	}
+
+	BenchmarkCameraPath BenchmarkCameraPath::CreateDefault(float Duration)
+	{
+		// Flies around the forest over the terrain, looking at the trees, the stall and the lamps
+		std::vector<KeyPoint> KeyPoints = {
+			{ GM::Vector3(-220.0f, -220.0f, 60.0f), GM::Vector3(0.0f, 0.0f, 0.0f) },
+			{ GM::Vector3(-20.0f, -180.0f, 25.0f), GM::Vector3(40.0f, -60.0f, 5.0f) },
+			{ GM::Vector3(160.0f, -120.0f, 40.0f), GM::Vector3(60.0f, 40.0f, 0.0f) },
+			{ GM::Vector3(200.0f, 80.0f, 90.0f), GM::Vector3(0.0f, 0.0f, 0.0f) },
+			{ GM::Vector3(40.0f, 200.0f, 20.0f), GM::Vector3(-40.0f, 60.0f, 5.0f) },
+			{ GM::Vector3(-150.0f, 120.0f, 35.0f), GM::Vector3(-10.0f, -20.0f, 0.0f) },
+			{ GM::Vector3(-10.0f, 5.0f, 8.0f), GM::Vector3(5.0f, -10.0f, 10.0f) },
+			{ GM::Vector3(-180.0f, -60.0f, 120.0f), GM::Vector3(50.0f, 50.0f, 0.0f) }
+		};
+
+		return BenchmarkCameraPath(KeyPoints, Duration);
+	}
+
+	/******************* Benchmark *********************/
+
+	BenchmarkData* Benchmark::s_Data = nullptr;
+
+	/* Parses the frame count of a command line option, a malformed count is reported and OutCount is left unchanged */
+	static void ParseFrameCount(const std::string& Arg, const std::string& Value, uint32_t MinCount, uint32_t& OutCount)
+	{
+		// Only plain digits, strtoul would accept the sign and the leading spaces
+		bool IsValid = !Value.empty() && Value.size() <= 10 && std::all_of(Value.begin(), Value.end(), [](char c) { return c >= '0' && c <= '9'; });
+
+		unsigned long long Count = IsValid ? std::strtoull(Value.c_str(), nullptr, 10) : 0;
+		if (!IsValid || Count < MinCount || Count > std::numeric_limits<uint32_t>::max())
+		{
+			GX_ENGINE_ERROR("Benchmark: Invalid frame count in {0}, using the default ({1})", Arg, OutCount);
+			return;
+		}
+
+		OutCount = (uint32_t)Count;
+	}
+
+	void Benchmark::ParseCommandLine(int argc, char** argv)
+	{
+		bool IsRequested = false;
+		BenchmarkSettings Settings;
+
+		for (int i = 1; i < argc; i++)
+		{
+			std::string Arg(argv[i]);
+			size_t Separator = Arg.find('=');
+			std::string Value = Separator == std::string::npos ? "" : Arg.substr(Separator + 1);
+
+			if (Arg == "--benchmark")
+				IsRequested = true;
+			else if (Arg.compare(0, 9, "--frames=") == 0)
+				ParseFrameCount(Arg, Value, 1, Settings.FrameCount);
+			else if (Arg.compare(0, 9, "--warmup=") == 0)
+				ParseFrameCount(Arg, Value, 0, Settings.WarmupFrames);
+			else if (Arg.compare(0, 9, "--output=") == 0)
+				Settings.OutputPath = Value;
+			else if (Arg == "--windowed")
+				Settings.IsHeadless = false;
+			else if (Arg == "--null-device")
+				Settings.UseNullDevice = true;
+		}
+
+		if (IsRequested)
+			Enable(Settings);
+	}
+
+	void Benchmark::Enable(const BenchmarkSettings& Settings)
+	{
+		GX_ENGINE_ASSERT(Settings.FrameCount > 0, "Benchmark must measure atleast one frame");
+
+		if (!s_Data)
+			s_Data = new BenchmarkData();
+
+		s_Data->Settings = Settings;
+		s_Data->CameraPath = CreateScope<BenchmarkCameraPath>(BenchmarkCameraPath::CreateDefault(Settings.CameraPathDuration));
+		s_Data->FrameIndex = 0;
+		s_Data->FrameTimes.clear();
+		s_Data->FrameTimes.reserve(Settings.FrameCount);
+		s_Data->Passes.clear();
+		s_Data->MicroResults.clear();
+		s_Data->DeviceStats = RenderDeviceStats();
+	}
+
+	bool Benchmark::IsEnabled()
+	{
+		return s_Data != nullptr;
+	}
+
+	const BenchmarkSettings& Benchmark::GetSettings()
+	{
+		GX_ENGINE_ASSERT(s_Data, "Benchmark is not enabled");
+
+		return s_Data->Settings;
+	}
+
+	void Benchmark::UpdateCamera(CameraController& Controller)
+	{
+		GX_PROFILE_FUNCTION()
+
+		// Camera path continues through the warm up frames, so the measured frames start wherever the warm up left it
+		s_Data->CameraPath->Apply(Controller, s_Data->FrameIndex * s_Data->Settings.FixedDeltaTime);
+	}
+
+	void Benchmark::BeginFrame()
+	{
+		for (BenchmarkPass& Pass : s_Data->Passes)
+			Pass.FrameDuration = 0.0f;
+
+		if (RenderDevice::GetType() == RenderDeviceType::Null)
+			static_cast<NullRenderDevice&>(RenderDevice::Get()).ResetStats();
+
+		s_Data->FrameStartTimePoint = std::chrono::steady_clock::now();
+	}
+
+	void Benchmark::EndFrame()
+	{
+		float FrameTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - s_Data->FrameStartTimePoint).count();
+
+		if (s_Data->FrameIndex++ < s_Data->Settings.WarmupFrames || IsFinished())
+			return;
+
+		s_Data->FrameTimes.push_back(FrameTime);
+
+		// Passes that first show up late (eg. toggled on) are padded with zeros for the earlier frames
+		for (BenchmarkPass& Pass : s_Data->Passes)
+		{
+			Pass.Durations.resize(s_Data->FrameTimes.size() - 1, 0.0f);
+			Pass.Durations.push_back(Pass.FrameDuration);
+		}
+
+		if (RenderDevice::GetType() == RenderDeviceType::Null)
+		{
+			const RenderDeviceStats& Stats = static_cast<NullRenderDevice&>(RenderDevice::Get()).GetStats();
+			RenderDeviceStats& Total = s_Data->DeviceStats;
+
+			Total.Calls += Stats.Calls;
+			Total.DrawCalls += Stats.DrawCalls;
+			Total.VerticesDrawn += Stats.VerticesDrawn;
+			Total.InstancesDrawn += Stats.InstancesDrawn;
+			Total.BytesUploaded += Stats.BytesUploaded;
+			Total.StateChanges += Stats.StateChanges;
+			Total.RedundantStateChanges += Stats.RedundantStateChanges;
+			Total.ProgramBinds += Stats.ProgramBinds;
+			Total.VertexArrayBinds += Stats.VertexArrayBinds;
+			Total.BufferBinds += Stats.BufferBinds;
+			Total.TextureBinds += Stats.TextureBinds;
+			Total.FramebufferBinds += Stats.FramebufferBinds;
+			Total.UniformUpdates += Stats.UniformUpdates;
+			Total.ObjectsCreated += Stats.ObjectsCreated;
+		}
+
+		if (IsFinished())
+			GX_ENGINE_INFO("Benchmark: Measured {0} frames", s_Data->FrameTimes.size());
+	}
+
+	bool Benchmark::IsFinished()
+	{
+		return s_Data->FrameTimes.size() >= s_Data->Settings.FrameCount;
+	}
+
+	void Benchmark::RecordPass(const char* Name, float Duration)
+	{
+		for (BenchmarkPass& Pass : s_Data->Passes)
+		{
+			if (Pass.Name == Name || strcmp(Pass.Name, Name) == 0)
+			{
+				Pass.FrameDuration += Duration;
+				return;
+			}
+		}
+
+		BenchmarkPass Pass;
+		Pass.Name = Name;
+		Pass.FrameDuration = Duration;
+		s_Data->Passes.push_back(Pass);
+	}
+
+	void Benchmark::RecordMicroBenchmark(const std::string& Name, const std::vector<std::pair<std::string, double>>& Values)
+	{
+		BenchmarkMicroResult Result;
+		Result.Name = Name;
+		Result.Values = Values;
+		s_Data->MicroResults.push_back(Result);
+	}
+
+	bool Benchmark::WriteResults()
+	{
+		GX_PROFILE_FUNCTION()
+
+		std::ofstream Stream(s_Data->Settings.OutputPath);
+		if (!Stream.is_open())
+		{
+			GX_ENGINE_ERROR("Benchmark: Could not open the {0} file.", s_Data->Settings.OutputPath);
+			return false;
+		}
+
+		const BenchmarkSettings& Settings = s_Data->Settings;
+		BenchmarkSummary FrameSummary = Summarize(s_Data->FrameTimes);
+
+		Stream << "{\n";
+		Stream << "\t\"frames\" : " << s_Data->FrameTimes.size() << ",\n";
+		Stream << "\t\"warmup_frames\" : " << Settings.WarmupFrames << ",\n";
+		Stream << "\t\"fixed_delta_time\" : " << Settings.FixedDeltaTime << ",\n";
+		Stream << "\t\"headless\" : " << (Settings.IsHeadless ? "true" : "false") << ",\n";
+		Stream << "\t\"null_device\" : " << (Settings.UseNullDevice ? "true" : "false") << ",\n";
+		Stream << "\t\"frame_time_ms\" : ";
+		WriteSummary(Stream, FrameSummary);
+		Stream << ",\n\t\"passes_cpu_ms\" : {";
+
+		for (size_t i = 0; i < s_Data->Passes.size(); i++)
+		{
+			const BenchmarkPass& Pass = s_Data->Passes[i];
+			Stream << (i == 0 ? "\n" : ",\n") << "\t\t\"" << Pass.Name << "\" : ";
+			WriteSummary(Stream, Summarize(Pass.Durations));
+		}
+
+		Stream << "\n\t}";
+
+		if (!s_Data->MicroResults.empty())
+		{
+			Stream << ",\n\t\"micro_benchmarks\" : {";
+
+			for (size_t i = 0; i < s_Data->MicroResults.size(); i++)
+			{
+				const BenchmarkMicroResult& Result = s_Data->MicroResults[i];
+				Stream << (i == 0 ? "\n" : ",\n") << "\t\t\"" << Result.Name << "\" : {";
+
+				for (size_t j = 0; j < Result.Values.size(); j++)
+					Stream << (j == 0 ? " " : ", ") << "\"" << Result.Values[j].first << "\" : " << Result.Values[j].second;
+
+				Stream << " }";
+			}
+
+			Stream << "\n\t}";
+		}
+
+		// Average work submitted to the device per frame
+		if (Settings.UseNullDevice)
+		{
+			const RenderDeviceStats& Stats = s_Data->DeviceStats;
+			const double Frames = (double)std::max(s_Data->FrameTimes.size(), (size_t)1);
+
+			Stream << ",\n\t\"device_per_frame\" : {\n";
+			Stream << "\t\t\"calls\" : " << Stats.Calls / Frames << ",\n";
+			Stream << "\t\t\"draw_calls\" : " << Stats.DrawCalls / Frames << ",\n";
+			Stream << "\t\t\"vertices\" : " << Stats.VerticesDrawn / Frames << ",\n";
+			Stream << "\t\t\"instances\" : " << Stats.InstancesDrawn / Frames << ",\n";
+			Stream << "\t\t\"bytes_uploaded\" : " << Stats.BytesUploaded / Frames << ",\n";
+			Stream << "\t\t\"state_changes\" : " << Stats.StateChanges / Frames << ",\n";
+			Stream << "\t\t\"redundant_state_changes\" : " << Stats.RedundantStateChanges / Frames << ",\n";
+			Stream << "\t\t\"program_binds\" : " << Stats.ProgramBinds / Frames << ",\n";
+			Stream << "\t\t\"vertex_array_binds\" : " << Stats.VertexArrayBinds / Frames << ",\n";
+			Stream << "\t\t\"buffer_binds\" : " << Stats.BufferBinds / Frames << ",\n";
+			Stream << "\t\t\"texture_binds\" : " << Stats.TextureBinds / Frames << ",\n";
+			Stream << "\t\t\"framebuffer_binds\" : " << Stats.FramebufferBinds / Frames << ",\n";
+			Stream << "\t\t\"uniform_updates\" : " << Stats.UniformUpdates / Frames << ",\n";
+			Stream << "\t\t\"objects_created\" : " << Stats.ObjectsCreated / Frames << "\n";
+			Stream << "\t}";
+		}
+
+		Stream << "\n}\n";
+
+		GX_ENGINE_INFO("Benchmark: Frame time p50 {0} ms, p95 {1} ms, p99 {2} ms, worst {3} ms (frame {4}). Results written to {5}", FrameSummary.P50, FrameSummary.P95, FrameSummary.P99, FrameSummary.Worst, FrameSummary.WorstIndex, Settings.OutputPath);
+
+		return true;
+	}
+
+	void Benchmark::Shutdown()
+	{
+		delete s_Data;
+		s_Data = nullptr;
+	}
+}
\ No newline at end of file
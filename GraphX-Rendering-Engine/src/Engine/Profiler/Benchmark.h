@@ -0,0 +1,132 @@
+#pragma once
+
+namespace GraphX
+{
+	class CameraController;
+	struct BenchmarkData;
+
+	/* Settings of a benchmark run */
+	struct BenchmarkSettings
+	{
+		/* Number of frames measured */
+		uint32_t FrameCount = 2000;
+
+		/* Frames rendered before the measurement starts (lets the driver and the caches warm up) */
+		uint32_t WarmupFrames = 100;
+
+		/* Time step (in seconds) the scene is updated with every frame, so that every run simulates the same frames */
+		float FixedDeltaTime = 1.0f / 60.0f;
+
+		/* Time (in seconds) taken to fly through the whole camera path once */
+		float CameraPathDuration = 30.0f;
+
+		/* Whether the window is hidden (rendering happens offscreen) */
+		bool IsHeadless = true;
+
+		/* Whether the frames are submitted to the null render device (measures only the CPU side of the renderer, no GPU or window needed) */
+		bool UseNullDevice = false;
+
+		/* File the results are written to */
+		std::string OutputPath = "GraphX-Benchmark.json";
+	};
+
+	/* Camera path through the scene, interpolated (Catmull-Rom) between the key points and looped */
+	class BenchmarkCameraPath
+	{
+	public:
+		struct KeyPoint
+		{
+			/* Position of the camera */
+			GM::Vector3 Position;
+
+			/* Point the camera looks at */
+			GM::Vector3 Target;
+		};
+
+	public:
+		BenchmarkCameraPath(const std::vector<KeyPoint>& KeyPoints, float Duration);
+
+		/* Returns the position and the target of the camera at the time on the path */
+		void Sample(float Time, GM::Vector3& OutPosition, GM::Vector3& OutTarget) const;
+
+		/* Moves the camera to the point on the path at the time */
+		void Apply(CameraController& Controller, float Time) const;
+
+		/* Creates the path flying over the sandbox scene */
+		static BenchmarkCameraPath CreateDefault(float Duration);
+
+	private:
+		std::vector<KeyPoint> m_KeyPoints;
+
+		/* Time taken to complete the path */
+		float m_Duration;
+	};
+
+	/*
+	* Runs the application for a fixed number of frames with a scripted camera and a fixed time step
+	* and writes the frame time percentiles and the cpu time of the passes to a json file
+	*/
+	class Benchmark
+	{
+	public:
+		/* Enables the benchmark if requested on the command line (--benchmark [--frames=N] [--warmup=N] [--output=File] [--windowed] [--null-device]) */
+		static void ParseCommandLine(int argc, char** argv);
+
+		/* Enables the benchmark with the settings (must be called before the application is created) */
+		static void Enable(const BenchmarkSettings& Settings);
+
+		static bool IsEnabled();
+
+		static const BenchmarkSettings& GetSettings();
+
+		/* Moves the camera along the benchmark path for the current frame */
+		static void UpdateCamera(CameraController& Controller);
+
+		/* Marks the start and the end of a frame */
+		static void BeginFrame();
+		static void EndFrame();
+
+		/* Returns whether all the frames have been measured */
+		static bool IsFinished();
+
+		/* Adds the CPU time (in milliseconds) of a pass to the current frame (times of a pass recorded multiple times in a frame are added) */
+		static void RecordPass(const char* Name, float Duration);
+
+		/* Adds the results of a micro benchmark (run outside of the frames) to be written along with the frame timings */
+		static void RecordMicroBenchmark(const std::string& Name, const std::vector<std::pair<std::string, double>>& Values);
+
+		/* Writes the results to the output file */
+		static bool WriteResults();
+
+		/* Releases the benchmark data */
+		static void Shutdown();
+
+	private:
+		static BenchmarkData* s_Data;
+	};
+
+	/* Records the CPU time of the enclosing scope as a pass of the benchmark */
+	class BenchmarkScope
+	{
+	public:
+		BenchmarkScope(const char* Name)
+			: m_Name(Name), m_IsEnabled(Benchmark::IsEnabled())
+		{
+			if (m_IsEnabled)
+				m_StartTimePoint = std::chrono::steady_clock::now();
+		}
+
+		~BenchmarkScope()
+		{
+			if (m_IsEnabled)
+				Benchmark::RecordPass(m_Name, std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - m_StartTimePoint).count());
+		}
+
+	private:
+		const char* m_Name;
+		bool m_IsEnabled;
+		std::chrono::steady_clock::time_point m_StartTimePoint;
+	};
+}
+
+#define GX_BENCHMARK_SCOPE(name)		::GraphX::BenchmarkScope BenchmarkScope##__LINE__(name);
\ No newline at end of file
@@ -0,0 +1,217 @@
+#include "pch.h"
+#include "GPUProfiler.h"
+#include "GL/glew.h"
+#include "Engine/Core/Device/RenderDevice.h"
+
+namespace GraphX
+{
+	/* Pass recorded in a frame */
+	struct GPUPassQueries
+	{
+		const char* Name;
+		uint32_t Depth;
+
+		/* Indices of the timestamp queries (in to the frame's query pool) at the start and the end of the pass */
+		uint32_t BeginQuery, EndQuery;
+	};
+
+	/* Queries issued in a frame */
+	struct GPUFrameQueries
+	{
+		/* Query objects owned by the frame (grows to the number of queries needed by a frame and reused after) */
+		std::vector<GLuint> QueryPool;
+
+		/* Number of queries from the pool used by the frame */
+		uint32_t QueriesUsed = 0;
+
+		std::vector<GPUPassQueries> Passes;
+
+		/* Whether the frame has queries waiting to be read back */
+		bool IsPending = false;
+	};
+
+	struct GPUProfilerData
+	{
+		std::array<GPUFrameQueries, EngineConstants::GPUProfilerFrameLatency> Frames;
+		uint32_t CurrentFrame = 0;
+
+		/* Passes that are not ended yet (indices in to the passes of the current frame) */
+		std::vector<uint32_t> OpenPasses;
+
+		/* Timings of the latest frame read back */
+		std::vector<GPUPassTiming> PassTimings;
+
+		/* Used to convert the GPU timestamps (nanoseconds) to the profiler time (microseconds) */
+		long long GPUTimeOffset = 0;
+
+		bool IsSupported = false;
+		bool IsEnabled = true;
+		bool IsFrameActive = false;
+	};
+
+	GPUProfilerData* GPUProfiler::s_Data = nullptr;
+
+	void GPUProfiler::Init()
+	{
+		GX_PROFILE_FUNCTION()
+
+		s_Data = new GPUProfilerData();
+
+		// The null device does not run anything to time
+		if (RenderDevice::GetType() == RenderDeviceType::Null)
+			return;
+
+		// Timer queries are core from OpenGL 3.3
+		s_Data->IsSupported = GLEW_ARB_timer_query || GLEW_VERSION_3_3;
+		if (!s_Data->IsSupported)
+			GX_ENGINE_WARN("Timer queries are not supported. GPU profiling is disabled");
+	}
+
+	void GPUProfiler::Shutdown()
+	{
+		GX_PROFILE_FUNCTION()
+
+		for (GPUFrameQueries& Frame : s_Data->Frames)
+		{
+			if (Frame.QueryPool.size() > 0)
+				RenderDevice::Get().DeleteQueries((GLsizei)Frame.QueryPool.size(), Frame.QueryPool.data());
+		}
+
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	void GPUProfiler::BeginFrame()
+	{
+		GX_PROFILE_FUNCTION()
+
+		if (!s_Data->IsSupported || !s_Data->IsEnabled)
+			return;
+
+		// Oldest frame in flight is reused for the new frame
+		s_Data->CurrentFrame = (s_Data->CurrentFrame + 1) % EngineConstants::GPUProfilerFrameLatency;
+		GPUFrameQueries& Frame = s_Data->Frames[s_Data->CurrentFrame];
+
+		// Results not available even after the latency frames are dropped (instead of stalling)
+		if (Frame.IsPending && !ReadBackFrame(Frame))
+			GX_ENGINE_WARN("GPU profiler results were not ready after {0} frames and were dropped", EngineConstants::GPUProfilerFrameLatency);
+
+		Frame.QueriesUsed = 0;
+		Frame.Passes.clear();
+		Frame.IsPending = false;
+		s_Data->OpenPasses.clear();
+		s_Data->IsFrameActive = true;
+
+		BeginPass("GPU Frame");
+	}
+
+	void GPUProfiler::EndFrame()
+	{
+		GX_PROFILE_FUNCTION()
+
+		if (!s_Data->IsFrameActive)
+			return;
+
+		GX_ENGINE_ASSERT(s_Data->OpenPasses.size() == 1, "All the GPU passes must be ended before the frame ends");
+
+		EndPass();
+
+		s_Data->Frames[s_Data->CurrentFrame].IsPending = true;
+		s_Data->IsFrameActive = false;
+	}
+
+	void GPUProfiler::BeginPass(const char* Name)
+	{
+		if (!s_Data->IsFrameActive)
+			return;
+
+		GPUFrameQueries& Frame = s_Data->Frames[s_Data->CurrentFrame];
+
+		// Grow the query pool of the frame for the begin and the end queries of the pass
+		if (Frame.QueriesUsed + 2 > Frame.QueryPool.size())
+		{
+			size_t OldSize = Frame.QueryPool.size();
+			Frame.QueryPool.resize(OldSize + 16);
+			RenderDevice::Get().GenQueries(16, Frame.QueryPool.data() + OldSize);
+		}
+
+		GPUPassQueries Pass;
+		Pass.Name = Name;
+		Pass.Depth = (uint32_t)s_Data->OpenPasses.size();
+		Pass.BeginQuery = Frame.QueriesUsed++;
+		Pass.EndQuery = Frame.QueriesUsed++;
+
+		RenderDevice::Get().QueryCounter(Frame.QueryPool[Pass.BeginQuery], GL_TIMESTAMP);
+
+		s_Data->OpenPasses.push_back((uint32_t)Frame.Passes.size());
+		Frame.Passes.push_back(Pass);
+	}
+
+	void GPUProfiler::EndPass()
+	{
+		if (!s_Data->IsFrameActive)
+			return;
+
+		GX_ENGINE_ASSERT(s_Data->OpenPasses.size() > 0, "GPU pass ended without beginning it");
+
+		GPUFrameQueries& Frame = s_Data->Frames[s_Data->CurrentFrame];
+		const GPUPassQueries& Pass = Frame.Passes[s_Data->OpenPasses.back()];
+		RenderDevice::Get().QueryCounter(Frame.QueryPool[Pass.EndQuery], GL_TIMESTAMP);
+
+		s_Data->OpenPasses.pop_back();
+	}
+
+	const std::vector<GPUPassTiming>& GPUProfiler::GetPassTimings()
+	{
+		return s_Data->PassTimings;
+	}
+
+	void GPUProfiler::SetEnabled(bool Enabled)
+	{
+		// Change takes effect from the next frame
+		s_Data->IsEnabled = Enabled;
+	}
+
+	bool GPUProfiler::IsEnabled()
+	{
+		return s_Data->IsEnabled && s_Data->IsSupported;
+	}
+
+	bool GPUProfiler::ReadBackFrame(GPUFrameQueries& Frame)
+	{
+		GX_PROFILE_FUNCTION()
+
+		for (uint32_t i = 0; i < Frame.QueriesUsed; i++)
+		{
+			GLint IsAvailable = GL_FALSE;
+			RenderDevice::Get().GetQueryObjectiv(Frame.QueryPool[i], GL_QUERY_RESULT_AVAILABLE, &IsAvailable);
+			if (IsAvailable == GL_FALSE)
+				return false;
+		}
+
+	#if GX_PROFILING
+		// Offset between the GPU and the CPU clock (GPU time is queried without waiting for the commands to finish)
+		GLint64 GPUTime = 0;
+		RenderDevice::Get().GetInteger64v(GL_TIMESTAMP, &GPUTime);
+		long long CPUTime = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now()).time_since_epoch().count();
+		s_Data->GPUTimeOffset = CPUTime - GPUTime / 1000;
+	#endif
+
+		s_Data->PassTimings.clear();
+		for (const GPUPassQueries& Pass : Frame.Passes)
+		{
+			GLuint64 BeginTime = 0, EndTime = 0;
+			RenderDevice::Get().GetQueryObjectui64v(Frame.QueryPool[Pass.BeginQuery], GL_QUERY_RESULT, &BeginTime);
+			RenderDevice::Get().GetQueryObjectui64v(Frame.QueryPool[Pass.EndQuery], GL_QUERY_RESULT, &EndTime);
+
+			s_Data->PassTimings.push_back({ Pass.Name, Pass.Depth, (EndTime - BeginTime) / 1000000.0f });
+
+		#if GX_PROFILING
+			// GPU passes are shown on a separate track of the trace
+			RunTimeProfiler::Get().WriteProfile({ Pass.Name, (long long)(BeginTime / 1000) + s_Data->GPUTimeOffset, (long long)(EndTime - BeginTime) / 1000, EngineConstants::GPUProfilerTraceThreadID });
+		#endif
+		}
+
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+namespace GraphX
+{
+	struct GPUFrameQueries;
+	struct GPUProfilerData;
+
+	/* GPU time spent in a pass */
+	struct GPUPassTiming
+	{
+		/* Name of the pass (must outlive the profiler, same as the cpu profiler scopes) */
+		const char* Name;
+
+		/* Nesting level of the pass (0 for the whole frame) */
+		uint32_t Depth;
+
+		/* Time taken by the pass on the GPU (in milliseconds) */
+		float Duration;
+	};
+
+	/*
+	* Measures the GPU time of the render passes using timestamp queries
+	* Queries are pooled per frame and read back a few frames later (when they are already available), so the CPU never waits on the GPU
+	*/
+	class GPUProfiler
+	{
+	public:
+		static void Init();
+		static void Shutdown();
+
+		/* Reads back the results of the oldest frame in flight and starts timing a new frame */
+		static void BeginFrame();
+		static void EndFrame();
+
+		/* Starts timing a pass (passes can be nested) */
+		static void BeginPass(const char* Name);
+
+		/* Ends the last pass started */
+		static void EndPass();
+
+		/* Returns the timings of the passes of the latest frame read back */
+		static const std::vector<GPUPassTiming>& GetPassTimings();
+
+		/* Enables or disables the profiler (no queries are issued while disabled) */
+		static void SetEnabled(bool Enabled);
+
+		static bool IsEnabled();
+
+	private:
+		/* Reads the queries of the frame, if they are all available */
+		static bool ReadBackFrame(GPUFrameQueries& Frame);
+
+	private:
+		static GPUProfilerData* s_Data;
+	};
+
+	/* Times the GPU work of the enclosing scope */
+	class GPUProfilerScope
+	{
+	public:
+		GPUProfilerScope(const char* Name)
+		{
+			GPUProfiler::BeginPass(Name);
+		}
+
+		~GPUProfilerScope()
+		{
+			GPUProfiler::EndPass();
+		}
+	};
+}
+
+#define GX_GPU_PROFILE_SCOPE(name)		::GraphX::GPUProfilerScope GPUScope##__LINE__(name);
\ No newline at end of file
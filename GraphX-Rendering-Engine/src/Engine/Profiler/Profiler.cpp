@@ -21,7 +21,7 @@ namespace GraphX
 {
 	/******************* RunTime Profiler *********************/
 
-	const char RunTimeProfiler::s_ProfileFormat[] = ", { \"cat\" : \"Scope\", \"dur\" : %lld, \"name\": \"%s\", \"ph\" : \"X\", \"pid\" : \"0\", \"tid\" : \"0\", \"ts\" : %lld}";
+	const char RunTimeProfiler::s_ProfileFormat[] = ", { \"cat\" : \"Scope\", \"dur\" : %lld, \"name\": \"%s\", \"ph\" : \"X\", \"pid\" : \"0\", \"tid\" : \"%u\", \"ts\" : %lld}";
 	
 	uint32_t RunTimeProfiler::s_FormatStringLen = (uint32_t)strlen(s_ProfileFormat);
 
@@ -62,13 +62,13 @@ namespace GraphX
 
 	void RunTimeProfiler::WriteProfile(const RunTimeProfilerResult&& Result)
 	{
-		uint32_t requiredBufferSize = s_FormatStringLen + (uint32_t)strlen(Result.Name) + 40; /* 40 for 40 possible characters of the durations in the result */
+		uint32_t requiredBufferSize = s_FormatStringLen + (uint32_t)strlen(Result.Name) + 50; /* 50 for 50 possible characters of the durations and the thread id in the result */
 		if (s_ProfileString.size() < requiredBufferSize)
 		{
 			s_ProfileString.resize(requiredBufferSize);
 		}
 
-		std::snprintf(s_ProfileString.data(), s_ProfileString.size(), s_ProfileFormat, Result.Duration, Result.Name, Result.StartTime);
+		std::snprintf(s_ProfileString.data(), s_ProfileString.size(), s_ProfileFormat, Result.Duration, Result.Name, Result.ThreadID, Result.StartTime);
 
 		if (m_CurrentSession)
 		{
@@ -47,6 +47,9 @@ namespace GraphX
 
 		long long StartTime;
 		long long Duration;
+
+		/* Track of the trace the result is shown on (0 for the CPU scopes) */
+		uint32_t ThreadID = 0;
 	};
 
 	struct MemoryProfilerResut
@@ -34,7 +34,7 @@ namespace GraphX
 	public:
 		template<typename... Args>
 		AsyncQueuedWork(Args&& ...args)
-			: m_WorkFinished(false), Task(std::forward<Args>(args)), m_ThreadPool(nullptr)
+			: m_WorkFinished(false), Task(std::forward<Args>(args)...), m_ThreadPool(nullptr)
 		{}
 
 		// IQueuedWork Interface
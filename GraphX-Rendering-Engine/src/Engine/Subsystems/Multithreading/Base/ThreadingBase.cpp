@@ -78,6 +78,7 @@ namespace GraphX
 		GX_ENGINE_ASSERT(m_Thread != nullptr, "Thread not created properly!!");
 		// Using the WinAPI directly here to pause / resume threads (Might need to change this, as the standard might not work properly with platform specific API)
 		// (OR use only the Win32API in place of c++ standard for the windows platform)
+#ifdef _WIN32
 		if (ShouldPause)
 		{
 			::SuspendThread(m_Thread->native_handle());
@@ -86,6 +87,9 @@ namespace GraphX
 		{
 			::ResumeThread(m_Thread->native_handle());
 		}
+#else
+		GX_ENGINE_WARN("RunnableThread: Suspending threads is only supported on Windows");
+#endif
 	}
 
 	bool RunnableThread::Kill(bool ShouldWait)
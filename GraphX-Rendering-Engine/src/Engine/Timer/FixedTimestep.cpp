@@ -0,0 +1,51 @@
+#include "pch.h"
+#include "FixedTimestep.h"
+
+#include <algorithm>
+
+namespace GraphX
+{
+	FixedTimestep::FixedTimestep(float TickRate, uint32_t MaxTicksPerFrame)
+		: m_TickDelta(1.0f), m_MaxTicksPerFrame(MaxTicksPerFrame), m_Accumulator(0.0f), m_TickCount(0), m_DroppedTime(0.0f)
+	{
+		GX_ENGINE_ASSERT(MaxTicksPerFrame > 0, "Atleast one simulation tick must be allowed per frame");
+
+		SetTickRate(TickRate);
+	}
+
+	uint32_t FixedTimestep::Advance(float FrameTime)
+	{
+		GX_PROFILE_FUNCTION()
+
+		m_Accumulator += std::max(FrameTime, 0.0f);
+
+		uint32_t Ticks = (uint32_t)(m_Accumulator / m_TickDelta);
+		if (Ticks > m_MaxTicksPerFrame)
+		{
+			// Simulation can't keep up (or the frame stalled), so the time beyond the limit is dropped and the simulation slows down instead
+			const float TimeToDrop = (Ticks - m_MaxTicksPerFrame) * m_TickDelta;
+			m_DroppedTime += TimeToDrop;
+			m_Accumulator -= TimeToDrop;
+			Ticks = m_MaxTicksPerFrame;
+		}
+
+		m_Accumulator -= Ticks * m_TickDelta;
+
+		// Guard against the rounding errors pushing the accumulator out of a tick
+		m_Accumulator = std::min(std::max(m_Accumulator, 0.0f), m_TickDelta);
+
+		m_TickCount += Ticks;
+		return Ticks;
+	}
+
+	void FixedTimestep::SetTickRate(float TickRate)
+	{
+		GX_ENGINE_ASSERT(TickRate > 0.0f, "Simulation tick rate must be positive");
+
+		// Keep the interpolation factor the same across the change
+		const float Alpha = GetAlpha();
+
+		m_TickDelta = 1.0f / TickRate;
+		m_Accumulator = Alpha * m_TickDelta;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+
+namespace GraphX
+{
+	/* 
+	* Splits the variable frame times in to fixed simulation ticks. 
+	* Time not yet simulated is carried over to the next frame and the fraction of a tick left over is used to interpolate the rendered state
+	*/
+	class FixedTimestep
+	{
+	public:
+		/**
+		* @param TickRate Number of simulation ticks per second
+		* @param MaxTicksPerFrame Maximum ticks simulated in a frame. Time beyond that is dropped (so that slow frames don't need ever more ticks to catch up)
+		*/
+		FixedTimestep(float TickRate, uint32_t MaxTicksPerFrame);
+
+		/* Adds the frame time and returns the number of ticks to simulate for the frame */
+		uint32_t Advance(float FrameTime);
+
+		/* Sets the number of simulation ticks per second */
+		void SetTickRate(float TickRate);
+
+		/* Returns the number of simulation ticks per second */
+		inline float GetTickRate() const { return 1.0f / m_TickDelta; }
+
+		/* Returns the time (in seconds) simulated by a tick */
+		inline float GetTickDelta() const { return m_TickDelta; }
+
+		/* Returns how far (0 - 1) the frame is between the last simulated tick and the next one (used to interpolate the rendered state) */
+		inline float GetAlpha() const { return m_Accumulator / m_TickDelta; }
+
+		/* Returns the total number of ticks simulated */
+		inline uint64_t GetTickCount() const { return m_TickCount; }
+
+		/* Returns the total time (in seconds) dropped because of the catch up limit */
+		inline float GetDroppedTime() const { return m_DroppedTime; }
+
+	private:
+		/* Time (in seconds) simulated by a tick */
+		float m_TickDelta;
+
+		/* Maximum ticks simulated in a frame */
+		uint32_t m_MaxTicksPerFrame;
+
+		/* Frame time that is not simulated yet (always less than a tick after advancing) */
+		float m_Accumulator;
+
+		uint64_t m_TickCount;
+
+		float m_DroppedTime;
+	};
+}
\ No newline at end of file
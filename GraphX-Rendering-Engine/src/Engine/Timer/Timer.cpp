@@ -4,29 +4,29 @@
 namespace GraphX
 {
 	Timer::Timer(const char* name)
-		:m_Name(name), m_StartTimePoint(std::chrono::high_resolution_clock::now()), m_LastUpdateTimePoint(std::chrono::high_resolution_clock::now())
+		:m_Name(name), m_StartTimePoint(std::chrono::steady_clock::now()), m_LastUpdateTimePoint(std::chrono::steady_clock::now())
 	{}
 
 	void Timer::Update()
 	{
-		m_LastUpdateTimePoint = std::chrono::high_resolution_clock::now();
+		m_LastUpdateTimePoint = std::chrono::steady_clock::now();
 	}
 
 	float Timer::GetDeltaTime() const
 	{
-		std::chrono::duration<float> duration  = std::chrono::high_resolution_clock::now() - m_LastUpdateTimePoint;
+		std::chrono::duration<float> duration  = std::chrono::steady_clock::now() - m_LastUpdateTimePoint;
 		return duration.count();
 	}
 
 	float Timer::GetTime() const
 	{
-		std::chrono::duration<float> duration = std::chrono::high_resolution_clock::now() - m_StartTimePoint;
+		std::chrono::duration<float> duration = std::chrono::steady_clock::now() - m_StartTimePoint;
 		return duration.count();
 	}
 
 	Timer::~Timer()
 	{
-		std::chrono::duration<float> duration = std::chrono::high_resolution_clock::now() - m_StartTimePoint;
+		std::chrono::duration<float> duration = std::chrono::steady_clock::now() - m_StartTimePoint;
 		GX_ENGINE_INFO("'{0}' runtime {1} ms.", m_Name, duration.count() * 1000.0f);
 	}
 }
\ No newline at end of file
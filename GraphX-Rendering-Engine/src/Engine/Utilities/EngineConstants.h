@@ -19,6 +19,57 @@ namespace GraphX
 		/* Texture slot used for the shadow map */
 		const uint32_t ShadowMapTextureSlot = 5;
 
+		/* Number of cascades the camera frustum is split in to for the shadows (2 - 4) */
+		const uint32_t ShadowCascadeCount = 3;
+
+		/* Width and height of each shadow cascade */
+		const uint32_t ShadowMapResolution = 2048;
+
+		/* Distance from the camera upto which the shadows are rendered */
+		const float ShadowDistance = 500.0f;
+
+		/* Blend between the logarithmic (1) and the uniform (0) split of the shadow cascades */
+		const float ShadowCascadeSplitLambda = 0.75f;
+
+		/* Distance by which the shadow cascades are extended towards the light to include casters outside the camera frustum */
+		const float ShadowCasterExtension = 200.0f;
+
+		/* Angle (in degrees) the sun light needs to move by, before the shadows are updated */
+		const float ShadowLightDirectionThreshold = 0.5f;
+
+		/****** Clustered Lighting ******/
+		/* Number of screen space tiles (along the width & height) and the depth slices the view is split in to, for assigning the point lights */
+		const uint32_t LightClusterTilesX = 16;
+		const uint32_t LightClusterTilesY = 9;
+		const uint32_t LightClusterSlices = 24;
+
+		/* Texture slots used for the point lights data, light list of each cluster and the light indices */
+		const uint32_t LightDataTextureSlot = 6;
+		const uint32_t LightClusterDataTextureSlot = 7;
+		const uint32_t LightIndicesTextureSlot = 8;
+
+		/* Maximum distance upto which a point light affects the scene */
+		const float MaxPointLightRange = 1000.0f;
+
+		/****** Texture Streaming ******/
+		/* Bytes of the streamed textures uploaded per frame (A level larger than this is still uploaded, alone in its frame) */
+		const uint32_t TextureStreamingBudget = 8 * 1024 * 1024;
+
+		/****** Sprite Atlas ******/
+		/* Width and height of the sprite atlas at the start, and the most it can grow up to */
+		const uint32_t SpriteAtlasInitialSize = 512;
+		const uint32_t SpriteAtlasMaxSize = 2048;
+
+		/* Pixels around each image in the sprite atlas, filled with the edges of the image */
+		const uint32_t SpriteAtlasPadding = 2;
+
+		/* Largest width or height of a texture packed in to the sprite atlas (Larger textures keep their own texture) */
+		const uint32_t SpriteAtlasMaxImageSize = 512;
+
+		/****** Mesh Optimisation ******/
+		/* Number of vertices in the FIFO vertex cache, the ACMR and ATVR of the meshes are measured on (and the overdraw clusters are split by) */
+		const uint32_t VertexCacheAnalysisSize = 16;
+
 		/****** Six Directions ******/
 		/* Forward Axis for the engine */
 		const GM::Vector3 ForwardAxis{ 1.0f, 0.0f, 0.0f };
@@ -44,6 +95,22 @@ namespace GraphX
 		/* Offset To be added to the rotation of skybox in order to rotate the Co ordinate axes so that z - axis is Up and x - axis  is forward */
 		const GM::Rotator AxesTransformRotationOffsetSkybox{ 0.0f, -90.0f, 90.0f };
 
+		// Profiling constants
+
+		/* Number of frames after which the GPU timings are read back (Results are available without stalling by then) */
+		const uint32_t GPUProfilerFrameLatency = 4;
+
+		/* Track (thread id) of the trace the GPU timings are written to */
+		const uint32_t GPUProfilerTraceThreadID = 1;
+
+		// Simulation constants
+
+		/* Number of fixed simulation ticks per second (the scene is updated in ticks and the rendering interpolates between them) */
+		const float SimulationTickRate = 60.0f;
+
+		/* Maximum number of simulation ticks run in a frame (time beyond that is dropped, instead of slowing the frames down further) */
+		const uint32_t MaxSimulationTicksPerFrame = 5;
+
 		// Multi threading constants
 
 		/* Number of threads in the global thread pool */
@@ -51,5 +118,8 @@ namespace GraphX
 
 		/* Wait time for a queued thread (in Milliseconds) */
 		const uint32_t QueuedThreadWaitTime = 10;
+
+		/* Vertices an imported scene needs, before its sub meshes are copied on the thread pool too */
+		const uint32_t ImporterParallelCopyMinVertices = 16384;
 	};
 }
\ No newline at end of file
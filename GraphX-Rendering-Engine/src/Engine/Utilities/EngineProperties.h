@@ -5,6 +5,18 @@ namespace GraphX
 	// Whether to enable shadows or not
 	static bool GX_ENABLE_SHADOWS = false;
 
+	// Whether the shadows of the static meshes are cached and only the dynamic meshes are rendered every frame
+	static bool GX_ENABLE_STATIC_SHADOW_CACHE = true;
+
+	// Whether to render the depth of the 3D scene before shading it (Reduces overdraw for fragment bound scenes, at the cost of rendering the geometry twice)
+	static bool GX_ENABLE_DEPTH_PREPASS = false;
+
+	// Whether the textures are loaded from their precompressed versions (DDS / KTX2 files written by the texture compressor), when present
+	static bool GX_ENABLE_COMPRESSED_TEXTURES = true;
+
+	// Whether the imported meshes are written to (and loaded from) the binary mesh cache, instead of parsing the source file on every launch
+	static bool GX_ENABLE_MESH_CACHE = true;
+
 	// Whether to enable particle effects or not
 	static bool GX_ENABLE_PARTICLE_EFFECTS = false;
 
@@ -13,4 +25,13 @@ namespace GraphX
 
 	// Whether to enable batch rendering or not
 	static bool GX_ENABLE_BATCH_RENDERING = true;
+
+	// Whether batched quads are rendered as instances (corners generated on the GPU) or as vertices
+	static bool GX_ENABLE_INSTANCED_QUADS = true;
+
+	// Whether the batches pack same sized textures in to texture arrays instead of using separate texture slots
+	static bool GX_ENABLE_TEXTURE_ARRAY_BATCHING = true;
+
+	// Whether the sprite sheets and the small particle textures are packed in to a shared atlas, so the batches draw them from a single texture
+	static bool GX_ENABLE_SPRITE_ATLAS = true;
 }
\ No newline at end of file
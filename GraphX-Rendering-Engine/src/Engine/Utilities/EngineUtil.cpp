@@ -1,13 +1,16 @@
 #include "pch.h"
 #include "EngineUtil.h"
 
+#include <sys/types.h>
+#include <sys/stat.h>
+
 namespace GraphX
 {
 	std::random_device EngineUtil::s_RandDevice;
 
 	std::mt19937_64 EngineUtil::s_RandNumGenerator(s_RandDevice());
 
-	std::wstring_convert<std::codecvt<wchar_t, char, std::mbstate_t>> EngineUtil::s_StringConvertor;
+	std::wstring_convert<EngineUtil::StringCodecvt> EngineUtil::s_StringConvertor;
 
 	std::string EngineUtil::ToByteString(const std::wstring& WideString)
 	{
@@ -47,4 +50,13 @@ namespace GraphX
 			return AbsoluteFilePath.substr(0, LastSlash);
 		}
 	}
+
+	int64_t EngineUtil::GetFileWriteTime(const std::string& FilePath)
+	{
+		struct stat FileStatus;
+		if (stat(FilePath.c_str(), &FileStatus) != 0)
+			return 0;
+
+		return (int64_t)FileStatus.st_mtime;
+	}
 }
\ No newline at end of file
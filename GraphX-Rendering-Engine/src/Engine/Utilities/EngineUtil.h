@@ -1,5 +1,8 @@
 #pragma once
 
+#include <locale>
+#include <codecvt>
+
 namespace GraphX
 {
 	// Time of the day and Coresponding hours
@@ -72,6 +75,9 @@ namespace GraphX
 		/* Returns the file location from the absolute file path */
 		static std::string ExtractFileLocation(const std::string& AbsoluteFilePath);
 
+		/* Returns the last modification time of the file (0 if the file does not exist) */
+		static int64_t GetFileWriteTime(const std::string& FilePath);
+
 	private:
 		/* Random device used to generate random values */
 		static std::random_device s_RandDevice;
@@ -79,7 +85,13 @@ namespace GraphX
 		/* Random value generator */
 		static std::mt19937_64 s_RandNumGenerator;
 
+		/* std::codecvt has a protected destructor outside MSVC, the convertor needs to delete it */
+		struct StringCodecvt : public std::codecvt<wchar_t, char, std::mbstate_t>
+		{
+			~StringCodecvt() {}
+		};
+
 		/* Convertor to convert between normal and wide strings */
-		static std::wstring_convert<std::codecvt<wchar_t, char, std::mbstate_t>> s_StringConvertor;
+		static std::wstring_convert<StringCodecvt> s_StringConvertor;
 	};
 }
\ No newline at end of file
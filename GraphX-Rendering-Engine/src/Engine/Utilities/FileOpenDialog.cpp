@@ -1,17 +1,22 @@
 #include "pch.h"
 #include "FileOpenDialog.h"
 
+#ifdef _WIN32
 #include <Windows.h>
 #include <ShObjIdl.h>
 #include <KnownFolders.h>
 #include <shtypes.h>
+#endif
 
 namespace GraphX
 {
+#ifdef _WIN32
 	const COMDLG_FILTERSPEC FileOpenDialog::TextureFileTypes[] = {
 		{L"PNG (*.png)", L"*.png"},
 		{L"JPEG (*.jpg)", L"*.jpg"},
-		{L"TGA (*.tga)", L"*.tga"}
+		{L"TGA (*.tga)", L"*.tga"},
+		{L"DDS (*.dds)", L"*.dds"},
+		{L"KTX2 (*.ktx2)", L"*.ktx2"}
 	};
 
 	const COMDLG_FILTERSPEC FileOpenDialog::ModelFileTypes[] = {
@@ -130,4 +135,18 @@ namespace GraphX
 		}
 	}
 
+#else
+	FileOpenDialog::FileOpenDialog(ResourceType RSType)
+	{
+	}
+
+	void FileOpenDialog::Show()
+	{
+		GX_ENGINE_WARN("FileOpenDialog: The file dialog is only available on Windows");
+	}
+
+	FileOpenDialog::~FileOpenDialog()
+	{
+	}
+#endif
 }
\ No newline at end of file
@@ -1,11 +1,13 @@
 #pragma once
 
+#ifdef _WIN32
 struct IFileOpenDialog;
 struct IKnownFolderManager;
 struct IKnownFolder;
 struct IShellItem;
 
 typedef struct _COMDLG_FILTERSPEC COMDLG_FILTERSPEC;
+#endif
 
 namespace GraphX
 {
@@ -16,7 +18,7 @@ namespace GraphX
 		MODELS
 	};
 
-	/* Dialog box to select a file from the windows explorer */
+	/* Dialog box to select a file from the windows explorer, the paths stay empty on other platforms */
 	class FileOpenDialog
 	{
 	public:
@@ -34,6 +36,7 @@ namespace GraphX
 
 		~FileOpenDialog();
 
+#ifdef _WIN32
 	private:
 		/* File types allowed for textures */
 		static const COMDLG_FILTERSPEC TextureFileTypes[];
@@ -59,6 +62,7 @@ namespace GraphX
 
 		/* Result of the Win API operation */
 		HRESULT m_Result;
+#endif
 
 		/* Path of the file relative to the parent folder */
 		std::wstring m_RelativePath;
@@ -6,195 +6,330 @@
 #include "Textures/Texture2D.h"
 #include "Utilities/EngineUtil.h"
 #include "Engine/Core/Materials/Material.h"
+#include "Engine/Core/AssetManager/AssetManager.h"
+#include "Subsystems/Multithreading/Async/AsyncTask.h"
+#include "MeshCache.h"
+#include "MeshOptimizer.h"
 
 #include "assimp/Importer.hpp"
 #include "assimp/scene.h"
 #include "assimp/postprocess.h"
 
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
 namespace GraphX
 {
 	using namespace GM;
 
-	std::shared_ptr<Importer> Importer::s_Importer = nullptr;
+	/* Returns the Assimp post processing steps for the import flags */
+	static unsigned int GetPostProcessSteps(uint32_t Flags)
+	{
+		unsigned int Steps = aiProcess_Triangulate | aiProcess_FlipUVs;
+
+		if (Flags & ImportFlags::JoinIdenticalVertices)
+			Steps |= aiProcess_JoinIdenticalVertices;
+
+		if (Flags & ImportFlags::ImproveCacheLocality)
+			Steps |= aiProcess_ImproveCacheLocality;
+
+		if (Flags & ImportFlags::OptimizeMeshes)
+			Steps |= aiProcess_OptimizeMeshes;
+
+		if (Flags & ImportFlags::GenSmoothNormals)
+			Steps |= aiProcess_GenSmoothNormals;
+
+		if (Flags & ImportFlags::CalcTangentSpace)
+			Steps |= aiProcess_CalcTangentSpace;
+
+		return Steps;
+	}
 
-	const std::shared_ptr<Importer>& Importer::Get()
+	/* Copies the vertices and the indices of a mesh of the scene to the offsets of its section */
+	static void CopySubMesh(const aiMesh* iMesh, Vertex3D* Vertices, uint32_t* Indices)
 	{
-		if (s_Importer == nullptr)
+		const size_t NumVertices = (size_t)iMesh->mNumVertices;
+
+		// Extract the Vertex positions
+		if (iMesh->HasPositions())
+		{
+			for (size_t i = 0; i < NumVertices; i++)
+			{
+				Vertices[i].Position = Vector3(iMesh->mVertices[i].x, iMesh->mVertices[i].y, iMesh->mVertices[i].z);
+			}
+		}
+
+		// Extract the Normals
+		if (iMesh->HasNormals())
+		{
+			for (size_t i = 0; i < NumVertices; i++)
+			{
+				Vertices[i].Normal = Vector3(iMesh->mNormals[i].x, iMesh->mNormals[i].y, iMesh->mNormals[i].z);
+			}
+		}
+
+		// Extract the Texture coordinates
+		// TODO: Extract texture coordinates for other channels too
+		if (iMesh->HasTextureCoords(0))
+		{
+			for (size_t i = 0; i < NumVertices; i++)
+			{
+				Vertices[i].TexCoord = Vector2(iMesh->mTextureCoords[0][i].x, iMesh->mTextureCoords[0][i].y);
+			}
+		}
+
+		// Extract indices (relative to the first vertex of the section)
+		if (iMesh->HasFaces())
 		{
-			s_Importer.reset(new Importer());
+			for (unsigned int i = 0; i < iMesh->mNumFaces; i++)
+			{
+				const aiFace& iFace = iMesh->mFaces[i];
+				for (unsigned int j = 0; j < iFace.mNumIndices; j++)
+				{
+					*Indices++ = iFace.mIndices[j];
+				}
+			}
 		}
 
-		return s_Importer;
+		// TODO: Extract vertex colors
+	}
+
+	/*
+	* Sub meshes shared between the importing thread and the thread pool helpers
+	* Every thread claims the next sub mesh until all are claimed, so the importing thread never waits on a helper which is not running yet
+	* (The import itself may be running on the thread pool)
+	*/
+	struct SubMeshCopyState
+	{
+		const aiScene* Scene = nullptr;
+		Vertex3D* Vertices = nullptr;
+		uint32_t* Indices = nullptr;
+
+		/* First vertex and index of each sub mesh */
+		std::vector<uint32_t> VertexOffsets;
+		std::vector<uint32_t> IndexOffsets;
+
+		uint32_t Count = 0;
+		std::atomic<uint32_t> NextMesh{ 0 };
+		std::atomic<uint32_t> CopiedMeshes{ 0 };
+
+		std::mutex Mutex;
+		std::condition_variable Copied;
+	};
+
+	/* Copies the sub meshes until all of them are claimed */
+	static void CopyClaimedSubMeshes(SubMeshCopyState& State)
+	{
+		uint32_t MeshIndex;
+		while ((MeshIndex = State.NextMesh++) < State.Count)
+		{
+			CopySubMesh(State.Scene->mMeshes[MeshIndex], State.Vertices + State.VertexOffsets[MeshIndex], State.Indices + State.IndexOffsets[MeshIndex]);
+
+			if (++State.CopiedMeshes == State.Count)
+			{
+				std::lock_guard<std::mutex> Lock(State.Mutex);
+				State.Copied.notify_all();
+			}
+		}
 	}
 
-	bool Importer::ImportMesh(const std::string& FilePath, Mesh3D* InMesh, const Ref<Material>& Mat)
+	bool Importer::ImportMesh(const std::string& FilePath, Mesh3D* InMesh, const Ref<Material>& Mat, uint32_t Flags)
 	{
+		GX_PROFILE_FUNCTION()
+
+		std::vector<MeshMaterialReference> Materials;
+		GM::BoxBounds Bounds;
+
+		// Binary cache is copied in to the mesh as it is, without parsing the source file
+		if (GX_ENABLE_MESH_CACHE && MeshCache::Load(FilePath, Flags, *InMesh->GetRawData(), Materials, Bounds))
+		{
+			InMesh->SetBounds(Bounds);
+			AddMaterials(Materials, InMesh, Mat);
+			return true;
+		}
+
+		// Local to the import, so that the files can be imported on multiple threads at once
 		Assimp::Importer AssimpImporter;
-		const aiScene* Scene = AssimpImporter.ReadFile(FilePath, aiProcess_Triangulate | aiProcess_FlipUVs);
+		const aiScene* Scene = AssimpImporter.ReadFile(FilePath, GetPostProcessSteps(Flags));
 
 		if (Scene == nullptr || Scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || Scene->mRootNode == nullptr)
 		{
+			GX_ENGINE_ERROR("Importer: Failed to import {0} : {1}", FilePath, AssimpImporter.GetErrorString());
 			return false;
 		}
 
 		// Extract meshes from the Scene object
-		return BuildMeshFromAssimpScene(FilePath, Scene, InMesh, Mat);
+		if (!BuildMeshFromAssimpScene(FilePath, Scene, InMesh, Materials))
+			return false;
+
+		// Optimised order is what gets cached, so it is only paid for on the first import
+		if (Flags & ImportFlags::OptimizeDrawOrder)
+			MeshOptimizer::Optimize(*InMesh->GetRawData(), FilePath);
+
+		AddMaterials(Materials, InMesh, Mat);
+
+		const RawMeshData& RawData = *InMesh->GetRawData();
+		GM::BoundingBox Box;
+		for (const Vertex3D& Vertex : RawData.Vertices)
+			Box += Vertex.Position;
+
+		Bounds = GM::BoxBounds(Box);
+		InMesh->SetBounds(Bounds);
+
+		if (GX_ENABLE_MESH_CACHE)
+			MeshCache::Store(FilePath, Flags, RawData, Materials, Bounds);
+
+		return true;
 	}
 
-	bool Importer::BuildMeshFromAssimpScene(const std::string& FilePath, const aiScene* Scene, Mesh3D* InMesh, const Ref<Material>& InMat)
+	bool Importer::BuildMeshFromAssimpScene(const std::string& FilePath, const aiScene* Scene, Mesh3D* InMesh, std::vector<MeshMaterialReference>& OutMaterials)
 	{
+		GX_PROFILE_FUNCTION()
+
 		if (!Scene->HasMeshes())
 			return false;
 
 		RawMeshData* RawData = InMesh->GetRawData();
-		const MaterialToSectionMap& MaterialMap = InMesh->GetMaterialMap();
-		std::vector<Vertex3D>& Vertices = RawData->Vertices;
-		std::vector<uint32_t>& Indices = RawData->Indices;
 		std::vector<RawMeshData::MeshSectionInfo>& Infos = RawData->SectionInfos;
-		
-		std::unordered_map<unsigned int, uint32_t> AssimpMaterialIndexMap;
 
-		uint32_t VerticesOffset = 0;
-		uint32_t IndicesOffset = 0;
+		std::shared_ptr<SubMeshCopyState> State = std::make_shared<SubMeshCopyState>();
+		State->Scene = Scene;
+		State->Count = Scene->mNumMeshes;
+		State->VertexOffsets.resize(State->Count);
+		State->IndexOffsets.resize(State->Count);
+
+		std::unordered_map<unsigned int, uint32_t> AssimpMaterialIndexMap;
+		const std::string FileLocation = EngineUtil::ExtractFileLocation(FilePath);
 
 		uint32_t VerticesCount = 0;
 		uint32_t IndicesCount = 0;
-		uint32_t SectionCount = Scene->mNumMeshes;
+		uint32_t ProvidedMaterialIndex = -1;
 
-		// Get the count of vertices and indices in this mesh
-		for (unsigned int i = 0; i < Scene->mNumMeshes; i++)
-		{
-			aiMesh* Mesh = Scene->mMeshes[i];
-			if(Mesh->HasPositions())
-			{
-				VerticesCount += Mesh->mNumVertices;
-			}
+		Infos.reserve(State->Count);
 
-			if (Mesh->HasFaces())
-			{
-				for (unsigned int i = 0; i < Mesh->mNumFaces; i++)
-				{
-					aiFace& Face = Mesh->mFaces[i];
-					IndicesCount += Face.mNumIndices;
-				}
-			}
-		}
-
-		// Expand the vertices and indices containers
-		RawData->Vertices.resize(VerticesCount);
-		RawData->Indices.resize(IndicesCount);
-		RawData->SectionInfos.reserve(SectionCount);
-
-		// Extract data from the mesh
+		// Place the sub meshes one after the other, and resolve their materials
 		for (unsigned int MeshIndex = 0; MeshIndex < Scene->mNumMeshes; MeshIndex++)
 		{
-			aiMesh* iMesh = Scene->mMeshes[MeshIndex];
+			const aiMesh* iMesh = Scene->mMeshes[MeshIndex];
 
-			size_t NumVertices = (size_t)iMesh->mNumVertices;
-			// Extract the Vertex positions
-			if (iMesh->HasPositions())
-			{
-				for (size_t i = 0; i < NumVertices; i++)
-				{
-					Vertices[VerticesOffset + i].Position = Vector3(iMesh->mVertices[i].x, iMesh->mVertices[i].y, iMesh->mVertices[i].z);
-				}
-			}
-
-			// Extract the Normals
-			if (iMesh->HasNormals())
-			{
-				for (size_t i = 0; i < NumVertices; i++)
-				{
-					Vertices[VerticesOffset + i].Normal = Vector3(iMesh->mNormals[i].x, iMesh->mNormals[i].y, iMesh->mNormals[i].z);
-				}
-			}
+			State->VertexOffsets[MeshIndex] = VerticesCount;
+			State->IndexOffsets[MeshIndex] = IndicesCount;
 
-			// Extract the Texture coordinates
-			// TODO: Extract texture coordinates for other channels too
-			if (iMesh->HasTextureCoords(0))
-			{
-				for (size_t i = 0; i < NumVertices; i++)
-				{
-					Vertices[VerticesOffset + i].TexCoord = Vector2(iMesh->mTextureCoords[0][i].x, iMesh->mTextureCoords[0][i].y);
-				}
-			}
+			RawMeshData::MeshSectionInfo Info;
+			Info.FirstVertexIndex = VerticesCount;
+			Info.FirstIndex = IndicesCount;
 
-			// Extract indices
-			uint32_t MeshIndicesCount = 0;
-			if (iMesh->HasFaces())
+			VerticesCount += iMesh->mNumVertices;
+			for (unsigned int i = 0; i < iMesh->mNumFaces; i++)
 			{
-				unsigned int NumFaces = iMesh->mNumFaces;
-				for (unsigned int i = 0; i < NumFaces; i++)
-				{
-					const aiFace& iFace = iMesh->mFaces[i];
-					for (unsigned int j = 0; j < iFace.mNumIndices; j++)
-					{
-						Indices[IndicesOffset + MeshIndicesCount + j] = iFace.mIndices[j];
-					}
-
-					MeshIndicesCount += iFace.mNumIndices;
-				}
+				IndicesCount += iMesh->mFaces[i].mNumIndices;
 			}
 
-			// TODO: Extract vertex colors
-
 			// Textures
 			if (Scene->HasMaterials())
 			{
-				Ref<Material> NewMaterial = nullptr;
-				uint32_t MaterialIndex = -1;
 				auto itr = AssimpMaterialIndexMap.find(iMesh->mMaterialIndex);
 				if (itr != AssimpMaterialIndexMap.end())
 				{
-					MaterialIndex = itr->second;
-					NewMaterial = InMesh->GetMaterial(itr->second);
+					Info.MaterialIndex = itr->second;
 				}
 				else
 				{
-					NewMaterial = CreateRef<Material>(InMat.operator*());
-					aiMaterial* mat = Scene->mMaterials[iMesh->mMaterialIndex];
+					MeshMaterialReference NewMaterial;
+					const aiMaterial* mat = Scene->mMaterials[iMesh->mMaterialIndex];
 					unsigned int TexCount = mat->GetTextureCount(aiTextureType::aiTextureType_DIFFUSE);
-					aiString* Path = new aiString();
-					std::string FileLocation = EngineUtil::ExtractFileLocation(FilePath);
+					aiString Path;
 					for (unsigned int i = 0; i < TexCount; i++)
 					{
-						mat->GetTexture(aiTextureType::aiTextureType_DIFFUSE, i, Path);
-						std::string FileName = EngineUtil::ExtractFileName(Path->C_Str());
-						NewMaterial->AddTexture(CreateRef<Texture2D>(FileLocation + '\\' + FileName));
-					}
+						mat->GetTexture(aiTextureType::aiTextureType_DIFFUSE, i, &Path);
 
-					// If no texture is loaded with the model, load the provided materials textures
-					// TODO: In case the provided material doesn't have textures either, provide the default material
-					if (TexCount == 0)
-					{
-						NewMaterial->AddTexture(InMat->GetTextures());
+						// Textures are looked up next to the model file (with their extension)
+						std::string TexturePath = Path.C_Str();
+						size_t LastSlash = TexturePath.find_last_of("/\\");
+						std::string FileName = LastSlash == std::string::npos ? TexturePath : TexturePath.substr(LastSlash + 1);
+						NewMaterial.TexturePaths.emplace_back(FileLocation.empty() ? FileName : FileLocation + '\\' + FileName);
 					}
 
-					MaterialIndex = InMesh->AddMaterial(NewMaterial);
+					Info.MaterialIndex = (uint32_t)OutMaterials.size();
+					AssimpMaterialIndexMap[iMesh->mMaterialIndex] = Info.MaterialIndex;
+					OutMaterials.emplace_back(NewMaterial);
+				}
+			}
+			else
+			{
+				// No Materials were loaded with the mesh, add the provided material (Special case)
+				if (ProvidedMaterialIndex == (uint32_t)-1)
+				{
+					MeshMaterialReference ProvidedMaterial;
+					ProvidedMaterial.UsesProvidedMaterial = true;
+
+					ProvidedMaterialIndex = (uint32_t)OutMaterials.size();
+					OutMaterials.emplace_back(ProvidedMaterial);
 				}
 
-				RawMeshData::MeshSectionInfo Info;
-				Info.FirstVertexIndex = VerticesOffset;
-				Info.FirstIndex = IndicesOffset;
-				Info.MaterialIndex = MaterialIndex;
-				Infos.emplace_back(Info);
+				Info.MaterialIndex = ProvidedMaterialIndex;
 			}
 
-			VerticesOffset += iMesh->mNumVertices;
-			IndicesOffset += MeshIndicesCount;
+			Infos.emplace_back(Info);
 		}
 
-		// No Materials were loaded with the mesh, add the provided material (Special case)
-		if (Infos.size() == 0)
-		{ 
-			RawMeshData::MeshSectionInfo Info;
-			Info.FirstVertexIndex = 0;
-			Info.FirstIndex = 0;
-			Info.MaterialIndex = InMesh->AddMaterial(InMat);
-			Infos.emplace_back(Info);
+		// Expand the vertices and indices containers
+		RawData->Vertices.resize(VerticesCount);
+		RawData->Indices.resize(IndicesCount);
+		State->Vertices = RawData->Vertices.data();
+		State->Indices = RawData->Indices.data();
+
+		// Sub meshes are copied in parallel, helped by the thread pool (once it is running)
+		uint32_t HelperCount = 0;
+		if (g_GlobalThreadPool != nullptr && State->Count > 1 && VerticesCount >= EngineConstants::ImporterParallelCopyMinVertices)
+		{
+			HelperCount = std::min(State->Count - 1, g_GlobalThreadPool->GetNumThreads());
+		}
+
+		for (uint32_t i = 0; i < HelperCount; i++)
+		{
+			// Helpers which start after the sub meshes have all been claimed return without touching the scene
+			Async<void>(AsyncExecutionPolicy::ThreadPool, [State]() {
+				CopyClaimedSubMeshes(*State);
+			});
+		}
+
+		CopyClaimedSubMeshes(*State);
+
+		// Scene is released by the Assimp importer once this returns, so wait for the sub meshes claimed by the helpers
+		{
+			std::unique_lock<std::mutex> Lock(State->Mutex);
+			State->Copied.wait(Lock, [&State]() { return State->CopiedMeshes == State->Count; });
 		}
 
 		return true;
 	}
 
+
+	void Importer::AddMaterials(const std::vector<MeshMaterialReference>& Materials, Mesh3D* InMesh, const Ref<Material>& InMat)
+	{
+		for (const MeshMaterialReference& Reference : Materials)
+		{
+			if (Reference.UsesProvidedMaterial)
+			{
+				InMesh->AddMaterial(InMat);
+				continue;
+			}
+
+			Ref<Material> NewMaterial = CreateRef<Material>(InMat.operator*());
+			for (const std::string& TexturePath : Reference.TexturePaths)
+				NewMaterial->AddTexture(AssetManager::LoadTexture2D(TexturePath, false, TextureLoadMode::Streamed));
+
+			// If no texture is loaded with the model, load the provided materials textures
+			// TODO: In case the provided material doesn't have textures either, provide the default material
+			if (Reference.TexturePaths.empty())
+			{
+				NewMaterial->AddTexture(InMat->GetTextures());
+			}
+
+			InMesh->AddMaterial(NewMaterial);
+		}
+	}
+
 }
\ No newline at end of file
@@ -4,26 +4,53 @@ struct aiScene;
 
 namespace GraphX
 {
+	struct MeshMaterialReference;
+
+	/* Post processing steps run on the imported scene (Added on top of the triangulation and the UV flip, which are always run) */
+	namespace ImportFlags
+	{
+		enum Type : uint32_t
+		{
+			None = 0,
+
+			/* Merges the identical vertices of a mesh, so that they are shared by the faces through the indices */
+			JoinIdenticalVertices = 1 << 0,
+
+			/* Reorders the triangles for the post transform vertex cache (Not run by default, OptimizeDrawOrder reorders them again along with the overdraw) */
+			ImproveCacheLocality = 1 << 1,
+
+			/* Merges the meshes using the same material, to reduce the number of sections (draw calls) */
+			OptimizeMeshes = 1 << 2,
+
+			/* Generates the smooth normals of the meshes without any */
+			GenSmoothNormals = 1 << 3,
+
+			/* Generates the tangents and bitangents (Not stored in Vertex3D yet, so not run by default) */
+			CalcTangentSpace = 1 << 4,
+
+			/* Runs the mesh optimizer on the imported sections (Vertex cache, overdraw and vertex fetch order) */
+			OptimizeDrawOrder = 1 << 5,
+
+			Default = JoinIdenticalVertices | OptimizeMeshes | GenSmoothNormals | OptimizeDrawOrder
+		};
+	}
+
 	/**
 	 * Importer used to import different types of objects (Currently uses Assimp)
+	 * Every import uses its own Assimp importer and builds only the CPU data, so the meshes can be imported concurrently (e.g. on the thread pool)
+	 * Textures of the materials are streamed, and the buffers are created by Mesh3D::InitResources on the render thread
 	 */
 	class Importer
 	{
 	public:
-		/* Returns the only Importer Instance */
-		static const std::shared_ptr<Importer>& Get();
-
 		/* Imports the scene from the specified file as a Mesh3D into the provided mesh. Returns if the model was loaded correctly or not */
-		bool ImportMesh(const std::string& FilePath, class Mesh3D* InMesh, const Ref<class Material>& Mat);
+		static bool ImportMesh(const std::string& FilePath, class Mesh3D* InMesh, const Ref<class Material>& Mat, uint32_t Flags = ImportFlags::Default);
 
 	private:
-		Importer() {}
-
 		/* Processes the scene loaded using the Assimp library */
-		bool BuildMeshFromAssimpScene(const std::string& FilePath, const aiScene* Scene, class Mesh3D* InMesh, const Ref<class Material>& Mat);
+		static bool BuildMeshFromAssimpScene(const std::string& FilePath, const aiScene* Scene, class Mesh3D* InMesh, std::vector<MeshMaterialReference>& OutMaterials);
 
-	private:
-		/* Importer Instance */
-		static std::shared_ptr<Importer> s_Importer;
+		/* Adds the materials referenced by the imported mesh to it (in the order of the references) */
+		static void AddMaterials(const std::vector<MeshMaterialReference>& Materials, class Mesh3D* InMesh, const Ref<class Material>& Mat);
 	};
 }
\ No newline at end of file
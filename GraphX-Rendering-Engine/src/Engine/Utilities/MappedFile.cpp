@@ -0,0 +1,105 @@
+#include "pch.h"
+#include "MappedFile.h"
+
+#ifdef _WIN32
+	#include <Windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace GraphX
+{
+	MappedFile::MappedFile()
+		: m_Data(nullptr), m_Size(0), m_FileHandle(nullptr), m_MappingHandle(nullptr)
+	{
+	}
+
+	bool MappedFile::Open(const std::string& FilePath)
+	{
+		GX_PROFILE_FUNCTION()
+
+		Close();
+
+#ifdef _WIN32
+		HANDLE File = CreateFileA(FilePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (File == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER FileSize;
+		if (!GetFileSizeEx(File, &FileSize) || FileSize.QuadPart == 0)
+		{
+			CloseHandle(File);
+			return false;
+		}
+
+		HANDLE Mapping = CreateFileMappingA(File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (Mapping == nullptr)
+		{
+			CloseHandle(File);
+			return false;
+		}
+
+		const void* View = MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0);
+		if (View == nullptr)
+		{
+			CloseHandle(Mapping);
+			CloseHandle(File);
+			return false;
+		}
+
+		m_FileHandle = File;
+		m_MappingHandle = Mapping;
+		m_Data = (const uint8_t*)View;
+		m_Size = (size_t)FileSize.QuadPart;
+#else
+		const int File = open(FilePath.c_str(), O_RDONLY);
+		if (File < 0)
+			return false;
+
+		struct stat FileStatus;
+		if (fstat(File, &FileStatus) != 0 || FileStatus.st_size == 0)
+		{
+			close(File);
+			return false;
+		}
+
+		void* View = mmap(nullptr, (size_t)FileStatus.st_size, PROT_READ, MAP_PRIVATE, File, 0);
+		close(File);
+
+		if (View == MAP_FAILED)
+			return false;
+
+		m_Data = (const uint8_t*)View;
+		m_Size = (size_t)FileStatus.st_size;
+#endif
+
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (!m_Data)
+			return;
+
+#ifdef _WIN32
+		UnmapViewOfFile(m_Data);
+		CloseHandle((HANDLE)m_MappingHandle);
+		CloseHandle((HANDLE)m_FileHandle);
+#else
+		munmap((void*)m_Data, m_Size);
+#endif
+
+		m_Data = nullptr;
+		m_Size = 0;
+		m_FileHandle = nullptr;
+		m_MappingHandle = nullptr;
+	}
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+
+namespace GraphX
+{
+	/* Read only view of a file mapped in to the memory (Pages are read from the disk as they are accessed, without copying the file) */
+	class MappedFile
+	{
+	public:
+		MappedFile();
+
+		/* Maps the whole file. Returns false if the file can not be opened (or is empty) */
+		bool Open(const std::string& FilePath);
+
+		void Close();
+
+		/* Returns whether a file is mapped */
+		inline bool IsOpen() const { return m_Data != nullptr; }
+
+		/* Returns the contents of the file */
+		inline const uint8_t* GetData() const { return m_Data; }
+		inline size_t GetSize() const { return m_Size; }
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		~MappedFile();
+
+	private:
+		const uint8_t* m_Data;
+		size_t m_Size;
+
+		/* Native handles of the file and of the mapping */
+		void* m_FileHandle;
+		void* m_MappingHandle;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,297 @@
+#include "pch.h"
+#include "MeshCache.h"
+
+#include "Vertex.h"
+#include "Model/Mesh/Mesh3D.h"
+#include "MappedFile.h"
+#include "EngineUtil.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace GraphX
+{
+	/* Header at the start of a mesh cache file */
+	struct MeshCacheFileHeader
+	{
+		/* 'GXMS' */
+		uint32_t Magic = 0x534d5847;
+
+		/* Bumped whenever the layout of the file changes */
+		uint32_t Version = 2;
+
+		/* Size of a vertex and of an index (A cache written with a different vertex layout is ignored) */
+		uint32_t VertexStride = sizeof(Vertex3D);
+		uint32_t IndexStride = sizeof(uint32_t);
+
+		/* Post processing steps the mesh was imported with (A cache imported with different steps is ignored) */
+		uint32_t ImportFlags = 0;
+
+		uint32_t VertexCount = 0;
+		uint32_t IndexCount = 0;
+		uint32_t SectionCount = 0;
+		uint32_t MaterialCount = 0;
+
+		/* Offsets of the blocks from the start of the file */
+		uint64_t VertexOffset = 0;
+		uint64_t IndexOffset = 0;
+		uint64_t SectionOffset = 0;
+		uint64_t MaterialOffset = 0;
+
+		/* Size of the whole file (guards against the partially written files) */
+		uint64_t FileSize = 0;
+
+		/* Bounds of all the vertices */
+		float BoundsOrigin[3] = { 0.0f, 0.0f, 0.0f };
+		float BoundsExtent[3] = { 0.0f, 0.0f, 0.0f };
+	};
+
+	// Vertices are copied to (and from) the cache as they are, like they are uploaded to the vertex buffer
+	static_assert(std::is_standard_layout<Vertex3D>::value && sizeof(Vertex3D) == 8 * sizeof(float), "Vertex3D has to be tightly packed floats");
+	static_assert(std::is_trivially_copyable<RawMeshData::MeshSectionInfo>::value, "Sections are copied to the mesh cache as they are");
+
+	/* Flags of a material in the cache */
+	static const uint32_t MaterialUsesProvidedMaterial = 1 << 0;
+
+	/* Blocks are aligned, so that the vertices can be uploaded straight from the mapped file */
+	static const uint64_t MeshCacheBlockAlignment = 16;
+
+	static uint64_t AlignOffset(uint64_t Offset)
+	{
+		return (Offset + MeshCacheBlockAlignment - 1) & ~(MeshCacheBlockAlignment - 1);
+	}
+
+	/* Whether the block is inside the file (Written so that the offsets read from a corrupt header can not wrap around) */
+	static bool IsInFile(uint64_t Offset, uint64_t Bytes, uint64_t FileSize)
+	{
+		return Offset <= FileSize && Bytes <= FileSize - Offset;
+	}
+
+	/* Checks that the sections are in order and inside the mesh, and that their indices refer to their own vertices (Like the mesh optimizer does) */
+	static bool AreSectionsValid(const RawMeshData& RawData, uint32_t MaterialCount)
+	{
+		const uint32_t TotalVertices = (uint32_t)RawData.Vertices.size();
+		const uint32_t TotalIndices = (uint32_t)RawData.Indices.size();
+		const std::vector<RawMeshData::MeshSectionInfo>& Sections = RawData.SectionInfos;
+
+		// Mesh without the sections is a single section
+		if (Sections.empty())
+			return std::all_of(RawData.Indices.begin(), RawData.Indices.end(), [TotalVertices](uint32_t Index) { return Index < TotalVertices; });
+
+		for (size_t i = 0; i < Sections.size(); i++)
+		{
+			const uint32_t FirstVertex = Sections[i].FirstVertexIndex;
+			const uint32_t FirstIndex = Sections[i].FirstIndex;
+			const uint32_t LastVertex = i + 1 < Sections.size() ? Sections[i + 1].FirstVertexIndex : TotalVertices;
+			const uint32_t LastIndex = i + 1 < Sections.size() ? Sections[i + 1].FirstIndex : TotalIndices;
+
+			if (LastVertex < FirstVertex || LastIndex < FirstIndex || LastVertex > TotalVertices || LastIndex > TotalIndices || Sections[i].MaterialIndex >= MaterialCount)
+				return false;
+
+			const uint32_t VertexCount = LastVertex - FirstVertex;
+			const uint32_t* Indices = RawData.Indices.data() + FirstIndex;
+			if (std::any_of(Indices, Indices + (LastIndex - FirstIndex), [VertexCount](uint32_t Index) { return Index >= VertexCount; }))
+				return false;
+		}
+
+		return true;
+	}
+
+	/* Reads the values from the mapped file, checking that they are in the file */
+	class MeshCacheReader
+	{
+	public:
+		MeshCacheReader(const uint8_t* Data, size_t Size, uint64_t Offset)
+			: m_Data(Data), m_Size(Size), m_Offset(Offset)
+		{}
+
+		bool Read(void* Destination, uint64_t Bytes)
+		{
+			if (!IsInFile(m_Offset, Bytes, m_Size))
+				return false;
+
+			std::memcpy(Destination, m_Data + m_Offset, (size_t)Bytes);
+			m_Offset += Bytes;
+			return true;
+		}
+
+	private:
+		const uint8_t* m_Data;
+		size_t m_Size;
+		uint64_t m_Offset;
+	};
+
+	std::string MeshCache::GetCacheFilePath(const std::string& SourcePath)
+	{
+		return SourcePath + ".gxmesh";
+	}
+
+	bool MeshCache::Load(const std::string& SourcePath, uint32_t ImportFlags, RawMeshData& OutRawData, std::vector<MeshMaterialReference>& OutMaterials, GM::BoxBounds& OutBounds)
+	{
+		GX_PROFILE_FUNCTION()
+
+		const std::string CachePath = GetCacheFilePath(SourcePath);
+
+		// Source modified after the cache was written, has to be imported again
+		const int64_t CacheWriteTime = EngineUtil::GetFileWriteTime(CachePath);
+		if (CacheWriteTime == 0 || CacheWriteTime < EngineUtil::GetFileWriteTime(SourcePath))
+			return false;
+
+		MappedFile File;
+		if (!File.Open(CachePath))
+			return false;
+
+		MeshCacheFileHeader Expected;
+		MeshCacheFileHeader Header;
+		if (File.GetSize() < sizeof(Header))
+			return false;
+
+		std::memcpy(&Header, File.GetData(), sizeof(Header));
+		if (Header.Magic != Expected.Magic || Header.Version != Expected.Version || Header.VertexStride != Expected.VertexStride || Header.IndexStride != Expected.IndexStride || Header.ImportFlags != ImportFlags || Header.FileSize != File.GetSize())
+		{
+			GX_ENGINE_WARN("Mesh Cache: Ignoring the outdated cache file {0}", CachePath);
+			return false;
+		}
+
+		const uint64_t VerticesSize = (uint64_t)Header.VertexCount * sizeof(Vertex3D);
+		const uint64_t IndicesSize = (uint64_t)Header.IndexCount * sizeof(uint32_t);
+		const uint64_t SectionsSize = (uint64_t)Header.SectionCount * sizeof(RawMeshData::MeshSectionInfo);
+		if (!IsInFile(Header.VertexOffset, VerticesSize, File.GetSize()) || !IsInFile(Header.IndexOffset, IndicesSize, File.GetSize()) || !IsInFile(Header.SectionOffset, SectionsSize, File.GetSize()))
+		{
+			GX_ENGINE_WARN("Mesh Cache: Ignoring the invalid cache file {0}", CachePath);
+			return false;
+		}
+
+		// Blocks are in the layout of the vectors, so each one is a single copy out of the mapped file
+		OutRawData.Vertices.resize(Header.VertexCount);
+		OutRawData.Indices.resize(Header.IndexCount);
+		OutRawData.SectionInfos.resize(Header.SectionCount);
+		std::memcpy(OutRawData.Vertices.data(), File.GetData() + Header.VertexOffset, (size_t)VerticesSize);
+		std::memcpy(OutRawData.Indices.data(), File.GetData() + Header.IndexOffset, (size_t)IndicesSize);
+		std::memcpy(OutRawData.SectionInfos.data(), File.GetData() + Header.SectionOffset, (size_t)SectionsSize);
+
+		MeshCacheReader Reader(File.GetData(), File.GetSize(), Header.MaterialOffset);
+		OutMaterials.resize(Header.MaterialCount);
+		for (MeshMaterialReference& Material : OutMaterials)
+		{
+			uint32_t Flags = 0, TextureCount = 0;
+			if (!Reader.Read(&Flags, sizeof(Flags)) || !Reader.Read(&TextureCount, sizeof(TextureCount)))
+				return false;
+
+			Material.UsesProvidedMaterial = (Flags & MaterialUsesProvidedMaterial) != 0;
+			Material.TexturePaths.resize(TextureCount);
+			for (std::string& TexturePath : Material.TexturePaths)
+			{
+				uint32_t Length = 0;
+				if (!Reader.Read(&Length, sizeof(Length)) || Length > File.GetSize())
+					return false;
+
+				TexturePath.resize(Length);
+				if (!Reader.Read(&TexturePath[0], Length))
+					return false;
+			}
+		}
+
+		if (!AreSectionsValid(OutRawData, Header.MaterialCount))
+		{
+			GX_ENGINE_WARN("Mesh Cache: Ignoring the cache file {0}, its sections do not match its vertices", CachePath);
+			return false;
+		}
+
+		OutBounds = GM::BoxBounds(GM::Vector3(Header.BoundsOrigin[0], Header.BoundsOrigin[1], Header.BoundsOrigin[2]), GM::Vector3(Header.BoundsExtent[0], Header.BoundsExtent[1], Header.BoundsExtent[2]));
+		return true;
+	}
+
+	bool MeshCache::Store(const std::string& SourcePath, uint32_t ImportFlags, const RawMeshData& RawData, const std::vector<MeshMaterialReference>& Materials, const GM::BoxBounds& Bounds)
+	{
+		GX_PROFILE_FUNCTION()
+
+		MeshCacheFileHeader Header;
+		Header.ImportFlags = ImportFlags;
+		Header.VertexCount = (uint32_t)RawData.Vertices.size();
+		Header.IndexCount = (uint32_t)RawData.Indices.size();
+		Header.SectionCount = (uint32_t)RawData.SectionInfos.size();
+		Header.MaterialCount = (uint32_t)Materials.size();
+
+		Header.VertexOffset = AlignOffset(sizeof(Header));
+		Header.IndexOffset = AlignOffset(Header.VertexOffset + (uint64_t)Header.VertexCount * sizeof(Vertex3D));
+		Header.SectionOffset = AlignOffset(Header.IndexOffset + (uint64_t)Header.IndexCount * sizeof(uint32_t));
+		Header.MaterialOffset = AlignOffset(Header.SectionOffset + (uint64_t)Header.SectionCount * sizeof(RawMeshData::MeshSectionInfo));
+
+		std::vector<uint8_t> MaterialBlock;
+		auto Append = [&MaterialBlock](const void* Data, size_t Size) {
+			MaterialBlock.insert(MaterialBlock.end(), (const uint8_t*)Data, (const uint8_t*)Data + Size);
+		};
+
+		for (const MeshMaterialReference& Material : Materials)
+		{
+			const uint32_t Flags = Material.UsesProvidedMaterial ? MaterialUsesProvidedMaterial : 0;
+			const uint32_t TextureCount = (uint32_t)Material.TexturePaths.size();
+			Append(&Flags, sizeof(Flags));
+			Append(&TextureCount, sizeof(TextureCount));
+
+			for (const std::string& TexturePath : Material.TexturePaths)
+			{
+				const uint32_t Length = (uint32_t)TexturePath.size();
+				Append(&Length, sizeof(Length));
+				Append(TexturePath.data(), Length);
+			}
+		}
+
+		Header.FileSize = Header.MaterialOffset + MaterialBlock.size();
+
+		Header.BoundsOrigin[0] = Bounds.Origin.x;
+		Header.BoundsOrigin[1] = Bounds.Origin.y;
+		Header.BoundsOrigin[2] = Bounds.Origin.z;
+		Header.BoundsExtent[0] = Bounds.Extent.x;
+		Header.BoundsExtent[1] = Bounds.Extent.y;
+		Header.BoundsExtent[2] = Bounds.Extent.z;
+
+		// Written to a temporary file first, so a cache file is never read while it is partially written (Named by the thread, as the same model can be imported on several threads)
+		const std::string CachePath = GetCacheFilePath(SourcePath);
+		std::stringstream TempPath;
+		TempPath << CachePath << '.' << std::this_thread::get_id() << ".tmp";
+		const std::string TempFilePath = TempPath.str();
+		{
+			std::ofstream Stream(TempFilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+			if (!Stream.is_open())
+			{
+				GX_ENGINE_WARN("Mesh Cache: Failed to write {0}", CachePath);
+				return false;
+			}
+
+			const char Padding[MeshCacheBlockAlignment] = {};
+			auto WriteBlock = [&Stream, &Padding](uint64_t Offset, const void* Data, uint64_t Size) {
+				Stream.write(Padding, (std::streamsize)(Offset - (uint64_t)Stream.tellp()));
+				Stream.write((const char*)Data, (std::streamsize)Size);
+			};
+
+			Stream.write((const char*)&Header, sizeof(Header));
+			WriteBlock(Header.VertexOffset, RawData.Vertices.data(), (uint64_t)Header.VertexCount * sizeof(Vertex3D));
+			WriteBlock(Header.IndexOffset, RawData.Indices.data(), (uint64_t)Header.IndexCount * sizeof(uint32_t));
+			WriteBlock(Header.SectionOffset, RawData.SectionInfos.data(), (uint64_t)Header.SectionCount * sizeof(RawMeshData::MeshSectionInfo));
+			WriteBlock(Header.MaterialOffset, MaterialBlock.data(), MaterialBlock.size());
+
+			if (!Stream)
+			{
+				GX_ENGINE_WARN("Mesh Cache: Failed to write {0}", CachePath);
+				Stream.close();
+				std::remove(TempFilePath.c_str());
+				return false;
+			}
+		}
+
+		std::remove(CachePath.c_str());
+		if (std::rename(TempFilePath.c_str(), CachePath.c_str()) != 0)
+		{
+			std::remove(TempFilePath.c_str());
+			return false;
+		}
+
+		GX_ENGINE_INFO("Mesh Cache: Stored {0} ({1} vertices, {2} indices)", CachePath, Header.VertexCount, Header.IndexCount);
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+namespace GraphX
+{
+	struct RawMeshData;
+
+	/* Material of an imported mesh, as it is referenced by the file */
+	struct MeshMaterialReference
+	{
+		/* Whether the sections use the material the mesh is loaded with (Otherwise they use a copy of it, with the textures below) */
+		bool UsesProvidedMaterial = false;
+
+		/* Paths to the diffuse textures (Textures of the provided material are used when there are none) */
+		std::vector<std::string> TexturePaths;
+	};
+
+	/*
+	* Binary cache of the imported meshes, written next to the source file (e.g. tree.obj.gxmesh)
+	* Vertices and indices are stored in the layout they are uploaded in (aligned to 16 bytes), so the file is mapped and copied without any parsing
+	* A cache file is only used while it is newer than the source, and has the same version, vertex layout and import flags as the engine
+	*/
+	class MeshCache
+	{
+	public:
+		/* Returns the path of the cache file for the source file */
+		static std::string GetCacheFilePath(const std::string& SourcePath);
+
+		/* Loads the mesh from the cache of the source file. Returns false if there is no (valid, up to date) cache and the source has to be imported */
+		static bool Load(const std::string& SourcePath, uint32_t ImportFlags, RawMeshData& OutRawData, std::vector<MeshMaterialReference>& OutMaterials, GM::BoxBounds& OutBounds);
+
+		/* Writes the imported mesh to the cache of the source file */
+		static bool Store(const std::string& SourcePath, uint32_t ImportFlags, const RawMeshData& RawData, const std::vector<MeshMaterialReference>& Materials, const GM::BoxBounds& Bounds);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,431 @@
+#include "pch.h"
+#include "MeshOptimizer.h"
+
+#include "Engine/Core/Vertex.h"
+#include "Model/Mesh/Mesh3D.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace GraphX
+{
+	using namespace GM;
+
+	/* Vertex score constants of the Forsyth optimisation (The cache here is only used for scoring, and is not the size of the hardware cache) */
+	static const uint32_t ForsythCacheSize = 32;
+	static const float ForsythCacheDecayPower = 1.5f;
+	static const float ForsythLastTriangleScore = 0.75f;
+	static const float ForsythValenceBoostScale = 2.0f;
+	static const float ForsythValenceBoostPower = 0.5f;
+
+	/* Score of a vertex, from its position in the LRU cache (-1 if not cached) and the triangles not emitted yet using it */
+	static float ForsythVertexScore(int32_t CachePosition, uint32_t RemainingTriangles)
+	{
+		// Vertex is not used by any of the remaining triangles
+		if (RemainingTriangles == 0)
+			return -1.0f;
+
+		float Score = 0.0f;
+		if (CachePosition >= 0)
+		{
+			// Vertices of the last triangle get a fixed score, so that the next triangle doesn't strictly need to share an edge with it
+			if (CachePosition < 3)
+			{
+				Score = ForsythLastTriangleScore;
+			}
+			else
+			{
+				const float Scale = 1.0f / (ForsythCacheSize - 3);
+				Score = std::pow(1.0f - (CachePosition - 3) * Scale, ForsythCacheDecayPower);
+			}
+		}
+
+		// Boost the vertices with a few triangles left, so that they are finished off instead of being left stranded
+		Score += ForsythValenceBoostScale * std::pow((float)RemainingTriangles, -ForsythValenceBoostPower);
+		return Score;
+	}
+
+	/* Simulates the FIFO cache for a triangle (A vertex is cached if it was one of the last CacheSize vertices transformed). Returns the number of cache misses */
+	static uint32_t SimulateFIFOCache(const uint32_t* Triangle, std::vector<uint32_t>& CacheTimestamps, uint32_t& Timestamp, uint32_t CacheSize)
+	{
+		uint32_t Misses = 0;
+		for (uint32_t k = 0; k < 3; k++)
+		{
+			const uint32_t Vertex = Triangle[k];
+			if (Timestamp - CacheTimestamps[Vertex] > CacheSize)
+			{
+				CacheTimestamps[Vertex] = Timestamp++;
+				Misses++;
+			}
+		}
+
+		return Misses;
+	}
+
+	VertexCacheStatistics& VertexCacheStatistics::operator+=(const VertexCacheStatistics& Other)
+	{
+		TriangleCount += Other.TriangleCount;
+		VertexCount += Other.VertexCount;
+		TransformedCount += Other.TransformedCount;
+		return *this;
+	}
+
+	void MeshOptimizer::Optimize(RawMeshData& RawData, const std::string& Name)
+	{
+		GX_PROFILE_FUNCTION()
+
+		const uint32_t TotalVertices = (uint32_t)RawData.Vertices.size();
+		const uint32_t TotalIndices = (uint32_t)RawData.Indices.size();
+
+		// A mesh without the section infos is a single section
+		std::vector<RawMeshData::MeshSectionInfo> Sections = RawData.SectionInfos;
+		if (Sections.empty())
+			Sections.emplace_back();
+
+		VertexCacheStatistics Before, After;
+		for (size_t i = 0; i < Sections.size(); i++)
+		{
+			const uint32_t FirstVertex = Sections[i].FirstVertexIndex;
+			const uint32_t FirstIndex = Sections[i].FirstIndex;
+			const uint32_t LastVertex = i + 1 < Sections.size() ? Sections[i + 1].FirstVertexIndex : TotalVertices;
+			const uint32_t LastIndex = i + 1 < Sections.size() ? Sections[i + 1].FirstIndex : TotalIndices;
+
+			if (LastVertex < FirstVertex || LastIndex < FirstIndex || LastVertex > TotalVertices || LastIndex > TotalIndices)
+			{
+				GX_ENGINE_WARN("Mesh Optimizer: Sections of {0} are not in order, the mesh is left as it is", Name);
+				return;
+			}
+
+			Vertex3D* Vertices = RawData.Vertices.data() + FirstVertex;
+			uint32_t* Indices = RawData.Indices.data() + FirstIndex;
+			const uint32_t VertexCount = LastVertex - FirstVertex;
+			const uint32_t IndexCount = LastIndex - FirstIndex;
+
+			// Indices are relative to the first vertex of the section, so they have to stay in its range
+			if (std::any_of(Indices, Indices + IndexCount, [VertexCount](uint32_t Index) { return Index >= VertexCount; }))
+			{
+				GX_ENGINE_WARN("Mesh Optimizer: Section {0} of {1} references vertices outside of it, the section is left as it is", i, Name);
+				continue;
+			}
+
+			Before += AnalyzeVertexCache(Indices, IndexCount, VertexCount);
+			Optimize(Vertices, VertexCount, Indices, IndexCount);
+			After += AnalyzeVertexCache(Indices, IndexCount, VertexCount);
+		}
+
+		GX_ENGINE_INFO("Mesh Optimizer: {0} ({1} triangles) ACMR {2:.3f} -> {3:.3f}, ATVR {4:.3f} -> {5:.3f}", Name, After.TriangleCount, Before.GetACMR(), After.GetACMR(), Before.GetATVR(), After.GetATVR());
+	}
+
+	void MeshOptimizer::Optimize(Vertex3D* Vertices, uint32_t VertexCount, uint32_t* Indices, uint32_t IndexCount)
+	{
+		OptimizeVertexCache(Indices, IndexCount, VertexCount);
+		OptimizeOverdraw(Indices, IndexCount, Vertices, VertexCount);
+		OptimizeVertexFetch(Vertices, VertexCount, Indices, IndexCount);
+	}
+
+	void MeshOptimizer::OptimizeVertexCache(uint32_t* Indices, uint32_t IndexCount, uint32_t VertexCount)
+	{
+		GX_PROFILE_FUNCTION()
+
+		const uint32_t TriangleCount = IndexCount / 3;
+		if (TriangleCount < 2)
+			return;
+
+		// Triangles using each vertex (The not emitted ones are kept at the front of the vertex's list)
+		std::vector<uint32_t> TriangleOffsets(VertexCount + 1, 0);
+		for (uint32_t i = 0; i < TriangleCount * 3; i++)
+			TriangleOffsets[Indices[i] + 1]++;
+
+		std::vector<uint32_t> RemainingTriangles(VertexCount);
+		for (uint32_t v = 0; v < VertexCount; v++)
+		{
+			RemainingTriangles[v] = TriangleOffsets[v + 1];
+			TriangleOffsets[v + 1] += TriangleOffsets[v];
+		}
+
+		std::vector<uint32_t> VertexTriangles(TriangleCount * 3);
+		{
+			std::vector<uint32_t> Cursors(TriangleOffsets.begin(), TriangleOffsets.end() - 1);
+			for (uint32_t t = 0; t < TriangleCount; t++)
+			{
+				for (uint32_t k = 0; k < 3; k++)
+					VertexTriangles[Cursors[Indices[t * 3 + k]]++] = t;
+			}
+		}
+
+		std::vector<int32_t> CachePositions(VertexCount, -1);
+		std::vector<float> VertexScores(VertexCount);
+		for (uint32_t v = 0; v < VertexCount; v++)
+			VertexScores[v] = ForsythVertexScore(-1, RemainingTriangles[v]);
+
+		std::vector<float> TriangleScores(TriangleCount);
+		std::vector<bool> Emitted(TriangleCount, false);
+		int64_t BestTriangle = -1;
+		float BestScore = -1.0f;
+		for (uint32_t t = 0; t < TriangleCount; t++)
+		{
+			TriangleScores[t] = VertexScores[Indices[t * 3]] + VertexScores[Indices[t * 3 + 1]] + VertexScores[Indices[t * 3 + 2]];
+			if (TriangleScores[t] > BestScore)
+			{
+				BestScore = TriangleScores[t];
+				BestTriangle = t;
+			}
+		}
+
+		std::vector<uint32_t> Output;
+		Output.reserve(TriangleCount * 3);
+
+		// LRU cache (with room for the vertices pushed out by the emitted triangle)
+		uint32_t Cache[ForsythCacheSize + 3];
+		uint32_t NewCache[ForsythCacheSize + 3];
+		uint32_t CacheCount = 0;
+		uint32_t ScanCursor = 0;
+
+		for (uint32_t Emit = 0; Emit < TriangleCount; Emit++)
+		{
+			// None of the cached vertices has any triangles left, continue from the first triangle not emitted yet
+			if (BestTriangle < 0)
+			{
+				while (Emitted[ScanCursor])
+					ScanCursor++;
+
+				BestTriangle = ScanCursor;
+			}
+
+			const uint32_t* Triangle = Indices + BestTriangle * 3;
+			Output.insert(Output.end(), Triangle, Triangle + 3);
+			Emitted[(size_t)BestTriangle] = true;
+
+			// Vertices of the triangle move to the front of the cache
+			uint32_t NewCacheCount = 0;
+			for (uint32_t k = 0; k < 3; k++)
+			{
+				if (std::find(NewCache, NewCache + NewCacheCount, Triangle[k]) == NewCache + NewCacheCount)
+					NewCache[NewCacheCount++] = Triangle[k];
+			}
+
+			for (uint32_t c = 0; c < CacheCount; c++)
+			{
+				const uint32_t Vertex = Cache[c];
+				if (Vertex != Triangle[0] && Vertex != Triangle[1] && Vertex != Triangle[2])
+					NewCache[NewCacheCount++] = Vertex;
+			}
+
+			// Remove the triangle from the lists of its vertices
+			for (uint32_t k = 0; k < 3; k++)
+			{
+				const uint32_t Vertex = Triangle[k];
+				uint32_t* Triangles = VertexTriangles.data() + TriangleOffsets[Vertex];
+				uint32_t& Remaining = RemainingTriangles[Vertex];
+
+				uint32_t* Found = std::find(Triangles, Triangles + Remaining, (uint32_t)BestTriangle);
+				if (Found != Triangles + Remaining)
+				{
+					std::swap(*Found, Triangles[Remaining - 1]);
+					Remaining--;
+				}
+			}
+
+			// Rescore the vertices whose cache position changed (including the ones pushed out of the cache)
+			for (uint32_t c = 0; c < NewCacheCount; c++)
+			{
+				const uint32_t Vertex = NewCache[c];
+				CachePositions[Vertex] = c < ForsythCacheSize ? (int32_t)c : -1;
+				VertexScores[Vertex] = ForsythVertexScore(CachePositions[Vertex], RemainingTriangles[Vertex]);
+			}
+
+			// Next triangle is the best of the ones using these vertices
+			BestTriangle = -1;
+			BestScore = 0.0f;
+			for (uint32_t c = 0; c < NewCacheCount; c++)
+			{
+				const uint32_t Vertex = NewCache[c];
+				const uint32_t* Triangles = VertexTriangles.data() + TriangleOffsets[Vertex];
+				for (uint32_t i = 0; i < RemainingTriangles[Vertex]; i++)
+				{
+					const uint32_t t = Triangles[i];
+					TriangleScores[t] = VertexScores[Indices[t * 3]] + VertexScores[Indices[t * 3 + 1]] + VertexScores[Indices[t * 3 + 2]];
+					if (TriangleScores[t] > BestScore)
+					{
+						BestScore = TriangleScores[t];
+						BestTriangle = t;
+					}
+				}
+			}
+
+			CacheCount = std::min(NewCacheCount, ForsythCacheSize);
+			std::copy(NewCache, NewCache + CacheCount, Cache);
+		}
+
+		std::copy(Output.begin(), Output.end(), Indices);
+	}
+
+	void MeshOptimizer::OptimizeOverdraw(uint32_t* Indices, uint32_t IndexCount, const Vertex3D* Vertices, uint32_t VertexCount, float Threshold)
+	{
+		GX_PROFILE_FUNCTION()
+
+		const uint32_t TriangleCount = IndexCount / 3;
+		if (TriangleCount < 2)
+			return;
+
+		const uint32_t CacheSize = EngineConstants::VertexCacheAnalysisSize;
+		std::vector<uint32_t> CacheTimestamps(VertexCount, 0);
+		uint32_t Timestamp = CacheSize + 1;
+
+		// Hard boundaries : The cache optimised order restarted (all the vertices of the triangle missed the cache)
+		std::vector<uint32_t> HardClusters;
+		for (uint32_t t = 0; t < TriangleCount; t++)
+		{
+			if (SimulateFIFOCache(Indices + t * 3, CacheTimestamps, Timestamp, CacheSize) == 3 || t == 0)
+				HardClusters.push_back(t);
+		}
+
+		// Soft boundaries : Split a hard cluster wherever the ACMR of the triangles so far is already within the threshold of the whole cluster's
+		// (Splitting flushes the cache, since the clusters are drawn in a different order)
+		std::vector<uint32_t> Clusters;
+		for (size_t c = 0; c < HardClusters.size(); c++)
+		{
+			const uint32_t Start = HardClusters[c];
+			const uint32_t End = c + 1 < HardClusters.size() ? HardClusters[c + 1] : TriangleCount;
+
+			Timestamp += CacheSize + 1;
+			uint32_t ClusterMisses = 0;
+			for (uint32_t t = Start; t < End; t++)
+				ClusterMisses += SimulateFIFOCache(Indices + t * 3, CacheTimestamps, Timestamp, CacheSize);
+
+			const float ClusterThreshold = Threshold * ClusterMisses / (End - Start);
+
+			Timestamp += CacheSize + 1;
+			Clusters.push_back(Start);
+
+			uint32_t RunStart = Start;
+			uint32_t RunMisses = 0;
+			for (uint32_t t = Start; t < End; t++)
+			{
+				RunMisses += SimulateFIFOCache(Indices + t * 3, CacheTimestamps, Timestamp, CacheSize);
+
+				if (t + 1 < End && RunMisses <= ClusterThreshold * (t + 1 - RunStart))
+				{
+					Clusters.push_back(t + 1);
+					RunStart = t + 1;
+					RunMisses = 0;
+					Timestamp += CacheSize + 1;
+				}
+			}
+		}
+
+		if (Clusters.size() < 2)
+			return;
+
+		// Area weighted centroid and normal of each cluster (and the centroid of the whole mesh)
+		std::vector<Vector3> Centroids(Clusters.size(), Vector3::ZeroVector);
+		std::vector<Vector3> Normals(Clusters.size(), Vector3::ZeroVector);
+		std::vector<float> Areas(Clusters.size(), 0.0f);
+		Vector3 MeshCentroid = Vector3::ZeroVector;
+		float MeshArea = 0.0f;
+
+		for (size_t c = 0; c < Clusters.size(); c++)
+		{
+			const uint32_t End = c + 1 < Clusters.size() ? Clusters[c + 1] : TriangleCount;
+			for (uint32_t t = Clusters[c]; t < End; t++)
+			{
+				const Vector3& P0 = Vertices[Indices[t * 3]].Position;
+				const Vector3& P1 = Vertices[Indices[t * 3 + 1]].Position;
+				const Vector3& P2 = Vertices[Indices[t * 3 + 2]].Position;
+
+				const Vector3 Normal = Vector3::CrossProduct(P1 - P0, P2 - P0);
+				const float Area = Normal.Magnitude();
+
+				Centroids[c] += (P0 + P1 + P2) * (Area / 3.0f);
+				Normals[c] += Normal;
+				Areas[c] += Area;
+			}
+
+			MeshCentroid += Centroids[c];
+			MeshArea += Areas[c];
+		}
+
+		if (MeshArea > 0.0f)
+			MeshCentroid /= MeshArea;
+
+		// Clusters facing away from the centre (on the outside of the mesh) are drawn first, and occlude the ones behind them
+		std::vector<float> SortKeys(Clusters.size(), 0.0f);
+		for (size_t c = 0; c < Clusters.size(); c++)
+		{
+			if (Areas[c] <= 0.0f || Normals[c].IsZero())
+				continue;
+
+			SortKeys[c] = Vector3::DotProduct(Centroids[c] / Areas[c] - MeshCentroid, Normals[c].Normal());
+		}
+
+		std::vector<uint32_t> Order(Clusters.size());
+		for (uint32_t c = 0; c < (uint32_t)Order.size(); c++)
+			Order[c] = c;
+
+		std::stable_sort(Order.begin(), Order.end(), [&SortKeys](uint32_t A, uint32_t B) { return SortKeys[A] > SortKeys[B]; });
+
+		std::vector<uint32_t> Output;
+		Output.reserve(TriangleCount * 3);
+		for (uint32_t c : Order)
+		{
+			const uint32_t End = c + 1 < Clusters.size() ? Clusters[c + 1] : TriangleCount;
+			Output.insert(Output.end(), Indices + Clusters[c] * 3, Indices + End * 3);
+		}
+
+		std::copy(Output.begin(), Output.end(), Indices);
+	}
+
+	void MeshOptimizer::OptimizeVertexFetch(Vertex3D* Vertices, uint32_t VertexCount, uint32_t* Indices, uint32_t IndexCount)
+	{
+		GX_PROFILE_FUNCTION()
+
+		const uint32_t Unused = (uint32_t)-1;
+		std::vector<uint32_t> Remap(VertexCount, Unused);
+		uint32_t NextVertex = 0;
+
+		for (uint32_t i = 0; i < IndexCount; i++)
+		{
+			uint32_t& NewIndex = Remap[Indices[i]];
+			if (NewIndex == Unused)
+				NewIndex = NextVertex++;
+
+			Indices[i] = NewIndex;
+		}
+
+		// Vertices which are not referenced are kept (at the end), so that the vertex range of the section doesn't change
+		for (uint32_t v = 0; v < VertexCount; v++)
+		{
+			if (Remap[v] == Unused)
+				Remap[v] = NextVertex++;
+		}
+
+		std::vector<Vertex3D> Reordered(VertexCount);
+		for (uint32_t v = 0; v < VertexCount; v++)
+			Reordered[Remap[v]] = Vertices[v];
+
+		std::copy(Reordered.begin(), Reordered.end(), Vertices);
+	}
+
+	VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache(const uint32_t* Indices, uint32_t IndexCount, uint32_t VertexCount, uint32_t CacheSize)
+	{
+		VertexCacheStatistics Statistics;
+		Statistics.TriangleCount = IndexCount / 3;
+
+		std::vector<uint32_t> CacheTimestamps(VertexCount, 0);
+		uint32_t Timestamp = CacheSize + 1;
+		for (uint32_t t = 0; t < Statistics.TriangleCount; t++)
+			Statistics.TransformedCount += SimulateFIFOCache(Indices + t * 3, CacheTimestamps, Timestamp, CacheSize);
+
+		std::vector<bool> Referenced(VertexCount, false);
+		for (uint32_t i = 0; i < Statistics.TriangleCount * 3; i++)
+		{
+			if (!Referenced[Indices[i]])
+			{
+				Referenced[Indices[i]] = true;
+				Statistics.VertexCount++;
+			}
+		}
+
+		return Statistics;
+	}
+}
\ No newline at end of file
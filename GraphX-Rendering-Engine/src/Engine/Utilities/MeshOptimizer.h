@@ -0,0 +1,54 @@
+#pragma once
+
+namespace GraphX
+{
+	struct Vertex3D;
+	struct RawMeshData;
+
+	/* Post transform vertex cache efficiency of a triangle list (simulated on a FIFO cache) */
+	struct VertexCacheStatistics
+	{
+		uint32_t TriangleCount = 0;
+
+		/* Number of distinct vertices referenced by the triangles */
+		uint32_t VertexCount = 0;
+
+		/* Number of vertices transformed (Cache misses) */
+		uint32_t TransformedCount = 0;
+
+		/* Average cache miss ratio : Vertices transformed per triangle (0.5 at best for a large grid, 3 at worst) */
+		inline float GetACMR() const { return TriangleCount ? (float)TransformedCount / TriangleCount : 0.0f; }
+
+		/* Average transform to vertex ratio : Vertices transformed per vertex (1 at best) */
+		inline float GetATVR() const { return VertexCount ? (float)TransformedCount / VertexCount : 0.0f; }
+
+		VertexCacheStatistics& operator+=(const VertexCacheStatistics& Other);
+	};
+
+	/*
+	* Reorders the triangles and the vertices of the meshes for the GPU, without changing what is drawn
+	* Triangles are ordered for the post transform vertex cache (Tom Forsyth's linear speed optimisation), then their clusters are sorted to draw the outer ones first (less overdraw),
+	* and the vertices are stored in the order they are first used (Vertex fetch locality)
+	*/
+	class MeshOptimizer
+	{
+	public:
+		/* Runs all the passes on each section of the mesh, and logs the cache statistics before and after them */
+		static void Optimize(RawMeshData& RawData, const std::string& Name);
+
+		/* Runs all the passes on a single section (Indices are relative to the first vertex) */
+		static void Optimize(Vertex3D* Vertices, uint32_t VertexCount, uint32_t* Indices, uint32_t IndexCount);
+
+		/* Reorders the triangles to reuse the vertices transformed by the recent triangles */
+		static void OptimizeVertexCache(uint32_t* Indices, uint32_t IndexCount, uint32_t VertexCount);
+
+		/* Sorts the clusters of the cache optimised triangles front to back (from the outside of the mesh in), as long as the ACMR of a cluster gets no worse than the threshold times the original */
+		static void OptimizeOverdraw(uint32_t* Indices, uint32_t IndexCount, const Vertex3D* Vertices, uint32_t VertexCount, float Threshold = 1.05f);
+
+		/* Reorders the vertices in the order they are first referenced by the indices (Vertices not referenced at all are moved to the end) */
+		static void OptimizeVertexFetch(Vertex3D* Vertices, uint32_t VertexCount, uint32_t* Indices, uint32_t IndexCount);
+
+		/* Simulates the FIFO vertex cache of the given size over the triangles */
+		static VertexCacheStatistics AnalyzeVertexCache(const uint32_t* Indices, uint32_t IndexCount, uint32_t VertexCount, uint32_t CacheSize = EngineConstants::VertexCacheAnalysisSize);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,313 @@
+#include "pch.h"
+#include "SelfTest.h"
+
+#include "Engine/Core/Textures/AtlasPacker.h"
+#include "Engine/Core/Textures/TextureAtlas.h"
+#include "Engine/Core/Textures/SubTexture2D.h"
+#include "Engine/Core/Renderer/LightClusterGrid.h"
+
+#include <cmath>
+#include <cstring>
+
+/* Logs the condition if it is false and counts it as a failure */
+#define GX_SELF_TEST_CHECK(Condition) if (!(Condition)) { GX_ENGINE_ERROR("Self test check failed : {0} ({1}:{2})", #Condition, __FILE__, __LINE__); Failures++; }
+
+namespace GraphX
+{
+	/* Returns whether all the rects are within the atlas and none of them overlap */
+	static bool AreRectsPacked(const std::vector<AtlasPacker::Rect>& Rects, uint32_t Width, uint32_t Height)
+	{
+		for (uint32_t i = 0; i < Rects.size(); i++)
+		{
+			const AtlasPacker::Rect& A = Rects[i];
+			if (A.X + A.Width > Width || A.Y + A.Height > Height)
+				return false;
+
+			for (uint32_t j = i + 1; j < Rects.size(); j++)
+			{
+				const AtlasPacker::Rect& B = Rects[j];
+				if (A.X < B.X + B.Width && B.X < A.X + A.Width && A.Y < B.Y + B.Height && B.Y < A.Y + A.Height)
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	/* Returns the RGBA8 pixel of the atlas at the texture coords */
+	static const uint8_t* GetAtlasPixel(const TextureAtlas& Atlas, const GM::Vector2& TexCoords, int32_t OffsetX = 0, int32_t OffsetY = 0)
+	{
+		uint32_t X = (uint32_t)((int32_t)std::lround(TexCoords.x * Atlas.GetWidth()) + OffsetX);
+		uint32_t Y = (uint32_t)((int32_t)std::lround(TexCoords.y * Atlas.GetHeight()) + OffsetY);
+		return &Atlas.GetPixels()[4 * (Y * Atlas.GetWidth() + X)];
+	}
+
+	/* Returns whether the light is assigned to the cluster */
+	static bool IsLightInCluster(const LightClusterGrid& Grid, uint32_t Cluster, uint32_t Light)
+	{
+		const uint32_t Offset = Grid.GetClusterData()[2 * Cluster];
+		const uint32_t Count = Grid.GetClusterData()[2 * Cluster + 1];
+		for (uint32_t i = Offset; i < Offset + Count; i++)
+		{
+			if (Grid.GetLightIndices()[i] == Light)
+				return true;
+		}
+
+		return false;
+	}
+
+	bool SelfTest::IsRequested(int argc, char** argv)
+	{
+		for (int i = 1; i < argc; i++)
+		{
+			if (std::string(argv[i]) == "--self-test")
+				return true;
+		}
+
+		return false;
+	}
+
+	bool SelfTest::Run()
+	{
+		// Application is not created, so the logger is initialised here
+		Log::Init();
+
+		uint32_t Failures = 0;
+		Failures += CheckAtlasPacker();
+		Failures += CheckTextureAtlas();
+		Failures += CheckLightClusterGrid();
+
+		if (Failures == 0)
+			GX_ENGINE_INFO("Self test passed");
+		else
+			GX_ENGINE_ERROR("Self test failed : {0} checks failed", Failures);
+
+		return Failures == 0;
+	}
+
+	uint32_t SelfTest::CheckAtlasPacker()
+	{
+		uint32_t Failures = 0;
+
+		// Rects of different sizes inserted one after the other
+		AtlasPacker Packer(64, 64);
+		const uint32_t Sizes[][2] = { { 16, 16 }, { 32, 8 }, { 8, 24 }, { 20, 20 }, { 12, 30 }, { 40, 10 } };
+
+		std::vector<AtlasPacker::Rect> Rects;
+		uint64_t UsedArea = 0;
+		for (const auto& Size : Sizes)
+		{
+			AtlasPacker::Rect NewRect;
+			GX_SELF_TEST_CHECK(Packer.Insert(Size[0], Size[1], NewRect));
+			GX_SELF_TEST_CHECK(NewRect.Width == Size[0] && NewRect.Height == Size[1]);
+
+			Rects.push_back(NewRect);
+			UsedArea += Size[0] * Size[1];
+		}
+
+		GX_SELF_TEST_CHECK(AreRectsPacked(Rects, 64, 64));
+		GX_SELF_TEST_CHECK(std::abs(Packer.GetOccupancy() - UsedArea / (64.0f * 64.0f)) < 1e-5f);
+
+		// Empty rects and rects larger than the atlas are never inserted
+		AtlasPacker::Rect Rejected;
+		GX_SELF_TEST_CHECK(!Packer.Insert(65, 1, Rejected));
+		GX_SELF_TEST_CHECK(!Packer.Insert(1, 65, Rejected));
+		GX_SELF_TEST_CHECK(!Packer.Insert(0, 4, Rejected));
+
+		// Atlas filled completely by equal tiles, nothing fits after that
+		Packer.Reset();
+		GX_SELF_TEST_CHECK(Packer.GetOccupancy() == 0.0f);
+
+		Rects.clear();
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			AtlasPacker::Rect NewRect;
+			GX_SELF_TEST_CHECK(Packer.Insert(16, 16, NewRect));
+			Rects.push_back(NewRect);
+		}
+
+		GX_SELF_TEST_CHECK(AreRectsPacked(Rects, 64, 64));
+		GX_SELF_TEST_CHECK(Packer.GetOccupancy() == 1.0f);
+		GX_SELF_TEST_CHECK(!Packer.Insert(1, 1, Rejected));
+
+		// Repack returns the rects in the order of the requests
+		std::vector<AtlasPacker::Request> Requests;
+		for (uint32_t i = 0; i < 6; i++)
+		{
+			AtlasPacker::Request NewRequest;
+			NewRequest.ID = i;
+			NewRequest.Width = Sizes[i][0];
+			NewRequest.Height = Sizes[i][1];
+			Requests.push_back(NewRequest);
+		}
+
+		GX_SELF_TEST_CHECK(Packer.Repack(Requests, Rects));
+		GX_SELF_TEST_CHECK(Rects.size() == Requests.size());
+		for (uint32_t i = 0; i < Rects.size() && i < Requests.size(); i++)
+		{
+			GX_SELF_TEST_CHECK(Rects[i].Width == Requests[i].Width && Rects[i].Height == Requests[i].Height);
+		}
+
+		GX_SELF_TEST_CHECK(AreRectsPacked(Rects, 64, 64));
+		GX_SELF_TEST_CHECK(std::abs(Packer.GetOccupancy() - UsedArea / (64.0f * 64.0f)) < 1e-5f);
+
+		// Requests which do not fit leave the atlas cleared
+		Requests.assign(4, AtlasPacker::Request());
+		for (AtlasPacker::Request& Request : Requests)
+		{
+			Request.Width = 40;
+			Request.Height = 40;
+		}
+
+		GX_SELF_TEST_CHECK(!Packer.Repack(Requests, Rects));
+		GX_SELF_TEST_CHECK(Packer.GetOccupancy() == 0.0f);
+
+		// Resized atlas fits them
+		Packer.Resize(128, 128);
+		GX_SELF_TEST_CHECK(Packer.Repack(Requests, Rects));
+		GX_SELF_TEST_CHECK(AreRectsPacked(Rects, 128, 128));
+
+		return Failures;
+	}
+
+	uint32_t SelfTest::CheckTextureAtlas()
+	{
+		uint32_t Failures = 0;
+
+		// Image with a different color in each quadrant
+		const uint32_t ImageSize = 24;
+		std::vector<uint8_t> Pixels(4 * ImageSize * ImageSize);
+		for (uint32_t y = 0; y < ImageSize; y++)
+		{
+			for (uint32_t x = 0; x < ImageSize; x++)
+			{
+				uint8_t* Pixel = &Pixels[4 * (y * ImageSize + x)];
+				Pixel[0] = x < ImageSize / 2 ? 255 : 0;
+				Pixel[1] = y < ImageSize / 2 ? 255 : 0;
+				Pixel[2] = 128;
+				Pixel[3] = 255;
+			}
+		}
+
+		TextureAtlas Atlas(32, 64, 2);
+		Ref<SubTexture2D> First = Atlas.Add(Pixels.data(), ImageSize, ImageSize, 4);
+		GX_SELF_TEST_CHECK(First != nullptr);
+		if (!First)
+			return Failures;
+
+		GX_SELF_TEST_CHECK(Atlas.GetWidth() == 32 && Atlas.GetHeight() == 32);
+		GX_SELF_TEST_CHECK(Atlas.IsDirty());
+
+		// Padding repeats the edge pixels of the image
+		const GM::Vector2 Min = First->GetTexCoords()[0];
+		GX_SELF_TEST_CHECK(std::memcmp(GetAtlasPixel(Atlas, Min), Pixels.data(), 4) == 0);
+		GX_SELF_TEST_CHECK(std::memcmp(GetAtlasPixel(Atlas, Min, -2, -2), Pixels.data(), 4) == 0);
+		GX_SELF_TEST_CHECK(std::memcmp(GetAtlasPixel(Atlas, Min, -1, 0), Pixels.data(), 4) == 0);
+
+		// Region of the image maps to the same pixels in the atlas
+		Ref<SubTexture2D> Quadrant = Atlas.AddRegion(First, GM::Vector2(0.5f, 0.5f), GM::Vector2(1.0f, 1.0f));
+		GX_SELF_TEST_CHECK(std::memcmp(GetAtlasPixel(Atlas, Quadrant->GetTexCoords()[0]), &Pixels[4 * ((ImageSize / 2) * ImageSize + ImageSize / 2)], 4) == 0);
+
+		// Second image does not fit, the atlas grows and the first image is moved along with its region
+		Ref<SubTexture2D> Second = Atlas.Add(Pixels.data(), ImageSize, ImageSize, 4);
+		GX_SELF_TEST_CHECK(Second != nullptr);
+		GX_SELF_TEST_CHECK(Atlas.GetWidth() == 64 && Atlas.GetHeight() == 32);
+		GX_SELF_TEST_CHECK(std::memcmp(GetAtlasPixel(Atlas, First->GetTexCoords()[0]), Pixels.data(), 4) == 0);
+		GX_SELF_TEST_CHECK(std::memcmp(GetAtlasPixel(Atlas, Quadrant->GetTexCoords()[0]), &Pixels[4 * ((ImageSize / 2) * ImageSize + ImageSize / 2)], 4) == 0);
+
+		// Image larger than the max size is rejected up front
+		const uint32_t LargeSize = 64;
+		std::vector<uint8_t> LargePixels(4 * LargeSize * LargeSize, 255);
+		GX_SELF_TEST_CHECK(Atlas.Add(LargePixels.data(), LargeSize, LargeSize, 4) == nullptr);
+
+		// Image which fits only in an empty atlas is rejected without growing the atlas
+		const uint32_t Width = Atlas.GetWidth(), Height = Atlas.GetHeight();
+		GX_SELF_TEST_CHECK(Atlas.Add(LargePixels.data(), LargeSize - 4, LargeSize - 4, 4) == nullptr);
+		GX_SELF_TEST_CHECK(Atlas.GetWidth() == Width && Atlas.GetHeight() == Height);
+		GX_SELF_TEST_CHECK(Atlas.GetImageCount() == 2);
+		GX_SELF_TEST_CHECK(std::memcmp(GetAtlasPixel(Atlas, First->GetTexCoords()[0]), Pixels.data(), 4) == 0);
+		GX_SELF_TEST_CHECK(std::memcmp(GetAtlasPixel(Atlas, Second->GetTexCoords()[0]), Pixels.data(), 4) == 0);
+
+		return Failures;
+	}
+
+	uint32_t SelfTest::CheckLightClusterGrid()
+	{
+		uint32_t Failures = 0;
+
+		// Each slice doubles the depth : Slice N covers the depths from 2^N to 2^(N + 1)
+		LightClusterGrid Grid(4, 4, 8);
+		ClusterView View;
+		View.Near = 1.0f;
+		View.Far = 256.0f;
+
+		auto MakeLight = [](float x, float y, float z, float Range) {
+			ClusterLightData Light;
+			Light.PositionRange = GM::Vector4(x, y, z, Range);
+			return Light;
+		};
+
+		// Camera is at the origin looking down the -ve z-axis
+		std::vector<ClusterLightData> Lights;
+		Lights.push_back(MakeLight(0.0f, 0.0f, -3.0f, 0.5f));		// Center of the view in the slice 1
+		Lights.push_back(MakeLight(2.4f, 0.0f, -6.0f, 0.5f));		// Right side of the view in the slice 2
+		Lights.push_back(MakeLight(0.0f, 0.0f, 5.0f, 1.0f));		// Behind the camera
+		Lights.push_back(MakeLight(0.0f, 0.0f, -300.0f, 10.0f));	// Beyond the far plane
+		Lights.push_back(MakeLight(0.0f, 0.0f, -10.0f, 1000.0f));	// Covers the entire view
+
+		Grid.AssignLights(View, Lights);
+
+		GX_SELF_TEST_CHECK(Grid.GetSlice(0.5f) == 0);
+		GX_SELF_TEST_CHECK(Grid.GetSlice(5.0f) == 2);
+		GX_SELF_TEST_CHECK(Grid.GetSlice(1000.0f) == 7);
+		GX_SELF_TEST_CHECK(std::abs(Grid.GetSliceDepth(3) - 8.0f) < 1e-3f);
+
+		// Clusters list their lights one after the other
+		const std::vector<uint32_t>& ClusterData = Grid.GetClusterData();
+		uint32_t ExpectedOffset = 0;
+		for (uint32_t Cluster = 0; Cluster < Grid.GetClusterCount(); Cluster++)
+		{
+			GX_SELF_TEST_CHECK(ClusterData[2 * Cluster] == ExpectedOffset);
+			ExpectedOffset += ClusterData[2 * Cluster + 1];
+		}
+
+		GX_SELF_TEST_CHECK(ExpectedOffset == Grid.GetLightIndices().size());
+
+		for (uint32_t Slice = 0; Slice < Grid.GetSlices(); Slice++)
+		{
+			for (uint32_t y = 0; y < Grid.GetTilesY(); y++)
+			{
+				for (uint32_t x = 0; x < Grid.GetTilesX(); x++)
+				{
+					const uint32_t Cluster = Grid.GetClusterIndex(x, y, Slice);
+
+					// Light near the center only affects the 4 clusters around the center of its slice
+					const bool IsCenter = Slice == 1 && (x == 1 || x == 2) && (y == 1 || y == 2);
+					GX_SELF_TEST_CHECK(IsLightInCluster(Grid, Cluster, 0) == IsCenter);
+
+					// Light on the right stays on the right half of its slice
+					if (Slice != 2 || x < 2)
+						GX_SELF_TEST_CHECK(!IsLightInCluster(Grid, Cluster, 1));
+
+					GX_SELF_TEST_CHECK(!IsLightInCluster(Grid, Cluster, 2));
+					GX_SELF_TEST_CHECK(!IsLightInCluster(Grid, Cluster, 3));
+					GX_SELF_TEST_CHECK(IsLightInCluster(Grid, Cluster, 4));
+				}
+			}
+		}
+
+		GX_SELF_TEST_CHECK(IsLightInCluster(Grid, Grid.GetClusterIndex(2, 2, 2), 1));
+
+		// Assigning only the lights outside the view clears the previous lights
+		std::vector<ClusterLightData> HiddenLights(Lights.begin() + 2, Lights.begin() + 4);
+		Grid.AssignLights(View, HiddenLights);
+
+		GX_SELF_TEST_CHECK(Grid.GetLightIndices().empty());
+		for (uint32_t Cluster = 0; Cluster < Grid.GetClusterCount(); Cluster++)
+		{
+			GX_SELF_TEST_CHECK(ClusterData[2 * Cluster + 1] == 0);
+		}
+
+		return Failures;
+	}
+}
\ No newline at end of file
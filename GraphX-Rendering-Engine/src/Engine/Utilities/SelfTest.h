@@ -0,0 +1,30 @@
+#pragma once
+
+namespace GraphX
+{
+	/*
+	* Checks of the parts of the engine which run only on the CPU (no window or graphics context is created)
+	* Run with --self-test in place of the application, the process exits with 0 if all the checks pass
+	*/
+	class SelfTest
+	{
+	public:
+		/* Returns whether the self test is requested on the command line */
+		static bool IsRequested(int argc, char** argv);
+
+		/* Runs all the checks and logs the failed ones, returns false if any check failed */
+		static bool Run();
+
+	private:
+		/* Each check returns the number of failed conditions */
+
+		/* Insertion, bounds, overlaps, repacking and occupancy of the atlas packer */
+		static uint32_t CheckAtlasPacker();
+
+		/* Layout of the texture atlas on the CPU (edge extrusion, growth, regions and rejected images) */
+		static uint32_t CheckTextureAtlas();
+
+		/* Slices of the light cluster grid and the lights assigned to each cluster */
+		static uint32_t CheckLightClusterGrid();
+	};
+}
\ No newline at end of file
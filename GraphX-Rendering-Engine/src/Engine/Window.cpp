@@ -4,6 +4,7 @@
 #include "GLFW/glfw3.h"
 
 #include "GraphicsContext.h"
+#include "Device/RenderDevice.h"
 #include "Timer/Timer.h"
 #include "Gui/GraphXGui.h"
 #include "Events/WindowEvent.h"
@@ -35,6 +36,15 @@ namespace GraphX
 		m_Data.Title = props.Title;
 		m_Data.Width = props.Width;
 		m_Data.Height = props.Height;
+		m_Data.Vsync = false;
+
+		// The null device renders nothing, so there is no native window (or context) to create
+		if (RenderDevice::GetType() == RenderDeviceType::Null)
+		{
+			m_Window = nullptr;
+			m_Context = nullptr;
+			return;
+		}
 
 		{
 			GX_PROFILE_SCOPE("glfwInit()")
@@ -50,6 +60,7 @@ namespace GraphX
 
 			// Requesting opengl debug context
 			glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
+			glfwWindowHint(GLFW_VISIBLE, props.IsVisible ? GLFW_TRUE : GLFW_FALSE);
 
 			// Create the window
 			m_Window = glfwCreateWindow(m_Data.Width, m_Data.Height, m_Data.Title.c_str(), NULL, NULL);
@@ -193,17 +204,15 @@ namespace GraphX
 	{
 		GX_PROFILE_FUNCTION()
 
-		glClearColor(r, g, b, a);
+		RenderDevice::Get().ClearColor(r, g, b, a);
 	}
 
 	void Window::SetVSync(bool enabled)
 	{
 		GX_PROFILE_FUNCTION()
 
-		if (enabled)
-			glfwSwapInterval(1);
-		else
-			glfwSwapInterval(0);
+		if (m_Window)
+			glfwSwapInterval(enabled ? 1 : 0);
 
 		m_Data.Vsync = enabled;
 	}
@@ -218,20 +227,23 @@ namespace GraphX
 		GX_PROFILE_FUNCTION()
 
 		/* Clear both color and depth buffer */
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);	// More efficient to do in one function call
+		RenderDevice::Get().Clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);	// More efficient to do in one function call
 	}
 
 	void Window::ClearDepthBuffer()
 	{
 		GX_PROFILE_FUNCTION()
 
-		glClear(GL_DEPTH_BUFFER_BIT);
+		RenderDevice::Get().Clear(GL_DEPTH_BUFFER_BIT);
 	}
 
 	void Window::OnUpdate()
 	{
 		GX_PROFILE_FUNCTION()
 
+		if (!m_Window)
+			return;
+
 		/* Swap the front and back buffers */
 		glfwSwapBuffers(m_Window);
 
@@ -243,12 +255,13 @@ namespace GraphX
 	{
 		GX_PROFILE_FUNCTION()
 
-		glViewport(0, 0, m_Data.Width, m_Data.Height);
+		RenderDevice::Get().Viewport(0, 0, m_Data.Width, m_Data.Height);
 	}
 
 	void Window::SetCursorInputMode(CursorInputMode InputMode)
 	{
-		glfwSetInputMode(m_Window, GLFW_CURSOR, GLFW_CURSOR_NORMAL + (int)InputMode);
+		if (m_Window)
+			glfwSetInputMode(m_Window, GLFW_CURSOR, GLFW_CURSOR_NORMAL + (int)InputMode);
 	}
 
 	Window::~Window()
@@ -259,6 +272,9 @@ namespace GraphX
 		/* Destroy the Graphics Context */
 		delete m_Context;
 
+		if (!m_Window)
+			return;
+
 		/* Destroy the window */
 		glfwDestroyWindow(m_Window);
 
@@ -16,8 +16,11 @@ namespace GraphX
 		// Width and height of the window
 		unsigned int Width, Height;
 
-		WindowProps(const std::string& title = "GraphX Engine", unsigned int width = 1920, unsigned int height = 1080)
-			: Title(title), Width(width), Height(height)
+		// Whether the window is shown (hidden windows still render offscreen)
+		bool IsVisible;
+
+		WindowProps(const std::string& title = "GraphX Engine", unsigned int width = 1920, unsigned int height = 1080, bool visible = true)
+			: Title(title), Width(width), Height(height), IsVisible(visible)
 		{}
 	};
 
@@ -5,6 +5,9 @@
 /* Standard Libraries */
 #include <iostream>
 #include <limits>
+#include <cmath>
+#include <cfloat>
+#include <climits>
 
 /* STL */
 #include <vector>
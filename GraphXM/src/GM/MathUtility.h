@@ -29,7 +29,7 @@ namespace GM
 		static float Sqrt(const float Value)
 		{
 			if (Value > 0)
-				return std::sqrtf(Value);
+				return std::sqrt(Value);
 			else
 				return 0;
 		}
@@ -0,0 +1,303 @@
+#include "pch.h"
+
+#include "Core/Textures/BlockCompression.h"
+#include "Core/Textures/CompressedImage.h"
+#include "Core/Textures/MipGenerator.h"
+#include "stb/stb_image.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <dirent.h>
+#endif
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+/**
+* Offline texture compressor
+* Encodes the images (PNG, JPG, TGA) in to block compressed DDS files along with their mip chains, written next to the images
+* The engine loads the DDS file in place of the image when it is present (GX_ENABLE_COMPRESSED_TEXTURES)
+*
+* Usage: TextureCompressor [--format auto|bc1|bc3|bc4|bc5|bc7] [--mips box|kaiser|none] [--wrap] [--force] [Files or directories...]
+* Everything under res/ is compressed when no paths are given, except the data textures (Which are compressed only when named explicitly)
+*/
+
+using namespace GraphX;
+
+struct CompressorOptions
+{
+	/* Picks BC1 for the opaque images and BC7 for the images with alpha */
+	bool IsAutoFormat = true;
+	BlockFormat Format = BlockFormat::BC1;
+
+	bool GenerateMips = true;
+	MipFilter Filter = MipFilter::Box;
+
+	/* Whether the mips wrap around the edges (for the tiled textures) */
+	bool Wrap = false;
+
+	/* Whether the images are compressed even if their DDS file is newer */
+	bool Force = false;
+
+	std::vector<std::string> Paths;
+};
+
+static void PrintUsage()
+{
+	std::cout << "Usage: TextureCompressor [--format auto|bc1|bc3|bc4|bc5|bc7] [--mips box|kaiser|none] [--wrap] [--force] [Files or directories...]" << std::endl;
+}
+
+static std::string ToLower(std::string String)
+{
+	std::transform(String.begin(), String.end(), String.begin(), ::tolower);
+	return String;
+}
+
+static bool ParseCommandLine(int argc, char** argv, CompressorOptions& Options)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string Argument = argv[i];
+
+		if (Argument == "--format" && i + 1 < argc)
+		{
+			const std::string Format = ToLower(argv[++i]);
+			Options.IsAutoFormat = Format == "auto";
+
+			if (Format == "bc1")		Options.Format = BlockFormat::BC1;
+			else if (Format == "bc3")	Options.Format = BlockFormat::BC3;
+			else if (Format == "bc4")	Options.Format = BlockFormat::BC4;
+			else if (Format == "bc5")	Options.Format = BlockFormat::BC5;
+			else if (Format == "bc7")	Options.Format = BlockFormat::BC7;
+			else if (!Options.IsAutoFormat)
+				return false;
+		}
+		else if (Argument == "--mips" && i + 1 < argc)
+		{
+			const std::string Mips = ToLower(argv[++i]);
+			Options.GenerateMips = Mips != "none";
+
+			if (Mips == "box")			Options.Filter = MipFilter::Box;
+			else if (Mips == "kaiser")	Options.Filter = MipFilter::Kaiser;
+			else if (Options.GenerateMips)
+				return false;
+		}
+		else if (Argument == "--wrap")
+			Options.Wrap = true;
+		else if (Argument == "--force")
+			Options.Force = true;
+		else if (Argument.compare(0, 2, "--") == 0)
+			return false;
+		else
+			Options.Paths.push_back(Argument);
+	}
+
+	if (Options.Paths.empty())
+		Options.Paths.push_back("res");
+
+	return true;
+}
+
+static bool IsImageFile(const std::string& FilePath)
+{
+	const size_t ExtensionStart = FilePath.find_last_of('.');
+	if (ExtensionStart == std::string::npos)
+		return false;
+
+	const std::string Extension = ToLower(FilePath.substr(ExtensionStart + 1));
+	return Extension == "png" || Extension == "jpg" || Extension == "jpeg" || Extension == "tga";
+}
+
+/**
+* Whether the image stores data in its channels instead of colors (blend maps, height maps, masks and normal maps)
+* BC1 / BC7 fit the channels together and bleed the values in to each other, so the format has to be picked for their channels
+*/
+static bool IsDataTexture(const std::string& FilePath)
+{
+	const std::string FileName = ToLower(FilePath.substr(FilePath.find_last_of("/\\") + 1));
+	for (const char* Name : { "blendmap", "heightmap", "mask", "normal" })
+	{
+		if (FileName.find(Name) != std::string::npos)
+			return true;
+	}
+
+	return false;
+}
+
+/* Adds the image at the path, or all the images under it if it is a directory (Data textures are added only when named directly) */
+static void CollectImages(const std::string& Path, std::vector<std::string>& OutImages, bool IsExplicitPath)
+{
+#ifdef _WIN32
+	const DWORD Attributes = GetFileAttributesA(Path.c_str());
+	if (Attributes == INVALID_FILE_ATTRIBUTES)
+	{
+		GX_CLIENT_ERROR("TextureCompressor: {0} does not exist", Path);
+		return;
+	}
+
+	if (!(Attributes & FILE_ATTRIBUTE_DIRECTORY))
+	{
+		if (IsImageFile(Path) && !IsExplicitPath && IsDataTexture(Path))
+			GX_CLIENT_INFO("TextureCompressor: Skipping the data texture {0} (Name it explicitly to compress it)", Path);
+		else if (IsImageFile(Path))
+			OutImages.push_back(Path);
+		return;
+	}
+
+	WIN32_FIND_DATAA FindData;
+	HANDLE FindHandle = FindFirstFileA((Path + "/*").c_str(), &FindData);
+	if (FindHandle == INVALID_HANDLE_VALUE)
+		return;
+
+	do
+	{
+		if (std::strcmp(FindData.cFileName, ".") != 0 && std::strcmp(FindData.cFileName, "..") != 0)
+			CollectImages(Path + "/" + FindData.cFileName, OutImages, false);
+	} while (FindNextFileA(FindHandle, &FindData));
+
+	FindClose(FindHandle);
+#else
+	struct stat Attributes;
+	if (stat(Path.c_str(), &Attributes) != 0)
+	{
+		GX_CLIENT_ERROR("TextureCompressor: {0} does not exist", Path);
+		return;
+	}
+
+	if (!S_ISDIR(Attributes.st_mode))
+	{
+		if (IsImageFile(Path) && !IsExplicitPath && IsDataTexture(Path))
+			GX_CLIENT_INFO("TextureCompressor: Skipping the data texture {0} (Name it explicitly to compress it)", Path);
+		else if (IsImageFile(Path))
+			OutImages.push_back(Path);
+		return;
+	}
+
+	DIR* Directory = opendir(Path.c_str());
+	if (Directory == nullptr)
+		return;
+
+	while (const dirent* Entry = readdir(Directory))
+	{
+		if (std::strcmp(Entry->d_name, ".") != 0 && std::strcmp(Entry->d_name, "..") != 0)
+			CollectImages(Path + "/" + Entry->d_name, OutImages, false);
+	}
+
+	closedir(Directory);
+#endif
+}
+
+/* Returns whether the output is newer than the input */
+static bool IsUpToDate(const std::string& InputPath, const std::string& OutputPath)
+{
+#ifdef _WIN32
+	struct _stat64 Input, Output;
+	if (_stat64(InputPath.c_str(), &Input) != 0 || _stat64(OutputPath.c_str(), &Output) != 0)
+		return false;
+#else
+	struct stat Input, Output;
+	if (stat(InputPath.c_str(), &Input) != 0 || stat(OutputPath.c_str(), &Output) != 0)
+		return false;
+#endif
+
+	return Output.st_mtime >= Input.st_mtime;
+}
+
+/* Compresses an image along with its mips in to a DDS file next to it, returns the sizes of the image and the DDS data (in video memory) */
+static bool CompressImage(const std::string& ImagePath, const CompressorOptions& Options, uint64_t& OutImageSize, uint64_t& OutCompressedSize)
+{
+	int Width, Height, Channels;
+	stbi_uc* Pixels = stbi_load(ImagePath.c_str(), &Width, &Height, &Channels, 4);
+	if (!Pixels)
+	{
+		GX_CLIENT_ERROR("TextureCompressor: Couldn't load {0} ({1})", ImagePath, stbi_failure_reason());
+		return false;
+	}
+
+	BlockFormat Format = Options.Format;
+	if (Options.IsAutoFormat)
+	{
+		bool HasAlpha = false;
+		for (size_t i = 3; i < (size_t)Width * Height * 4 && !HasAlpha; i += 4)
+			HasAlpha = Pixels[i] < 255;
+
+		Format = HasAlpha ? BlockFormat::BC7 : BlockFormat::BC1;
+	}
+
+	CompressedImage Image(Format, Width, Height);
+	Image.AddLevel(Width, Height, BlockCompression::Compress(Pixels, Width, Height, Format));
+
+	// Uncompressed size of the texture in the engine (RGB images are stored without the alpha)
+	const uint32_t BytesPerPixel = Channels == 4 ? 4 : 3;
+	OutImageSize = (uint64_t)Width * Height * BytesPerPixel;
+
+	if (Options.GenerateMips)
+	{
+		for (const MipLevel& Level : MipGenerator::Generate(Pixels, Width, Height, 4, Options.Filter, Options.Wrap))
+		{
+			Image.AddLevel(Level.Width, Level.Height, BlockCompression::Compress(Level.Pixels.data(), Level.Width, Level.Height, Format));
+			OutImageSize += (uint64_t)Level.Width * Level.Height * BytesPerPixel;
+		}
+	}
+
+	stbi_image_free(Pixels);
+
+	OutCompressedSize = 0;
+	for (uint32_t Level = 0; Level < Image.GetLevelCount(); Level++)
+		OutCompressedSize += Image.GetLevel(0, Level).Size;
+
+	const std::string OutputPath = ImagePath.substr(0, ImagePath.find_last_of('.')) + ".dds";
+	if (!Image.SaveDDS(OutputPath))
+		return false;
+
+	GX_CLIENT_INFO("TextureCompressor: {0} -> {1} ({2}x{3}, {4} levels, {5})", ImagePath, OutputPath, Width, Height, Image.GetLevelCount(), BlockCompression::GetFormatName(Format));
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	Log::Init();
+
+	CompressorOptions Options;
+	if (!ParseCommandLine(argc, argv, Options))
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	std::vector<std::string> Images;
+	for (const std::string& Path : Options.Paths)
+		CollectImages(Path, Images, true);
+
+	uint32_t Compressed = 0, Skipped = 0, Failed = 0;
+	uint64_t TotalImageSize = 0, TotalCompressedSize = 0;
+
+	for (const std::string& ImagePath : Images)
+	{
+		if (!Options.Force && IsUpToDate(ImagePath, ImagePath.substr(0, ImagePath.find_last_of('.')) + ".dds"))
+		{
+			Skipped++;
+			continue;
+		}
+
+		uint64_t ImageSize = 0, CompressedSize = 0;
+		if (!CompressImage(ImagePath, Options, ImageSize, CompressedSize))
+		{
+			Failed++;
+			continue;
+		}
+
+		Compressed++;
+		TotalImageSize += ImageSize;
+		TotalCompressedSize += CompressedSize;
+	}
+
+	GX_CLIENT_INFO("TextureCompressor: {0} compressed, {1} up to date, {2} failed", Compressed, Skipped, Failed);
+	if (TotalCompressedSize > 0)
+		GX_CLIENT_INFO("TextureCompressor: Video memory of the compressed textures {0:.2f} MB -> {1:.2f} MB", TotalImageSize / (1024.0 * 1024.0), TotalCompressedSize / (1024.0 * 1024.0));
+
+	return Failed > 0 ? 1 : 0;
+}
\ No newline at end of file